@@ -0,0 +1,207 @@
+#ifndef H_UTILS_BENCH_COMMON_H
+#define H_UTILS_BENCH_COMMON_H
+
+//  includes
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <initializer_list>
+#include <random>
+#include <string>
+#include <vector>
+#include "benchmark/benchmark.h"
+#include "perf_counters.h"
+
+//  largest element count any suite benchmark runs at, set from CMake with UTILS_BENCH_MAX_SIZE
+#ifndef UTILS_BENCH_MAX_SIZE
+#define UTILS_BENCH_MAX_SIZE 10000000
+#endif
+
+namespace utils {
+    namespace bench {
+
+        //  no container is grown past this many bytes of elements, so the 256 byte runs stop
+        //  a decade or two short of the int ones
+        enum { MAX_ELEMENT_BYTES = 1 << 28 };
+
+        //  element of Bytes bytes, ordered and compared on its key so it can key a map too
+        template<std::size_t Bytes>
+        struct Payload
+        {
+            static_assert(Bytes >= sizeof(std::uint32_t), "payload must hold its key");
+
+            Payload() = default;
+            explicit Payload(const std::uint32_t key) : mKey(key) { std::memset(mPad, static_cast<int>(key & 0xFF), sizeof(mPad)); }
+
+            bool operator==(const Payload& rhs) const { return mKey == rhs.mKey; }
+            bool operator!=(const Payload& rhs) const { return mKey != rhs.mKey; }
+            bool operator<(const Payload& rhs) const { return mKey < rhs.mKey; }
+            bool operator>(const Payload& rhs) const { return mKey > rhs.mKey; }
+
+            std::uint32_t mKey = 0;
+            char mPad[Bytes - sizeof(std::uint32_t)];
+        };
+
+        template<typename T>
+        inline T makeValue(const std::uint32_t key) { return T(key); }
+
+        //  the key a value was made from, something cheap to fold while walking a container
+        inline std::uint32_t keyOf(const int value) { return static_cast<std::uint32_t>(value); }
+        template<std::size_t Bytes>
+        inline std::uint32_t keyOf(const Payload<Bytes>& value) { return value.mKey; }
+
+        //  order keys are inserted in
+        //  sorted and adversarial (alternating smallest and largest left) both degenerate an unbalanced tree
+        enum E_KEY_ORDER
+        {
+            SORTED_KO,
+            RANDOM_KO,
+            ADVERSARIAL_KO
+        };
+
+        inline std::vector<std::uint32_t> makeKeys(const std::size_t count, const E_KEY_ORDER order)
+        {
+            std::vector<std::uint32_t> keys(count);
+            for (std::size_t i = 0; i < count; ++i) {
+                keys[i] = static_cast<std::uint32_t>(i);
+            }
+
+            if (order == RANDOM_KO) {
+                std::mt19937 rng(1234);
+                std::shuffle(keys.begin(), keys.end(), rng);
+            }
+            else if (order == ADVERSARIAL_KO) {
+                for (std::size_t i = 0; i < count; ++i) {
+                    keys[i] = static_cast<std::uint32_t>(i % 2 == 0 ? i / 2 : count - 1 - i / 2);
+                }
+            }
+
+            return keys;
+        }
+
+        //  the largest count worth running for elements of type T under limit
+        template<typename T>
+        std::int64_t sizeCap(const std::int64_t limit)
+        {
+            const std::int64_t cap = std::min<std::int64_t>(limit, UTILS_BENCH_MAX_SIZE);
+            return std::min<std::int64_t>(cap, MAX_ELEMENT_BYTES / static_cast<std::int64_t>(sizeof(T)));
+        }
+
+        //  for Apply(), sizes 1, 10, 100 ... up to sizeCap
+        template<typename T, std::int64_t Limit = UTILS_BENCH_MAX_SIZE>
+        void decadeSizes(benchmark::internal::Benchmark* b)
+        {
+            for (std::int64_t size = 1; size <= sizeCap<T>(Limit); size *= 10) {
+                b->Arg(size);
+            }
+        }
+
+        //  as decadeSizes, with the key order as the second argument
+        //  the orders that degenerate an unbalanced tree stop at DegenerateLimit,
+        //  past that they only measure the same quadratic walk for longer
+        template<typename T, std::int64_t Limit = UTILS_BENCH_MAX_SIZE, std::int64_t DegenerateLimit = Limit>
+        void decadeSizesByOrder(benchmark::internal::Benchmark* b)
+        {
+            for (const E_KEY_ORDER order : { SORTED_KO, RANDOM_KO, ADVERSARIAL_KO }) {
+                const std::int64_t cap = sizeCap<T>(order == RANDOM_KO ? Limit : DegenerateLimit);
+                for (std::int64_t size = 1; size <= cap; size *= 10) {
+                    b->Args({ size, order });
+                }
+            }
+        }
+
+        //  PerfRegion
+        //  counts one benchmark, opt in by setting UTILS_BENCH_PERF_COUNTERS=1 in the environment
+        //  report() adds each available counter divided by the operations done next to the timings,
+        //  so "L1d-misses/op" sits alongside items_per_second
+        //  counters keep running through state.PauseTiming(), benchmarks that pause call pause() and
+        //  resume() too
+        class PerfRegion
+        {
+        public:
+            explicit PerfRegion(benchmark::State& state);
+
+            void pause() { if (mCounters) mCounters->pause(); }
+            void resume() { if (mCounters) mCounters->resume(); }
+
+            //  items is the number of operations each iteration did
+            void report(const std::int64_t items);
+
+            static bool enabled();
+
+        private:
+            benchmark::State& mState;
+            PerfCounters* mCounters;
+        };
+
+        //  items and element bytes processed per second
+        template<typename T>
+        void setCounters(benchmark::State& state, const std::int64_t items)
+        {
+            state.SetItemsProcessed(state.iterations() * items);
+            state.SetBytesProcessed(state.iterations() * items * static_cast<std::int64_t>(sizeof(T)));
+        }
+
+        //  as above, with the hardware counters for the run per item when they were asked for
+        template<typename T>
+        void setCounters(benchmark::State& state, const std::int64_t items, PerfRegion& perf)
+        {
+            setCounters<T>(state, items);
+            perf.report(items);
+        }
+
+        inline PerfRegion::PerfRegion(benchmark::State& state) : mState(state), mCounters(nullptr)
+        {
+            if (!enabled()) {
+                return;
+            }
+
+            //  one set of counters for the whole run, opening six fds per benchmark adds up
+            static PerfCounters counters;
+            static bool warned = false;
+            if (!counters.anyAvailable()) {
+                if (!warned) {
+                    std::fprintf(stderr, "UTILS_BENCH_PERF_COUNTERS is set but no hardware counters could be opened\n");
+                    warned = true;
+                }
+
+                return;
+            }
+
+            mCounters = &counters;
+            mCounters->start();
+        }
+
+        inline void PerfRegion::report(const std::int64_t items)
+        {
+            if (!mCounters) {
+                return;
+            }
+
+            mCounters->pause();
+
+            const double operations = static_cast<double>(mState.iterations()) * static_cast<double>(items);
+            if (operations <= 0.0) {
+                return;
+            }
+
+            for (int i = 0; i < PerfCounters::COUNTER_COUNT; ++i) {
+                const PerfCounters::E_COUNTER counter = static_cast<PerfCounters::E_COUNTER>(i);
+                if (mCounters->available(counter)) {
+                    mState.counters[std::string(PerfCounters::name(counter)) + "/op"] = mCounters->read(counter) / operations;
+                }
+            }
+        }
+
+        inline bool PerfRegion::enabled()
+        {
+            const char* value = std::getenv("UTILS_BENCH_PERF_COUNTERS");
+            return value != nullptr && value[0] != '\0' && std::strcmp(value, "0") != 0;
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,227 @@
+#ifndef H_UTILS_BENCH_PERF_COUNTERS_H
+#define H_UTILS_BENCH_PERF_COUNTERS_H
+
+//  includes
+#include <cstdint>
+#include <cstring>
+
+#if defined(__linux__)
+#define UTILS_BENCH_PERF_EVENTS
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace utils {
+    namespace bench {
+
+        //  PerfCounters
+        //  hardware counters for the calling thread, user space only, read through perf_event_open
+        //  each counter opens on its own so one the CPU or kernel does not offer (common in VMs and
+        //  containers, or with a strict perf_event_paranoid) only drops that counter
+        //  off Linux nothing opens and every counter reads as unavailable
+        class PerfCounters
+        {
+        public:
+            enum E_COUNTER
+            {
+                CYCLES_PC,
+                INSTRUCTIONS_PC,
+                L1D_MISSES_PC,
+                LLC_MISSES_PC,
+                BRANCH_MISSES_PC,
+                DTLB_MISSES_PC,
+                COUNTER_COUNT
+            };
+
+            PerfCounters();
+            ~PerfCounters();
+
+            PerfCounters(const PerfCounters&) = delete;
+            PerfCounters& operator=(const PerfCounters&) = delete;
+
+            //  start zeroes the counts, pause and resume bracket work that should not be counted
+            void start();
+            void pause();
+            void resume();
+
+            bool available(const E_COUNTER counter) const { return mFds[counter] >= 0; }
+            bool anyAvailable() const;
+
+            //  count since start, scaled up when the kernel had to multiplex the counter
+            double read(const E_COUNTER counter) const;
+
+            static const char* name(const E_COUNTER counter);
+
+        private:
+            void ioctlAll(const unsigned long request);
+            //  value, time enabled, time running, false if the counter is closed or the read fails
+            bool readRaw(const E_COUNTER counter, std::uint64_t (&values)[3]) const;
+
+        private:
+            int mFds[COUNTER_COUNT];
+            //  reset only zeroes the value, the times keep running from the open, so start remembers them
+            std::uint64_t mEnabledAtStart[COUNTER_COUNT];
+            std::uint64_t mRunningAtStart[COUNTER_COUNT];
+        };
+
+        inline PerfCounters::PerfCounters()
+        {
+            for (int i = 0; i < COUNTER_COUNT; ++i) {
+                mFds[i] = -1;
+                mEnabledAtStart[i] = 0;
+                mRunningAtStart[i] = 0;
+            }
+
+#ifdef UTILS_BENCH_PERF_EVENTS
+            //  (type, config) for each E_COUNTER, cache events are (cache | op << 8 | result << 16)
+            const std::uint32_t types[COUNTER_COUNT] = {
+                PERF_TYPE_HARDWARE,
+                PERF_TYPE_HARDWARE,
+                PERF_TYPE_HW_CACHE,
+                PERF_TYPE_HARDWARE,
+                PERF_TYPE_HARDWARE,
+                PERF_TYPE_HW_CACHE
+            };
+
+            const std::uint64_t configs[COUNTER_COUNT] = {
+                PERF_COUNT_HW_CPU_CYCLES,
+                PERF_COUNT_HW_INSTRUCTIONS,
+                PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16),
+                PERF_COUNT_HW_CACHE_MISSES,
+                PERF_COUNT_HW_BRANCH_MISSES,
+                PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)
+            };
+
+            for (int i = 0; i < COUNTER_COUNT; ++i) {
+                perf_event_attr attr;
+                std::memset(&attr, 0, sizeof(attr));
+                attr.size = sizeof(attr);
+                attr.type = types[i];
+                attr.config = configs[i];
+                attr.disabled = 1;
+                attr.exclude_kernel = 1;
+                attr.exclude_hv = 1;
+                attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+                //  this thread, any cpu, no group
+                mFds[i] = static_cast<int>(syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0));
+            }
+#endif
+        }
+
+        inline PerfCounters::~PerfCounters()
+        {
+#ifdef UTILS_BENCH_PERF_EVENTS
+            for (int i = 0; i < COUNTER_COUNT; ++i) {
+                if (mFds[i] >= 0) {
+                    close(mFds[i]);
+                }
+            }
+#endif
+        }
+
+        inline void PerfCounters::start()
+        {
+#ifdef UTILS_BENCH_PERF_EVENTS
+            ioctlAll(PERF_EVENT_IOC_RESET);
+            for (int i = 0; i < COUNTER_COUNT; ++i) {
+                std::uint64_t values[3] = { 0, 0, 0 };
+                readRaw(static_cast<E_COUNTER>(i), values);
+                mEnabledAtStart[i] = values[1];
+                mRunningAtStart[i] = values[2];
+            }
+
+            ioctlAll(PERF_EVENT_IOC_ENABLE);
+#endif
+        }
+
+        inline void PerfCounters::pause()
+        {
+#ifdef UTILS_BENCH_PERF_EVENTS
+            ioctlAll(PERF_EVENT_IOC_DISABLE);
+#endif
+        }
+
+        inline void PerfCounters::resume()
+        {
+#ifdef UTILS_BENCH_PERF_EVENTS
+            ioctlAll(PERF_EVENT_IOC_ENABLE);
+#endif
+        }
+
+        inline bool PerfCounters::anyAvailable() const
+        {
+            for (int i = 0; i < COUNTER_COUNT; ++i) {
+                if (mFds[i] >= 0) {
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
+        inline double PerfCounters::read(const E_COUNTER counter) const
+        {
+#ifdef UTILS_BENCH_PERF_EVENTS
+            std::uint64_t values[3] = { 0, 0, 0 };
+            if (!readRaw(counter, values)) {
+                return 0.0;
+            }
+
+            //  scaled by the share of the region the counter was actually on the hardware
+            const std::uint64_t enabled = values[1] - mEnabledAtStart[counter];
+            const std::uint64_t running = values[2] - mRunningAtStart[counter];
+            if (running == 0) {
+                return 0.0;
+            }
+
+            return static_cast<double>(values[0]) * (static_cast<double>(enabled) / static_cast<double>(running));
+#else
+            (void)counter;
+            return 0.0;
+#endif
+        }
+
+        inline const char* PerfCounters::name(const E_COUNTER counter)
+        {
+            static const char* const names[COUNTER_COUNT] = {
+                "cycles",
+                "instructions",
+                "L1d-misses",
+                "LLC-misses",
+                "branch-misses",
+                "dTLB-misses"
+            };
+
+            return names[counter];
+        }
+
+        inline void PerfCounters::ioctlAll(const unsigned long request)
+        {
+#ifdef UTILS_BENCH_PERF_EVENTS
+            for (int i = 0; i < COUNTER_COUNT; ++i) {
+                if (mFds[i] >= 0) {
+                    ioctl(mFds[i], request, 0);
+                }
+            }
+#else
+            (void)request;
+#endif
+        }
+
+        inline bool PerfCounters::readRaw(const E_COUNTER counter, std::uint64_t (&values)[3]) const
+        {
+#ifdef UTILS_BENCH_PERF_EVENTS
+            return mFds[counter] >= 0 && ::read(mFds[counter], values, sizeof(values)) == static_cast<ssize_t>(sizeof(values));
+#else
+            (void)counter;
+            (void)values;
+            return false;
+#endif
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,128 @@
+#include "benchmark/benchmark.h"
+#include <cstdint>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+#include "../../lib/include/adaptive_radix_tree.h"
+#include "../../lib/include/bst.h"
+
+//  path like string keys and 64 bit ids, built in random order
+//  BST has no lookup, so inserts are compared against it (an insert does the same descent),
+//  and lookups against std::map, which is also a tree of full key compares
+
+using utils::storage::AdaptiveRadixTree;
+using utils::storage::BST;
+
+static std::vector<std::string> makePaths(const int count)
+{
+	static const char* const dirs[] = { "/usr/", "/usr/local/", "/var/lib/", "/home/user/projects/", "/opt/vendor/runtime/" };
+	std::mt19937 rng(11);
+	std::vector<std::string> paths(count);
+	for (int i = 0; i < count; ++i) {
+		paths[i] = std::string(dirs[rng() % 5]) + "module" + std::to_string(rng() % 97) + "/file" + std::to_string(i) + ".cpp";
+	}
+
+	return paths;
+}
+
+static std::vector<std::uint64_t> makeIds(const int count)
+{
+	std::mt19937_64 rng(11);
+	std::vector<std::uint64_t> ids(count);
+	for (std::uint64_t& id : ids) {
+		id = rng();
+	}
+
+	return ids;
+}
+
+template <typename Tree, typename Key>
+static void radixInsertBench(benchmark::State& state, const std::vector<Key>& keys)
+{
+	for (auto _ : state) {
+		Tree tree;
+		for (const Key& key : keys) {
+			tree.insert(key, 1);
+		}
+
+		benchmark::DoNotOptimize(tree.getSize());
+	}
+
+	state.SetItemsProcessed(state.iterations() * keys.size());
+}
+
+template <typename Key>
+static void bstInsertBench(benchmark::State& state, const std::vector<Key>& keys)
+{
+	for (auto _ : state) {
+		BST<Key, int> tree;
+		for (const Key& key : keys) {
+			tree.insert(key, 1);
+		}
+
+		state.PauseTiming();
+		tree.clear();
+		state.ResumeTiming();
+	}
+
+	state.SetItemsProcessed(state.iterations() * keys.size());
+}
+
+template <typename Map, typename Key>
+static void lookupBench(benchmark::State& state, const std::vector<Key>& keys)
+{
+	Map map;
+	for (const Key& key : keys) {
+		map.insert(std::make_pair(key, 1));
+	}
+
+	for (auto _ : state) {
+		std::size_t found = 0;
+		for (const Key& key : keys) {
+			found += map.find(key) != map.end() ? 1 : 0;
+		}
+
+		benchmark::DoNotOptimize(found);
+	}
+
+	state.SetItemsProcessed(state.iterations() * keys.size());
+}
+
+template <typename Key>
+static void radixLookupBench(benchmark::State& state, const std::vector<Key>& keys)
+{
+	AdaptiveRadixTree<Key, int> tree;
+	for (const Key& key : keys) {
+		tree.insert(key, 1);
+	}
+
+	for (auto _ : state) {
+		std::size_t found = 0;
+		for (const Key& key : keys) {
+			found += tree.contains(key) ? 1 : 0;
+		}
+
+		benchmark::DoNotOptimize(found);
+	}
+
+	state.SetItemsProcessed(state.iterations() * keys.size());
+}
+
+static void stringRadixInsert(benchmark::State& state) { radixInsertBench<AdaptiveRadixTree<std::string, int>>(state, makePaths(static_cast<int>(state.range(0)))); }
+static void stringBstInsert(benchmark::State& state) { bstInsertBench(state, makePaths(static_cast<int>(state.range(0)))); }
+static void stringRadixLookup(benchmark::State& state) { radixLookupBench(state, makePaths(static_cast<int>(state.range(0)))); }
+static void stringMapLookup(benchmark::State& state) { lookupBench<std::map<std::string, int>>(state, makePaths(static_cast<int>(state.range(0)))); }
+static void idRadixInsert(benchmark::State& state) { radixInsertBench<AdaptiveRadixTree<std::uint64_t, int>>(state, makeIds(static_cast<int>(state.range(0)))); }
+static void idBstInsert(benchmark::State& state) { bstInsertBench(state, makeIds(static_cast<int>(state.range(0)))); }
+static void idRadixLookup(benchmark::State& state) { radixLookupBench(state, makeIds(static_cast<int>(state.range(0)))); }
+static void idMapLookup(benchmark::State& state) { lookupBench<std::map<std::uint64_t, int>>(state, makeIds(static_cast<int>(state.range(0)))); }
+
+BENCHMARK(stringRadixInsert)->RangeMultiplier(16)->Range(1 << 10, 1 << 18);
+BENCHMARK(stringBstInsert)->RangeMultiplier(16)->Range(1 << 10, 1 << 18);
+BENCHMARK(stringRadixLookup)->RangeMultiplier(16)->Range(1 << 10, 1 << 18);
+BENCHMARK(stringMapLookup)->RangeMultiplier(16)->Range(1 << 10, 1 << 18);
+BENCHMARK(idRadixInsert)->RangeMultiplier(16)->Range(1 << 10, 1 << 18);
+BENCHMARK(idBstInsert)->RangeMultiplier(16)->Range(1 << 10, 1 << 18);
+BENCHMARK(idRadixLookup)->RangeMultiplier(16)->Range(1 << 10, 1 << 18);
+BENCHMARK(idMapLookup)->RangeMultiplier(16)->Range(1 << 10, 1 << 18);
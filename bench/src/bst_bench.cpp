@@ -0,0 +1,173 @@
+#include "benchmark/benchmark.h"
+#include <map>
+#include <vector>
+#include "../include/bench_common.h"
+#include "../../lib/include/bst.h"
+
+//  BST against std::map, insert n keys in sorted, random and adversarial order, remove them all
+//  and walk the tree in order
+//  BST does not balance and inserts recursively, sorted and adversarial keys build a tree as deep
+//  as it is big, so those orders stop at 10^4
+
+using utils::bench::E_KEY_ORDER;
+using utils::bench::Payload;
+using utils::bench::PerfRegion;
+using utils::bench::decadeSizesByOrder;
+using utils::bench::keyOf;
+using utils::bench::makeKeys;
+using utils::bench::makeValue;
+using utils::bench::setCounters;
+using utils::storage::BST;
+
+enum { DEGENERATE_LIMIT = 10000 };
+
+template <typename T>
+static void bstInsertOrderBench(benchmark::State& state)
+{
+	const std::vector<std::uint32_t> keys = makeKeys(static_cast<std::size_t>(state.range(0)), static_cast<E_KEY_ORDER>(state.range(1)));
+
+	PerfRegion perf(state);
+	for (auto _ : state) {
+		BST<std::uint32_t, T> bst;
+		for (const std::uint32_t key : keys) {
+			bst.insert(key, makeValue<T>(key));
+		}
+
+		state.PauseTiming();
+		perf.pause();
+		bst.clear();
+		perf.resume();
+		state.ResumeTiming();
+	}
+
+	setCounters<T>(state, static_cast<std::int64_t>(keys.size()), perf);
+}
+
+template <typename T>
+static void mapInsertOrderBench(benchmark::State& state)
+{
+	const std::vector<std::uint32_t> keys = makeKeys(static_cast<std::size_t>(state.range(0)), static_cast<E_KEY_ORDER>(state.range(1)));
+
+	PerfRegion perf(state);
+	for (auto _ : state) {
+		std::map<std::uint32_t, T> map;
+		for (const std::uint32_t key : keys) {
+			map[key] = makeValue<T>(key);
+		}
+
+		state.PauseTiming();
+		perf.pause();
+		map.clear();
+		perf.resume();
+		state.ResumeTiming();
+	}
+
+	setCounters<T>(state, static_cast<std::int64_t>(keys.size()), perf);
+}
+
+template <typename T>
+static void bstRemoveOrderBench(benchmark::State& state)
+{
+	const std::vector<std::uint32_t> keys = makeKeys(static_cast<std::size_t>(state.range(0)), static_cast<E_KEY_ORDER>(state.range(1)));
+
+	PerfRegion perf(state);
+	for (auto _ : state) {
+		state.PauseTiming();
+		perf.pause();
+		BST<std::uint32_t, T> bst;
+		for (const std::uint32_t key : keys) {
+			bst.insert(key, makeValue<T>(key));
+		}
+		perf.resume();
+		state.ResumeTiming();
+
+		for (const std::uint32_t key : keys) {
+			bst.remove(key);
+		}
+	}
+
+	setCounters<T>(state, static_cast<std::int64_t>(keys.size()), perf);
+}
+
+template <typename T>
+static void mapRemoveOrderBench(benchmark::State& state)
+{
+	const std::vector<std::uint32_t> keys = makeKeys(static_cast<std::size_t>(state.range(0)), static_cast<E_KEY_ORDER>(state.range(1)));
+
+	PerfRegion perf(state);
+	for (auto _ : state) {
+		state.PauseTiming();
+		perf.pause();
+		std::map<std::uint32_t, T> map;
+		for (const std::uint32_t key : keys) {
+			map[key] = makeValue<T>(key);
+		}
+		perf.resume();
+		state.ResumeTiming();
+
+		for (const std::uint32_t key : keys) {
+			map.erase(key);
+		}
+	}
+
+	setCounters<T>(state, static_cast<std::int64_t>(keys.size()), perf);
+}
+
+template <typename T>
+static void bstForEachOrderBench(benchmark::State& state)
+{
+	const std::vector<std::uint32_t> keys = makeKeys(static_cast<std::size_t>(state.range(0)), static_cast<E_KEY_ORDER>(state.range(1)));
+	BST<std::uint32_t, T> bst;
+	for (const std::uint32_t key : keys) {
+		bst.insert(key, makeValue<T>(key));
+	}
+
+	PerfRegion perf(state);
+	for (auto _ : state) {
+		std::uint64_t sum = 0;
+		bst.forEach([&sum](const std::uint32_t&, const T& t) { sum += keyOf(t); });
+		benchmark::DoNotOptimize(sum);
+	}
+
+	bst.clear();
+	setCounters<T>(state, static_cast<std::int64_t>(keys.size()), perf);
+}
+
+template <typename T>
+static void mapForEachOrderBench(benchmark::State& state)
+{
+	const std::vector<std::uint32_t> keys = makeKeys(static_cast<std::size_t>(state.range(0)), static_cast<E_KEY_ORDER>(state.range(1)));
+	std::map<std::uint32_t, T> map;
+	for (const std::uint32_t key : keys) {
+		map[key] = makeValue<T>(key);
+	}
+
+	PerfRegion perf(state);
+	for (auto _ : state) {
+		std::uint64_t sum = 0;
+		for (const auto& entry : map) {
+			sum += keyOf(entry.second);
+		}
+
+		benchmark::DoNotOptimize(sum);
+	}
+
+	setCounters<T>(state, static_cast<std::int64_t>(keys.size()), perf);
+}
+
+BENCHMARK_TEMPLATE(bstInsertOrderBench, int)->Apply(decadeSizesByOrder<int, UTILS_BENCH_MAX_SIZE, DEGENERATE_LIMIT>);
+BENCHMARK_TEMPLATE(bstInsertOrderBench, Payload<64>)->Apply(decadeSizesByOrder<Payload<64>, UTILS_BENCH_MAX_SIZE, DEGENERATE_LIMIT>);
+BENCHMARK_TEMPLATE(bstInsertOrderBench, Payload<256>)->Apply(decadeSizesByOrder<Payload<256>, UTILS_BENCH_MAX_SIZE, DEGENERATE_LIMIT>);
+BENCHMARK_TEMPLATE(mapInsertOrderBench, int)->Apply(decadeSizesByOrder<int>);
+BENCHMARK_TEMPLATE(mapInsertOrderBench, Payload<64>)->Apply(decadeSizesByOrder<Payload<64>>);
+BENCHMARK_TEMPLATE(mapInsertOrderBench, Payload<256>)->Apply(decadeSizesByOrder<Payload<256>>);
+
+BENCHMARK_TEMPLATE(bstRemoveOrderBench, int)->Apply(decadeSizesByOrder<int, UTILS_BENCH_MAX_SIZE, DEGENERATE_LIMIT>);
+BENCHMARK_TEMPLATE(bstRemoveOrderBench, Payload<256>)->Apply(decadeSizesByOrder<Payload<256>, UTILS_BENCH_MAX_SIZE, DEGENERATE_LIMIT>);
+BENCHMARK_TEMPLATE(mapRemoveOrderBench, int)->Apply(decadeSizesByOrder<int>);
+BENCHMARK_TEMPLATE(mapRemoveOrderBench, Payload<256>)->Apply(decadeSizesByOrder<Payload<256>>);
+
+BENCHMARK_TEMPLATE(bstForEachOrderBench, int)->Apply(decadeSizesByOrder<int, UTILS_BENCH_MAX_SIZE, DEGENERATE_LIMIT>);
+BENCHMARK_TEMPLATE(bstForEachOrderBench, Payload<256>)->Apply(decadeSizesByOrder<Payload<256>, UTILS_BENCH_MAX_SIZE, DEGENERATE_LIMIT>);
+BENCHMARK_TEMPLATE(mapForEachOrderBench, int)->Apply(decadeSizesByOrder<int>);
+BENCHMARK_TEMPLATE(mapForEachOrderBench, Payload<256>)->Apply(decadeSizesByOrder<Payload<256>>);
@@ -0,0 +1,100 @@
+#include "benchmark/benchmark.h"
+#include <random>
+#include <utility>
+#include <vector>
+#include "../../lib/include/bst.h"
+#include "../../lib/include/thread_pool.h"
+
+//  building a BST from 16M unsorted pairs and summing it, sequentially (0 workers) and over pools
+//  of 1 to 32 workers, against inserting the batch one pair at a time
+
+using utils::concurrency::ThreadPool;
+using utils::storage::BST;
+
+static const int COUNT = 1 << 24;
+
+static const std::vector<std::pair<int, int>>& batch()
+{
+	static const std::vector<std::pair<int, int>> items = []() {
+		std::mt19937 rng(42);
+		std::vector<std::pair<int, int>> result(COUNT);
+		for (std::pair<int, int>& item : result) {
+			item.first = static_cast<int>(rng());
+			item.second = item.first;
+		}
+
+		return result;
+	}();
+
+	return items;
+}
+
+static void workerArgs(benchmark::internal::Benchmark* b)
+{
+	for (int workers : { 0, 1, 2, 4, 8, 16, 32 }) {
+		b->Arg(workers);
+	}
+
+	b->ArgName("workers")->UseRealTime()->Unit(benchmark::kMillisecond);
+}
+
+static void buildBench(benchmark::State& state)
+{
+	const std::size_t workers = static_cast<std::size_t>(state.range(0));
+	ThreadPool pool(workers == 0 ? 1 : workers);
+	ThreadPool* p = workers == 0 ? nullptr : &pool;
+
+	for (auto _ : state) {
+		BST<int, int> tree;
+		tree.build(batch().begin(), batch().end(), p);
+		benchmark::DoNotOptimize(tree.mRoot);
+
+		state.PauseTiming();
+		tree.clear();
+		state.ResumeTiming();
+	}
+
+	state.SetItemsProcessed(state.iterations() * COUNT);
+}
+BENCHMARK(buildBench)->Apply(workerArgs);
+
+static void reduceBench(benchmark::State& state)
+{
+	//  a single worker pool walks the whole tree as one task, the sequential baseline
+	const std::size_t workers = static_cast<std::size_t>(state.range(0));
+	ThreadPool pool(workers == 0 ? 1 : workers);
+
+	BST<int, int> tree;
+	tree.build(batch().begin(), batch().end(), &pool);
+
+	for (auto _ : state) {
+		const long long sum = tree.parallel_reduce(0LL,
+			[](const int&, const int& d) { return static_cast<long long>(d); },
+			[](long long lhs, long long rhs) { return lhs + rhs; },
+			pool);
+		benchmark::DoNotOptimize(sum);
+	}
+
+	tree.clear();
+	state.SetItemsProcessed(state.iterations() * COUNT);
+}
+BENCHMARK(reduceBench)->Apply(workerArgs);
+
+static void insertEachBuildBench(benchmark::State& state)
+{
+	for (auto _ : state) {
+		BST<int, int> tree;
+		for (const std::pair<int, int>& item : batch()) {
+			tree.insert(item.first, item.second);
+		}
+
+		benchmark::DoNotOptimize(tree.mRoot);
+
+		state.PauseTiming();
+		tree.clear();
+		state.ResumeTiming();
+	}
+
+	state.SetItemsProcessed(state.iterations() * COUNT);
+}
+BENCHMARK(insertEachBuildBench)->Iterations(1)->UseRealTime()->Unit(benchmark::kMillisecond);
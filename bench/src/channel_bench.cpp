@@ -0,0 +1,123 @@
+#include "benchmark/benchmark.h"
+#include "../../lib/include/channel.h"
+
+//  messages per second through a chain of stages, each stage a coroutine reading one channel and
+//  writing the next, on one thread and on a pool, one message at a time and in batches
+//  only built when the compiler has coroutines, configure with UTILS_COROUTINES=ON
+#ifdef UTILS_HAS_COROUTINES
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+using utils::concurrency::Channel;
+using utils::concurrency::Executor;
+using utils::concurrency::PoolExecutor;
+using utils::concurrency::SingleThreadExecutor;
+using utils::concurrency::Task;
+using utils::concurrency::ThreadPool;
+
+static const std::int64_t MESSAGES = 100000;
+static const std::size_t CAPACITY = 64;
+static const std::size_t BATCH = 32;
+
+static Task source(Channel<std::int64_t>& out)
+{
+	for (std::int64_t i = 0; i < MESSAGES; ++i) {
+		co_await out.send(i);
+	}
+
+	out.close();
+}
+
+static Task stage(Channel<std::int64_t>& in, Channel<std::int64_t>& out)
+{
+	while (auto value = co_await in.receive()) {
+		co_await out.send(*value + 1);
+	}
+
+	out.close();
+}
+
+static Task batchStage(Channel<std::int64_t>& in, Channel<std::int64_t>& out)
+{
+	for (;;) {
+		std::vector<std::int64_t> batch = co_await in.receive_batch(BATCH);
+		if (batch.empty()) break;
+
+		for (const std::int64_t value : batch) {
+			co_await out.send(value + 1);
+		}
+	}
+
+	out.close();
+}
+
+static Task sink(Channel<std::int64_t>& in, std::int64_t& sum)
+{
+	for (;;) {
+		std::vector<std::int64_t> batch = co_await in.receive_batch(BATCH);
+		if (batch.empty()) break;
+
+		for (const std::int64_t value : batch) {
+			sum += value;
+		}
+	}
+}
+
+//  spawns source, state.range(0) stages and a sink onto executor, run drives them to the end
+template<typename Run>
+static void runChain(benchmark::State& state, Executor& executor, const bool batched, Run run)
+{
+	const std::size_t stages = static_cast<std::size_t>(state.range(0));
+
+	for (auto _ : state) {
+		std::vector<std::unique_ptr<Channel<std::int64_t>>> channels;
+		for (std::size_t i = 0; i <= stages; ++i) {
+			channels.emplace_back(new Channel<std::int64_t>(executor, CAPACITY));
+		}
+
+		std::int64_t sum = 0;
+		executor.spawn(source(*channels[0]));
+		for (std::size_t i = 0; i < stages; ++i) {
+			executor.spawn(batched ? batchStage(*channels[i], *channels[i + 1]) : stage(*channels[i], *channels[i + 1]));
+		}
+
+		executor.spawn(sink(*channels[stages], sum));
+		run();
+		benchmark::DoNotOptimize(sum);
+	}
+
+	state.SetItemsProcessed(state.iterations() * MESSAGES);
+}
+
+static void channelSingleThreadBench(benchmark::State& state)
+{
+	SingleThreadExecutor executor;
+	runChain(state, executor, false, [&executor]() { executor.run(); });
+}
+
+static void channelSingleThreadBatchBench(benchmark::State& state)
+{
+	SingleThreadExecutor executor;
+	runChain(state, executor, true, [&executor]() { executor.run(); });
+}
+
+static void channelPoolBench(benchmark::State& state)
+{
+	ThreadPool pool;
+	PoolExecutor executor(pool);
+	runChain(state, executor, false, [&executor]() { executor.join(); });
+}
+
+static void channelPoolBatchBench(benchmark::State& state)
+{
+	ThreadPool pool;
+	PoolExecutor executor(pool);
+	runChain(state, executor, true, [&executor]() { executor.join(); });
+}
+
+BENCHMARK(channelSingleThreadBench)->Arg(1)->Arg(4)->Arg(16)->Unit(benchmark::kMillisecond);
+BENCHMARK(channelSingleThreadBatchBench)->Arg(1)->Arg(4)->Arg(16)->Unit(benchmark::kMillisecond);
+BENCHMARK(channelPoolBench)->Arg(1)->Arg(4)->Arg(16)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(channelPoolBatchBench)->Arg(1)->Arg(4)->Arg(16)->Unit(benchmark::kMillisecond)->UseRealTime();
+#endif
@@ -0,0 +1,95 @@
+#include "benchmark/benchmark.h"
+#include <cstddef>
+#include <cstdint>
+#include "../../lib/include/bst.h"
+#include "../../lib/include/const_map.h"
+#include "../../lib/include/flat_map.h"
+
+//  tables of the size an opcode or enum map has, lookups of every key in a ConstMap built at
+//  compile time against the same table in a FlatMap, and the startup cost ConstMap removes,
+//  filling a BST one insert at a time
+
+using utils::storage::BST;
+using utils::storage::ConstEntry;
+using utils::storage::ConstMap;
+using utils::storage::FlatMap;
+
+//  keys spread out and out of order
+static constexpr std::int32_t keyAt(const std::size_t i, const std::size_t count)
+{
+	return static_cast<std::int32_t>(((i * 37) % count) * 3);
+}
+
+template<std::size_t N>
+static constexpr ConstMap<std::int32_t, std::int32_t, N> makeTable()
+{
+	ConstEntry<std::int32_t, std::int32_t> entries[N] = {};
+	for (std::size_t i = 0; i < N; ++i) {
+		entries[i].mKey = keyAt(i, N);
+		entries[i].mData = static_cast<std::int32_t>(i);
+	}
+
+	return ConstMap<std::int32_t, std::int32_t, N>(entries);
+}
+
+template<std::size_t N>
+static void constMapFindBench(benchmark::State& state)
+{
+	static constexpr ConstMap<std::int32_t, std::int32_t, N> table = makeTable<N>();
+
+	for (auto _ : state) {
+		std::int64_t sum = 0;
+		for (std::size_t i = 0; i < N; ++i) {
+			sum += *table.find(keyAt(i, N));
+		}
+
+		benchmark::DoNotOptimize(sum);
+	}
+
+	state.SetItemsProcessed(state.iterations() * N);
+}
+
+template<std::size_t N>
+static void flatMapFindBench(benchmark::State& state)
+{
+	FlatMap<std::int32_t, std::int32_t> map;
+	for (std::size_t i = 0; i < N; ++i) {
+		map.insert(keyAt(i, N), static_cast<std::int32_t>(i));
+	}
+
+	for (auto _ : state) {
+		std::int64_t sum = 0;
+		for (std::size_t i = 0; i < N; ++i) {
+			sum += *map.find(keyAt(i, N));
+		}
+
+		benchmark::DoNotOptimize(sum);
+	}
+
+	state.SetItemsProcessed(state.iterations() * N);
+}
+
+template<std::size_t N>
+static void bstStartupBench(benchmark::State& state)
+{
+	for (auto _ : state) {
+		BST<std::int32_t, std::int32_t> tree;
+		for (std::size_t i = 0; i < N; ++i) {
+			tree.insert(keyAt(i, N), static_cast<std::int32_t>(i));
+		}
+
+		benchmark::DoNotOptimize(&tree);
+	}
+
+	state.SetItemsProcessed(state.iterations() * N);
+}
+
+BENCHMARK_TEMPLATE(constMapFindBench, 16);
+BENCHMARK_TEMPLATE(constMapFindBench, 64);
+BENCHMARK_TEMPLATE(constMapFindBench, 256);
+BENCHMARK_TEMPLATE(flatMapFindBench, 16);
+BENCHMARK_TEMPLATE(flatMapFindBench, 64);
+BENCHMARK_TEMPLATE(flatMapFindBench, 256);
+BENCHMARK_TEMPLATE(bstStartupBench, 16);
+BENCHMARK_TEMPLATE(bstStartupBench, 64);
+BENCHMARK_TEMPLATE(bstStartupBench, 256);
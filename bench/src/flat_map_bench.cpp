@@ -0,0 +1,135 @@
+#include "benchmark/benchmark.h"
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <random>
+#include <utility>
+#include <vector>
+#include "../../lib/include/bst.h"
+#include "../../lib/include/flat_map.h"
+
+//  building a map of n random int keys one insert at a time and as one batch, against BST,
+//  then lookups of every key against std::map (BST has no lookup) and std::lower_bound on a vector
+
+using utils::storage::BST;
+using utils::storage::FlatMap;
+
+static std::vector<std::pair<std::int32_t, std::int32_t>> makeItems(const int count)
+{
+	std::mt19937 rng(5);
+	std::vector<std::pair<std::int32_t, std::int32_t>> items(count);
+	for (int i = 0; i < count; ++i) {
+		items[i] = std::make_pair(static_cast<std::int32_t>(rng()), i);
+	}
+
+	return items;
+}
+
+static void flatMapInsertEachBench(benchmark::State& state)
+{
+	const auto items = makeItems(static_cast<int>(state.range(0)));
+
+	for (auto _ : state) {
+		FlatMap<std::int32_t, std::int32_t> map;
+		for (const auto& item : items) {
+			map.insert(item.first, item.second);
+		}
+
+		benchmark::DoNotOptimize(map.getSize());
+	}
+
+	state.SetItemsProcessed(state.iterations() * items.size());
+}
+
+static void flatMapInsertBatchBench(benchmark::State& state)
+{
+	const auto items = makeItems(static_cast<int>(state.range(0)));
+
+	for (auto _ : state) {
+		FlatMap<std::int32_t, std::int32_t> map;
+		benchmark::DoNotOptimize(map.insert_batch(items.begin(), items.end()));
+	}
+
+	state.SetItemsProcessed(state.iterations() * items.size());
+}
+
+static void bstInsertEachMapBench(benchmark::State& state)
+{
+	const auto items = makeItems(static_cast<int>(state.range(0)));
+
+	for (auto _ : state) {
+		BST<std::int32_t, std::int32_t> tree;
+		for (const auto& item : items) {
+			tree.insert(item.first, item.second);
+		}
+
+		state.PauseTiming();
+		tree.clear();
+		state.ResumeTiming();
+	}
+
+	state.SetItemsProcessed(state.iterations() * items.size());
+}
+
+static void flatMapFindBench(benchmark::State& state)
+{
+	const auto items = makeItems(static_cast<int>(state.range(0)));
+	FlatMap<std::int32_t, std::int32_t> map;
+	map.insert_batch(items.begin(), items.end());
+
+	for (auto _ : state) {
+		std::int64_t sum = 0;
+		for (const auto& item : items) {
+			sum += *map.find(item.first);
+		}
+
+		benchmark::DoNotOptimize(sum);
+	}
+
+	state.SetItemsProcessed(state.iterations() * items.size());
+}
+
+static void stdMapFindBench(benchmark::State& state)
+{
+	const auto items = makeItems(static_cast<int>(state.range(0)));
+	std::map<std::int32_t, std::int32_t> map(items.begin(), items.end());
+
+	for (auto _ : state) {
+		std::int64_t sum = 0;
+		for (const auto& item : items) {
+			sum += map.find(item.first)->second;
+		}
+
+		benchmark::DoNotOptimize(sum);
+	}
+
+	state.SetItemsProcessed(state.iterations() * items.size());
+}
+
+static void stdLowerBoundBench(benchmark::State& state)
+{
+	const auto items = makeItems(static_cast<int>(state.range(0)));
+	std::vector<std::int32_t> keys;
+	for (const auto& item : items) {
+		keys.push_back(item.first);
+	}
+	std::sort(keys.begin(), keys.end());
+
+	for (auto _ : state) {
+		std::size_t sum = 0;
+		for (const auto& item : items) {
+			sum += static_cast<std::size_t>(std::lower_bound(keys.begin(), keys.end(), item.first) - keys.begin());
+		}
+
+		benchmark::DoNotOptimize(sum);
+	}
+
+	state.SetItemsProcessed(state.iterations() * items.size());
+}
+
+BENCHMARK(flatMapInsertEachBench)->RangeMultiplier(8)->Range(64, 1 << 15);
+BENCHMARK(flatMapInsertBatchBench)->RangeMultiplier(8)->Range(64, 1 << 17);
+BENCHMARK(bstInsertEachMapBench)->RangeMultiplier(8)->Range(64, 1 << 17);
+BENCHMARK(flatMapFindBench)->RangeMultiplier(8)->Range(64, 1 << 17);
+BENCHMARK(stdMapFindBench)->RangeMultiplier(8)->Range(64, 1 << 17);
+BENCHMARK(stdLowerBoundBench)->RangeMultiplier(8)->Range(64, 1 << 17);
@@ -0,0 +1,90 @@
+#include "benchmark/benchmark.h"
+#include <cstdint>
+#include <random>
+#include <vector>
+#include "../../lib/include/bst.h"
+#include "../../lib/include/interval_tree.h"
+
+//  stabbing queries, which of n time ranges contain a random instant
+//  ranges start uniformly over the timeline and mostly last a short while, with a few long ones
+//  against the BST keyed by start that is scanned in full today
+
+using utils::storage::BST;
+using utils::storage::IntervalTree;
+
+static const std::int64_t TIMELINE = std::int64_t(1) << 40;
+static const int QUERIES = 1 << 10;
+
+template <typename Insert>
+static void makeIntervals(const int count, Insert insert)
+{
+	std::mt19937_64 rng(9);
+	for (int i = 0; i < count; ++i) {
+		const std::int64_t lo = static_cast<std::int64_t>(rng() % TIMELINE);
+		const std::int64_t length = 1 + static_cast<std::int64_t>(rng() % (i % 1024 == 0 ? TIMELINE / 1024 : TIMELINE / count * 4));
+		insert(lo, lo + length, i);
+	}
+}
+
+static std::vector<std::int64_t> makePoints()
+{
+	std::mt19937_64 rng(10);
+	std::vector<std::int64_t> points(QUERIES);
+	for (std::int64_t& point : points) {
+		point = static_cast<std::int64_t>(rng() % TIMELINE);
+	}
+
+	return points;
+}
+
+static void intervalTreeStabBench(benchmark::State& state)
+{
+	IntervalTree<std::int64_t, int> tree;
+	makeIntervals(static_cast<int>(state.range(0)), [&](std::int64_t lo, std::int64_t hi, int i) { tree.insert(lo, hi, i); });
+	const std::vector<std::int64_t> points = makePoints();
+	std::size_t found = 0;
+
+	for (auto _ : state) {
+		for (const std::int64_t point : points) {
+			tree.query_overlapping(point, [&](const std::int64_t&, const std::int64_t&, const int&) { ++found; });
+		}
+	}
+
+	state.SetItemsProcessed(state.iterations() * QUERIES);
+	state.counters["hits_per_query"] = static_cast<double>(found) / static_cast<double>(state.iterations() * QUERIES);
+}
+
+static void bstScanStabBench(benchmark::State& state)
+{
+	BST<std::int64_t, std::int64_t> tree;
+	makeIntervals(static_cast<int>(state.range(0)), [&](std::int64_t lo, std::int64_t hi, int) { tree.insert(lo, hi); });
+	const std::vector<std::int64_t> points = makePoints();
+	std::size_t found = 0;
+
+	for (auto _ : state) {
+		//  the scan is the same for every point, so a handful are enough to time it
+		for (int q = 0; q < 4; ++q) {
+			const std::int64_t point = points[q];
+			tree.forEach([&](const std::int64_t& lo, const std::int64_t& hi) { found += (lo <= point && point < hi) ? 1 : 0; });
+		}
+	}
+
+	state.SetItemsProcessed(state.iterations() * 4);
+	benchmark::DoNotOptimize(found);
+	tree.clear();
+}
+
+static void intervalTreeBuildBench(benchmark::State& state)
+{
+	for (auto _ : state) {
+		IntervalTree<std::int64_t, int> tree;
+		makeIntervals(static_cast<int>(state.range(0)), [&](std::int64_t lo, std::int64_t hi, int i) { tree.insert(lo, hi, i); });
+		benchmark::DoNotOptimize(tree.getSize());
+	}
+
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(intervalTreeStabBench)->RangeMultiplier(8)->Range(1 << 12, 1 << 21)->Unit(benchmark::kMicrosecond);
+BENCHMARK(bstScanStabBench)->RangeMultiplier(8)->Range(1 << 12, 1 << 21)->Unit(benchmark::kMicrosecond);
+BENCHMARK(intervalTreeBuildBench)->Arg(1 << 21)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,259 @@
+#include "benchmark/benchmark.h"
+#include <forward_list>
+#include <vector>
+#include "../include/bench_common.h"
+#include "../../lib/include/list.h"
+
+//  List against std::forward_list, append n, walk n, remove the last of n (a full scan),
+//  copy n and sort n keys in sorted, random and adversarial order
+
+using utils::bench::E_KEY_ORDER;
+using utils::bench::Payload;
+using utils::bench::PerfRegion;
+using utils::bench::decadeSizes;
+using utils::bench::decadeSizesByOrder;
+using utils::bench::keyOf;
+using utils::bench::makeKeys;
+using utils::bench::makeValue;
+using utils::bench::setCounters;
+using utils::storage::List;
+
+//  forward_list has no push_back, appending goes through the tail iterator
+template <typename T>
+static std::forward_list<T> makeForwardList(const std::uint32_t count)
+{
+	std::forward_list<T> l;
+	auto tail = l.before_begin();
+	for (std::uint32_t i = 0; i < count; ++i) {
+		tail = l.insert_after(tail, makeValue<T>(i));
+	}
+
+	return l;
+}
+
+template <typename T>
+static void listInsertBench(benchmark::State& state)
+{
+	const std::uint32_t count = static_cast<std::uint32_t>(state.range(0));
+
+	PerfRegion perf(state);
+	for (auto _ : state) {
+		List<T> l;
+		for (std::uint32_t i = 0; i < count; ++i) {
+			l.insert(makeValue<T>(i));
+		}
+
+		benchmark::DoNotOptimize(l.getSize());
+	}
+
+	setCounters<T>(state, count, perf);
+}
+
+template <typename T>
+static void forwardListInsertBench(benchmark::State& state)
+{
+	const std::uint32_t count = static_cast<std::uint32_t>(state.range(0));
+
+	PerfRegion perf(state);
+	for (auto _ : state) {
+		std::forward_list<T> l = makeForwardList<T>(count);
+		benchmark::DoNotOptimize(l.front());
+	}
+
+	setCounters<T>(state, count, perf);
+}
+
+template <typename T>
+static void listIterateBench(benchmark::State& state)
+{
+	const std::uint32_t count = static_cast<std::uint32_t>(state.range(0));
+	List<T> l;
+	for (std::uint32_t i = 0; i < count; ++i) {
+		l.insert(makeValue<T>(i));
+	}
+
+	PerfRegion perf(state);
+	for (auto _ : state) {
+		std::uint64_t sum = 0;
+		for (const T& t : l) {
+			sum += keyOf(t);
+		}
+
+		benchmark::DoNotOptimize(sum);
+	}
+
+	setCounters<T>(state, count, perf);
+}
+
+template <typename T>
+static void forwardListIterateBench(benchmark::State& state)
+{
+	const std::uint32_t count = static_cast<std::uint32_t>(state.range(0));
+	const std::forward_list<T> l = makeForwardList<T>(count);
+
+	PerfRegion perf(state);
+	for (auto _ : state) {
+		std::uint64_t sum = 0;
+		for (const T& t : l) {
+			sum += keyOf(t);
+		}
+
+		benchmark::DoNotOptimize(sum);
+	}
+
+	setCounters<T>(state, count, perf);
+}
+
+template <typename T>
+static void listRemoveLastBench(benchmark::State& state)
+{
+	const std::uint32_t count = static_cast<std::uint32_t>(state.range(0));
+	List<T> l;
+	for (std::uint32_t i = 0; i < count; ++i) {
+		l.insert(makeValue<T>(i));
+	}
+
+	const T last = makeValue<T>(count - 1);
+	PerfRegion perf(state);
+	for (auto _ : state) {
+		l.remove(last);
+		l.insert(last);
+	}
+
+	setCounters<T>(state, count, perf);
+}
+
+template <typename T>
+static void forwardListRemoveLastBench(benchmark::State& state)
+{
+	const std::uint32_t count = static_cast<std::uint32_t>(state.range(0));
+	std::forward_list<T> l = makeForwardList<T>(count);
+
+	const T last = makeValue<T>(count - 1);
+	PerfRegion perf(state);
+	for (auto _ : state) {
+		//  remove drops every match, the value goes back on the front which keeps it at n elements
+		l.remove(last);
+		l.push_front(last);
+	}
+
+	setCounters<T>(state, count, perf);
+}
+
+template <typename T>
+static void listCopyBench(benchmark::State& state)
+{
+	const std::uint32_t count = static_cast<std::uint32_t>(state.range(0));
+	List<T> l;
+	for (std::uint32_t i = 0; i < count; ++i) {
+		l.insert(makeValue<T>(i));
+	}
+
+	PerfRegion perf(state);
+	for (auto _ : state) {
+		List<T> copy(l);
+		benchmark::DoNotOptimize(copy.getSize());
+	}
+
+	setCounters<T>(state, count, perf);
+}
+
+template <typename T>
+static void forwardListCopyBench(benchmark::State& state)
+{
+	const std::uint32_t count = static_cast<std::uint32_t>(state.range(0));
+	const std::forward_list<T> l = makeForwardList<T>(count);
+
+	PerfRegion perf(state);
+	for (auto _ : state) {
+		std::forward_list<T> copy(l);
+		benchmark::DoNotOptimize(copy.front());
+	}
+
+	setCounters<T>(state, count, perf);
+}
+
+template <typename T>
+static void listSortOrderBench(benchmark::State& state)
+{
+	const std::vector<std::uint32_t> keys = makeKeys(static_cast<std::size_t>(state.range(0)), static_cast<E_KEY_ORDER>(state.range(1)));
+
+	PerfRegion perf(state);
+	for (auto _ : state) {
+		state.PauseTiming();
+		perf.pause();
+		List<T> l;
+		for (const std::uint32_t key : keys) {
+			l.insert(makeValue<T>(key));
+		}
+		perf.resume();
+		state.ResumeTiming();
+
+		l.sort();
+		benchmark::DoNotOptimize(l.front());
+
+		state.PauseTiming();
+		perf.pause();
+		l.clear();
+		perf.resume();
+		state.ResumeTiming();
+	}
+
+	setCounters<T>(state, static_cast<std::int64_t>(keys.size()), perf);
+}
+
+template <typename T>
+static void forwardListSortOrderBench(benchmark::State& state)
+{
+	const std::vector<std::uint32_t> keys = makeKeys(static_cast<std::size_t>(state.range(0)), static_cast<E_KEY_ORDER>(state.range(1)));
+
+	PerfRegion perf(state);
+	for (auto _ : state) {
+		state.PauseTiming();
+		perf.pause();
+		std::forward_list<T> l;
+		for (auto it = keys.rbegin(); it != keys.rend(); ++it) {
+			l.push_front(makeValue<T>(*it));
+		}
+		perf.resume();
+		state.ResumeTiming();
+
+		l.sort();
+		benchmark::DoNotOptimize(l.front());
+
+		state.PauseTiming();
+		perf.pause();
+		l.clear();
+		perf.resume();
+		state.ResumeTiming();
+	}
+
+	setCounters<T>(state, static_cast<std::int64_t>(keys.size()), perf);
+}
+
+BENCHMARK_TEMPLATE(listInsertBench, int)->Apply(decadeSizes<int>);
+BENCHMARK_TEMPLATE(listInsertBench, Payload<64>)->Apply(decadeSizes<Payload<64>>);
+BENCHMARK_TEMPLATE(listInsertBench, Payload<256>)->Apply(decadeSizes<Payload<256>>);
+BENCHMARK_TEMPLATE(forwardListInsertBench, int)->Apply(decadeSizes<int>);
+BENCHMARK_TEMPLATE(forwardListInsertBench, Payload<64>)->Apply(decadeSizes<Payload<64>>);
+BENCHMARK_TEMPLATE(forwardListInsertBench, Payload<256>)->Apply(decadeSizes<Payload<256>>);
+
+BENCHMARK_TEMPLATE(listIterateBench, int)->Apply(decadeSizes<int>);
+BENCHMARK_TEMPLATE(listIterateBench, Payload<256>)->Apply(decadeSizes<Payload<256>>);
+BENCHMARK_TEMPLATE(forwardListIterateBench, int)->Apply(decadeSizes<int>);
+BENCHMARK_TEMPLATE(forwardListIterateBench, Payload<256>)->Apply(decadeSizes<Payload<256>>);
+
+BENCHMARK_TEMPLATE(listRemoveLastBench, int)->Apply(decadeSizes<int>);
+BENCHMARK_TEMPLATE(listRemoveLastBench, Payload<256>)->Apply(decadeSizes<Payload<256>>);
+BENCHMARK_TEMPLATE(forwardListRemoveLastBench, int)->Apply(decadeSizes<int>);
+BENCHMARK_TEMPLATE(forwardListRemoveLastBench, Payload<256>)->Apply(decadeSizes<Payload<256>>);
+
+BENCHMARK_TEMPLATE(listCopyBench, int)->Apply(decadeSizes<int>);
+BENCHMARK_TEMPLATE(listCopyBench, Payload<256>)->Apply(decadeSizes<Payload<256>>);
+BENCHMARK_TEMPLATE(forwardListCopyBench, int)->Apply(decadeSizes<int>);
+BENCHMARK_TEMPLATE(forwardListCopyBench, Payload<256>)->Apply(decadeSizes<Payload<256>>);
+
+BENCHMARK_TEMPLATE(listSortOrderBench, int)->Apply(decadeSizesByOrder<int>);
+BENCHMARK_TEMPLATE(listSortOrderBench, Payload<256>)->Apply(decadeSizesByOrder<Payload<256>>);
+BENCHMARK_TEMPLATE(forwardListSortOrderBench, int)->Apply(decadeSizesByOrder<int>);
+BENCHMARK_TEMPLATE(forwardListSortOrderBench, Payload<256>)->Apply(decadeSizesByOrder<Payload<256>>);
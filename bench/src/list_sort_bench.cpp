@@ -0,0 +1,96 @@
+#include "benchmark/benchmark.h"
+#include <algorithm>
+#include <random>
+#include <vector>
+#include "../../lib/include/list.h"
+
+//  List::sort relinking in place against the old approach of
+//  copying into a std::vector, sorting it and rebuilding the list
+
+using utils::storage::List;
+
+static List<int> makeRandomList(const int count)
+{
+	std::mt19937 rng(42);
+	List<int> l;
+	for (int i = 0; i < count; ++i) {
+		l.insert(static_cast<int>(rng()));
+	}
+
+	return l;
+}
+
+static void listSortBench(benchmark::State& state)
+{
+	const int count = static_cast<int>(state.range(0));
+
+	for (auto _ : state) {
+		state.PauseTiming();
+		List<int> l = makeRandomList(count);
+		state.ResumeTiming();
+
+		l.sort();
+		benchmark::DoNotOptimize(l.front());
+
+		state.PauseTiming();
+		l.clear();
+		state.ResumeTiming();
+	}
+
+	state.SetItemsProcessed(state.iterations() * count);
+}
+
+static void vectorRoundTripSortBench(benchmark::State& state)
+{
+	const int count = static_cast<int>(state.range(0));
+
+	for (auto _ : state) {
+		state.PauseTiming();
+		List<int> l = makeRandomList(count);
+		state.ResumeTiming();
+
+		std::vector<int> v(l.begin(), l.end());
+		std::stable_sort(v.begin(), v.end());
+
+		List<int> sorted;
+		for (int i : v) {
+			sorted.insert(i);
+		}
+
+		l = std::move(sorted);
+		benchmark::DoNotOptimize(l.front());
+
+		state.PauseTiming();
+		l.clear();
+		state.ResumeTiming();
+	}
+
+	state.SetItemsProcessed(state.iterations() * count);
+}
+
+static void listMergeBench(benchmark::State& state)
+{
+	const int count = static_cast<int>(state.range(0));
+
+	for (auto _ : state) {
+		state.PauseTiming();
+		List<int> lhs = makeRandomList(count);
+		List<int> rhs = makeRandomList(count);
+		lhs.sort();
+		rhs.sort();
+		state.ResumeTiming();
+
+		lhs.merge(rhs);
+		benchmark::DoNotOptimize(lhs.front());
+
+		state.PauseTiming();
+		lhs.clear();
+		state.ResumeTiming();
+	}
+
+	state.SetItemsProcessed(state.iterations() * count * 2);
+}
+
+BENCHMARK(listSortBench)->RangeMultiplier(8)->Range(64, 1 << 20);
+BENCHMARK(vectorRoundTripSortBench)->RangeMultiplier(8)->Range(64, 1 << 20);
+BENCHMARK(listMergeBench)->RangeMultiplier(8)->Range(64, 1 << 20);
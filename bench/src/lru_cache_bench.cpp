@@ -0,0 +1,133 @@
+#include "benchmark/benchmark.h"
+#include <cmath>
+#include <random>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "../../lib/include/list.h"
+#include "../../lib/include/lru_cache.h"
+
+//  get-or-put over a skewed key stream, the cache holds a tenth of the key space
+//  reports ops/s and the hit rate, against the old List based cache that scans on every lookup
+
+using utils::storage::CLOCK_EP;
+using utils::storage::E_EVICTION_POLICY;
+using utils::storage::List;
+using utils::storage::LRU_EP;
+using utils::storage::LruCache;
+using utils::storage::ShardedLruCache;
+
+static const int STREAM_LENGTH = 1 << 16;
+
+//  roughly zipfian, a few keys take most of the traffic
+static std::vector<int> makeKeyStream(const int keySpace, const unsigned seed)
+{
+	std::mt19937 rng(seed);
+	std::uniform_real_distribution<double> uniform(0.0, 1.0);
+	std::vector<int> keys(STREAM_LENGTH);
+	for (int& key : keys) {
+		key = static_cast<int>(keySpace * std::pow(uniform(rng), 4.0));
+	}
+
+	return keys;
+}
+
+template <E_EVICTION_POLICY Policy>
+static void cacheBench(benchmark::State& state)
+{
+	const int keySpace = static_cast<int>(state.range(0));
+	const std::vector<int> keys = makeKeyStream(keySpace, 42);
+	LruCache<int, int, Policy> cache(keySpace / 10);
+
+	for (auto _ : state) {
+		for (int key : keys) {
+			int* value = cache.find(key);
+			if (value == nullptr) {
+				cache.put(key, key);
+			} else {
+				benchmark::DoNotOptimize(*value);
+			}
+		}
+	}
+
+	state.SetItemsProcessed(state.iterations() * STREAM_LENGTH);
+	state.counters["hit_rate"] = static_cast<double>(cache.getHits()) / static_cast<double>(cache.getHits() + cache.getMisses());
+}
+BENCHMARK_TEMPLATE(cacheBench, LRU_EP)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(cacheBench, CLOCK_EP)->Range(1 << 10, 1 << 20);
+
+//  the cache this replaces, find by scanning and move to the back on a hit
+static void listCacheBench(benchmark::State& state)
+{
+	typedef List<std::pair<int, int>> Entries;
+
+	const int keySpace = static_cast<int>(state.range(0));
+	const std::size_t capacity = static_cast<std::size_t>(keySpace / 10);
+	const std::vector<int> keys = makeKeyStream(keySpace, 42);
+	Entries entries;
+	std::size_t hits = 0;
+	std::size_t lookups = 0;
+
+	for (auto _ : state) {
+		for (int key : keys) {
+			++lookups;
+
+			Entries::iterator prev = entries.before_begin();
+			Entries::iterator it = entries.begin();
+			while (it != entries.end() && it->first != key) {
+				prev = it++;
+			}
+
+			if (it != entries.end()) {
+				++hits;
+				const std::pair<int, int> entry = *it;
+				entries.erase_after(prev);
+				entries.insert(entry);
+				continue;
+			}
+
+			if (entries.getSize() == capacity) {
+				entries.erase_after(entries.before_begin());
+			}
+
+			entries.insert(std::make_pair(key, key));
+		}
+	}
+
+	state.SetItemsProcessed(state.iterations() * STREAM_LENGTH);
+	state.counters["hit_rate"] = static_cast<double>(hits) / static_cast<double>(lookups);
+}
+BENCHMARK(listCacheBench)->Range(1 << 10, 1 << 14);
+
+//  shared cache hammered by every benchmark thread
+template <E_EVICTION_POLICY Policy>
+static void shardedCacheBench(benchmark::State& state)
+{
+	static ShardedLruCache<int, int, Policy>* cache = nullptr;
+	const int keySpace = 1 << 20;
+
+	if (state.thread_index() == 0) {
+		cache = new ShardedLruCache<int, int, Policy>(keySpace / 10);
+	}
+
+	const std::vector<int> keys = makeKeyStream(keySpace, 42 + state.thread_index());
+
+	for (auto _ : state) {
+		for (int key : keys) {
+			int value;
+			if (!cache->get(key, value)) {
+				cache->put(key, key);
+			}
+		}
+	}
+
+	state.SetItemsProcessed(state.iterations() * STREAM_LENGTH);
+
+	if (state.thread_index() == 0) {
+		state.counters["hit_rate"] = static_cast<double>(cache->getHits()) / static_cast<double>(cache->getHits() + cache->getMisses());
+		delete cache;
+		cache = nullptr;
+	}
+}
+BENCHMARK_TEMPLATE(shardedCacheBench, LRU_EP)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK_TEMPLATE(shardedCacheBench, CLOCK_EP)->ThreadRange(1, 16)->UseRealTime();
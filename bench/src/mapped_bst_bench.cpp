@@ -0,0 +1,91 @@
+#include "benchmark/benchmark.h"
+#include <cstdio>
+#include <random>
+#include <utility>
+#include <vector>
+#include "../../lib/include/bst.h"
+#include "../../lib/include/mapped_bst.h"
+
+//  startup of a 4M key map from a mapped file against rebuilding it in memory,
+//  and random lookups once it is up
+
+using utils::storage::BST;
+using utils::storage::MappedBST;
+
+static const int COUNT = 1 << 22;
+static const char* PATH = "mapped_bst_bench.bin";
+
+static const std::vector<std::pair<int, int>>& batch()
+{
+	static const std::vector<std::pair<int, int>> items = []() {
+		std::mt19937 rng(42);
+		std::vector<std::pair<int, int>> result(COUNT);
+		for (std::pair<int, int>& item : result) {
+			item.first = static_cast<int>(rng());
+			item.second = item.first;
+		}
+
+		return result;
+	}();
+
+	return items;
+}
+
+static void writeFile()
+{
+	static bool written = false;
+	if (written) return;
+
+	BST<int, int> tree;
+	tree.build(batch().begin(), batch().end());
+	MappedBST<int, int>::write(tree, PATH);
+	tree.clear();
+	written = true;
+}
+
+//  open and answer the first query, the file is already in the page cache
+static void mappedOpenBench(benchmark::State& state)
+{
+	writeFile();
+
+	for (auto _ : state) {
+		MappedBST<int, int> mapped(PATH);
+		benchmark::DoNotOptimize(mapped.find(batch()[0].first));
+	}
+}
+BENCHMARK(mappedOpenBench)->Unit(benchmark::kMicrosecond);
+
+static void rebuildBench(benchmark::State& state)
+{
+	for (auto _ : state) {
+		BST<int, int> tree;
+		tree.build(batch().begin(), batch().end());
+		benchmark::DoNotOptimize(tree.mRoot);
+
+		state.PauseTiming();
+		tree.clear();
+		state.ResumeTiming();
+	}
+}
+BENCHMARK(rebuildBench)->Unit(benchmark::kMillisecond);
+
+static void mappedFindBench(benchmark::State& state)
+{
+	writeFile();
+	MappedBST<int, int> mapped(PATH);
+
+	std::mt19937 rng(7);
+	std::vector<int> queries(1 << 16);
+	for (int& query : queries) {
+		query = batch()[rng() % COUNT].first;
+	}
+
+	for (auto _ : state) {
+		for (int query : queries) {
+			benchmark::DoNotOptimize(mapped.find(query));
+		}
+	}
+
+	state.SetItemsProcessed(state.iterations() * queries.size());
+}
+BENCHMARK(mappedFindBench);
@@ -0,0 +1,144 @@
+#include "benchmark/benchmark.h"
+#include <cstddef>
+#include <cstdint>
+#include "../../lib/include/bst.h"
+#include "../../lib/include/list.h"
+#include "../../lib/include/pooled_bst.h"
+#include "../../lib/include/pooled_list.h"
+#include "../../lib/include/pooled_queue.h"
+#include "../../lib/include/queue.h"
+
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+//  bytes per element of the pointer linked containers against their NodePool versions,
+//  measured as the growth of the heap while the container is built so malloc's per node
+//  header and rounding are included, the time is for one in order walk of every element
+//  without glibc the heap cannot be asked, only the pooled containers report their usage
+
+using utils::storage::BST;
+using utils::storage::List;
+using utils::storage::PooledBST;
+using utils::storage::PooledList;
+using utils::storage::PooledQueue;
+using utils::storage::Queue;
+
+static std::size_t heapInUse()
+{
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || __GLIBC_MINOR__ >= 33)
+	return mallinfo2().uordblks;
+#elif defined(__GLIBC__)
+	return static_cast<std::size_t>(static_cast<unsigned int>(mallinfo().uordblks));
+#else
+	return 0;
+#endif
+}
+
+//  scatters the keys so the trees stay shallow
+static std::uint32_t scatter(const std::uint32_t i, const std::uint32_t count)
+{
+	return static_cast<std::uint32_t>((static_cast<std::uint64_t>(i) * 2654435761u) % count);
+}
+
+template <typename Tree>
+static void treeMemoryBench(benchmark::State& state)
+{
+	const std::uint32_t count = static_cast<std::uint32_t>(state.range(0));
+
+	const std::size_t before = heapInUse();
+	Tree tree;
+	for (std::uint32_t i = 0; i < count; ++i) {
+		tree.insert(scatter(i, count), i);
+	}
+	const std::size_t after = heapInUse();
+
+	for (auto _ : state) {
+		std::uint64_t sum = 0;
+		tree.forEach([&](const std::uint32_t& k, const std::uint32_t& d) { sum += k + d; });
+		benchmark::DoNotOptimize(sum);
+	}
+
+	state.SetItemsProcessed(state.iterations() * count);
+	state.counters["bytes_per_element"] = static_cast<double>(after - before) / count;
+	tree.clear();
+}
+
+template <typename ListType>
+static void listMemoryBench(benchmark::State& state)
+{
+	const std::uint32_t count = static_cast<std::uint32_t>(state.range(0));
+
+	const std::size_t before = heapInUse();
+	ListType l;
+	for (std::uint32_t i = 0; i < count; ++i) {
+		l.insert(i);
+	}
+	const std::size_t after = heapInUse();
+
+	for (auto _ : state) {
+		std::uint64_t sum = 0;
+		for (const std::uint32_t value : l) {
+			sum += value;
+		}
+		benchmark::DoNotOptimize(sum);
+	}
+
+	state.SetItemsProcessed(state.iterations() * count);
+	state.counters["bytes_per_element"] = static_cast<double>(after - before) / count;
+}
+
+//  Queue::push_back walks to the tail, so both queues are filled from the front
+template <typename QueueType>
+static void queueMemoryBench(benchmark::State& state)
+{
+	const std::uint32_t count = static_cast<std::uint32_t>(state.range(0));
+	double bytes = 0;
+
+	for (auto _ : state) {
+		state.PauseTiming();
+		const std::size_t before = heapInUse();
+		QueueType queue;
+		for (std::uint32_t i = 0; i < count; ++i) {
+			queue.push_front(i);
+		}
+		bytes = static_cast<double>(heapInUse() - before);
+		state.ResumeTiming();
+
+		std::uint64_t sum = 0;
+		for (std::uint32_t i = 0; i < count; ++i) {
+			sum += queue.front();
+			queue.pop_front();
+		}
+		benchmark::DoNotOptimize(sum);
+	}
+
+	state.SetItemsProcessed(state.iterations() * count);
+	state.counters["bytes_per_element"] = bytes / count;
+}
+
+//  the pooled containers' own accounting, valid on every platform
+template <typename Tree>
+static void pooledReportedBench(benchmark::State& state)
+{
+	const std::uint32_t count = static_cast<std::uint32_t>(state.range(0));
+
+	Tree tree;
+	for (std::uint32_t i = 0; i < count; ++i) {
+		tree.insert(scatter(i, count), i);
+	}
+
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(tree.getMemoryUsage());
+	}
+
+	state.counters["bytes_per_element"] = static_cast<double>(tree.getMemoryUsage()) / count;
+}
+
+BENCHMARK_TEMPLATE(treeMemoryBench, BST<std::uint32_t, std::uint32_t>)->RangeMultiplier(16)->Range(1 << 12, 1 << 20);
+BENCHMARK_TEMPLATE(treeMemoryBench, PooledBST<std::uint32_t, std::uint32_t>)->RangeMultiplier(16)->Range(1 << 12, 1 << 20);
+BENCHMARK_TEMPLATE(pooledReportedBench, PooledBST<std::uint32_t, std::uint32_t>)->RangeMultiplier(16)->Range(1 << 12, 1 << 20);
+BENCHMARK_TEMPLATE(listMemoryBench, List<std::uint32_t>)->RangeMultiplier(16)->Range(1 << 12, 1 << 20);
+BENCHMARK_TEMPLATE(listMemoryBench, PooledList<std::uint32_t>)->RangeMultiplier(16)->Range(1 << 12, 1 << 20);
+BENCHMARK_TEMPLATE(queueMemoryBench, Queue<std::uint32_t>)->RangeMultiplier(16)->Range(1 << 12, 1 << 20);
+BENCHMARK_TEMPLATE(queueMemoryBench, PooledQueue<std::uint32_t>)->RangeMultiplier(16)->Range(1 << 12, 1 << 20);
@@ -0,0 +1,61 @@
+#include "benchmark/benchmark.h"
+#include <functional>
+#include <queue>
+#include <random>
+#include <vector>
+#include "../../lib/include/priority_queue.h"
+
+//  push n random ints then pop them all, and bulk heapify, against std::priority_queue
+
+using utils::storage::PriorityQueue;
+
+static std::vector<int> makeRandomInts(const int count)
+{
+	std::mt19937 rng(42);
+	std::vector<int> values(count);
+	for (int& value : values) {
+		value = static_cast<int>(rng());
+	}
+
+	return values;
+}
+
+template <typename Queue>
+static void pushPopBench(benchmark::State& state)
+{
+	const std::vector<int> values = makeRandomInts(static_cast<int>(state.range(0)));
+
+	for (auto _ : state) {
+		Queue q;
+		for (int value : values) {
+			q.push(value);
+		}
+
+		while (!q.empty()) {
+			benchmark::DoNotOptimize(q.top());
+			q.pop();
+		}
+	}
+
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename Queue>
+static void heapifyBench(benchmark::State& state)
+{
+	const std::vector<int> values = makeRandomInts(static_cast<int>(state.range(0)));
+
+	for (auto _ : state) {
+		Queue q(values.begin(), values.end());
+		benchmark::DoNotOptimize(q.top());
+	}
+
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK_TEMPLATE(pushPopBench, std::priority_queue<int>)->RangeMultiplier(16)->Range(256, 1 << 20);
+BENCHMARK_TEMPLATE(pushPopBench, PriorityQueue<int, std::less<int>, 2>)->RangeMultiplier(16)->Range(256, 1 << 20);
+BENCHMARK_TEMPLATE(pushPopBench, PriorityQueue<int, std::less<int>, 4>)->RangeMultiplier(16)->Range(256, 1 << 20);
+BENCHMARK_TEMPLATE(pushPopBench, PriorityQueue<int, std::less<int>, 8>)->RangeMultiplier(16)->Range(256, 1 << 20);
+BENCHMARK_TEMPLATE(heapifyBench, std::priority_queue<int>)->RangeMultiplier(16)->Range(256, 1 << 20);
+BENCHMARK_TEMPLATE(heapifyBench, PriorityQueue<int, std::less<int>, 4>)->RangeMultiplier(16)->Range(256, 1 << 20);
@@ -0,0 +1,196 @@
+#include "benchmark/benchmark.h"
+#include <deque>
+#include "../include/bench_common.h"
+#include "../../lib/include/queue.h"
+
+//  Queue against std::deque, push n to either end, pop n from the front and copy n elements
+//  Queue::push_back walks to the tail on every call, so it stops at 10^4 elements
+
+using utils::bench::Payload;
+using utils::bench::PerfRegion;
+using utils::bench::decadeSizes;
+using utils::bench::makeValue;
+using utils::bench::setCounters;
+using utils::storage::Queue;
+
+enum { QUADRATIC_LIMIT = 10000 };
+
+template <typename T>
+static void queuePushFrontBench(benchmark::State& state)
+{
+	const std::uint32_t count = static_cast<std::uint32_t>(state.range(0));
+
+	PerfRegion perf(state);
+	for (auto _ : state) {
+		Queue<T> queue;
+		for (std::uint32_t i = 0; i < count; ++i) {
+			queue.push_front(makeValue<T>(i));
+		}
+
+		benchmark::DoNotOptimize(queue.front());
+	}
+
+	setCounters<T>(state, count, perf);
+}
+
+template <typename T>
+static void dequePushFrontBench(benchmark::State& state)
+{
+	const std::uint32_t count = static_cast<std::uint32_t>(state.range(0));
+
+	PerfRegion perf(state);
+	for (auto _ : state) {
+		std::deque<T> queue;
+		for (std::uint32_t i = 0; i < count; ++i) {
+			queue.push_front(makeValue<T>(i));
+		}
+
+		benchmark::DoNotOptimize(queue.front());
+	}
+
+	setCounters<T>(state, count, perf);
+}
+
+template <typename T>
+static void queuePushBackBench(benchmark::State& state)
+{
+	const std::uint32_t count = static_cast<std::uint32_t>(state.range(0));
+
+	PerfRegion perf(state);
+	for (auto _ : state) {
+		Queue<T> queue;
+		for (std::uint32_t i = 0; i < count; ++i) {
+			queue.push_back(makeValue<T>(i));
+		}
+
+		benchmark::DoNotOptimize(queue.front());
+	}
+
+	setCounters<T>(state, count, perf);
+}
+
+template <typename T>
+static void dequePushBackBench(benchmark::State& state)
+{
+	const std::uint32_t count = static_cast<std::uint32_t>(state.range(0));
+
+	PerfRegion perf(state);
+	for (auto _ : state) {
+		std::deque<T> queue;
+		for (std::uint32_t i = 0; i < count; ++i) {
+			queue.push_back(makeValue<T>(i));
+		}
+
+		benchmark::DoNotOptimize(queue.front());
+	}
+
+	setCounters<T>(state, count, perf);
+}
+
+template <typename T>
+static void queuePopFrontBench(benchmark::State& state)
+{
+	const std::uint32_t count = static_cast<std::uint32_t>(state.range(0));
+
+	PerfRegion perf(state);
+	for (auto _ : state) {
+		state.PauseTiming();
+		perf.pause();
+		Queue<T> queue;
+		for (std::uint32_t i = 0; i < count; ++i) {
+			queue.push_front(makeValue<T>(i));
+		}
+		perf.resume();
+		state.ResumeTiming();
+
+		for (std::uint32_t i = 0; i < count; ++i) {
+			benchmark::DoNotOptimize(queue.front());
+			queue.pop_front();
+		}
+	}
+
+	setCounters<T>(state, count, perf);
+}
+
+template <typename T>
+static void dequePopFrontBench(benchmark::State& state)
+{
+	const std::uint32_t count = static_cast<std::uint32_t>(state.range(0));
+
+	PerfRegion perf(state);
+	for (auto _ : state) {
+		state.PauseTiming();
+		perf.pause();
+		std::deque<T> queue;
+		for (std::uint32_t i = 0; i < count; ++i) {
+			queue.push_front(makeValue<T>(i));
+		}
+		perf.resume();
+		state.ResumeTiming();
+
+		for (std::uint32_t i = 0; i < count; ++i) {
+			benchmark::DoNotOptimize(queue.front());
+			queue.pop_front();
+		}
+	}
+
+	setCounters<T>(state, count, perf);
+}
+
+template <typename T>
+static void queueCopyBench(benchmark::State& state)
+{
+	const std::uint32_t count = static_cast<std::uint32_t>(state.range(0));
+	Queue<T> queue;
+	for (std::uint32_t i = 0; i < count; ++i) {
+		queue.push_front(makeValue<T>(i));
+	}
+
+	PerfRegion perf(state);
+	for (auto _ : state) {
+		Queue<T> copy(queue);
+		benchmark::DoNotOptimize(copy.front());
+	}
+
+	setCounters<T>(state, count, perf);
+}
+
+template <typename T>
+static void dequeCopyBench(benchmark::State& state)
+{
+	const std::uint32_t count = static_cast<std::uint32_t>(state.range(0));
+	std::deque<T> queue;
+	for (std::uint32_t i = 0; i < count; ++i) {
+		queue.push_front(makeValue<T>(i));
+	}
+
+	PerfRegion perf(state);
+	for (auto _ : state) {
+		std::deque<T> copy(queue);
+		benchmark::DoNotOptimize(copy.front());
+	}
+
+	setCounters<T>(state, count, perf);
+}
+
+BENCHMARK_TEMPLATE(queuePushFrontBench, int)->Apply(decadeSizes<int>);
+BENCHMARK_TEMPLATE(queuePushFrontBench, Payload<64>)->Apply(decadeSizes<Payload<64>>);
+BENCHMARK_TEMPLATE(queuePushFrontBench, Payload<256>)->Apply(decadeSizes<Payload<256>>);
+BENCHMARK_TEMPLATE(dequePushFrontBench, int)->Apply(decadeSizes<int>);
+BENCHMARK_TEMPLATE(dequePushFrontBench, Payload<64>)->Apply(decadeSizes<Payload<64>>);
+BENCHMARK_TEMPLATE(dequePushFrontBench, Payload<256>)->Apply(decadeSizes<Payload<256>>);
+
+BENCHMARK_TEMPLATE(queuePushBackBench, int)->Apply(decadeSizes<int, QUADRATIC_LIMIT>);
+BENCHMARK_TEMPLATE(queuePushBackBench, Payload<256>)->Apply(decadeSizes<Payload<256>, QUADRATIC_LIMIT>);
+BENCHMARK_TEMPLATE(dequePushBackBench, int)->Apply(decadeSizes<int>);
+BENCHMARK_TEMPLATE(dequePushBackBench, Payload<256>)->Apply(decadeSizes<Payload<256>>);
+
+BENCHMARK_TEMPLATE(queuePopFrontBench, int)->Apply(decadeSizes<int>);
+BENCHMARK_TEMPLATE(queuePopFrontBench, Payload<256>)->Apply(decadeSizes<Payload<256>>);
+BENCHMARK_TEMPLATE(dequePopFrontBench, int)->Apply(decadeSizes<int>);
+BENCHMARK_TEMPLATE(dequePopFrontBench, Payload<256>)->Apply(decadeSizes<Payload<256>>);
+
+BENCHMARK_TEMPLATE(queueCopyBench, int)->Apply(decadeSizes<int>);
+BENCHMARK_TEMPLATE(queueCopyBench, Payload<256>)->Apply(decadeSizes<Payload<256>>);
+BENCHMARK_TEMPLATE(dequeCopyBench, int)->Apply(decadeSizes<int>);
+BENCHMARK_TEMPLATE(dequeCopyBench, Payload<256>)->Apply(decadeSizes<Payload<256>>);
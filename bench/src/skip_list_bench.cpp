@@ -0,0 +1,54 @@
+#include "benchmark/benchmark.h"
+#include <cstdint>
+#include "../../lib/include/skip_list.h"
+
+//  mixed find/insert/erase throughput on one shared ConcurrentSkipList
+//  range(0) is the percentage of operations that are reads, the rest are split between insert and erase
+
+using utils::storage::ConcurrentSkipList;
+
+namespace {
+	const int KEY_RANGE = 1 << 20;
+	ConcurrentSkipList<int, int>* sharedList = nullptr;
+}
+
+static void skipListMixedBench(benchmark::State& state)
+{
+	if (state.thread_index() == 0) {
+		sharedList = new ConcurrentSkipList<int, int>;
+
+		//  start half full so inserts and erases both hit
+		for (int i = 0; i < KEY_RANGE; i += 2) {
+			sharedList->insert(i, i);
+		}
+	}
+
+	const int readPercent = static_cast<int>(state.range(0));
+	std::uint64_t rng = 0x9E3779B97F4A7C15ull * (state.thread_index() + 1);
+
+	for (auto _ : state) {
+		rng ^= rng << 13;
+		rng ^= rng >> 7;
+		rng ^= rng << 17;
+
+		const int key = static_cast<int>(rng % KEY_RANGE);
+		const int op = static_cast<int>((rng >> 32) % 100);
+
+		if (op < readPercent) {
+			benchmark::DoNotOptimize(sharedList->contains(key));
+		} else if (op % 2 == 0) {
+			benchmark::DoNotOptimize(sharedList->insert(key, key));
+		} else {
+			benchmark::DoNotOptimize(sharedList->erase(key));
+		}
+	}
+
+	state.SetItemsProcessed(state.iterations());
+
+	if (state.thread_index() == 0) {
+		delete sharedList;
+		sharedList = nullptr;
+	}
+}
+
+BENCHMARK(skipListMixedBench)->Arg(50)->Arg(90)->Arg(99)->ThreadRange(1, 64)->UseRealTime();
@@ -0,0 +1,70 @@
+#include "benchmark/benchmark.h"
+#include <cstdint>
+#include "../include/bench_common.h"
+#include "../../lib/include/pooled_queue.h"
+#include "../../lib/include/spill_queue.h"
+#include "../../test/include/temp_path.h"
+
+//  a burst of n pushes followed by popping everything, through a SpillQueue that keeps 4096
+//  elements in memory and spills the rest to the temporary directory, against a PooledQueue
+//  holding the whole burst
+
+using utils::bench::Payload;
+using utils::bench::PerfRegion;
+using utils::bench::decadeSizes;
+using utils::bench::keyOf;
+using utils::bench::makeValue;
+using utils::bench::setCounters;
+using utils::storage::PooledQueue;
+using utils::storage::SpillQueue;
+
+template <typename T>
+static void spillQueueBurstBench(benchmark::State& state)
+{
+	const std::uint32_t count = static_cast<std::uint32_t>(state.range(0));
+	SpillQueue<T> queue(utils::test::tempPath("spill_queue_bench"), 4096, 16 << 20);
+
+	PerfRegion perf(state);
+	for (auto _ : state) {
+		for (std::uint32_t i = 0; i < count; ++i) {
+			queue.push_back(makeValue<T>(i));
+		}
+
+		std::uint64_t sum = 0;
+		while (!queue.empty()) {
+			sum += keyOf(queue.front());
+			queue.pop_front();
+		}
+
+		benchmark::DoNotOptimize(sum);
+	}
+
+	setCounters<T>(state, count, perf);
+}
+
+template <typename T>
+static void pooledQueueBurstBench(benchmark::State& state)
+{
+	const std::uint32_t count = static_cast<std::uint32_t>(state.range(0));
+	PooledQueue<T> queue;
+
+	PerfRegion perf(state);
+	for (auto _ : state) {
+		for (std::uint32_t i = 0; i < count; ++i) {
+			queue.push_back(makeValue<T>(i));
+		}
+
+		std::uint64_t sum = 0;
+		while (!queue.empty()) {
+			sum += keyOf(queue.front());
+			queue.pop_front();
+		}
+
+		benchmark::DoNotOptimize(sum);
+	}
+
+	setCounters<T>(state, count, perf);
+}
+
+BENCHMARK_TEMPLATE(spillQueueBurstBench, Payload<64>)->Apply(decadeSizes<Payload<64>>)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(pooledQueueBurstBench, Payload<64>)->Apply(decadeSizes<Payload<64>>)->Unit(benchmark::kMillisecond);
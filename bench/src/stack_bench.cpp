@@ -0,0 +1,152 @@
+#include "benchmark/benchmark.h"
+#include <vector>
+#include "../include/bench_common.h"
+#include "../../lib/include/stack.h"
+
+//  Stack against std::vector, push n, pop n and copy n elements of 4 to 256 bytes
+
+using utils::bench::Payload;
+using utils::bench::PerfRegion;
+using utils::bench::decadeSizes;
+using utils::bench::makeValue;
+using utils::bench::setCounters;
+using utils::storage::Stack;
+
+template <typename T>
+static void stackPushBench(benchmark::State& state)
+{
+	const std::uint32_t count = static_cast<std::uint32_t>(state.range(0));
+
+	PerfRegion perf(state);
+	for (auto _ : state) {
+		Stack<T> stack;
+		for (std::uint32_t i = 0; i < count; ++i) {
+			stack.push(makeValue<T>(i));
+		}
+
+		benchmark::DoNotOptimize(stack.getSize());
+	}
+
+	setCounters<T>(state, count, perf);
+}
+
+template <typename T>
+static void vectorPushBench(benchmark::State& state)
+{
+	const std::uint32_t count = static_cast<std::uint32_t>(state.range(0));
+
+	PerfRegion perf(state);
+	for (auto _ : state) {
+		std::vector<T> stack;
+		for (std::uint32_t i = 0; i < count; ++i) {
+			stack.push_back(makeValue<T>(i));
+		}
+
+		benchmark::DoNotOptimize(stack.size());
+	}
+
+	setCounters<T>(state, count, perf);
+}
+
+template <typename T>
+static void stackPopBench(benchmark::State& state)
+{
+	const std::uint32_t count = static_cast<std::uint32_t>(state.range(0));
+
+	PerfRegion perf(state);
+	for (auto _ : state) {
+		state.PauseTiming();
+		perf.pause();
+		Stack<T> stack;
+		for (std::uint32_t i = 0; i < count; ++i) {
+			stack.push(makeValue<T>(i));
+		}
+		perf.resume();
+		state.ResumeTiming();
+
+		while (!stack.empty()) {
+			benchmark::DoNotOptimize(stack.top());
+			stack.pop();
+		}
+	}
+
+	setCounters<T>(state, count, perf);
+}
+
+template <typename T>
+static void vectorPopBench(benchmark::State& state)
+{
+	const std::uint32_t count = static_cast<std::uint32_t>(state.range(0));
+
+	PerfRegion perf(state);
+	for (auto _ : state) {
+		state.PauseTiming();
+		perf.pause();
+		std::vector<T> stack;
+		for (std::uint32_t i = 0; i < count; ++i) {
+			stack.push_back(makeValue<T>(i));
+		}
+		perf.resume();
+		state.ResumeTiming();
+
+		while (!stack.empty()) {
+			benchmark::DoNotOptimize(stack.back());
+			stack.pop_back();
+		}
+	}
+
+	setCounters<T>(state, count, perf);
+}
+
+template <typename T>
+static void stackCopyBench(benchmark::State& state)
+{
+	const std::uint32_t count = static_cast<std::uint32_t>(state.range(0));
+	Stack<T> stack;
+	for (std::uint32_t i = 0; i < count; ++i) {
+		stack.push(makeValue<T>(i));
+	}
+
+	PerfRegion perf(state);
+	for (auto _ : state) {
+		Stack<T> copy(stack);
+		benchmark::DoNotOptimize(copy.getSize());
+	}
+
+	setCounters<T>(state, count, perf);
+}
+
+template <typename T>
+static void vectorCopyBench(benchmark::State& state)
+{
+	const std::uint32_t count = static_cast<std::uint32_t>(state.range(0));
+	std::vector<T> stack;
+	for (std::uint32_t i = 0; i < count; ++i) {
+		stack.push_back(makeValue<T>(i));
+	}
+
+	PerfRegion perf(state);
+	for (auto _ : state) {
+		std::vector<T> copy(stack);
+		benchmark::DoNotOptimize(copy.size());
+	}
+
+	setCounters<T>(state, count, perf);
+}
+
+BENCHMARK_TEMPLATE(stackPushBench, int)->Apply(decadeSizes<int>);
+BENCHMARK_TEMPLATE(stackPushBench, Payload<64>)->Apply(decadeSizes<Payload<64>>);
+BENCHMARK_TEMPLATE(stackPushBench, Payload<256>)->Apply(decadeSizes<Payload<256>>);
+BENCHMARK_TEMPLATE(vectorPushBench, int)->Apply(decadeSizes<int>);
+BENCHMARK_TEMPLATE(vectorPushBench, Payload<64>)->Apply(decadeSizes<Payload<64>>);
+BENCHMARK_TEMPLATE(vectorPushBench, Payload<256>)->Apply(decadeSizes<Payload<256>>);
+
+BENCHMARK_TEMPLATE(stackPopBench, int)->Apply(decadeSizes<int>);
+BENCHMARK_TEMPLATE(stackPopBench, Payload<256>)->Apply(decadeSizes<Payload<256>>);
+BENCHMARK_TEMPLATE(vectorPopBench, int)->Apply(decadeSizes<int>);
+BENCHMARK_TEMPLATE(vectorPopBench, Payload<256>)->Apply(decadeSizes<Payload<256>>);
+
+BENCHMARK_TEMPLATE(stackCopyBench, int)->Apply(decadeSizes<int>);
+BENCHMARK_TEMPLATE(stackCopyBench, Payload<256>)->Apply(decadeSizes<Payload<256>>);
+BENCHMARK_TEMPLATE(vectorCopyBench, int)->Apply(decadeSizes<int>);
+BENCHMARK_TEMPLATE(vectorCopyBench, Payload<256>)->Apply(decadeSizes<Payload<256>>);
@@ -0,0 +1,95 @@
+#include "benchmark/benchmark.h"
+#include <cstdint>
+#include <random>
+#include <vector>
+#include "../../lib/include/timing_wheel.h"
+
+//  schedule, cancel and expire rates for n pending timeouts with deadlines up to a minute of millisecond ticks
+
+using utils::storage::Timer;
+using utils::storage::TimingWheel;
+
+static const std::uint64_t HORIZON = 60000;
+
+static std::vector<std::uint64_t> makeDeadlines(const int count)
+{
+	std::mt19937_64 rng(42);
+	std::vector<std::uint64_t> deadlines(count);
+	for (std::uint64_t& deadline : deadlines) {
+		deadline = 1 + rng() % HORIZON;
+	}
+
+	return deadlines;
+}
+
+static void scheduleBench(benchmark::State& state)
+{
+	const std::vector<std::uint64_t> deadlines = makeDeadlines(static_cast<int>(state.range(0)));
+	std::vector<Timer> timers(deadlines.size());
+
+	for (auto _ : state) {
+		TimingWheel<> wheel;
+		for (std::size_t i = 0; i < timers.size(); ++i) {
+			wheel.schedule(timers[i], deadlines[i]);
+		}
+
+		state.PauseTiming();
+		for (Timer& timer : timers) {
+			wheel.cancel(timer);
+		}
+		state.ResumeTiming();
+	}
+
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(scheduleBench)->Range(1 << 10, 1 << 20);
+
+static void cancelBench(benchmark::State& state)
+{
+	const std::vector<std::uint64_t> deadlines = makeDeadlines(static_cast<int>(state.range(0)));
+	std::vector<Timer> timers(deadlines.size());
+
+	for (auto _ : state) {
+		TimingWheel<> wheel;
+
+		state.PauseTiming();
+		for (std::size_t i = 0; i < timers.size(); ++i) {
+			wheel.schedule(timers[i], deadlines[i]);
+		}
+		state.ResumeTiming();
+
+		for (Timer& timer : timers) {
+			wheel.cancel(timer);
+		}
+	}
+
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(cancelBench)->Range(1 << 10, 1 << 20);
+
+//  expire everything by ticking a millisecond at a time, the usual event loop pattern
+static void expireBench(benchmark::State& state)
+{
+	const std::vector<std::uint64_t> deadlines = makeDeadlines(static_cast<int>(state.range(0)));
+	std::vector<Timer> timers(deadlines.size());
+
+	for (auto _ : state) {
+		TimingWheel<> wheel;
+
+		state.PauseTiming();
+		for (std::size_t i = 0; i < timers.size(); ++i) {
+			wheel.schedule(timers[i], deadlines[i]);
+		}
+		state.ResumeTiming();
+
+		std::size_t fired = 0;
+		for (std::uint64_t now = 1; now <= HORIZON; ++now) {
+			fired += wheel.advance(now, [](Timer& timer) { benchmark::DoNotOptimize(&timer); });
+		}
+
+		benchmark::DoNotOptimize(fired);
+	}
+
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(expireBench)->Range(1 << 10, 1 << 20);
@@ -0,0 +1,100 @@
+#include "benchmark/benchmark.h"
+#include <random>
+#include <vector>
+#include "../../lib/include/thread_pool.h"
+#include "../../lib/include/treap.h"
+
+//  union, intersection and difference of a 1M key treap with one 1, 16 or 256 times smaller,
+//  run sequentially (0 workers) and forked over pools of 1 to 32 workers,
+//  against folding the smaller side in one insert at a time
+
+using utils::concurrency::ThreadPool;
+using utils::storage::Treap;
+
+typedef Treap<int, int> IntTreap;
+
+static const int LARGE = 1 << 20;
+
+enum { UNION_OP, INTERSECTION_OP, DIFFERENCE_OP };
+
+static IntTreap makeTreap(const int count, const unsigned seed)
+{
+	std::mt19937 rng(seed);
+	IntTreap treap;
+	while (treap.getSize() < static_cast<std::size_t>(count)) {
+		const int key = static_cast<int>(rng() % (4u * LARGE));
+		treap.insert(key, key);
+	}
+
+	return treap;
+}
+
+template <int Op>
+static void setOperationBench(benchmark::State& state)
+{
+	const int ratio = static_cast<int>(state.range(0));
+	const std::size_t workers = static_cast<std::size_t>(state.range(1));
+
+	static const IntTreap large = makeTreap(LARGE, 1);
+	const IntTreap small = makeTreap(LARGE / ratio, 2 + ratio);
+	ThreadPool pool(workers == 0 ? 1 : workers);
+	ThreadPool* p = workers == 0 ? nullptr : &pool;
+
+	for (auto _ : state) {
+		state.PauseTiming();
+		IntTreap lhs(large);
+		IntTreap rhs(small);
+		state.ResumeTiming();
+
+		if (Op == UNION_OP) lhs.set_union(rhs, p);
+		if (Op == INTERSECTION_OP) lhs.set_intersection(rhs, p);
+		if (Op == DIFFERENCE_OP) lhs.set_difference(rhs, p);
+
+		benchmark::DoNotOptimize(lhs.getSize());
+
+		state.PauseTiming();
+		lhs.clear();
+		state.ResumeTiming();
+	}
+
+	state.SetItemsProcessed(state.iterations() * (LARGE + LARGE / ratio));
+}
+
+static void setOperationArgs(benchmark::internal::Benchmark* b)
+{
+	for (int ratio : { 1, 16, 256 }) {
+		for (int workers : { 0, 1, 2, 4, 8, 16, 32 }) {
+			b->Args({ ratio, workers });
+		}
+	}
+
+	b->ArgNames({ "ratio", "workers" })->UseRealTime()->Unit(benchmark::kMillisecond);
+}
+BENCHMARK_TEMPLATE(setOperationBench, UNION_OP)->Apply(setOperationArgs);
+BENCHMARK_TEMPLATE(setOperationBench, INTERSECTION_OP)->Apply(setOperationArgs);
+BENCHMARK_TEMPLATE(setOperationBench, DIFFERENCE_OP)->Apply(setOperationArgs);
+
+//  the single threaded reconciliation this replaces
+static void insertEachBench(benchmark::State& state)
+{
+	const int ratio = static_cast<int>(state.range(0));
+
+	static const IntTreap large = makeTreap(LARGE, 1);
+	const IntTreap small = makeTreap(LARGE / ratio, 2 + ratio);
+
+	for (auto _ : state) {
+		state.PauseTiming();
+		IntTreap lhs(large);
+		state.ResumeTiming();
+
+		small.forEach([&](const int& k, const int& d) { lhs.insert(k, d); });
+		benchmark::DoNotOptimize(lhs.getSize());
+
+		state.PauseTiming();
+		lhs.clear();
+		state.ResumeTiming();
+	}
+
+	state.SetItemsProcessed(state.iterations() * (LARGE + LARGE / ratio));
+}
+BENCHMARK(insertEachBench)->Arg(1)->Arg(16)->Arg(256)->ArgName("ratio")->UseRealTime()->Unit(benchmark::kMillisecond);
@@ -0,0 +1,75 @@
+#include "benchmark/benchmark.h"
+#include "../../lib/include/list.h"
+#include "../../lib/include/unrolled_list.h"
+
+//  insert n ints, remove a value that is not present (a full scan),
+//  then remove every element one value at a time from the front
+
+template <typename ListType>
+static void insertBench(benchmark::State& state)
+{
+	const int count = static_cast<int>(state.range(0));
+
+	for (auto _ : state) {
+		ListType l;
+		for (int i = 0; i < count; ++i) {
+			l.insert(i);
+		}
+
+		benchmark::DoNotOptimize(l.getSize());
+	}
+
+	state.SetItemsProcessed(state.iterations() * count);
+}
+
+template <typename ListType>
+static void scanBench(benchmark::State& state)
+{
+	const int count = static_cast<int>(state.range(0));
+
+	ListType l;
+	for (int i = 0; i < count; ++i) {
+		l.insert(i);
+	}
+
+	for (auto _ : state) {
+		//  value is never present so every element is visited
+		l.remove(-1);
+		benchmark::DoNotOptimize(l.getSize());
+	}
+
+	state.SetItemsProcessed(state.iterations() * count);
+}
+
+template <typename ListType>
+static void removeBench(benchmark::State& state)
+{
+	const int count = static_cast<int>(state.range(0));
+
+	for (auto _ : state) {
+		state.PauseTiming();
+		ListType l;
+		for (int i = 0; i < count; ++i) {
+			l.insert(i);
+		}
+		state.ResumeTiming();
+
+		for (int i = 0; i < count; ++i) {
+			l.remove(i);
+		}
+
+		benchmark::DoNotOptimize(l.getSize());
+	}
+
+	state.SetItemsProcessed(state.iterations() * count);
+}
+
+using utils::storage::List;
+using utils::storage::UnrolledList;
+
+BENCHMARK_TEMPLATE(insertBench, List<int>)->RangeMultiplier(4)->Range(64, 4096);
+BENCHMARK_TEMPLATE(insertBench, UnrolledList<int>)->RangeMultiplier(4)->Range(64, 4096);
+BENCHMARK_TEMPLATE(scanBench, List<int>)->RangeMultiplier(8)->Range(64, 1 << 15);
+BENCHMARK_TEMPLATE(scanBench, UnrolledList<int>)->RangeMultiplier(8)->Range(64, 1 << 15);
+BENCHMARK_TEMPLATE(removeBench, List<int>)->RangeMultiplier(4)->Range(64, 4096);
+BENCHMARK_TEMPLATE(removeBench, UnrolledList<int>)->RangeMultiplier(4)->Range(64, 4096);
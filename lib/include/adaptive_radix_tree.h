@@ -0,0 +1,1042 @@
+#ifndef H_UTILS_STORAGE_ADAPTIVE_RADIX_TREE_H
+#define H_UTILS_STORAGE_ADAPTIVE_RADIX_TREE_H
+
+//  includes
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define UTILS_ART_SSE2
+#include <emmintrin.h>
+#endif
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace utils {
+    namespace storage {
+
+        //  RadixKeyTraits
+        //  how a key is cut into bytes, the byte order must match the key order
+        //  strings are used as they are, integers big endian with the sign bit flipped
+        template<typename Key, typename Enable = void>
+        struct RadixKeyTraits;
+
+        template<>
+        struct RadixKeyTraits<std::string>
+        {
+            static std::size_t size(const std::string& key) { return key.size(); }
+            static unsigned char byteAt(const std::string& key, const std::size_t i) { return static_cast<unsigned char>(key[i]); }
+        };
+
+        template<typename Key>
+        struct RadixKeyTraits<Key, typename std::enable_if<std::is_integral<Key>::value>::type>
+        {
+            typedef typename std::make_unsigned<Key>::type Bits;
+
+            static std::size_t size(const Key&) { return sizeof(Key); }
+            static unsigned char byteAt(const Key& key, const std::size_t i)
+            {
+                const Bits signBit = std::is_signed<Key>::value ? static_cast<Bits>(Bits(1) << (8 * sizeof(Key) - 1)) : Bits(0);
+                const Bits bits = static_cast<Bits>(static_cast<Bits>(key) ^ signBit);
+                return static_cast<unsigned char>(bits >> (8 * (sizeof(Key) - 1 - i)));
+            }
+        };
+
+        //  AdaptiveRadixTree
+        //  ordered map on the bytes of the key, a lookup costs one step per key byte whatever the
+        //  number of keys, instead of a full key comparison at every level of a BST
+        //  inner nodes grow and shrink between four layouts (4, 16, 48 and 256 children) with the
+        //  number of children they have, so sparse levels stay small and dense ones take one index
+        //  runs of single child nodes are collapsed into a prefix on the node below them, only the first
+        //  MAX_PREFIX bytes are stored and the rest are checked against a leaf when it matters
+        //  a key that ends where an inner node sits, a prefix of longer keys, hangs off that node
+        template<typename Key, typename Data, typename Traits = RadixKeyTraits<Key>>
+        class AdaptiveRadixTree
+        {
+            friend void swap(AdaptiveRadixTree<Key, Data, Traits>& lhs, AdaptiveRadixTree<Key, Data, Traits>& rhs) noexcept
+            {
+                using std::swap;
+                swap(lhs.mRoot, rhs.mRoot);
+                swap(lhs.mSize, rhs.mSize);
+            }
+
+        public:
+            enum E_INSERT_RESULT
+            {
+                OVERWRITE_SAME_VALUE_IR,
+                OVERWRITE_DIFFERENT_VALUE_IR,
+                NEW_INSERT_IR
+            };
+
+            typedef std::pair<bool, E_INSERT_RESULT> INSERT_RESULT;
+
+            enum { MAX_PREFIX = 8 };
+
+        private:
+            enum E_NODE_TYPE : std::uint8_t
+            {
+                LEAF_NT,
+                NODE4_NT,
+                NODE16_NT,
+                NODE48_NT,
+                NODE256_NT
+            };
+
+            struct Node
+            {
+                explicit Node(const E_NODE_TYPE type) : mType(type) {}
+
+                E_NODE_TYPE mType;
+            };
+
+            struct Leaf : Node
+            {
+                Leaf(const Key& k, const Data& d) : Node(LEAF_NT), mKey(k), mData(d) {}
+
+                Key mKey;
+                Data mData;
+            };
+
+            struct Inner : Node
+            {
+                explicit Inner(const E_NODE_TYPE type) : Node(type) {}
+
+                std::uint16_t mCount = 0;
+                std::uint32_t mPrefixLength = 0;
+                unsigned char mPrefix[MAX_PREFIX];
+                //  the key that ends at this node, if any
+                Leaf* mTerminal = nullptr;
+            };
+
+            //  keys are kept sorted
+            struct Node4 : Inner
+            {
+                Node4() : Inner(NODE4_NT) {}
+
+                unsigned char mKeys[4];
+                Node* mChildren[4];
+            };
+
+            struct Node16 : Inner
+            {
+                Node16() : Inner(NODE16_NT) {}
+
+                unsigned char mKeys[16];
+                Node* mChildren[16];
+            };
+
+            //  mIndex holds slot + 1 for each key byte, 0 for none
+            struct Node48 : Inner
+            {
+                Node48() : Inner(NODE48_NT) { std::memset(mIndex, 0, sizeof(mIndex)); std::memset(mChildren, 0, sizeof(mChildren)); }
+
+                unsigned char mIndex[256];
+                Node* mChildren[48];
+            };
+
+            struct Node256 : Inner
+            {
+                Node256() : Inner(NODE256_NT) { std::memset(mChildren, 0, sizeof(mChildren)); }
+
+                Node* mChildren[256];
+            };
+
+        public:
+            AdaptiveRadixTree() = default;
+            AdaptiveRadixTree(const AdaptiveRadixTree& rhs);
+            AdaptiveRadixTree(AdaptiveRadixTree&& rhs) noexcept { swap(*this, rhs); }
+            ~AdaptiveRadixTree() { clear(); }
+
+            AdaptiveRadixTree& operator=(const AdaptiveRadixTree& rhs);
+            AdaptiveRadixTree& operator=(AdaptiveRadixTree&& rhs) noexcept;
+
+            INSERT_RESULT insert(const Key& k, const Data& d);
+            bool remove(const Key& k);
+
+            Data* find(const Key& k);
+            const Data* find(const Key& k) const;
+            bool contains(const Key& k) const { return find(k) != nullptr; }
+
+            //  f(key, data) for every element, in key byte order
+            template<typename Function>
+            void forEach(Function f) const { forEachHelper(mRoot, f); }
+            //  f(key, data) for every element whose key starts with the bytes of prefix, in key byte order
+            template<typename Function>
+            void forEachWithPrefix(const Key& prefix, Function f) const;
+
+            void clear();
+
+            std::size_t getSize() const { return mSize; }
+            bool empty() const { return mSize == 0; }
+
+        private:
+            static bool isLeaf(const Node* node) { return node->mType == LEAF_NT; }
+            static unsigned trailingZeros(const unsigned bits);
+
+            //  number of leading bytes of the stored prefix that match k from depth
+            static std::size_t checkPrefix(const Inner* node, const Key& k, const std::size_t depth);
+            //  as checkPrefix, but over the whole prefix, reading the bytes past MAX_PREFIX from a leaf
+            static std::size_t prefixMismatch(const Inner* node, const Key& k, const std::size_t depth);
+            static const Leaf* minimumLeaf(const Node* node);
+            static bool startsWith(const Key& k, const Key& prefix);
+
+            static Node** findChild(Inner* node, const unsigned char byte);
+            //  adds child under byte, growing the node into ref if it is full
+            static void addChild(Node*& ref, const unsigned char byte, Node* child);
+            static void removeChild(Inner* node, const unsigned char byte);
+            //  the node in ref after a removal, downgraded or collapsed if it has become too sparse
+            static void shrink(Node*& ref);
+            static void copyHeader(Inner* to, const Inner* from);
+
+            INSERT_RESULT insertHelper(Node*& ref, const Key& k, const Data& d, std::size_t depth);
+            bool removeHelper(Node*& ref, const Key& k, std::size_t depth);
+
+            static Node* copyNode(const Node* node);
+            static void destroy(Node* node);
+
+            template<typename Function>
+            static void forEachHelper(const Node* node, Function& f);
+
+        private:
+            Node* mRoot = nullptr;
+            std::size_t mSize = 0;
+        };
+
+        template<typename Key, typename Data, typename Traits>
+        AdaptiveRadixTree<Key, Data, Traits>::AdaptiveRadixTree(const AdaptiveRadixTree<Key, Data, Traits>& rhs) :
+            mRoot(copyNode(rhs.mRoot)),
+            mSize(rhs.mSize)
+        {
+        }
+
+        template<typename Key, typename Data, typename Traits>
+        AdaptiveRadixTree<Key, Data, Traits>& AdaptiveRadixTree<Key, Data, Traits>::operator=(const AdaptiveRadixTree<Key, Data, Traits>& rhs)
+        {
+            //  check for self assignment
+            if (this != &rhs) {
+                AdaptiveRadixTree copy(rhs);
+                swap(*this, copy);
+            }
+
+            return *this;
+        }
+
+        template<typename Key, typename Data, typename Traits>
+        AdaptiveRadixTree<Key, Data, Traits>& AdaptiveRadixTree<Key, Data, Traits>::operator=(AdaptiveRadixTree<Key, Data, Traits>&& rhs) noexcept
+        {
+            //  check for self move
+            if (this != &rhs) {
+                clear();
+                swap(*this, rhs);
+            }
+
+            return *this;
+        }
+
+        template<typename Key, typename Data, typename Traits>
+        typename AdaptiveRadixTree<Key, Data, Traits>::INSERT_RESULT AdaptiveRadixTree<Key, Data, Traits>::insert(const Key& k, const Data& d)
+        {
+            return insertHelper(mRoot, k, d, 0);
+        }
+
+        template<typename Key, typename Data, typename Traits>
+        bool AdaptiveRadixTree<Key, Data, Traits>::remove(const Key& k)
+        {
+            return removeHelper(mRoot, k, 0);
+        }
+
+        template<typename Key, typename Data, typename Traits>
+        Data* AdaptiveRadixTree<Key, Data, Traits>::find(const Key& k)
+        {
+            return const_cast<Data*>(static_cast<const AdaptiveRadixTree*>(this)->find(k));
+        }
+
+        //  the stored prefix bytes are compared on the way down, the leaf compare at the end
+        //  covers any bytes that were skipped
+        template<typename Key, typename Data, typename Traits>
+        const Data* AdaptiveRadixTree<Key, Data, Traits>::find(const Key& k) const
+        {
+            const std::size_t size = Traits::size(k);
+            const Node* node = mRoot;
+            std::size_t depth = 0;
+
+            while (node) {
+                if (isLeaf(node)) {
+                    const Leaf* leaf = static_cast<const Leaf*>(node);
+                    return leaf->mKey == k ? &leaf->mData : nullptr;
+                }
+
+                const Inner* inner = static_cast<const Inner*>(node);
+                if (inner->mPrefixLength) {
+                    if (checkPrefix(inner, k, depth) != std::min<std::size_t>(inner->mPrefixLength, MAX_PREFIX)) {
+                        return nullptr;
+                    }
+
+                    depth += inner->mPrefixLength;
+                }
+
+                if (depth >= size) {
+                    const Leaf* terminal = depth == size ? inner->mTerminal : nullptr;
+                    return terminal && terminal->mKey == k ? &terminal->mData : nullptr;
+                }
+
+                Node* const* child = findChild(const_cast<Inner*>(inner), Traits::byteAt(k, depth));
+                node = child ? *child : nullptr;
+                ++depth;
+            }
+
+            return nullptr;
+        }
+
+        template<typename Key, typename Data, typename Traits>
+        template<typename Function>
+        void AdaptiveRadixTree<Key, Data, Traits>::forEachWithPrefix(const Key& prefix, Function f) const
+        {
+            const std::size_t size = Traits::size(prefix);
+            const Node* node = mRoot;
+            std::size_t depth = 0;
+
+            //  walk down until the prefix runs out, everything below that point has the same first bytes
+            while (node && depth < size && !isLeaf(node)) {
+                const Inner* inner = static_cast<const Inner*>(node);
+                const std::size_t stored = std::min<std::size_t>(inner->mPrefixLength, MAX_PREFIX);
+                const std::size_t matched = checkPrefix(inner, prefix, depth);
+
+                if (matched < stored && depth + matched < size) {
+                    return;
+                }
+
+                depth += inner->mPrefixLength;
+                if (depth >= size) {
+                    break;
+                }
+
+                Node* const* child = findChild(const_cast<Inner*>(inner), Traits::byteAt(prefix, depth));
+                node = child ? *child : nullptr;
+                ++depth;
+            }
+
+            //  the bytes skipped on the way are checked once, against any key below
+            if (node && startsWith(minimumLeaf(node)->mKey, prefix)) {
+                forEachHelper(node, f);
+            }
+        }
+
+        template<typename Key, typename Data, typename Traits>
+        void AdaptiveRadixTree<Key, Data, Traits>::clear()
+        {
+            destroy(mRoot);
+            mRoot = nullptr;
+            mSize = 0;
+        }
+
+        template<typename Key, typename Data, typename Traits>
+        unsigned AdaptiveRadixTree<Key, Data, Traits>::trailingZeros(const unsigned bits)
+        {
+#ifdef _MSC_VER
+            unsigned long index;
+            _BitScanForward(&index, bits);
+            return static_cast<unsigned>(index);
+#else
+            return static_cast<unsigned>(__builtin_ctz(bits));
+#endif
+        }
+
+        template<typename Key, typename Data, typename Traits>
+        std::size_t AdaptiveRadixTree<Key, Data, Traits>::checkPrefix(const Inner* node, const Key& k, const std::size_t depth)
+        {
+            const std::size_t size = Traits::size(k);
+            const std::size_t stored = std::min<std::size_t>(node->mPrefixLength, MAX_PREFIX);
+
+            std::size_t i = 0;
+            while (i < stored && depth + i < size && node->mPrefix[i] == Traits::byteAt(k, depth + i)) {
+                ++i;
+            }
+
+            return i;
+        }
+
+        template<typename Key, typename Data, typename Traits>
+        std::size_t AdaptiveRadixTree<Key, Data, Traits>::prefixMismatch(const Inner* node, const Key& k, const std::size_t depth)
+        {
+            std::size_t i = checkPrefix(node, k, depth);
+            if (i < MAX_PREFIX || i == node->mPrefixLength) {
+                return i;
+            }
+
+            //  every key below shares the whole prefix, so any leaf has the missing bytes
+            const Key& full = minimumLeaf(node)->mKey;
+            const std::size_t size = Traits::size(k);
+            while (i < node->mPrefixLength && depth + i < size && Traits::byteAt(full, depth + i) == Traits::byteAt(k, depth + i)) {
+                ++i;
+            }
+
+            return i;
+        }
+
+        //  the shortest key sorts first, so a terminal beats every child
+        template<typename Key, typename Data, typename Traits>
+        const typename AdaptiveRadixTree<Key, Data, Traits>::Leaf* AdaptiveRadixTree<Key, Data, Traits>::minimumLeaf(const Node* node)
+        {
+            while (!isLeaf(node)) {
+                const Inner* inner = static_cast<const Inner*>(node);
+                if (inner->mTerminal) {
+                    return inner->mTerminal;
+                }
+
+                switch (node->mType) {
+                case NODE4_NT:
+                    node = static_cast<const Node4*>(node)->mChildren[0];
+                    break;
+                case NODE16_NT:
+                    node = static_cast<const Node16*>(node)->mChildren[0];
+                    break;
+                case NODE48_NT: {
+                    const Node48* n48 = static_cast<const Node48*>(node);
+                    std::size_t byte = 0;
+                    while (n48->mIndex[byte] == 0) ++byte;
+                    node = n48->mChildren[n48->mIndex[byte] - 1];
+                    break;
+                }
+                default: {
+                    const Node256* n256 = static_cast<const Node256*>(node);
+                    std::size_t byte = 0;
+                    while (n256->mChildren[byte] == nullptr) ++byte;
+                    node = n256->mChildren[byte];
+                    break;
+                }
+                }
+            }
+
+            return static_cast<const Leaf*>(node);
+        }
+
+        template<typename Key, typename Data, typename Traits>
+        bool AdaptiveRadixTree<Key, Data, Traits>::startsWith(const Key& k, const Key& prefix)
+        {
+            const std::size_t size = Traits::size(prefix);
+            if (Traits::size(k) < size) {
+                return false;
+            }
+
+            for (std::size_t i = 0; i < size; ++i) {
+                if (Traits::byteAt(k, i) != Traits::byteAt(prefix, i)) {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+
+        template<typename Key, typename Data, typename Traits>
+        typename AdaptiveRadixTree<Key, Data, Traits>::Node** AdaptiveRadixTree<Key, Data, Traits>::findChild(Inner* node, const unsigned char byte)
+        {
+            switch (node->mType) {
+            case NODE4_NT: {
+                Node4* n4 = static_cast<Node4*>(node);
+                for (std::size_t i = 0; i < n4->mCount; ++i) {
+                    if (n4->mKeys[i] == byte) return &n4->mChildren[i];
+                }
+
+                return nullptr;
+            }
+            case NODE16_NT: {
+                Node16* n16 = static_cast<Node16*>(node);
+#ifdef UTILS_ART_SSE2
+                //  all sixteen keys compared in one instruction, the unused tail is masked off
+                const __m128i keys = _mm_loadu_si128(reinterpret_cast<const __m128i*>(n16->mKeys));
+                const __m128i matches = _mm_cmpeq_epi8(keys, _mm_set1_epi8(static_cast<char>(byte)));
+                const unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(matches)) & ((1u << n16->mCount) - 1);
+                return mask ? &n16->mChildren[trailingZeros(mask)] : nullptr;
+#else
+                for (std::size_t i = 0; i < n16->mCount; ++i) {
+                    if (n16->mKeys[i] == byte) return &n16->mChildren[i];
+                }
+
+                return nullptr;
+#endif
+            }
+            case NODE48_NT: {
+                Node48* n48 = static_cast<Node48*>(node);
+                return n48->mIndex[byte] ? &n48->mChildren[n48->mIndex[byte] - 1] : nullptr;
+            }
+            default: {
+                Node256* n256 = static_cast<Node256*>(node);
+                return n256->mChildren[byte] ? &n256->mChildren[byte] : nullptr;
+            }
+            }
+        }
+
+        template<typename Key, typename Data, typename Traits>
+        void AdaptiveRadixTree<Key, Data, Traits>::copyHeader(Inner* to, const Inner* from)
+        {
+            to->mCount = from->mCount;
+            to->mPrefixLength = from->mPrefixLength;
+            std::memcpy(to->mPrefix, from->mPrefix, MAX_PREFIX);
+            to->mTerminal = from->mTerminal;
+        }
+
+        template<typename Key, typename Data, typename Traits>
+        void AdaptiveRadixTree<Key, Data, Traits>::addChild(Node*& ref, const unsigned char byte, Node* child)
+        {
+            switch (ref->mType) {
+            case NODE4_NT: {
+                Node4* n4 = static_cast<Node4*>(ref);
+                if (n4->mCount < 4) {
+                    std::size_t i = n4->mCount;
+                    for (; i > 0 && n4->mKeys[i - 1] > byte; --i) {
+                        n4->mKeys[i] = n4->mKeys[i - 1];
+                        n4->mChildren[i] = n4->mChildren[i - 1];
+                    }
+
+                    n4->mKeys[i] = byte;
+                    n4->mChildren[i] = child;
+                    ++n4->mCount;
+                    return;
+                }
+
+                Node16* n16 = new Node16;
+                copyHeader(n16, n4);
+                std::memcpy(n16->mKeys, n4->mKeys, 4);
+                std::memcpy(n16->mChildren, n4->mChildren, 4 * sizeof(Node*));
+                delete n4;
+                ref = n16;
+                addChild(ref, byte, child);
+                return;
+            }
+            case NODE16_NT: {
+                Node16* n16 = static_cast<Node16*>(ref);
+                if (n16->mCount < 16) {
+                    std::size_t i = n16->mCount;
+                    for (; i > 0 && n16->mKeys[i - 1] > byte; --i) {
+                        n16->mKeys[i] = n16->mKeys[i - 1];
+                        n16->mChildren[i] = n16->mChildren[i - 1];
+                    }
+
+                    n16->mKeys[i] = byte;
+                    n16->mChildren[i] = child;
+                    ++n16->mCount;
+                    return;
+                }
+
+                Node48* n48 = new Node48;
+                copyHeader(n48, n16);
+                for (std::size_t i = 0; i < 16; ++i) {
+                    n48->mChildren[i] = n16->mChildren[i];
+                    n48->mIndex[n16->mKeys[i]] = static_cast<unsigned char>(i + 1);
+                }
+                delete n16;
+                ref = n48;
+                addChild(ref, byte, child);
+                return;
+            }
+            case NODE48_NT: {
+                Node48* n48 = static_cast<Node48*>(ref);
+                if (n48->mCount < 48) {
+                    std::size_t slot = 0;
+                    while (n48->mChildren[slot]) ++slot;
+
+                    n48->mChildren[slot] = child;
+                    n48->mIndex[byte] = static_cast<unsigned char>(slot + 1);
+                    ++n48->mCount;
+                    return;
+                }
+
+                Node256* n256 = new Node256;
+                copyHeader(n256, n48);
+                for (std::size_t i = 0; i < 256; ++i) {
+                    if (n48->mIndex[i]) n256->mChildren[i] = n48->mChildren[n48->mIndex[i] - 1];
+                }
+                delete n48;
+                ref = n256;
+                addChild(ref, byte, child);
+                return;
+            }
+            default: {
+                Node256* n256 = static_cast<Node256*>(ref);
+                n256->mChildren[byte] = child;
+                ++n256->mCount;
+                return;
+            }
+            }
+        }
+
+        template<typename Key, typename Data, typename Traits>
+        void AdaptiveRadixTree<Key, Data, Traits>::removeChild(Inner* node, const unsigned char byte)
+        {
+            switch (node->mType) {
+            case NODE4_NT:
+            case NODE16_NT: {
+                //  Node4 and Node16 share their layout up to the array sizes
+                unsigned char* keys = node->mType == NODE4_NT ? static_cast<Node4*>(node)->mKeys : static_cast<Node16*>(node)->mKeys;
+                Node** children = node->mType == NODE4_NT ? static_cast<Node4*>(node)->mChildren : static_cast<Node16*>(node)->mChildren;
+
+                std::size_t i = 0;
+                while (keys[i] != byte) ++i;
+                for (; i + 1 < node->mCount; ++i) {
+                    keys[i] = keys[i + 1];
+                    children[i] = children[i + 1];
+                }
+                break;
+            }
+            case NODE48_NT: {
+                Node48* n48 = static_cast<Node48*>(node);
+                n48->mChildren[n48->mIndex[byte] - 1] = nullptr;
+                n48->mIndex[byte] = 0;
+                break;
+            }
+            default:
+                static_cast<Node256*>(node)->mChildren[byte] = nullptr;
+                break;
+            }
+
+            --node->mCount;
+        }
+
+        template<typename Key, typename Data, typename Traits>
+        void AdaptiveRadixTree<Key, Data, Traits>::shrink(Node*& ref)
+        {
+            switch (ref->mType) {
+            case NODE4_NT: {
+                Node4* n4 = static_cast<Node4*>(ref);
+                if (n4->mCount == 0) {
+                    //  only the key ending here is left, it takes the node's place
+                    ref = n4->mTerminal;
+                    delete n4;
+                }
+                else if (n4->mCount == 1 && n4->mTerminal == nullptr) {
+                    //  a single path, fold this node's prefix and key byte into the child
+                    Node* child = n4->mChildren[0];
+                    if (!isLeaf(child)) {
+                        Inner* below = static_cast<Inner*>(child);
+                        unsigned char prefix[MAX_PREFIX];
+                        std::size_t length = std::min<std::size_t>(n4->mPrefixLength, MAX_PREFIX);
+                        std::memcpy(prefix, n4->mPrefix, length);
+
+                        if (length < MAX_PREFIX) {
+                            prefix[length++] = n4->mKeys[0];
+                        }
+
+                        const std::size_t tail = std::min<std::size_t>(below->mPrefixLength, MAX_PREFIX - length);
+                        std::memcpy(prefix + length, below->mPrefix, tail);
+                        std::memcpy(below->mPrefix, prefix, length + tail);
+                        below->mPrefixLength += n4->mPrefixLength + 1;
+                    }
+
+                    ref = child;
+                    delete n4;
+                }
+                break;
+            }
+            case NODE16_NT: {
+                Node16* n16 = static_cast<Node16*>(ref);
+                if (n16->mCount <= 3) {
+                    Node4* n4 = new Node4;
+                    copyHeader(n4, n16);
+                    std::memcpy(n4->mKeys, n16->mKeys, n16->mCount);
+                    std::memcpy(n4->mChildren, n16->mChildren, n16->mCount * sizeof(Node*));
+                    delete n16;
+                    ref = n4;
+                    //  a Node4 may have to collapse too
+                    shrink(ref);
+                }
+                break;
+            }
+            case NODE48_NT: {
+                Node48* n48 = static_cast<Node48*>(ref);
+                if (n48->mCount <= 12) {
+                    Node16* n16 = new Node16;
+                    copyHeader(n16, n48);
+                    std::size_t count = 0;
+                    for (std::size_t i = 0; i < 256; ++i) {
+                        if (n48->mIndex[i]) {
+                            n16->mKeys[count] = static_cast<unsigned char>(i);
+                            n16->mChildren[count++] = n48->mChildren[n48->mIndex[i] - 1];
+                        }
+                    }
+                    delete n48;
+                    ref = n16;
+                }
+                break;
+            }
+            default: {
+                Node256* n256 = static_cast<Node256*>(ref);
+                if (n256->mCount <= 36) {
+                    Node48* n48 = new Node48;
+                    copyHeader(n48, n256);
+                    std::size_t count = 0;
+                    for (std::size_t i = 0; i < 256; ++i) {
+                        if (n256->mChildren[i]) {
+                            n48->mChildren[count] = n256->mChildren[i];
+                            n48->mIndex[i] = static_cast<unsigned char>(++count);
+                        }
+                    }
+                    delete n256;
+                    ref = n48;
+                }
+                break;
+            }
+            }
+        }
+
+        template<typename Key, typename Data, typename Traits>
+        typename AdaptiveRadixTree<Key, Data, Traits>::INSERT_RESULT AdaptiveRadixTree<Key, Data, Traits>::insertHelper(Node*& ref, const Key& k, const Data& d, std::size_t depth)
+        {
+            const std::size_t size = Traits::size(k);
+            Node* node = ref;
+
+            if (node == nullptr) {
+                ref = new Leaf(k, d);
+                ++mSize;
+                return INSERT_RESULT(true, NEW_INSERT_IR);
+            }
+
+            if (isLeaf(node)) {
+                Leaf* leaf = static_cast<Leaf*>(node);
+                if (leaf->mKey == k) {
+                    const E_INSERT_RESULT result = leaf->mData == d ? OVERWRITE_SAME_VALUE_IR : OVERWRITE_DIFFERENT_VALUE_IR;
+                    leaf->mData = d;
+                    return INSERT_RESULT(true, result);
+                }
+
+                //  two keys now share this spot, a Node4 over their common bytes splits them
+                const std::size_t leafSize = Traits::size(leaf->mKey);
+                std::size_t common = 0;
+                while (depth + common < size && depth + common < leafSize && Traits::byteAt(k, depth + common) == Traits::byteAt(leaf->mKey, depth + common)) {
+                    ++common;
+                }
+
+                Leaf* added = new Leaf(k, d);
+                Node* split = nullptr;
+                try {
+                    split = new Node4;
+                } catch (...) {
+                    delete added;
+                    throw;
+                }
+
+                Node4* n4 = static_cast<Node4*>(split);
+                n4->mPrefixLength = static_cast<std::uint32_t>(common);
+                for (std::size_t i = 0; i < std::min<std::size_t>(common, MAX_PREFIX); ++i) {
+                    n4->mPrefix[i] = Traits::byteAt(k, depth + i);
+                }
+
+                depth += common;
+                const Leaf* sides[2] = { leaf, added };
+                for (const Leaf* side : sides) {
+                    if (Traits::size(side->mKey) == depth) {
+                        n4->mTerminal = const_cast<Leaf*>(side);
+                    }
+                    else {
+                        addChild(split, Traits::byteAt(side->mKey, depth), const_cast<Leaf*>(side));
+                    }
+                }
+
+                ref = split;
+                ++mSize;
+                return INSERT_RESULT(true, NEW_INSERT_IR);
+            }
+
+            Inner* inner = static_cast<Inner*>(node);
+            if (inner->mPrefixLength) {
+                const std::size_t mismatch = prefixMismatch(inner, k, depth);
+
+                if (mismatch < inner->mPrefixLength) {
+                    //  the key leaves the compressed path part way, a Node4 takes over the shared part
+                    //  and this node keeps what is left after the byte that now tells them apart
+                    unsigned char full[MAX_PREFIX + 1];
+                    const Leaf* any = inner->mPrefixLength > MAX_PREFIX ? minimumLeaf(inner) : nullptr;
+                    const std::size_t available = std::min<std::size_t>(inner->mPrefixLength, mismatch + 1 + MAX_PREFIX);
+                    auto prefixByte = [&](const std::size_t i) {
+                        return i < MAX_PREFIX ? inner->mPrefix[i] : Traits::byteAt(any->mKey, depth + i);
+                    };
+
+                    Leaf* added = new Leaf(k, d);
+                    Node* split = nullptr;
+                    try {
+                        split = new Node4;
+                    } catch (...) {
+                        delete added;
+                        throw;
+                    }
+
+                    Node4* n4 = static_cast<Node4*>(split);
+                    n4->mPrefixLength = static_cast<std::uint32_t>(mismatch);
+                    for (std::size_t i = 0; i < std::min<std::size_t>(mismatch, MAX_PREFIX); ++i) {
+                        n4->mPrefix[i] = prefixByte(i);
+                    }
+
+                    const unsigned char branch = prefixByte(mismatch);
+                    std::size_t kept = 0;
+                    for (std::size_t i = mismatch + 1; i < available && kept < MAX_PREFIX; ++i) {
+                        full[kept++] = prefixByte(i);
+                    }
+
+                    std::memcpy(inner->mPrefix, full, kept);
+                    inner->mPrefixLength -= static_cast<std::uint32_t>(mismatch + 1);
+                    addChild(split, branch, inner);
+
+                    if (depth + mismatch == size) {
+                        n4->mTerminal = added;
+                    }
+                    else {
+                        addChild(split, Traits::byteAt(k, depth + mismatch), added);
+                    }
+
+                    ref = split;
+                    ++mSize;
+                    return INSERT_RESULT(true, NEW_INSERT_IR);
+                }
+
+                depth += inner->mPrefixLength;
+            }
+
+            if (depth == size) {
+                //  the whole prefix matched, so a terminal here has exactly this key
+                if (inner->mTerminal) {
+                    Leaf* terminal = inner->mTerminal;
+                    const E_INSERT_RESULT result = terminal->mData == d ? OVERWRITE_SAME_VALUE_IR : OVERWRITE_DIFFERENT_VALUE_IR;
+                    terminal->mData = d;
+                    return INSERT_RESULT(true, result);
+                }
+
+                inner->mTerminal = new Leaf(k, d);
+                ++mSize;
+                return INSERT_RESULT(true, NEW_INSERT_IR);
+            }
+
+            const unsigned char byte = Traits::byteAt(k, depth);
+            Node** child = findChild(inner, byte);
+            if (child) {
+                return insertHelper(*child, k, d, depth + 1);
+            }
+
+            Leaf* added = new Leaf(k, d);
+            try {
+                addChild(ref, byte, added);
+            } catch (...) {
+                delete added;
+                throw;
+            }
+
+            ++mSize;
+            return INSERT_RESULT(true, NEW_INSERT_IR);
+        }
+
+        template<typename Key, typename Data, typename Traits>
+        bool AdaptiveRadixTree<Key, Data, Traits>::removeHelper(Node*& ref, const Key& k, std::size_t depth)
+        {
+            Node* node = ref;
+            if (node == nullptr) {
+                return false;
+            }
+
+            if (isLeaf(node)) {
+                Leaf* leaf = static_cast<Leaf*>(node);
+                if (!(leaf->mKey == k)) {
+                    return false;
+                }
+
+                delete leaf;
+                ref = nullptr;
+                --mSize;
+                return true;
+            }
+
+            const std::size_t size = Traits::size(k);
+            Inner* inner = static_cast<Inner*>(node);
+            if (inner->mPrefixLength) {
+                if (checkPrefix(inner, k, depth) != std::min<std::size_t>(inner->mPrefixLength, MAX_PREFIX)) {
+                    return false;
+                }
+
+                depth += inner->mPrefixLength;
+            }
+
+            if (depth >= size) {
+                Leaf* terminal = inner->mTerminal;
+                if (depth > size || terminal == nullptr || !(terminal->mKey == k)) {
+                    return false;
+                }
+
+                delete terminal;
+                inner->mTerminal = nullptr;
+                --mSize;
+                shrink(ref);
+                return true;
+            }
+
+            const unsigned char byte = Traits::byteAt(k, depth);
+            Node** child = findChild(inner, byte);
+            if (child == nullptr || !removeHelper(*child, k, depth + 1)) {
+                return false;
+            }
+
+            if (*child == nullptr) {
+                removeChild(inner, byte);
+            }
+
+            shrink(ref);
+            return true;
+        }
+
+        template<typename Key, typename Data, typename Traits>
+        typename AdaptiveRadixTree<Key, Data, Traits>::Node* AdaptiveRadixTree<Key, Data, Traits>::copyNode(const Node* node)
+        {
+            if (node == nullptr) {
+                return nullptr;
+            }
+
+            if (isLeaf(node)) {
+                return new Leaf(*static_cast<const Leaf*>(node));
+            }
+
+            //  the copy starts with no children so a throw part way can destroy it as it stands
+            Inner* copy = nullptr;
+            switch (node->mType) {
+            case NODE4_NT:
+                copy = new Node4(*static_cast<const Node4*>(node));
+                std::memset(static_cast<Node4*>(copy)->mChildren, 0, sizeof(Node4::mChildren));
+                break;
+            case NODE16_NT:
+                copy = new Node16(*static_cast<const Node16*>(node));
+                std::memset(static_cast<Node16*>(copy)->mChildren, 0, sizeof(Node16::mChildren));
+                break;
+            case NODE48_NT:
+                copy = new Node48(*static_cast<const Node48*>(node));
+                std::memset(static_cast<Node48*>(copy)->mChildren, 0, sizeof(Node48::mChildren));
+                break;
+            default:
+                copy = new Node256(*static_cast<const Node256*>(node));
+                std::memset(static_cast<Node256*>(copy)->mChildren, 0, sizeof(Node256::mChildren));
+                break;
+            }
+
+            copy->mTerminal = nullptr;
+            try {
+                const Inner* source = static_cast<const Inner*>(node);
+                copy->mTerminal = source->mTerminal ? new Leaf(*source->mTerminal) : nullptr;
+
+                switch (node->mType) {
+                case NODE4_NT:
+                    for (std::size_t i = 0; i < source->mCount; ++i) {
+                        static_cast<Node4*>(copy)->mChildren[i] = copyNode(static_cast<const Node4*>(node)->mChildren[i]);
+                    }
+                    break;
+                case NODE16_NT:
+                    for (std::size_t i = 0; i < source->mCount; ++i) {
+                        static_cast<Node16*>(copy)->mChildren[i] = copyNode(static_cast<const Node16*>(node)->mChildren[i]);
+                    }
+                    break;
+                case NODE48_NT:
+                    for (std::size_t i = 0; i < 48; ++i) {
+                        static_cast<Node48*>(copy)->mChildren[i] = copyNode(static_cast<const Node48*>(node)->mChildren[i]);
+                    }
+                    break;
+                default:
+                    for (std::size_t i = 0; i < 256; ++i) {
+                        static_cast<Node256*>(copy)->mChildren[i] = copyNode(static_cast<const Node256*>(node)->mChildren[i]);
+                    }
+                    break;
+                }
+            } catch (...) {
+                destroy(copy);
+                throw;
+            }
+
+            return copy;
+        }
+
+        template<typename Key, typename Data, typename Traits>
+        void AdaptiveRadixTree<Key, Data, Traits>::destroy(Node* node)
+        {
+            if (node == nullptr) return;
+
+            if (isLeaf(node)) {
+                delete static_cast<Leaf*>(node);
+                return;
+            }
+
+            delete static_cast<Inner*>(node)->mTerminal;
+
+            switch (node->mType) {
+            case NODE4_NT: {
+                Node4* n4 = static_cast<Node4*>(node);
+                for (std::size_t i = 0; i < n4->mCount; ++i) destroy(n4->mChildren[i]);
+                delete n4;
+                break;
+            }
+            case NODE16_NT: {
+                Node16* n16 = static_cast<Node16*>(node);
+                for (std::size_t i = 0; i < n16->mCount; ++i) destroy(n16->mChildren[i]);
+                delete n16;
+                break;
+            }
+            case NODE48_NT: {
+                Node48* n48 = static_cast<Node48*>(node);
+                for (Node* child : n48->mChildren) destroy(child);
+                delete n48;
+                break;
+            }
+            default: {
+                Node256* n256 = static_cast<Node256*>(node);
+                for (Node* child : n256->mChildren) destroy(child);
+                delete n256;
+                break;
+            }
+            }
+        }
+
+        template<typename Key, typename Data, typename Traits>
+        template<typename Function>
+        void AdaptiveRadixTree<Key, Data, Traits>::forEachHelper(const Node* node, Function& f)
+        {
+            if (node == nullptr) return;
+
+            if (isLeaf(node)) {
+                const Leaf* leaf = static_cast<const Leaf*>(node);
+                f(leaf->mKey, leaf->mData);
+                return;
+            }
+
+            const Inner* inner = static_cast<const Inner*>(node);
+            if (inner->mTerminal) {
+                f(inner->mTerminal->mKey, inner->mTerminal->mData);
+            }
+
+            switch (node->mType) {
+            case NODE4_NT: {
+                const Node4* n4 = static_cast<const Node4*>(node);
+                for (std::size_t i = 0; i < n4->mCount; ++i) forEachHelper(n4->mChildren[i], f);
+                break;
+            }
+            case NODE16_NT: {
+                const Node16* n16 = static_cast<const Node16*>(node);
+                for (std::size_t i = 0; i < n16->mCount; ++i) forEachHelper(n16->mChildren[i], f);
+                break;
+            }
+            case NODE48_NT: {
+                const Node48* n48 = static_cast<const Node48*>(node);
+                for (std::size_t i = 0; i < 256; ++i) {
+                    if (n48->mIndex[i]) forEachHelper(n48->mChildren[n48->mIndex[i] - 1], f);
+                }
+                break;
+            }
+            default: {
+                const Node256* n256 = static_cast<const Node256*>(node);
+                for (const Node* child : n256->mChildren) forEachHelper(child, f);
+                break;
+            }
+            }
+        }
+    }
+}
+
+#endif
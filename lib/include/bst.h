@@ -1,13 +1,19 @@
 #ifndef H_UTILS_STORAGE_BST_H
 #define H_UTILS_STORAGE_BST_H
 
+#include <cstddef>
+#include <iterator>
 #include <utility>
+#include <vector>
+#include "container_stats.h"
+#include "parallel_algorithm.h"
+#include "thread_pool.h"
 
 namespace utils {
     namespace storage {
 
-        template<typename Key, typename Data>
-        class BST
+        template<typename Key, typename Data, typename Stats = NoStats>
+        class BST : private Stats
         {
         public:
             enum E_INSERT_RESULT
@@ -33,47 +39,92 @@ namespace utils {
 
             INSERT_RESULT insert(const Key& k, const Data& d);
             bool remove(const Key& k);
+            void clear();
+
+            //  f(key, data) for every element, in key order
+            template<typename Function>
+            void forEach(Function f) const { forEachHelper(mRoot, f); }
+
+            //  replaces the contents with a perfectly balanced tree of the (key, data) pairs in [first, last),
+            //  which need not be sorted, the last of any duplicate keys wins
+            //  with a pool the batch is sorted and the tree built with fork-join tasks
+            template<typename Iterator>
+            void build(Iterator first, Iterator last, concurrency::ThreadPool* pool = nullptr);
+
+            //  f(key, data) for every element, called concurrently from the pool's threads in no particular order
+            template<typename Function>
+            void parallel_for_each(Function f, concurrency::ThreadPool& pool);
+
+            //  reduce(map(key, data)...) over the whole tree, reduce must be associative
+            //  results are combined in key order so it need not be commutative
+            template<typename T, typename Map, typename Reduce>
+            T parallel_reduce(const T& identity, Map map, Reduce reduce, concurrency::ThreadPool& pool) const;
+
+            //  counts kept by the Stats policy, all zero under NoStats
+            //  with statistics on the snapshot also walks the tree for its height
+            ContainerStats stats() const;
+            //  keys and data as payload, the object and child links as overhead, walks the tree
+            MemoryUsage memory_usage() const;
 
         private:
-            Node* insertHelper(Node* node, const Key& k, const Data& d, INSERT_RESULT& insertResult);
-            Node* removeHelper(Node* node, const Key& k);
+            Node* insertHelper(Node* node, const Key& k, const Data& d, INSERT_RESULT& insertResult, const std::size_t depth);
+            Node* removeHelper(Node* node, const Key& k, bool& removed, const std::size_t depth);
             Node* findLeftMostNode(Node* node, Node*& result);
 
+            //  subtrees this many levels below the root or deeper are walked sequentially
+            static unsigned forkDepth(const concurrency::ThreadPool& pool);
+            static Node* buildHelper(const std::pair<Key, Data>* items, const std::size_t count, concurrency::ThreadPool* pool, const unsigned depth);
+            template<typename Function>
+            static void forEachHelper(const Node* node, Function& f);
+            template<typename Function>
+            static void forEachHelper(Node* node, Function& f, concurrency::ThreadPool& pool, const unsigned depth);
+            template<typename T, typename Map, typename Reduce>
+            static T reduceHelper(const Node* node, const T& identity, Map& map, Reduce& reduce, concurrency::ThreadPool& pool, const unsigned depth);
+            static std::size_t height(const Node* node);
+            static std::size_t count(const Node* node);
+            //  returns the number of nodes deleted
+            static std::size_t destroy(Node* node);
+
         public:
             Node * mRoot;
         };
 
-        template<typename Key, typename Data>
-        typename BST<Key, Data>::INSERT_RESULT BST<Key, Data>::insert(const Key& k, const Data& d)
+        template<typename Key, typename Data, typename Stats>
+        typename BST<Key, Data, Stats>::INSERT_RESULT BST<Key, Data, Stats>::insert(const Key& k, const Data& d)
         {
             INSERT_RESULT insertResult;
 
             if (mRoot) {
-                insertHelper(mRoot, k, d, insertResult);
+                insertHelper(mRoot, k, d, insertResult, 0);
             }
             else {
                 insertResult.first = true;
                 insertResult.second = NEW_INSERT_IR;
                 mRoot = new Node{ k,d,nullptr, nullptr };
+                this->onAllocate(1);
+                this->onInsertDepth(0);
             }
 
             return insertResult;
         }
 
-        template<typename Key, typename Data>
-        typename BST<Key, Data>::Node* BST<Key, Data>::insertHelper(typename BST<Key, Data>::Node* node, const Key& k, const Data& d, typename BST<Key, Data>::INSERT_RESULT& insertResult)
+        template<typename Key, typename Data, typename Stats>
+        typename BST<Key, Data, Stats>::Node* BST<Key, Data, Stats>::insertHelper(typename BST<Key, Data, Stats>::Node* node, const Key& k, const Data& d, typename BST<Key, Data, Stats>::INSERT_RESULT& insertResult, const std::size_t depth)
         {
             if (node == nullptr) {
                 insertResult.first = true;
                 insertResult.second = NEW_INSERT_IR;
-                return new Node{ k, d, nullptr, nullptr };
+                Node* created = new Node{ k, d, nullptr, nullptr };
+                this->onAllocate(1);
+                this->onInsertDepth(depth);
+                return created;
             }
 
             if (node->mKey < k) {
-                node->mRight = insertHelper(node->mRight, k, d, insertResult);
+                node->mRight = insertHelper(node->mRight, k, d, insertResult, depth + 1);
             }
             else if (node->mKey > k) {
-                node->mLeft = insertHelper(node->mLeft, k, d, insertResult);
+                node->mLeft = insertHelper(node->mLeft, k, d, insertResult, depth + 1);
             }
             else {
 
@@ -92,21 +143,18 @@ namespace utils {
             return node;
         }
 
-        template<typename Key, typename Data>
-        bool BST<Key, Data>::remove(const Key& k)
+        template<typename Key, typename Data, typename Stats>
+        bool BST<Key, Data, Stats>::remove(const Key& k)
         {
-            if (mRoot) {
-                if (removeHelper(mRoot, k)) {
-                    return true;
-                }
-            }
-
-            return false;
+            //  the root itself may be the node removed
+            bool removed = false;
+            mRoot = removeHelper(mRoot, k, removed, 0);
+            return removed;
         }
 
        
-        template<typename Key, typename Data>
-        typename BST<Key, Data>::Node* BST<Key, Data>::removeHelper(typename BST<Key, Data>::Node* node, const Key& k)
+        template<typename Key, typename Data, typename Stats>
+        typename BST<Key, Data, Stats>::Node* BST<Key, Data, Stats>::removeHelper(typename BST<Key, Data, Stats>::Node* node, const Key& k, bool& removed, const std::size_t depth)
         {
             if (node == nullptr) {
                 return nullptr;
@@ -115,13 +163,16 @@ namespace utils {
             Node* result = node;
 
             if (k < node->mKey) {
-                node->mLeft = removeHelper(node->mLeft, k);
+                node->mLeft = removeHelper(node->mLeft, k, removed, depth + 1);
             }
             else if (k > node->mKey) {
-                node->mRight = removeHelper(node->mRight, k);
+                node->mRight = removeHelper(node->mRight, k, removed, depth + 1);
             }
             else {
-               
+                removed = true;
+                this->onFree(1);
+                this->onRemoveDepth(depth);
+
                 if (node->mLeft == nullptr || node->mRight == nullptr) {
                     result = node->mLeft == nullptr ? node->mRight : node->mLeft;
                     delete node;
@@ -138,8 +189,8 @@ namespace utils {
             return result;
         }
 
-        template<typename Key, typename Data>
-        typename BST<Key, Data>::Node* BST<Key, Data>::findLeftMostNode(typename BST<Key, Data>::Node* node, typename BST<Key, Data>::Node*& result)
+        template<typename Key, typename Data, typename Stats>
+        typename BST<Key, Data, Stats>::Node* BST<Key, Data, Stats>::findLeftMostNode(typename BST<Key, Data, Stats>::Node* node, typename BST<Key, Data, Stats>::Node*& result)
         {
             if (node->mLeft == nullptr) {                
                 result = node;                
@@ -150,6 +201,177 @@ namespace utils {
             return node;
         }
 
+        template<typename Key, typename Data, typename Stats>
+        void BST<Key, Data, Stats>::clear()
+        {
+            this->onFree(destroy(mRoot));
+            mRoot = nullptr;
+        }
+
+        template<typename Key, typename Data, typename Stats>
+        template<typename Iterator>
+        void BST<Key, Data, Stats>::build(Iterator first, Iterator last, concurrency::ThreadPool* pool)
+        {
+            std::vector<std::pair<Key, Data>> items(first, last);
+            const auto keyLess = [](const std::pair<Key, Data>& lhs, const std::pair<Key, Data>& rhs) { return lhs.first < rhs.first; };
+
+            //  stable, so the last of equal keys is still last after sorting
+            concurrency::parallelSort(items.begin(), items.end(), keyLess, pool);
+
+            std::vector<std::pair<Key, Data>> unique(items.size());
+            const std::size_t count = static_cast<std::size_t>(concurrency::parallelUniqueCopy(items.begin(), items.end(), unique.begin(), keyLess, pool) - unique.begin());
+            items.clear();
+            items.shrink_to_fit();
+
+            clear();
+            mRoot = buildHelper(unique.data(), count, pool, pool ? forkDepth(*pool) : 0);
+            this->onAllocate(count);
+        }
+
+        template<typename Key, typename Data, typename Stats>
+        template<typename Function>
+        void BST<Key, Data, Stats>::parallel_for_each(Function f, concurrency::ThreadPool& pool)
+        {
+            forEachHelper(mRoot, f, pool, forkDepth(pool));
+        }
+
+        template<typename Key, typename Data, typename Stats>
+        template<typename T, typename Map, typename Reduce>
+        T BST<Key, Data, Stats>::parallel_reduce(const T& identity, Map map, Reduce reduce, concurrency::ThreadPool& pool) const
+        {
+            return reduceHelper(mRoot, identity, map, reduce, pool, forkDepth(pool));
+        }
+
+        //  enough tasks to keep every worker busy on a balanced tree with some slack for uneven subtrees
+        template<typename Key, typename Data, typename Stats>
+        unsigned BST<Key, Data, Stats>::forkDepth(const concurrency::ThreadPool& pool)
+        {
+            unsigned depth = 3;
+            for (std::size_t threads = pool.getThreadCount(); threads > 1; threads >>= 1) {
+                ++depth;
+            }
+
+            return depth;
+        }
+
+        //  middle element at the root, the halves on either side built as its subtrees
+        template<typename Key, typename Data, typename Stats>
+        typename BST<Key, Data, Stats>::Node* BST<Key, Data, Stats>::buildHelper(const std::pair<Key, Data>* items, const std::size_t count, concurrency::ThreadPool* pool, const unsigned depth)
+        {
+            if (count == 0) {
+                return nullptr;
+            }
+
+            const std::size_t middle = count / 2;
+            Node* node = new Node{ items[middle].first, items[middle].second, nullptr, nullptr };
+
+            concurrency::forkJoin(pool, depth > 0 && count >= concurrency::PARALLEL_SORT_GRAIN,
+                [&]() { node->mLeft = buildHelper(items, middle, pool, depth > 0 ? depth - 1 : 0); },
+                [&]() { node->mRight = buildHelper(items + middle + 1, count - middle - 1, pool, depth > 0 ? depth - 1 : 0); });
+
+            return node;
+        }
+
+        template<typename Key, typename Data, typename Stats>
+        template<typename Function>
+        void BST<Key, Data, Stats>::forEachHelper(const Node* node, Function& f)
+        {
+            if (node == nullptr) return;
+
+            forEachHelper(node->mLeft, f);
+            f(node->mKey, node->mData);
+            forEachHelper(node->mRight, f);
+        }
+
+        template<typename Key, typename Data, typename Stats>
+        template<typename Function>
+        void BST<Key, Data, Stats>::forEachHelper(Node* node, Function& f, concurrency::ThreadPool& pool, const unsigned depth)
+        {
+            if (node == nullptr) return;
+
+            if (depth == 0) {
+                forEachHelper(node->mLeft, f, pool, 0);
+                f(node->mKey, node->mData);
+                forEachHelper(node->mRight, f, pool, 0);
+                return;
+            }
+
+            concurrency::forkJoin(&pool, true,
+                [&]() { forEachHelper(node->mLeft, f, pool, depth - 1); },
+                [&]() {
+                    f(node->mKey, node->mData);
+                    forEachHelper(node->mRight, f, pool, depth - 1);
+                });
+        }
+
+        template<typename Key, typename Data, typename Stats>
+        template<typename T, typename Map, typename Reduce>
+        T BST<Key, Data, Stats>::reduceHelper(const Node* node, const T& identity, Map& map, Reduce& reduce, concurrency::ThreadPool& pool, const unsigned depth)
+        {
+            if (node == nullptr) {
+                return identity;
+            }
+
+            T left = identity;
+            T right = identity;
+
+            concurrency::forkJoin(&pool, depth > 0,
+                [&]() { left = reduceHelper(node->mLeft, identity, map, reduce, pool, depth > 0 ? depth - 1 : 0); },
+                [&]() { right = reduceHelper(node->mRight, identity, map, reduce, pool, depth > 0 ? depth - 1 : 0); });
+
+            return reduce(reduce(left, map(node->mKey, node->mData)), right);
+        }
+
+        template<typename Key, typename Data, typename Stats>
+        ContainerStats BST<Key, Data, Stats>::stats() const
+        {
+            ContainerStats snapshot = Stats::snapshot();
+            if (Stats::ENABLED) {
+                snapshot.mHeight = height(mRoot);
+            }
+
+            return snapshot;
+        }
+
+        template<typename Key, typename Data, typename Stats>
+        MemoryUsage BST<Key, Data, Stats>::memory_usage() const
+        {
+            const std::size_t nodes = count(mRoot);
+
+            MemoryUsage usage;
+            usage.mPayload = nodes * (sizeof(Key) + sizeof(Data));
+            usage.mOverhead = sizeof(*this) + nodes * (sizeof(Node) - sizeof(Key) - sizeof(Data));
+            return usage;
+        }
+
+        template<typename Key, typename Data, typename Stats>
+        std::size_t BST<Key, Data, Stats>::height(const Node* node)
+        {
+            if (node == nullptr) return 0;
+
+            const std::size_t left = height(node->mLeft);
+            const std::size_t right = height(node->mRight);
+            return 1 + (left > right ? left : right);
+        }
+
+        template<typename Key, typename Data, typename Stats>
+        std::size_t BST<Key, Data, Stats>::count(const Node* node)
+        {
+            if (node == nullptr) return 0;
+
+            return 1 + count(node->mLeft) + count(node->mRight);
+        }
+
+        template<typename Key, typename Data, typename Stats>
+        std::size_t BST<Key, Data, Stats>::destroy(Node* node)
+        {
+            if (node == nullptr) return 0;
+
+            const std::size_t deleted = destroy(node->mLeft) + destroy(node->mRight);
+            delete node;
+            return deleted + 1;
+        }
+
     }
 }
 
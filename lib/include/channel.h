@@ -0,0 +1,513 @@
+#ifndef H_UTILS_CONCURRENCY_CHANNEL_H
+#define H_UTILS_CONCURRENCY_CHANNEL_H
+
+//  the channel needs C++20 coroutines, the rest of the library is C++14 so everything here is
+//  compiled out unless the compiler has them, UTILS_HAS_COROUTINES says whether it did
+//  define UTILS_REQUIRE_COROUTINES to make their absence an error instead
+#if defined(__cpp_impl_coroutine) && __cpp_impl_coroutine >= 201902L
+#define UTILS_HAS_COROUTINES
+
+//  includes
+#include <atomic>
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "intrusive_queue.h"
+#include "pooled_queue.h"
+#include "thread_pool.h"
+
+namespace utils {
+    namespace concurrency {
+
+        class Executor;
+
+        //  Task
+        //  coroutine started by Executor::spawn, it does not run until then and its frame is
+        //  destroyed as soon as it finishes, an exception it throws is handed to the executor
+        class Task {
+
+        public:
+            struct promise_type;
+            typedef std::coroutine_handle<promise_type> Handle;
+
+        private:
+            //  the frame is gone once this returns, the executor is told last
+            struct FinalAwaiter {
+                bool await_ready() const noexcept { return false; }
+                void await_suspend(Handle handle) noexcept;
+                void await_resume() const noexcept {}
+            };
+
+        public:
+            struct promise_type {
+                Task get_return_object() { return Task(Handle::from_promise(*this)); }
+                std::suspend_always initial_suspend() const noexcept { return {}; }
+                FinalAwaiter final_suspend() const noexcept { return {}; }
+                void return_void() const noexcept {}
+                void unhandled_exception() { mError = std::current_exception(); }
+
+                Executor* mExecutor = nullptr;
+                std::exception_ptr mError;
+            };
+
+        public:
+            Task(Task&& rhs) noexcept : mHandle(std::exchange(rhs.mHandle, nullptr)) {}
+            //  only a task that was never spawned still owns its frame
+            ~Task() { if (mHandle) mHandle.destroy(); }
+
+            Task(const Task&) = delete;
+            Task& operator=(const Task&) = delete;
+            Task& operator=(Task&&) = delete;
+
+        private:
+            friend class Executor;
+
+            explicit Task(Handle handle) : mHandle(handle) {}
+
+        private:
+            Handle mHandle;
+        };
+
+        //  Executor
+        //  decides where suspended coroutines resume, every Channel is bound to one
+        //  counts the tasks it has spawned until they finish and keeps the first exception one threw
+        class Executor {
+
+        public:
+            virtual ~Executor() = default;
+
+            //  queue handle to be resumed, may be called from any thread the executor supports
+            virtual void schedule(std::coroutine_handle<> handle) = 0;
+
+            void spawn(Task task);
+
+            std::size_t getPendingCount() const { return mPending.load(std::memory_order_acquire); }
+
+        protected:
+            //  throws the first exception a task finished with, once
+            void rethrow();
+
+        private:
+            friend class Task;
+
+            void onTaskDone(std::exception_ptr error);
+
+        private:
+            std::atomic<std::size_t> mPending{ 0 };
+            std::exception_ptr mError;
+            std::mutex mErrorMutex;
+        };
+
+        //  SingleThreadExecutor
+        //  resumes coroutines on the thread calling run(), not safe to use from any other thread
+        class SingleThreadExecutor : public Executor {
+
+        public:
+            void schedule(std::coroutine_handle<> handle) override { mReady.push_back(handle); }
+
+            //  resumes ready coroutines until none is left, then rethrows the first exception a task threw
+            //  throws std::logic_error if tasks are still suspended, every one of them is waiting on
+            //  a channel nobody will touch again
+            //  their frames are left alone, they are still linked into those channels, the caller has to
+            //  close the channels and run again so the tasks can finish, otherwise the frames leak
+            void run();
+
+        private:
+            storage::PooledQueue<std::coroutine_handle<>> mReady;
+        };
+
+        //  PoolExecutor
+        //  resumes coroutines as tasks of a ThreadPool, so stages of a pipeline run in parallel
+        class PoolExecutor : public Executor {
+
+        public:
+            explicit PoolExecutor(ThreadPool& pool) : mPool(pool) {}
+
+            void schedule(std::coroutine_handle<> handle) override { mPool.submit([handle]() { handle.resume(); }); }
+
+            //  waits for every spawned task to finish, running queued work on the calling thread
+            //  meanwhile, then rethrows the first exception a task threw
+            void join();
+
+        private:
+            ThreadPool& mPool;
+        };
+
+        //  Channel
+        //  bounded queue between coroutines, co_await send(x) suspends the sender while the channel
+        //  is full and co_await receive() suspends the receiver while it is empty, so a fast stage
+        //  is held back by a slow one instead of buffering without limit
+        //  the elements sit in a PooledQueue, which reuses its nodes once it has grown to capacity,
+        //  and suspended coroutines wait in intrusive queues of their own awaiters, so a send or
+        //  receive that has to wait allocates nothing
+        //  waiters are resumed in the order they arrived, through the channel's executor, and
+        //  every operation takes one mutex so any executor may be used
+        template<typename T>
+        class Channel {
+
+            //  receivers wait here, a sender hands its value straight to the first one
+            struct ReceiveWaiter : storage::IntrusiveHook<> {
+                std::coroutine_handle<> mHandle;
+                std::optional<T> mValue;
+            };
+
+        public:
+            class SendAwaiter;
+            class ReceiveAwaiter;
+            class BatchAwaiter;
+
+            Channel(Executor& executor, const std::size_t capacity);
+            ~Channel() = default;
+
+            Channel(const Channel&) = delete;
+            Channel& operator=(const Channel&) = delete;
+
+            //  co_await send(x) throws std::logic_error if the channel is closed before x gets in
+            SendAwaiter send(T value) { return SendAwaiter(*this, std::move(value)); }
+            //  co_await receive() gives std::nullopt once the channel is closed and drained
+            ReceiveAwaiter receive() { return ReceiveAwaiter(*this); }
+            //  co_await receive_batch(n) waits for at least one element and gives up to n,
+            //  an empty vector once the channel is closed and drained, n of 0 is taken as 1
+            BatchAwaiter receive_batch(const std::size_t maxCount) { return BatchAwaiter(*this, maxCount > 0 ? maxCount : 1); }
+
+            //  no more sends, receivers drain what is left, suspended senders are woken to throw
+            void close();
+
+            bool isClosed() const;
+            std::size_t getSize() const;
+            std::size_t getCapacity() const { return mCapacity; }
+
+        private:
+            //  moves the front of the buffer into out, refilling from the first waiting sender,
+            //  whose handle is returned to be scheduled once the lock is released
+            std::coroutine_handle<> takeFront(std::optional<T>& out);
+
+        private:
+            Executor& mExecutor;
+            const std::size_t mCapacity;
+            mutable std::mutex mMutex;
+            storage::PooledQueue<T> mBuffer;
+            storage::IntrusiveQueue<SendAwaiter> mSenders;
+            storage::IntrusiveQueue<ReceiveWaiter> mReceivers;
+            bool mClosed = false;
+        };
+
+        //  SendAwaiter
+        //  holds the value while its sender is suspended on a full channel
+        template<typename T>
+        class Channel<T>::SendAwaiter : public storage::IntrusiveHook<> {
+
+        public:
+            SendAwaiter(Channel<T>& channel, T&& value) : mChannel(channel), mValue(std::move(value)) {}
+
+            bool await_ready() const noexcept { return false; }
+            bool await_suspend(std::coroutine_handle<> handle);
+            void await_resume() const;
+
+        private:
+            friend class Channel<T>;
+
+            Channel<T>& mChannel;
+            T mValue;
+            std::coroutine_handle<> mHandle;
+            bool mClosed = false;
+        };
+
+        //  ReceiveAwaiter
+        template<typename T>
+        class Channel<T>::ReceiveAwaiter : private ReceiveWaiter {
+
+        public:
+            explicit ReceiveAwaiter(Channel<T>& channel) : mChannel(channel) {}
+
+            bool await_ready() const noexcept { return false; }
+            bool await_suspend(std::coroutine_handle<> handle);
+            std::optional<T> await_resume() { return std::move(this->mValue); }
+
+        private:
+            friend class Channel<T>;
+
+            Channel<T>& mChannel;
+        };
+
+        //  BatchAwaiter
+        //  waits like ReceiveAwaiter, then takes whatever else has arrived in the same lock
+        template<typename T>
+        class Channel<T>::BatchAwaiter : private ReceiveWaiter {
+
+        public:
+            BatchAwaiter(Channel<T>& channel, const std::size_t maxCount) : mChannel(channel), mMaxCount(maxCount) {}
+
+            bool await_ready() const noexcept { return false; }
+            bool await_suspend(std::coroutine_handle<> handle);
+            std::vector<T> await_resume();
+
+        private:
+            friend class Channel<T>;
+
+            Channel<T>& mChannel;
+            const std::size_t mMaxCount;
+        };
+
+        inline void Task::FinalAwaiter::await_suspend(Handle handle) noexcept
+        {
+            Executor* executor = handle.promise().mExecutor;
+            std::exception_ptr error = std::move(handle.promise().mError);
+            handle.destroy();
+            executor->onTaskDone(std::move(error));
+        }
+
+        inline void Executor::spawn(Task task)
+        {
+            Task::Handle handle = std::exchange(task.mHandle, nullptr);
+            handle.promise().mExecutor = this;
+            mPending.fetch_add(1, std::memory_order_relaxed);
+            schedule(handle);
+        }
+
+        inline void Executor::rethrow()
+        {
+            std::lock_guard<std::mutex> lock(mErrorMutex);
+            if (mError) {
+                std::exception_ptr error = mError;
+                mError = nullptr;
+                std::rethrow_exception(error);
+            }
+        }
+
+        inline void Executor::onTaskDone(std::exception_ptr error)
+        {
+            if (error) {
+                std::lock_guard<std::mutex> lock(mErrorMutex);
+                if (!mError) {
+                    mError = std::move(error);
+                }
+            }
+
+            mPending.fetch_sub(1, std::memory_order_acq_rel);
+        }
+
+        inline void SingleThreadExecutor::run()
+        {
+            while (!mReady.empty()) {
+                std::coroutine_handle<> handle = mReady.front();
+                mReady.pop_front();
+                handle.resume();
+            }
+
+            rethrow();
+
+            if (getPendingCount() != 0) {
+                throw std::logic_error("executor ran out of work with tasks still suspended");
+            }
+        }
+
+        inline void PoolExecutor::join()
+        {
+            while (getPendingCount() != 0) {
+                if (!mPool.runPendingTask()) {
+                    std::this_thread::yield();
+                }
+            }
+
+            rethrow();
+        }
+
+        template<typename T>
+        Channel<T>::Channel(Executor& executor, const std::size_t capacity) : mExecutor(executor), mCapacity(capacity)
+        {
+            if (capacity == 0) {
+                throw std::invalid_argument("a channel needs room for at least one element");
+            }
+        }
+
+        template<typename T>
+        void Channel<T>::close()
+        {
+            std::vector<std::coroutine_handle<>> woken;
+
+            {
+                std::lock_guard<std::mutex> lock(mMutex);
+                mClosed = true;
+
+                while (!mSenders.empty()) {
+                    SendAwaiter& sender = mSenders.front();
+                    mSenders.pop_front();
+                    sender.mClosed = true;
+                    woken.push_back(sender.mHandle);
+                }
+
+                //  a receiver only waits on an empty buffer, it wakes to nothing
+                while (!mReceivers.empty()) {
+                    ReceiveWaiter& receiver = mReceivers.front();
+                    mReceivers.pop_front();
+                    woken.push_back(receiver.mHandle);
+                }
+            }
+
+            for (std::coroutine_handle<> handle : woken) {
+                mExecutor.schedule(handle);
+            }
+        }
+
+        template<typename T>
+        bool Channel<T>::isClosed() const
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            return mClosed;
+        }
+
+        template<typename T>
+        std::size_t Channel<T>::getSize() const
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            return mBuffer.getSize();
+        }
+
+        template<typename T>
+        std::coroutine_handle<> Channel<T>::takeFront(std::optional<T>& out)
+        {
+            out.emplace(std::move(mBuffer.front()));
+            mBuffer.pop_front();
+
+            //  the space just freed goes to the longest waiting sender
+            if (mSenders.empty()) {
+                return nullptr;
+            }
+
+            SendAwaiter& sender = mSenders.front();
+            mSenders.pop_front();
+            mBuffer.push_back(std::move(sender.mValue));
+            return sender.mHandle;
+        }
+
+        //  does the whole send under the lock and only suspends when there is no room,
+        //  once the lock is released a suspended sender may already be resumed on another thread
+        //  so nothing touches the awaiter after that
+        template<typename T>
+        bool Channel<T>::SendAwaiter::await_suspend(std::coroutine_handle<> handle)
+        {
+            std::coroutine_handle<> woken;
+
+            {
+                std::lock_guard<std::mutex> lock(mChannel.mMutex);
+                if (mChannel.mClosed) {
+                    mClosed = true;
+                    return false;
+                }
+
+                if (!mChannel.mReceivers.empty()) {
+                    //  the buffer is empty while anyone waits to receive, skip it
+                    ReceiveWaiter& receiver = mChannel.mReceivers.front();
+                    mChannel.mReceivers.pop_front();
+                    receiver.mValue.emplace(std::move(mValue));
+                    woken = receiver.mHandle;
+                }
+                else if (mChannel.mBuffer.getSize() < mChannel.mCapacity) {
+                    mChannel.mBuffer.push_back(std::move(mValue));
+                }
+                else {
+                    mHandle = handle;
+                    mChannel.mSenders.push_back(*this);
+                    return true;
+                }
+            }
+
+            if (woken) {
+                mChannel.mExecutor.schedule(woken);
+            }
+
+            return false;
+        }
+
+        template<typename T>
+        void Channel<T>::SendAwaiter::await_resume() const
+        {
+            if (mClosed) {
+                throw std::logic_error("trying to send on a closed channel");
+            }
+        }
+
+        template<typename T>
+        bool Channel<T>::ReceiveAwaiter::await_suspend(std::coroutine_handle<> handle)
+        {
+            std::coroutine_handle<> woken;
+
+            {
+                std::lock_guard<std::mutex> lock(mChannel.mMutex);
+                if (mChannel.mBuffer.empty()) {
+                    if (mChannel.mClosed) {
+                        return false;
+                    }
+
+                    this->mHandle = handle;
+                    mChannel.mReceivers.push_back(*this);
+                    return true;
+                }
+
+                woken = mChannel.takeFront(this->mValue);
+            }
+
+            if (woken) {
+                mChannel.mExecutor.schedule(woken);
+            }
+
+            return false;
+        }
+
+        template<typename T>
+        bool Channel<T>::BatchAwaiter::await_suspend(std::coroutine_handle<> handle)
+        {
+            std::lock_guard<std::mutex> lock(mChannel.mMutex);
+            if (!mChannel.mBuffer.empty() || mChannel.mClosed) {
+                //  await_resume takes what there is
+                return false;
+            }
+
+            this->mHandle = handle;
+            mChannel.mReceivers.push_back(*this);
+            return true;
+        }
+
+        template<typename T>
+        std::vector<T> Channel<T>::BatchAwaiter::await_resume()
+        {
+            std::vector<T> batch;
+            std::vector<std::coroutine_handle<>> woken;
+
+            if (this->mValue) {
+                batch.push_back(std::move(*this->mValue));
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(mChannel.mMutex);
+                std::optional<T> value;
+                while (batch.size() < mMaxCount && !mChannel.mBuffer.empty()) {
+                    const std::coroutine_handle<> sender = mChannel.takeFront(value);
+                    batch.push_back(std::move(*value));
+                    if (sender) {
+                        woken.push_back(sender);
+                    }
+                }
+            }
+
+            for (std::coroutine_handle<> handle : woken) {
+                mChannel.mExecutor.schedule(handle);
+            }
+
+            return batch;
+        }
+    }
+}
+
+#elif defined(UTILS_REQUIRE_COROUTINES)
+#error "UTILS_REQUIRE_COROUTINES is defined but the compiler offers no C++20 coroutines"
+#endif
+
+#endif
@@ -0,0 +1,147 @@
+#ifndef H_UTILS_STORAGE_CONST_MAP_H
+#define H_UTILS_STORAGE_CONST_MAP_H
+
+//  includes
+#include <cstddef>
+#include <functional>
+#include <stdexcept>
+#include "eytzinger.h"
+
+namespace utils {
+    namespace storage {
+
+        //  ConstEntry
+        //  one (key, data) pair of the initializer a ConstMap is built from
+        template<typename Key, typename Data>
+        struct ConstEntry
+        {
+            Key mKey;
+            Data mData;
+        };
+
+        //  ConstMap
+        //  map fixed when it is built, meant to be built in a constant expression so a table that
+        //  never changes (opcodes, enum to handler) costs nothing at startup
+        //  the pairs are sorted and laid out in Eytzinger order, breadth first as an implicit tree
+        //  with the children of node i at 2i and 2i + 1, so the first levels of every search share
+        //  a few cache lines and find is a fixed number of compares with no data dependent branch
+        //  Key, Data and Compare must be literal types, and Key and Data default constructible,
+        //  for the map to be built at compile time, any other type is built at run time
+        template<typename Key, typename Data, std::size_t N, typename Compare = std::less<Key>>
+        class ConstMap
+        {
+            static_assert(N > 0, "a const map needs at least one entry");
+
+        public:
+            typedef ConstEntry<Key, Data> Entry;
+
+        public:
+            //  throws std::logic_error on a duplicate key, a compile error in a constant expression
+            constexpr explicit ConstMap(const Entry (&entries)[N], const Compare& less = Compare());
+
+            constexpr const Data* find(const Key& k) const;
+            constexpr bool contains(const Key& k) const { return find(k) != nullptr; }
+
+            //  throws std::out_of_range when k is not in the map
+            constexpr const Data& at(const Key& k) const;
+
+            //  f(key, data) for every element, in key order
+            template<typename Function>
+            constexpr void forEach(Function f) const { forEachHelper(1, f); }
+
+            static constexpr std::size_t getSize() { return N; }
+
+        private:
+            //  fills the subtree under node with sorted[next...], returns the next unused index
+            constexpr std::size_t layout(const Entry* sorted, std::size_t next, const std::size_t node);
+
+            template<typename Function>
+            constexpr void forEachHelper(const std::size_t node, Function& f) const;
+
+        private:
+            Compare mLess;
+            //  node i of the tree is at index i - 1
+            Key mKeys[N];
+            Data mData[N];
+        };
+
+        //  builds the map from a braced list, makeConstMap<int, char>({ { 1, 'a' }, { 2, 'b' } })
+        template<typename Key, typename Data, typename Compare = std::less<Key>, std::size_t N>
+        constexpr ConstMap<Key, Data, N, Compare> makeConstMap(const ConstEntry<Key, Data> (&entries)[N], const Compare& less = Compare())
+        {
+            return ConstMap<Key, Data, N, Compare>(entries, less);
+        }
+
+        //  insertion sort, the tables are small and std::sort is not constexpr before C++20
+        template<typename Key, typename Data, std::size_t N, typename Compare>
+        constexpr ConstMap<Key, Data, N, Compare>::ConstMap(const Entry (&entries)[N], const Compare& less) : mLess(less), mKeys(), mData()
+        {
+            Entry sorted[N] = {};
+            for (std::size_t i = 0; i < N; ++i) {
+                std::size_t j = i;
+                for (; j > 0 && mLess(entries[i].mKey, sorted[j - 1].mKey); --j) {
+                    sorted[j] = sorted[j - 1];
+                }
+
+                sorted[j] = entries[i];
+            }
+
+            for (std::size_t i = 1; i < N; ++i) {
+                if (!mLess(sorted[i - 1].mKey, sorted[i].mKey)) {
+                    throw std::logic_error("duplicate key in const map");
+                }
+            }
+
+            layout(sorted, 0, 1);
+        }
+
+        template<typename Key, typename Data, std::size_t N, typename Compare>
+        constexpr const Data* ConstMap<Key, Data, N, Compare>::find(const Key& k) const
+        {
+            const std::size_t node = detail::eytzingerLowerBound(mKeys, N, k, mLess);
+            if (node == 0 || mLess(k, mKeys[node - 1])) {
+                return nullptr;
+            }
+
+            return &mData[node - 1];
+        }
+
+        template<typename Key, typename Data, std::size_t N, typename Compare>
+        constexpr const Data& ConstMap<Key, Data, N, Compare>::at(const Key& k) const
+        {
+            const Data* data = find(k);
+            if (data == nullptr) {
+                throw std::out_of_range("key not in const map");
+            }
+
+            return *data;
+        }
+
+        //  an in order walk of the implicit tree hands out the sorted entries in order
+        template<typename Key, typename Data, std::size_t N, typename Compare>
+        constexpr std::size_t ConstMap<Key, Data, N, Compare>::layout(const Entry* sorted, std::size_t next, const std::size_t node)
+        {
+            if (node > N) {
+                return next;
+            }
+
+            next = layout(sorted, next, 2 * node);
+            mKeys[node - 1] = sorted[next].mKey;
+            mData[node - 1] = sorted[next].mData;
+            return layout(sorted, next + 1, 2 * node + 1);
+        }
+
+        template<typename Key, typename Data, std::size_t N, typename Compare>
+        template<typename Function>
+        constexpr void ConstMap<Key, Data, N, Compare>::forEachHelper(const std::size_t node, Function& f) const
+        {
+            if (node > N) return;
+
+            forEachHelper(2 * node, f);
+            f(mKeys[node - 1], mData[node - 1]);
+            forEachHelper(2 * node + 1, f);
+        }
+    }
+}
+
+#endif
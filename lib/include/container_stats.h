@@ -0,0 +1,111 @@
+#ifndef H_UTILS_STORAGE_CONTAINER_STATS_H
+#define H_UTILS_STORAGE_CONTAINER_STATS_H
+
+//  includes
+#include <cstddef>
+
+namespace utils {
+    namespace storage {
+
+        //  ContainerStats
+        //  what a container has done since it was constructed, returned by stats()
+        //  a count that does not apply to a container stays at zero
+        struct ContainerStats
+        {
+            //  depths past the last bucket are counted in it
+            enum { DEPTH_BUCKETS = 64 };
+
+            //  nodes, or for Stack whole blocks
+            std::size_t mAllocations = 0;
+            std::size_t mFrees = 0;
+
+            //  Stack growth, and the bytes of elements carried over to the new block
+            std::size_t mResizes = 0;
+            std::size_t mBytesCopied = 0;
+
+            //  walks along a chain of nodes (Queue::push_back, List appends and removes)
+            std::size_t mWalks = 0;
+            std::size_t mNodesVisited = 0;
+            std::size_t mLongestWalk = 0;
+
+            //  BST, mInsertDepths[d] inserts created a node at depth d (the root is 0),
+            //  mRemoveDepths[d] removes found their key at depth d
+            std::size_t mInsertDepths[DEPTH_BUCKETS] = {};
+            std::size_t mRemoveDepths[DEPTH_BUCKETS] = {};
+
+            //  BST height when the snapshot was taken, an empty tree is 0
+            std::size_t mHeight = 0;
+        };
+
+        //  MemoryUsage
+        //  bytes held by a container split into the elements themselves and everything else,
+        //  the object, node links and unused capacity, the allocator's own headers are not included
+        struct MemoryUsage
+        {
+            std::size_t mPayload = 0;
+            std::size_t mOverhead = 0;
+
+            std::size_t getTotal() const { return mPayload + mOverhead; }
+        };
+
+        //  NoStats
+        //  default statistics policy, every hook is empty so the calls compile away
+        //  and, as an empty base, it adds no bytes to the container
+        struct NoStats
+        {
+            enum { ENABLED = 0 };
+
+            void onAllocate(const std::size_t) {}
+            void onFree(const std::size_t) {}
+            void onResize(const std::size_t) {}
+            void onWalk(const std::size_t) {}
+            void onInsertDepth(const std::size_t) {}
+            void onRemoveDepth(const std::size_t) {}
+
+            ContainerStats snapshot() const { return ContainerStats(); }
+        };
+
+        //  CountingStats
+        //  statistics policy that keeps a ContainerStats up to date,
+        //  none of the hooks allocate or throw so counting never changes a container's behaviour
+        class CountingStats
+        {
+        public:
+            enum { ENABLED = 1 };
+
+            void onAllocate(const std::size_t count) { mStats.mAllocations += count; }
+            void onFree(const std::size_t count) { mStats.mFrees += count; }
+
+            void onResize(const std::size_t bytesCopied)
+            {
+                ++mStats.mResizes;
+                mStats.mBytesCopied += bytesCopied;
+            }
+
+            void onWalk(const std::size_t nodesVisited)
+            {
+                ++mStats.mWalks;
+                mStats.mNodesVisited += nodesVisited;
+                if (nodesVisited > mStats.mLongestWalk) {
+                    mStats.mLongestWalk = nodesVisited;
+                }
+            }
+
+            void onInsertDepth(const std::size_t depth) { ++mStats.mInsertDepths[bucket(depth)]; }
+            void onRemoveDepth(const std::size_t depth) { ++mStats.mRemoveDepths[bucket(depth)]; }
+
+            ContainerStats snapshot() const { return mStats; }
+
+        private:
+            static std::size_t bucket(const std::size_t depth)
+            {
+                return depth < ContainerStats::DEPTH_BUCKETS ? depth : ContainerStats::DEPTH_BUCKETS - 1;
+            }
+
+        private:
+            ContainerStats mStats;
+        };
+    }
+}
+
+#endif
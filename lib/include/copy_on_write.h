@@ -0,0 +1,197 @@
+#ifndef H_UTILS_STORAGE_COPY_ON_WRITE_H
+#define H_UTILS_STORAGE_COPY_ON_WRITE_H
+
+//  includes
+#include <atomic>
+#include <cstddef>
+#include <utility>
+#include "list.h"
+#include "queue.h"
+
+namespace utils {
+    namespace storage {
+
+        //  CopyOnWrite
+        //  copies share one container through an atomic reference count so copying is O(1),
+        //  the first write() through a shared copy makes it a private deep copy first
+        //  read() never copies, so read-mostly copies handed to many workers cost one allocation in total
+        template<typename Container>
+        class CopyOnWrite {
+
+        public:
+            friend void swap(CopyOnWrite<Container>& lhs, CopyOnWrite<Container>& rhs) noexcept
+            {
+                Shared* temp(lhs.mShared);
+                lhs.mShared = rhs.mShared;
+                rhs.mShared = temp;
+            }
+
+        private:
+            struct Shared {
+                explicit Shared(const Container& container) : mContainer(container) {}
+                explicit Shared(Container&& container) : mContainer(std::move(container)) {}
+
+                std::atomic<std::size_t> mRefs{ 1 };
+                Container mContainer;
+            };
+
+        public:
+            CopyOnWrite() = default;
+            explicit CopyOnWrite(const Container& container);
+            explicit CopyOnWrite(Container&& container);
+            CopyOnWrite(const CopyOnWrite<Container>& rhs) noexcept;
+            CopyOnWrite(CopyOnWrite<Container>&& rhs) noexcept;
+            ~CopyOnWrite();
+
+            CopyOnWrite& operator=(const CopyOnWrite<Container>& rhs) noexcept;
+            CopyOnWrite& operator=(CopyOnWrite<Container>&& rhs) noexcept;
+
+            const Container& read() const;
+            Container& write();
+
+            bool isShared() const;
+            std::size_t useCount() const;
+
+        private:
+            void release() noexcept;
+
+        private:
+            //  nullptr while empty so default constructed copies allocate nothing
+            Shared* mShared = nullptr;
+        };
+
+        template<typename T>
+        using CowList = CopyOnWrite<List<T>>;
+
+        template<typename T>
+        using CowQueue = CopyOnWrite<Queue<T>>;
+
+        template<typename Container>
+        CopyOnWrite<Container>::CopyOnWrite(const Container& container)
+            : mShared(new Shared(container))
+        {
+        }
+
+        template<typename Container>
+        CopyOnWrite<Container>::CopyOnWrite(Container&& container)
+            : mShared(new Shared(std::move(container)))
+        {
+        }
+
+        //  O(1), shares rhs's container
+        template<typename Container>
+        CopyOnWrite<Container>::CopyOnWrite(const CopyOnWrite<Container>& rhs) noexcept
+            : mShared(rhs.mShared)
+        {
+            if (mShared) {
+                //  only the count matters here, no data is published by an increment
+                mShared->mRefs.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+
+        template<typename Container>
+        CopyOnWrite<Container>::CopyOnWrite(CopyOnWrite<Container>&& rhs) noexcept
+        {
+            using std::swap;
+            swap(*this, rhs);
+        }
+
+        template<typename Container>
+        CopyOnWrite<Container>::~CopyOnWrite()
+        {
+            release();
+        }
+
+        template<typename Container>
+        CopyOnWrite<Container>& CopyOnWrite<Container>::operator=(const CopyOnWrite<Container>& rhs) noexcept
+        {
+            //  check for self assignment
+            if (this != &rhs) {
+
+                //  make a copy, only bumps the count
+                CopyOnWrite<Container> rhsCopy(rhs);
+
+                //  swap with copy
+                using std::swap;
+                swap(*this, rhsCopy);
+            }
+
+            return *this;
+        }
+
+        template<typename Container>
+        CopyOnWrite<Container>& CopyOnWrite<Container>::operator=(CopyOnWrite<Container>&& rhs) noexcept
+        {
+            //  check for self move
+            if (this != &rhs) {
+
+                //  swap with rhs
+                using std::swap;
+                swap(*this, rhs);
+            }
+
+            return *this;
+        }
+
+        template<typename Container>
+        const Container& CopyOnWrite<Container>::read() const
+        {
+            if (mShared) {
+                return mShared->mContainer;
+            }
+
+            //  every empty instance reads the same empty container
+            static const Container empty;
+            return empty;
+        }
+
+        //  returns a container only this instance refers to,
+        //  deep copying the shared one first if anyone else still holds it
+        template<typename Container>
+        Container& CopyOnWrite<Container>::write()
+        {
+            if (mShared == nullptr) {
+                mShared = new Shared(Container());
+            } else if (mShared->mRefs.load(std::memory_order_acquire) != 1) {
+                //  if the copy throws this instance still shares the original
+                Shared* copy = new Shared(mShared->mContainer);
+                release();
+                mShared = copy;
+            }
+
+            return mShared->mContainer;
+        }
+
+        template<typename Container>
+        bool CopyOnWrite<Container>::isShared() const
+        {
+            return useCount() > 1;
+        }
+
+        template<typename Container>
+        std::size_t CopyOnWrite<Container>::useCount() const
+        {
+            return mShared ? mShared->mRefs.load(std::memory_order_acquire) : 0;
+        }
+
+        template<typename Container>
+        void CopyOnWrite<Container>::release() noexcept
+        {
+            if (mShared == nullptr) return;
+
+            //  the last owner to let go sees every other owner's writes before deleting
+            if (mShared->mRefs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                try {
+                    delete mShared;
+                } catch (...) {
+                    //  T's destructor could be set to noexcept(false) and throw during the delete call
+                    //  do not allow any exceptions to propogate from here
+                }
+            }
+
+            mShared = nullptr;
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,220 @@
+#ifndef H_UTILS_CONCURRENCY_EPOCH_H
+#define H_UTILS_CONCURRENCY_EPOCH_H
+
+//  includes
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace utils {
+    namespace concurrency {
+
+        //  EpochDomain
+        //  epoch based reclamation for lock-free containers
+        //  readers wrap every access in an EpochGuard, writers hand unlinked memory to retire()
+        //  memory retired during epoch e is only freed once the global epoch reaches e + 2,
+        //  at which point no thread can still be inside a critical section that saw it
+        class EpochDomain {
+
+        public:
+            enum { MAX_THREADS = 256, RETIRES_PER_ADVANCE = 64 };
+
+            typedef void (*Deleter)(void*);
+
+        private:
+            static const std::uint64_t QUIESCENT = ~static_cast<std::uint64_t>(0);
+
+            //  one per registered thread, padded so threads do not share a cache line
+            struct alignas(64) Slot {
+                std::atomic<std::uint64_t> mEpoch{ QUIESCENT };
+                std::atomic<bool> mInUse{ false };
+            };
+
+            struct Retired {
+                void* mPointer;
+                Deleter mDeleter;
+            };
+
+            //  per thread state, released when the thread exits
+            struct ThreadState {
+                ~ThreadState();
+
+                Slot* mSlot = nullptr;
+                unsigned mDepth = 0;
+                unsigned mRetiresSinceAdvance = 0;
+                std::uint64_t mBagEpoch[3] = { 0, 0, 0 };
+                std::vector<Retired> mBags[3];
+            };
+
+        public:
+            static EpochDomain& instance();
+
+            void enter();
+            void exit();
+            void retire(void* pointer, Deleter deleter);
+
+            //  blocks until everything the calling thread has retired is freed,
+            //  must not be called from inside a critical section
+            void synchronize() { synchronize(threadState()); }
+
+            std::uint64_t getEpoch() const { return mGlobalEpoch.load(std::memory_order_acquire); }
+
+        private:
+            EpochDomain() = default;
+
+            ThreadState& threadState();
+            void synchronize(ThreadState& state);
+            bool tryAdvance();
+            static void freeBag(std::vector<Retired>& bag);
+
+        private:
+            alignas(64) std::atomic<std::uint64_t> mGlobalEpoch{ 0 };
+            Slot mSlots[MAX_THREADS];
+        };
+
+        //  EpochGuard
+        //  marks the calling thread as inside a critical section for its lifetime, guards nest
+        class EpochGuard {
+
+        public:
+            EpochGuard() { EpochDomain::instance().enter(); }
+            ~EpochGuard() { EpochDomain::instance().exit(); }
+
+            EpochGuard(const EpochGuard&) = delete;
+            EpochGuard& operator=(const EpochGuard&) = delete;
+        };
+
+        inline EpochDomain& EpochDomain::instance()
+        {
+            static EpochDomain domain;
+            return domain;
+        }
+
+        //  the first critical section of a thread claims a free slot
+        inline EpochDomain::ThreadState& EpochDomain::threadState()
+        {
+            thread_local ThreadState state;
+
+            if (state.mSlot == nullptr) {
+                for (std::size_t i = 0; i < MAX_THREADS; ++i) {
+                    bool expected = false;
+                    if (mSlots[i].mInUse.compare_exchange_strong(expected, true, std::memory_order_acq_rel)) {
+                        state.mSlot = &mSlots[i];
+                        break;
+                    }
+                }
+
+                if (state.mSlot == nullptr) {
+                    throw std::runtime_error("too many threads registered with the epoch domain");
+                }
+            }
+
+            return state;
+        }
+
+        inline void EpochDomain::enter()
+        {
+            ThreadState& state = threadState();
+
+            if (state.mDepth++ == 0) {
+                //  publish the epoch this thread is reading in, seq_cst so the store is ordered
+                //  before any load of shared pointers that follows, repeated if the epoch moved
+                //  in between so the published epoch is never already stale
+                std::uint64_t epoch = mGlobalEpoch.load(std::memory_order_seq_cst);
+                for (;;) {
+                    state.mSlot->mEpoch.store(epoch, std::memory_order_seq_cst);
+
+                    const std::uint64_t current = mGlobalEpoch.load(std::memory_order_seq_cst);
+                    if (current == epoch) break;
+
+                    epoch = current;
+                }
+            }
+        }
+
+        inline void EpochDomain::exit()
+        {
+            ThreadState& state = threadState();
+
+            if (--state.mDepth == 0) {
+                state.mSlot->mEpoch.store(QUIESCENT, std::memory_order_release);
+            }
+        }
+
+        inline void EpochDomain::retire(void* pointer, Deleter deleter)
+        {
+            ThreadState& state = threadState();
+            const std::uint64_t epoch = mGlobalEpoch.load(std::memory_order_acquire);
+            const std::size_t bag = epoch % 3;
+
+            if (state.mBagEpoch[bag] != epoch) {
+                //  the bag holds memory from epoch - 3 or earlier, which nobody can still see
+                freeBag(state.mBags[bag]);
+                state.mBagEpoch[bag] = epoch;
+            }
+
+            state.mBags[bag].push_back(Retired{ pointer, deleter });
+
+            if (++state.mRetiresSinceAdvance >= RETIRES_PER_ADVANCE) {
+                state.mRetiresSinceAdvance = 0;
+                tryAdvance();
+            }
+        }
+
+        inline void EpochDomain::synchronize(ThreadState& state)
+        {
+            const std::uint64_t target = mGlobalEpoch.load(std::memory_order_acquire) + 2;
+
+            while (mGlobalEpoch.load(std::memory_order_acquire) < target) {
+                if (!tryAdvance()) {
+                    std::this_thread::yield();
+                }
+            }
+
+            for (std::size_t i = 0; i < 3; ++i) {
+                freeBag(state.mBags[i]);
+            }
+        }
+
+        //  moves the global epoch on if every thread inside a critical section has caught up with it
+        inline bool EpochDomain::tryAdvance()
+        {
+            std::uint64_t epoch = mGlobalEpoch.load(std::memory_order_seq_cst);
+
+            for (std::size_t i = 0; i < MAX_THREADS; ++i) {
+                const std::uint64_t observed = mSlots[i].mEpoch.load(std::memory_order_seq_cst);
+                if (observed != QUIESCENT && observed != epoch) {
+                    //  a thread is still reading in an older epoch
+                    return false;
+                }
+            }
+
+            //  losing the race means another thread advanced it, which is just as good
+            mGlobalEpoch.compare_exchange_strong(epoch, epoch + 1, std::memory_order_seq_cst);
+            return true;
+        }
+
+        inline void EpochDomain::freeBag(std::vector<Retired>& bag)
+        {
+            for (const Retired& retired : bag) {
+                retired.mDeleter(retired.mPointer);
+            }
+
+            bag.clear();
+        }
+
+        //  a thread leaving hands back its slot once all it retired is safe to free
+        inline EpochDomain::ThreadState::~ThreadState()
+        {
+            if (mSlot == nullptr) return;
+
+            EpochDomain::instance().synchronize(*this);
+            mSlot->mInUse.store(false, std::memory_order_release);
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,63 @@
+#ifndef H_UTILS_STORAGE_EYTZINGER_H
+#define H_UTILS_STORAGE_EYTZINGER_H
+
+//  includes
+#include <cstddef>
+
+namespace utils {
+    namespace storage {
+        namespace detail {
+
+            //  number of low bits of bits that are set
+            constexpr unsigned trailingOnes(std::size_t bits)
+            {
+#if defined(__GNUC__)
+                //  usable in a constant expression too
+                return static_cast<unsigned>(__builtin_ctzll(~static_cast<unsigned long long>(bits)));
+#else
+                unsigned ones = 0;
+                for (; bits & 1; bits >>= 1) {
+                    ++ones;
+                }
+
+                return ones;
+#endif
+            }
+
+            //  hints that p is about to be read, does nothing where the compiler has no hint
+            inline void prefetchRead(const void* p)
+            {
+#if defined(__GNUC__)
+                __builtin_prefetch(p);
+#else
+                (void)p;
+#endif
+            }
+
+            //  lower bound over count keys laid out in Eytzinger order, breadth first as an implicit tree
+            //  with the children of node i at 2i and 2i + 1 and node i at keys[i - 1]
+            //  returns the node of the first key not less than k, 0 when every key is less than k
+            //  walks all the way down, moving right past every key less than k, so there is one compare
+            //  per level and no data dependent branch, the bits of the final node then record the turns
+            //  taken and dropping the trailing right turns and the last left one gives the answer
+            //  with Prefetch the line holding the node's descendants four levels down is asked for at
+            //  every step, worth it once the keys no longer fit in cache, never in a constant expression
+            template<bool Prefetch = false, typename Key, typename Compare>
+            constexpr std::size_t eytzingerLowerBound(const Key* keys, const std::size_t count, const Key& k, const Compare& less)
+            {
+                std::size_t node = 1;
+                while (node <= count) {
+                    if (Prefetch) {
+                        prefetchRead(keys + 16 * node - 1);
+                    }
+
+                    node = 2 * node + (less(keys[node - 1], k) ? 1 : 0);
+                }
+
+                return node >> (trailingOnes(node) + 1);
+            }
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,330 @@
+#ifndef H_UTILS_STORAGE_FLAT_MAP_H
+#define H_UTILS_STORAGE_FLAT_MAP_H
+
+//  includes
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "parallel_algorithm.h"
+#include "thread_pool.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define UTILS_FLAT_MAP_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace utils {
+    namespace storage {
+
+        namespace detail {
+
+            //  number of values in [first, first + count) less than k, no early exit so the compiler
+            //  can turn it into vector compares
+            template<typename T>
+            std::size_t countLess(const T* first, const std::size_t count, const T& k)
+            {
+                std::size_t less = 0;
+                for (std::size_t i = 0; i < count; ++i) {
+                    less += first[i] < k ? 1 : 0;
+                }
+
+                return less;
+            }
+
+#ifdef UTILS_FLAT_MAP_SSE2
+            inline std::size_t countLess(const std::int32_t* first, const std::size_t count, const std::int32_t& k)
+            {
+                const __m128i key = _mm_set1_epi32(k);
+                std::size_t less = 0;
+                std::size_t i = 0;
+
+                for (; i + 4 <= count; i += 4) {
+                    const __m128i values = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first + i));
+                    const int mask = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmplt_epi32(values, key)));
+                    less += static_cast<std::size_t>((mask & 1) + ((mask >> 1) & 1) + ((mask >> 2) & 1) + ((mask >> 3) & 1));
+                }
+
+                for (; i < count; ++i) {
+                    less += first[i] < k ? 1 : 0;
+                }
+
+                return less;
+            }
+#endif
+        }
+
+        //  FlatMap
+        //  ordered map kept as two sorted arrays, keys in one and data in the other, so a search only
+        //  touches keys and walks memory the prefetcher can follow, built for read heavy maps that
+        //  are small enough (up to ~100k entries) for the O(n) shifting of a single insert not to matter
+        //  the search halves the range without branches and, for arithmetic keys under std::less,
+        //  finishes with a count of the keys below k over the last few, vectorised where possible
+        //  insert_batch sorts a whole batch and merges it in one pass
+        template<typename Key, typename Data, typename Compare = std::less<Key>>
+        class FlatMap
+        {
+            friend void swap(FlatMap<Key, Data, Compare>& lhs, FlatMap<Key, Data, Compare>& rhs) noexcept
+            {
+                using std::swap;
+                swap(lhs.mKeys, rhs.mKeys);
+                swap(lhs.mData, rhs.mData);
+                swap(lhs.mLess, rhs.mLess);
+            }
+
+        public:
+            enum E_INSERT_RESULT
+            {
+                OVERWRITE_SAME_VALUE_IR,
+                OVERWRITE_DIFFERENT_VALUE_IR,
+                NEW_INSERT_IR
+            };
+
+            typedef std::pair<bool, E_INSERT_RESULT> INSERT_RESULT;
+
+        private:
+            //  ranges this small are finished with a linear count
+            enum { LINEAR_WINDOW = 16 };
+
+            typedef std::integral_constant<bool, std::is_arithmetic<Key>::value && std::is_same<Compare, std::less<Key>>::value> CountableKeys;
+            typedef std::integral_constant<bool, std::is_nothrow_move_constructible<Key>::value && std::is_nothrow_move_constructible<Data>::value> NothrowMoves;
+
+            //  the steps of a batch merge
+            enum E_MERGE_STEP
+            {
+                TAKE_MAP_MS,
+                TAKE_BATCH_MS,
+                REPLACE_MS
+            };
+
+        public:
+            FlatMap() = default;
+
+            INSERT_RESULT insert(const Key& k, const Data& d);
+            //  inserts the (key, data) pairs in [first, last), which need not be sorted, the last of any
+            //  duplicate keys wins, as it does over keys already in the map
+            //  returns the number of keys that were not already present
+            //  with a pool the batch is sorted with fork-join tasks
+            template<typename Iterator>
+            std::size_t insert_batch(Iterator first, Iterator last, concurrency::ThreadPool* pool = nullptr);
+            bool remove(const Key& k);
+
+            Data* find(const Key& k);
+            const Data* find(const Key& k) const;
+            bool contains(const Key& k) const { return find(k) != nullptr; }
+
+            //  index of the first key not less than k, getSize() if there is none
+            std::size_t lower_bound(const Key& k) const { return lowerBound(k, CountableKeys()); }
+
+            //  f(key, data) for every element, in key order
+            template<typename Function>
+            void forEach(Function f) const;
+
+            void reserve(const std::size_t capacity);
+            void clear();
+
+            std::size_t getSize() const { return mKeys.size(); }
+            bool empty() const { return mKeys.empty(); }
+
+        private:
+            std::size_t lowerBound(const Key& k, std::false_type) const;
+            std::size_t lowerBound(const Key& k, std::true_type) const;
+
+            //  an element of the map going into the merged arrays, moved only when no later step can throw
+            template<typename T>
+            static typename std::conditional<NothrowMoves::value, T&&, const T&>::type takeFromMap(T& t) { return std::move(t); }
+
+        private:
+            std::vector<Key> mKeys;
+            std::vector<Data> mData;
+            Compare mLess;
+        };
+
+        template<typename Key, typename Data, typename Compare>
+        typename FlatMap<Key, Data, Compare>::INSERT_RESULT FlatMap<Key, Data, Compare>::insert(const Key& k, const Data& d)
+        {
+            const std::size_t index = lower_bound(k);
+
+            if (index < mKeys.size() && !mLess(k, mKeys[index])) {
+                const E_INSERT_RESULT result = mData[index] == d ? OVERWRITE_SAME_VALUE_IR : OVERWRITE_DIFFERENT_VALUE_IR;
+                mData[index] = d;
+                return INSERT_RESULT(true, result);
+            }
+
+            mKeys.insert(mKeys.begin() + index, k);
+            try {
+                mData.insert(mData.begin() + index, d);
+            } catch (...) {
+                //  keep the two arrays the same length
+                mKeys.erase(mKeys.begin() + index);
+                throw;
+            }
+
+            return INSERT_RESULT(true, NEW_INSERT_IR);
+        }
+
+        template<typename Key, typename Data, typename Compare>
+        template<typename Iterator>
+        std::size_t FlatMap<Key, Data, Compare>::insert_batch(Iterator first, Iterator last, concurrency::ThreadPool* pool)
+        {
+            std::vector<std::pair<Key, Data>> items(first, last);
+            Compare& less = mLess;
+            const auto keyLess = [&less](const std::pair<Key, Data>& lhs, const std::pair<Key, Data>& rhs) { return less(lhs.first, rhs.first); };
+
+            //  stable, so the last of equal keys is still last after sorting
+            concurrency::parallelSort(items.begin(), items.end(), keyLess, pool);
+
+            std::vector<std::pair<Key, Data>> unique(items.size());
+            const std::size_t count = static_cast<std::size_t>(concurrency::parallelUniqueCopy(items.begin(), items.end(), unique.begin(), keyLess, pool) - unique.begin());
+            items.clear();
+            items.shrink_to_fit();
+
+            //  the merge order is settled with compares alone, so a compare that throws changes nothing
+            std::vector<unsigned char> steps;
+            steps.reserve(mKeys.size() + count);
+
+            std::size_t i = 0;
+            std::size_t j = 0;
+            std::size_t added = 0;
+            while (i < mKeys.size() || j < count) {
+                if (j == count || (i < mKeys.size() && mLess(mKeys[i], unique[j].first))) {
+                    steps.push_back(TAKE_MAP_MS);
+                    ++i;
+                }
+                else if (i < mKeys.size() && !mLess(unique[j].first, mKeys[i])) {
+                    //  the batch overwrites
+                    steps.push_back(REPLACE_MS);
+                    ++i;
+                    ++j;
+                }
+                else {
+                    steps.push_back(TAKE_BATCH_MS);
+                    ++j;
+                    ++added;
+                }
+            }
+
+            //  then replayed into new arrays, with moves that cannot throw the map's elements are moved
+            //  out, otherwise they are copied and the map is untouched until the swap
+            std::vector<Key> keys;
+            std::vector<Data> data;
+            keys.reserve(steps.size());
+            data.reserve(steps.size());
+
+            i = 0;
+            j = 0;
+            for (const unsigned char step : steps) {
+                if (step == TAKE_MAP_MS) {
+                    keys.push_back(takeFromMap(mKeys[i]));
+                    data.push_back(takeFromMap(mData[i]));
+                    ++i;
+                    continue;
+                }
+
+                if (step == REPLACE_MS) {
+                    ++i;
+                }
+
+                keys.push_back(std::move(unique[j].first));
+                data.push_back(std::move(unique[j].second));
+                ++j;
+            }
+
+            mKeys.swap(keys);
+            mData.swap(data);
+            return added;
+        }
+
+        template<typename Key, typename Data, typename Compare>
+        bool FlatMap<Key, Data, Compare>::remove(const Key& k)
+        {
+            const std::size_t index = lower_bound(k);
+            if (index == mKeys.size() || mLess(k, mKeys[index])) {
+                return false;
+            }
+
+            mKeys.erase(mKeys.begin() + index);
+            mData.erase(mData.begin() + index);
+            return true;
+        }
+
+        template<typename Key, typename Data, typename Compare>
+        Data* FlatMap<Key, Data, Compare>::find(const Key& k)
+        {
+            return const_cast<Data*>(static_cast<const FlatMap*>(this)->find(k));
+        }
+
+        template<typename Key, typename Data, typename Compare>
+        const Data* FlatMap<Key, Data, Compare>::find(const Key& k) const
+        {
+            const std::size_t index = lower_bound(k);
+            if (index == mKeys.size() || mLess(k, mKeys[index])) {
+                return nullptr;
+            }
+
+            return &mData[index];
+        }
+
+        template<typename Key, typename Data, typename Compare>
+        template<typename Function>
+        void FlatMap<Key, Data, Compare>::forEach(Function f) const
+        {
+            for (std::size_t i = 0; i < mKeys.size(); ++i) {
+                f(mKeys[i], mData[i]);
+            }
+        }
+
+        template<typename Key, typename Data, typename Compare>
+        void FlatMap<Key, Data, Compare>::reserve(const std::size_t capacity)
+        {
+            mKeys.reserve(capacity);
+            mData.reserve(capacity);
+        }
+
+        template<typename Key, typename Data, typename Compare>
+        void FlatMap<Key, Data, Compare>::clear()
+        {
+            mKeys.clear();
+            mData.clear();
+        }
+
+        //  the range [base, base + count] always holds the answer, each step keeps the upper or lower
+        //  half with a conditional move rather than a branch the predictor would get wrong half the time
+        template<typename Key, typename Data, typename Compare>
+        std::size_t FlatMap<Key, Data, Compare>::lowerBound(const Key& k, std::false_type) const
+        {
+            std::size_t count = mKeys.size();
+            if (count == 0) {
+                return 0;
+            }
+
+            const Key* base = mKeys.data();
+            while (count > 1) {
+                const std::size_t half = count / 2;
+                base = mLess(base[half], k) ? base + half : base;
+                count -= half;
+            }
+
+            return static_cast<std::size_t>(base - mKeys.data()) + (mLess(*base, k) ? 1 : 0);
+        }
+
+        template<typename Key, typename Data, typename Compare>
+        std::size_t FlatMap<Key, Data, Compare>::lowerBound(const Key& k, std::true_type) const
+        {
+            std::size_t count = mKeys.size();
+            const Key* base = mKeys.data();
+
+            while (count > LINEAR_WINDOW) {
+                const std::size_t half = count / 2;
+                base = base[half] < k ? base + half : base;
+                count -= half;
+            }
+
+            return static_cast<std::size_t>(base - mKeys.data()) + detail::countLess(base, count, k);
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,404 @@
+#ifndef H_UTILS_STORAGE_INTERVAL_TREE_H
+#define H_UTILS_STORAGE_INTERVAL_TREE_H
+
+//  includes
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+#include "random_seed.h"
+
+namespace utils {
+    namespace storage {
+
+        //  IntervalTree
+        //  map from half open intervals [lo, hi) to data, ordered by lo then hi and balanced as a treap
+        //  every node also records the largest hi in its subtree, so an overlap query skips any subtree
+        //  that ends before the query starts and any right subtree that starts after it ends,
+        //  each result then costs at most one root to leaf path, so a query is O(min(n, k log n))
+        //  for k results
+        //  results are reported in (lo, hi) order
+        template<typename T, typename Data>
+        class IntervalTree
+        {
+            friend void swap(IntervalTree<T, Data>& lhs, IntervalTree<T, Data>& rhs) noexcept
+            {
+                using std::swap;
+                swap(lhs.mRoot, rhs.mRoot);
+                swap(lhs.mSize, rhs.mSize);
+                swap(lhs.mSeed, rhs.mSeed);
+            }
+
+        public:
+            enum E_INSERT_RESULT
+            {
+                OVERWRITE_SAME_VALUE_IR,
+                OVERWRITE_DIFFERENT_VALUE_IR,
+                NEW_INSERT_IR
+            };
+
+            typedef std::pair<bool, E_INSERT_RESULT> INSERT_RESULT;
+
+        private:
+            struct Node
+            {
+                T mLo;
+                T mHi;
+                Data mData;
+                //  largest hi in this subtree
+                T mMaxHi;
+                std::uint32_t mPriority;
+                Node* mLeft;
+                Node* mRight;
+            };
+
+        public:
+            IntervalTree() = default;
+            IntervalTree(const IntervalTree& rhs);
+            IntervalTree(IntervalTree&& rhs) noexcept { swap(*this, rhs); }
+            ~IntervalTree() { clear(); }
+
+            IntervalTree& operator=(const IntervalTree& rhs);
+            IntervalTree& operator=(IntervalTree&& rhs) noexcept;
+
+            //  throws std::invalid_argument if the interval is empty, hi must be greater than lo
+            INSERT_RESULT insert(const T& lo, const T& hi, const Data& d);
+            bool remove(const T& lo, const T& hi);
+
+            Data* find(const T& lo, const T& hi);
+            const Data* find(const T& lo, const T& hi) const;
+            bool contains(const T& lo, const T& hi) const { return find(lo, hi) != nullptr; }
+
+            //  f(lo, hi, data) for every interval containing point
+            template<typename Function>
+            void query_overlapping(const T& point, Function f) const { queryHelper(mRoot, point, point, true, f); }
+            //  f(lo, hi, data) for every interval sharing at least one point with [lo, hi)
+            template<typename Function>
+            void query_overlapping(const T& lo, const T& hi, Function f) const;
+
+            //  f(lo, hi, data) for every interval, in (lo, hi) order
+            template<typename Function>
+            void forEach(Function f) const { forEachHelper(mRoot, f); }
+
+            void clear();
+
+            std::size_t getSize() const { return mSize; }
+            std::size_t getHeight() const { return heightOf(mRoot); }
+            bool empty() const { return mSize == 0; }
+
+        private:
+            static bool less(const T& lo, const T& hi, const Node* node) { return lo < node->mLo || (!(node->mLo < lo) && hi < node->mHi); }
+            static bool greater(const T& lo, const T& hi, const Node* node) { return node->mLo < lo || (!(lo < node->mLo) && node->mHi < hi); }
+            static std::size_t heightOf(const Node* node);
+            static void update(Node* node);
+
+            static Node* rotateRight(Node* node);
+            static Node* rotateLeft(Node* node);
+            static Node* joinNodes(Node* left, Node* right);
+
+            Node* insertHelper(Node* node, const T& lo, const T& hi, const Data& d, INSERT_RESULT& insertResult);
+            Node* removeHelper(Node* node, const T& lo, const T& hi, bool& removed);
+
+            //  with point set the query is point itself and hi is ignored
+            template<typename Function>
+            static void queryHelper(const Node* node, const T& lo, const T& hi, const bool point, Function& f);
+            template<typename Function>
+            static void forEachHelper(const Node* node, Function& f);
+            static Node* copyHelper(const Node* node);
+            static void destroy(Node* node);
+
+            std::uint32_t nextPriority();
+
+        private:
+            Node* mRoot = nullptr;
+            std::size_t mSize = 0;
+            //  xorshift state, seeded apart for every tree so two filled alike are shaped differently
+            std::uint32_t mSeed = detail::randomSeed();
+        };
+
+        template<typename T, typename Data>
+        IntervalTree<T, Data>::IntervalTree(const IntervalTree<T, Data>& rhs) :
+            mRoot(copyHelper(rhs.mRoot)),
+            mSize(rhs.mSize),
+            mSeed(detail::randomSeed())
+        {
+        }
+
+        template<typename T, typename Data>
+        IntervalTree<T, Data>& IntervalTree<T, Data>::operator=(const IntervalTree<T, Data>& rhs)
+        {
+            //  check for self assignment
+            if (this != &rhs) {
+                IntervalTree copy(rhs);
+                swap(*this, copy);
+            }
+
+            return *this;
+        }
+
+        template<typename T, typename Data>
+        IntervalTree<T, Data>& IntervalTree<T, Data>::operator=(IntervalTree<T, Data>&& rhs) noexcept
+        {
+            //  check for self move
+            if (this != &rhs) {
+                clear();
+                swap(*this, rhs);
+            }
+
+            return *this;
+        }
+
+        template<typename T, typename Data>
+        typename IntervalTree<T, Data>::INSERT_RESULT IntervalTree<T, Data>::insert(const T& lo, const T& hi, const Data& d)
+        {
+            if (!(lo < hi)) {
+                throw std::invalid_argument("interval must not be empty");
+            }
+
+            INSERT_RESULT insertResult;
+            mRoot = insertHelper(mRoot, lo, hi, d, insertResult);
+            return insertResult;
+        }
+
+        template<typename T, typename Data>
+        bool IntervalTree<T, Data>::remove(const T& lo, const T& hi)
+        {
+            bool removed = false;
+            mRoot = removeHelper(mRoot, lo, hi, removed);
+            return removed;
+        }
+
+        template<typename T, typename Data>
+        Data* IntervalTree<T, Data>::find(const T& lo, const T& hi)
+        {
+            return const_cast<Data*>(static_cast<const IntervalTree*>(this)->find(lo, hi));
+        }
+
+        template<typename T, typename Data>
+        const Data* IntervalTree<T, Data>::find(const T& lo, const T& hi) const
+        {
+            const Node* node = mRoot;
+            while (node) {
+                if (less(lo, hi, node)) {
+                    node = node->mLeft;
+                }
+                else if (greater(lo, hi, node)) {
+                    node = node->mRight;
+                }
+                else {
+                    return &node->mData;
+                }
+            }
+
+            return nullptr;
+        }
+
+        template<typename T, typename Data>
+        template<typename Function>
+        void IntervalTree<T, Data>::query_overlapping(const T& lo, const T& hi, Function f) const
+        {
+            if (lo < hi) {
+                queryHelper(mRoot, lo, hi, false, f);
+            }
+        }
+
+        template<typename T, typename Data>
+        void IntervalTree<T, Data>::clear()
+        {
+            destroy(mRoot);
+            mRoot = nullptr;
+            mSize = 0;
+        }
+
+        template<typename T, typename Data>
+        std::size_t IntervalTree<T, Data>::heightOf(const Node* node)
+        {
+            if (node == nullptr) {
+                return 0;
+            }
+
+            const std::size_t left = heightOf(node->mLeft);
+            const std::size_t right = heightOf(node->mRight);
+            return 1 + (left > right ? left : right);
+        }
+
+        template<typename T, typename Data>
+        void IntervalTree<T, Data>::update(Node* node)
+        {
+            node->mMaxHi = node->mHi;
+            if (node->mLeft && node->mMaxHi < node->mLeft->mMaxHi) node->mMaxHi = node->mLeft->mMaxHi;
+            if (node->mRight && node->mMaxHi < node->mRight->mMaxHi) node->mMaxHi = node->mRight->mMaxHi;
+        }
+
+        template<typename T, typename Data>
+        typename IntervalTree<T, Data>::Node* IntervalTree<T, Data>::rotateRight(Node* node)
+        {
+            Node* left = node->mLeft;
+            node->mLeft = left->mRight;
+            left->mRight = node;
+            update(node);
+            update(left);
+            return left;
+        }
+
+        template<typename T, typename Data>
+        typename IntervalTree<T, Data>::Node* IntervalTree<T, Data>::rotateLeft(Node* node)
+        {
+            Node* right = node->mRight;
+            node->mRight = right->mLeft;
+            right->mLeft = node;
+            update(node);
+            update(right);
+            return right;
+        }
+
+        template<typename T, typename Data>
+        typename IntervalTree<T, Data>::Node* IntervalTree<T, Data>::joinNodes(Node* left, Node* right)
+        {
+            if (left == nullptr) return right;
+            if (right == nullptr) return left;
+
+            //  the higher priority root stays on top
+            if (left->mPriority > right->mPriority) {
+                left->mRight = joinNodes(left->mRight, right);
+                update(left);
+                return left;
+            }
+
+            right->mLeft = joinNodes(left, right->mLeft);
+            update(right);
+            return right;
+        }
+
+        template<typename T, typename Data>
+        typename IntervalTree<T, Data>::Node* IntervalTree<T, Data>::insertHelper(Node* node, const T& lo, const T& hi, const Data& d, INSERT_RESULT& insertResult)
+        {
+            if (node == nullptr) {
+                insertResult.first = true;
+                insertResult.second = NEW_INSERT_IR;
+                ++mSize;
+                return new Node{ lo, hi, d, hi, nextPriority(), nullptr, nullptr };
+            }
+
+            if (less(lo, hi, node)) {
+                node->mLeft = insertHelper(node->mLeft, lo, hi, d, insertResult);
+                if (node->mLeft->mPriority > node->mPriority) {
+                    return rotateRight(node);
+                }
+            }
+            else if (greater(lo, hi, node)) {
+                node->mRight = insertHelper(node->mRight, lo, hi, d, insertResult);
+                if (node->mRight->mPriority > node->mPriority) {
+                    return rotateLeft(node);
+                }
+            }
+            else {
+                insertResult.first = true;
+                insertResult.second = node->mData == d ? OVERWRITE_SAME_VALUE_IR : OVERWRITE_DIFFERENT_VALUE_IR;
+                node->mData = d;
+                return node;
+            }
+
+            update(node);
+            return node;
+        }
+
+        template<typename T, typename Data>
+        typename IntervalTree<T, Data>::Node* IntervalTree<T, Data>::removeHelper(Node* node, const T& lo, const T& hi, bool& removed)
+        {
+            if (node == nullptr) {
+                return nullptr;
+            }
+
+            if (less(lo, hi, node)) {
+                node->mLeft = removeHelper(node->mLeft, lo, hi, removed);
+            }
+            else if (greater(lo, hi, node)) {
+                node->mRight = removeHelper(node->mRight, lo, hi, removed);
+            }
+            else {
+                //  the children are ordered already, joining them takes the node's place
+                Node* result = joinNodes(node->mLeft, node->mRight);
+                delete node;
+                --mSize;
+                removed = true;
+                return result;
+            }
+
+            update(node);
+            return node;
+        }
+
+        template<typename T, typename Data>
+        template<typename Function>
+        void IntervalTree<T, Data>::queryHelper(const Node* node, const T& lo, const T& hi, const bool point, Function& f)
+        {
+            //  nothing below ends after the query starts
+            if (node == nullptr || !(lo < node->mMaxHi)) return;
+
+            queryHelper(node->mLeft, lo, hi, point, f);
+
+            //  this node and everything to its right start after the query ends
+            const bool startsInside = point ? !(lo < node->mLo) : node->mLo < hi;
+            if (!startsInside) return;
+
+            if (lo < node->mHi) {
+                f(node->mLo, node->mHi, node->mData);
+            }
+
+            queryHelper(node->mRight, lo, hi, point, f);
+        }
+
+        template<typename T, typename Data>
+        template<typename Function>
+        void IntervalTree<T, Data>::forEachHelper(const Node* node, Function& f)
+        {
+            if (node == nullptr) return;
+
+            forEachHelper(node->mLeft, f);
+            f(node->mLo, node->mHi, node->mData);
+            forEachHelper(node->mRight, f);
+        }
+
+        template<typename T, typename Data>
+        typename IntervalTree<T, Data>::Node* IntervalTree<T, Data>::copyHelper(const Node* node)
+        {
+            if (node == nullptr) {
+                return nullptr;
+            }
+
+            Node* copy = new Node{ node->mLo, node->mHi, node->mData, node->mMaxHi, node->mPriority, nullptr, nullptr };
+            try {
+                copy->mLeft = copyHelper(node->mLeft);
+                copy->mRight = copyHelper(node->mRight);
+            } catch (...) {
+                //  a copy threw, release the part of this subtree built so far
+                destroy(copy);
+                throw;
+            }
+
+            return copy;
+        }
+
+        template<typename T, typename Data>
+        void IntervalTree<T, Data>::destroy(Node* node)
+        {
+            if (node == nullptr) return;
+
+            destroy(node->mLeft);
+            destroy(node->mRight);
+            delete node;
+        }
+
+        template<typename T, typename Data>
+        std::uint32_t IntervalTree<T, Data>::nextPriority()
+        {
+            mSeed ^= mSeed << 13;
+            mSeed ^= mSeed >> 17;
+            mSeed ^= mSeed << 5;
+            return mSeed;
+        }
+    }
+}
+
+#endif
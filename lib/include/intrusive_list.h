@@ -0,0 +1,327 @@
+#ifndef H_UTILS_STORAGE_INTRUSIVE_LIST_H
+#define H_UTILS_STORAGE_INTRUSIVE_LIST_H
+
+
+//  includes
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+
+//  define UTILS_INTRUSIVE_SAFE_MODE to have every hook remember the container it is linked into
+//  and assert when an object is pushed into a second container or erased from the wrong one
+//  it changes the hook's layout, so define it alike in every translation unit sharing a hook type
+#ifdef UTILS_INTRUSIVE_SAFE_MODE
+#define UTILS_INTRUSIVE_ASSERT(expr) assert(expr)
+#else
+#define UTILS_INTRUSIVE_ASSERT(expr) ((void)0)
+#endif
+
+namespace utils {
+    namespace storage {
+
+        //  IntrusiveHook
+        //  embedded in the user type, either as a base class or as a member,
+        //  the Tag lets one type derive from several hooks to sit in several containers at once
+        template <typename Tag = void>
+        struct IntrusiveHook {
+            IntrusiveHook() = default;
+
+            //  copying an object never copies its container membership
+            IntrusiveHook(const IntrusiveHook&) {}
+            IntrusiveHook& operator=(const IntrusiveHook&) { return *this; }
+
+            bool isLinked() const { return mPrev != nullptr; }
+
+            IntrusiveHook* mNext = nullptr;
+            IntrusiveHook* mPrev = nullptr;
+#ifdef UTILS_INTRUSIVE_SAFE_MODE
+            const void* mOwner = nullptr;
+#endif
+        };
+
+        //  BaseHook
+        //  T derives from IntrusiveHook<Tag>
+        template <typename T, typename Tag = void>
+        struct BaseHook {
+            typedef IntrusiveHook<Tag> Hook;
+
+            static Hook* toHook(T& t) { return static_cast<Hook*>(&t); }
+            static T& fromHook(Hook* hook) { return *static_cast<T*>(hook); }
+        };
+
+        //  MemberHook
+        //  T holds an IntrusiveHook<Tag> as the data member Member
+        template <typename T, typename Tag, IntrusiveHook<Tag> T::*Member>
+        struct MemberHook {
+            typedef IntrusiveHook<Tag> Hook;
+
+            static Hook* toHook(T& t)
+            {
+                offsetIn(&t);
+                return &(t.*Member);
+            }
+
+            //  step back from the member to the start of the owning object, every hook handed back
+            //  was linked through toHook first, so the offset has been measured by then
+            static T& fromHook(Hook* hook) { return *reinterpret_cast<T*>(reinterpret_cast<char*>(hook) - offsetIn(nullptr)); }
+
+        private:
+            //  the member's offset, measured once on the first real object, the same for every T
+            static std::ptrdiff_t offsetIn(const T* t)
+            {
+                static const std::ptrdiff_t offset = reinterpret_cast<const char*>(&(t->*Member)) - reinterpret_cast<const char*>(t);
+                return offset;
+            }
+        };
+
+        //  IntrusiveList
+        //  links objects the caller already owns through their hooks,
+        //  never allocates or copies, every push/pop/erase is O(1)
+        //  the container does not own its elements, destroying it only unlinks them
+        template <typename T, typename Access = BaseHook<T>>
+        class IntrusiveList {
+
+            typedef typename Access::Hook Hook;
+
+            //  Iterator
+            template <typename Value>
+            class Iterator {
+                friend class IntrusiveList<T, Access>;
+
+            public:
+                typedef std::bidirectional_iterator_tag iterator_category;
+                typedef T value_type;
+                typedef std::ptrdiff_t difference_type;
+                typedef Value* pointer;
+                typedef Value& reference;
+
+                Iterator() = default;
+
+                reference operator*() const { return Access::fromHook(mHook); }
+                pointer operator->() const { return &Access::fromHook(mHook); }
+
+                Iterator& operator++() { mHook = mHook->mNext; return *this; }
+                Iterator operator++(int) { Iterator copy(*this); mHook = mHook->mNext; return copy; }
+                Iterator& operator--() { mHook = mHook->mPrev; return *this; }
+                Iterator operator--(int) { Iterator copy(*this); mHook = mHook->mPrev; return copy; }
+
+                bool operator==(const Iterator& rhs) const { return mHook == rhs.mHook; }
+                bool operator!=(const Iterator& rhs) const { return mHook != rhs.mHook; }
+
+            private:
+                explicit Iterator(Hook* hook) : mHook(hook) {}
+
+                Hook* mHook = nullptr;
+            };
+
+        public:
+            typedef Iterator<T> iterator;
+            typedef Iterator<const T> const_iterator;
+
+        public:
+            IntrusiveList();
+            IntrusiveList(const IntrusiveList& rhs) = delete;
+            IntrusiveList(IntrusiveList&& rhs) noexcept;
+            ~IntrusiveList();
+
+            IntrusiveList& operator=(const IntrusiveList& rhs) = delete;
+            IntrusiveList& operator=(IntrusiveList&& rhs) noexcept;
+
+            void push_front(T& t);
+            void push_back(T& t);
+            void pop_front();
+            void pop_back();
+
+            void insert(iterator pos, T& t);
+            iterator erase(T& t);
+            void clear();
+
+            T& front() { return Access::fromHook(mRoot.mNext); }
+            const T& front() const { return Access::fromHook(mRoot.mNext); }
+            T& back() { return Access::fromHook(mRoot.mPrev); }
+            const T& back() const { return Access::fromHook(mRoot.mPrev); }
+
+            iterator begin() { return iterator(mRoot.mNext); }
+            const_iterator begin() const { return const_iterator(mRoot.mNext); }
+            iterator end() { return iterator(&mRoot); }
+            const_iterator end() const { return const_iterator(const_cast<Hook*>(&mRoot)); }
+
+            //  iterator to an element already linked into this list
+            iterator iteratorTo(T& t) { return iterator(Access::toHook(t)); }
+
+            bool empty() const { return mRoot.mNext == &mRoot; }
+            std::size_t getSize() const { return mSize; }
+
+        private:
+            void link(Hook* before, Hook* hook);
+            void unlink(Hook* hook);
+            void takeOver(IntrusiveList& rhs);
+
+        private:
+            //  sentinel, the list is circular through it so no operation needs a null check
+            Hook mRoot;
+            std::size_t mSize = 0;
+        };
+
+        template <typename T, typename Access>
+        IntrusiveList<T, Access>::IntrusiveList()
+        {
+            mRoot.mNext = &mRoot;
+            mRoot.mPrev = &mRoot;
+        }
+
+        template <typename T, typename Access>
+        IntrusiveList<T, Access>::IntrusiveList(IntrusiveList<T, Access>&& rhs) noexcept
+        {
+            mRoot.mNext = &mRoot;
+            mRoot.mPrev = &mRoot;
+            takeOver(rhs);
+        }
+
+        template <typename T, typename Access>
+        IntrusiveList<T, Access>::~IntrusiveList()
+        {
+            clear();
+        }
+
+        template <typename T, typename Access>
+        IntrusiveList<T, Access>& IntrusiveList<T, Access>::operator=(IntrusiveList<T, Access>&& rhs) noexcept
+        {
+            //  check for self move
+            if (this != &rhs) {
+                clear();
+                takeOver(rhs);
+            }
+
+            return *this;
+        }
+
+        template <typename T, typename Access>
+        void IntrusiveList<T, Access>::push_front(T& t)
+        {
+            link(mRoot.mNext, Access::toHook(t));
+        }
+
+        template <typename T, typename Access>
+        void IntrusiveList<T, Access>::push_back(T& t)
+        {
+            link(&mRoot, Access::toHook(t));
+        }
+
+        //  no op on an empty list
+        template <typename T, typename Access>
+        void IntrusiveList<T, Access>::pop_front()
+        {
+            if (empty()) return;
+
+            unlink(mRoot.mNext);
+        }
+
+        //  no op on an empty list
+        template <typename T, typename Access>
+        void IntrusiveList<T, Access>::pop_back()
+        {
+            if (empty()) return;
+
+            unlink(mRoot.mPrev);
+        }
+
+        //  links t in front of pos
+        template <typename T, typename Access>
+        void IntrusiveList<T, Access>::insert(iterator pos, T& t)
+        {
+            link(pos.mHook, Access::toHook(t));
+        }
+
+        //  unlinks t from this list in O(1), returns an iterator to the element that followed it
+        template <typename T, typename Access>
+        typename IntrusiveList<T, Access>::iterator IntrusiveList<T, Access>::erase(T& t)
+        {
+            Hook* hook = Access::toHook(t);
+            Hook* next = hook->mNext;
+            unlink(hook);
+            return iterator(next);
+        }
+
+        //  unlinks every element, the objects themselves are untouched
+        template <typename T, typename Access>
+        void IntrusiveList<T, Access>::clear()
+        {
+            Hook* hook = mRoot.mNext;
+            while (hook != &mRoot) {
+                Hook* next = hook->mNext;
+
+                hook->mNext = nullptr;
+                hook->mPrev = nullptr;
+#ifdef UTILS_INTRUSIVE_SAFE_MODE
+                hook->mOwner = nullptr;
+#endif
+
+                hook = next;
+            }
+
+            mRoot.mNext = &mRoot;
+            mRoot.mPrev = &mRoot;
+            mSize = 0;
+        }
+
+        //  links hook in front of before
+        template <typename T, typename Access>
+        void IntrusiveList<T, Access>::link(Hook* before, Hook* hook)
+        {
+            UTILS_INTRUSIVE_ASSERT(!hook->isLinked() && "object is already linked into a container");
+
+            hook->mNext = before;
+            hook->mPrev = before->mPrev;
+            before->mPrev->mNext = hook;
+            before->mPrev = hook;
+#ifdef UTILS_INTRUSIVE_SAFE_MODE
+            hook->mOwner = this;
+#endif
+
+            ++mSize;
+        }
+
+        template <typename T, typename Access>
+        void IntrusiveList<T, Access>::unlink(Hook* hook)
+        {
+            UTILS_INTRUSIVE_ASSERT(hook->mOwner == this && "object is not linked into this container");
+
+            hook->mPrev->mNext = hook->mNext;
+            hook->mNext->mPrev = hook->mPrev;
+
+            hook->mNext = nullptr;
+            hook->mPrev = nullptr;
+#ifdef UTILS_INTRUSIVE_SAFE_MODE
+            hook->mOwner = nullptr;
+#endif
+
+            --mSize;
+        }
+
+        //  moves every element of rhs into this (empty) list, the sentinel cannot move so the ends are relinked
+        template <typename T, typename Access>
+        void IntrusiveList<T, Access>::takeOver(IntrusiveList<T, Access>& rhs)
+        {
+            if (rhs.empty()) return;
+
+            mRoot.mNext = rhs.mRoot.mNext;
+            mRoot.mPrev = rhs.mRoot.mPrev;
+            mRoot.mNext->mPrev = &mRoot;
+            mRoot.mPrev->mNext = &mRoot;
+            mSize = rhs.mSize;
+
+#ifdef UTILS_INTRUSIVE_SAFE_MODE
+            for (Hook* hook = mRoot.mNext; hook != &mRoot; hook = hook->mNext) {
+                hook->mOwner = this;
+            }
+#endif
+
+            rhs.mRoot.mNext = &rhs.mRoot;
+            rhs.mRoot.mPrev = &rhs.mRoot;
+            rhs.mSize = 0;
+        }
+    }
+}
+
+#endif
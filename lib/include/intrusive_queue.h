@@ -0,0 +1,82 @@
+#ifndef H_UTILS_STORAGE_INTRUSIVE_QUEUE_H
+#define H_UTILS_STORAGE_INTRUSIVE_QUEUE_H
+
+//  includes
+#include <stdexcept>
+#include "intrusive_list.h"
+
+namespace utils {
+    namespace storage {
+
+        //  IntrusiveQueue
+        //  the Queue interface over objects that carry an IntrusiveHook,
+        //  pushing links the caller's object instead of copying it into a new node
+        template<typename T, typename Access = BaseHook<T>>
+        class IntrusiveQueue {
+
+        //  friends
+        friend void swap(IntrusiveQueue<T, Access>& lhs, IntrusiveQueue<T, Access>& rhs) noexcept
+        {
+            IntrusiveList<T, Access> temp(std::move(lhs.mList));
+            lhs.mList = std::move(rhs.mList);
+            rhs.mList = std::move(temp);
+        }
+
+        public:
+            IntrusiveQueue() = default;
+            IntrusiveQueue(const IntrusiveQueue<T, Access>& rhs) = delete;
+            IntrusiveQueue(IntrusiveQueue<T, Access>&& rhs) noexcept = default;
+            ~IntrusiveQueue() = default;
+
+            IntrusiveQueue<T, Access>& operator=(const IntrusiveQueue<T, Access>& rhs) = delete;
+            IntrusiveQueue<T, Access>& operator=(IntrusiveQueue<T, Access>&& rhs) noexcept = default;
+
+            T& front();
+            const T& front() const;
+            void pop_front() noexcept;
+
+            void push_front(T& data) { mList.push_front(data); }
+            void push_back(T& data) { mList.push_back(data); }
+
+            //  O(1) removal of an object from anywhere in the queue, e.g. a cancelled request
+            void unlink(T& data) { mList.erase(data); }
+
+            void clear() { mList.clear(); }
+
+            bool empty() const { return mList.empty(); }
+            std::size_t getSize() const { return mList.getSize(); }
+
+        private:
+            IntrusiveList<T, Access> mList;
+
+        };  //  IntrusiveQueue
+
+        template<typename T, typename Access>
+        T& IntrusiveQueue<T, Access>::front()
+        {
+            if (!mList.empty()) {
+                return mList.front();
+            } else {
+                throw std::logic_error("trying to get front of empty queue");
+            }
+        }
+
+        template<typename T, typename Access>
+        const T& IntrusiveQueue<T, Access>::front() const
+        {
+            if (!mList.empty()) {
+                return mList.front();
+            } else {
+                throw std::logic_error("trying to get front of empty queue");
+            }
+        }
+
+        template<typename T, typename Access>
+        void IntrusiveQueue<T, Access>::pop_front() noexcept
+        {
+            mList.pop_front();
+        }
+    }  //  storage
+}  //  utils
+
+#endif
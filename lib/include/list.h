@@ -3,34 +3,98 @@
 
 
 //  includes
+#include <cstddef>
+#include <functional>
 #include <initializer_list>
+#include <iterator>
+#include <type_traits>
 #include <utility>
+#include "container_stats.h"
 
 namespace utils {
     namespace storage {
 
 
-        template <typename T>
-        class List {
+        template <typename T, typename Stats = NoStats>
+        class List : private Stats {
 
-            friend void swap(List<T>& lhs, List<T>& rhs) noexcept
+            friend void swap(List<T, Stats>& lhs, List<T, Stats>& rhs) noexcept
             {
-                Node* tempHead(lhs.mHead);
-                lhs.mHead = rhs.mHead;
-                rhs.mHead = tempHead;
+                Node* tempHead(lhs.mHead.mNext);
+                lhs.mHead.mNext = rhs.mHead.mNext;
+                rhs.mHead.mNext = tempHead;
+
+                Node* tempTail(lhs.mTail);
+                lhs.mTail = rhs.mTail;
+                rhs.mTail = tempTail;
 
                 std::size_t tempSize(lhs.mSize);
                 lhs.mSize = rhs.mSize;
                 rhs.mSize = tempSize;
+
+                //  the statistics follow the elements
+                using std::swap;
+                swap(static_cast<Stats&>(lhs), static_cast<Stats&>(rhs));
             }
 
         private:
+            struct Node;
+
+            //  Link
+            //  the part of a node that chains the list together,
+            //  the list owns one as its head so before_begin() needs no allocation
+            struct Link {
+                Node* mNext = nullptr;
+            };
+
             //  Node
-            struct Node {
+            struct Node : Link {
+                template<typename ...Args>
+                explicit Node(Args&&... args) : mData(std::forward<Args>(args)...) {}
+
                 T mData;
-                Node* mNext = nullptr;
             };
 
+            //  Iterator
+            //  forward iterator over the list, stays valid until the element it refers to is erased
+            template <typename Value>
+            class Iterator {
+                friend class List<T, Stats>;
+
+            public:
+                typedef std::forward_iterator_tag iterator_category;
+                typedef T value_type;
+                typedef std::ptrdiff_t difference_type;
+                typedef Value* pointer;
+                typedef Value& reference;
+
+                Iterator() = default;
+
+                //  allow iterator -> const_iterator but not the other way round
+                template <typename Other, typename = typename std::enable_if<std::is_same<const Other, Value>::value>::type>
+                Iterator(const Iterator<Other>& rhs) : mLink(rhs.mLink) {}
+
+                reference operator*() const { return static_cast<Node*>(mLink)->mData; }
+                pointer operator->() const { return &static_cast<Node*>(mLink)->mData; }
+
+                Iterator& operator++() { mLink = mLink->mNext; return *this; }
+                Iterator operator++(int) { Iterator copy(*this); mLink = mLink->mNext; return copy; }
+
+                bool operator==(const Iterator& rhs) const { return mLink == rhs.mLink; }
+                bool operator!=(const Iterator& rhs) const { return mLink != rhs.mLink; }
+
+            private:
+                template <typename Other> friend class Iterator;
+
+                explicit Iterator(Link* link) : mLink(link) {}
+
+                Link* mLink = nullptr;
+            };
+
+        public:
+            typedef Iterator<T> iterator;
+            typedef Iterator<const T> const_iterator;
+
         public:
             List() = default;
             explicit List(const std::size_t size, const T& defaultVal = T{});
@@ -48,112 +112,120 @@ namespace utils {
             void insert(const T& t);
             void insert(T&& t);
 
+            template<typename ...Args>
+            iterator emplace_after(const_iterator pos, Args&&... args);
+            iterator insert_after(const_iterator pos, const T& t);
+            iterator insert_after(const_iterator pos, T&& t);
+
             void remove(const T& t);
+            template<typename Predicate>
+            std::size_t remove_if(Predicate pred);
+
+            iterator erase_after(const_iterator pos);
+            iterator erase_after(const_iterator first, const_iterator last);
+
+            void splice_after(const_iterator pos, List& other);
+            void splice_after(const_iterator pos, List& other, const_iterator first, const_iterator last);
+
+            template<typename Compare = std::less<T>>
+            void sort(Compare comp = Compare());
+            template<typename Compare = std::less<T>>
+            void merge(List& other, Compare comp = Compare());
+            template<typename BinaryPredicate = std::equal_to<T>>
+            std::size_t unique(BinaryPredicate pred = BinaryPredicate());
+
             void clear();
 
+            T& front() { return mHead.mNext->mData; }
+            const T& front() const { return mHead.mNext->mData; }
+            T& back() { return mTail->mData; }
+            const T& back() const { return mTail->mData; }
+
+            iterator before_begin() { return iterator(&mHead); }
+            const_iterator before_begin() const { return const_iterator(const_cast<Link*>(&mHead)); }
+            iterator begin() { return iterator(mHead.mNext); }
+            const_iterator begin() const { return const_iterator(mHead.mNext); }
+            iterator end() { return iterator(nullptr); }
+            const_iterator end() const { return const_iterator(nullptr); }
+            const_iterator cbegin() const { return begin(); }
+            const_iterator cend() const { return end(); }
+
+            bool empty() const { return mSize == 0; }
             std::size_t getSize() const { return mSize; }
 
+            //  counts kept by the Stats policy, all zero under NoStats
+            ContainerStats stats() const { return Stats::snapshot(); }
+            //  the elements as payload, the object and node links as overhead
+            MemoryUsage memory_usage() const;
+
         private:
             void internalInsert(Node* node);
+            Link* internalInsertAfter(Link* pos, Node* node);
+            Link* internalEraseAfter(Link* pos);
+
+            template<typename Compare>
+            static Node* mergeChains(Node* left, Node* right, Compare& comp, Node*& tail);
 
         private:
-            Node* mHead = nullptr;
+            Link mHead;
+            Node* mTail = nullptr;
             std::size_t mSize = 0;
         };
 
         //  custom constructor - create a list of N size
-        template <typename T>
-        List<T>::List(const std::size_t size, const T& defaultVal)
+        template <typename T, typename Stats>
+        List<T, Stats>::List(const std::size_t size, const T& defaultVal)
         {
-            //  empty list?
-            if (size == 0) return;
-
-            //  create head
-            mHead = new Node{ defaultVal, nullptr };
-
-            //  create a temporary pointer to the head of the list
-            Node* node = mHead;
-            for (int i = 0; i < size - 1; ++i) {
-                //  this is a valid node
-                //  create a new node
-                //  link it to the list
-                node->mNext = new Node{ defaultVal, nullptr };
-
-                //  iterate to the next node
-                node = node->mNext;
+            try {
+                for (std::size_t i = 0; i < size; ++i) {
+                    internalInsert(new Node(defaultVal));
+                }
+            } catch (...) {
+                //  a copy threw, release what has been built so far
+                clear();
+                throw;
             }
-
-            mSize = size;
         }
 
         //  custom constructor - create a list populated with data
-        template <typename T>
-        List<T>::List(const std::initializer_list<T>& il)
+        template <typename T, typename Stats>
+        List<T, Stats>::List(const std::initializer_list<T>& il)
         {
-            //  empty list?
-            if (il.size() == 0) return;
-
-            //  get first element in list and make the head node
-            auto it = il.begin();
-            mHead = new Node{ (*it), nullptr };
-            ++it;
-
-            //  create a temporary pointer to the head of the list
-            Node* node = mHead;
-            for (; it != il.end(); ++it) {
-                //  this is a valid node
-                //  create a new node
-                //  link it to the list
-                node->mNext = new Node{ (*it), nullptr };
-
-                //  iterate to the next node
-                node = node->mNext;
+            try {
+                for (const T& t : il) {
+                    internalInsert(new Node(t));
+                }
+            } catch (...) {
+                //  a copy threw, release what has been built so far
+                clear();
+                throw;
             }
-
-            mSize = il.size();
         }
 
-        template <typename T>
-        List<T>::List(const List<T>& rhs)
+        template <typename T, typename Stats>
+        List<T, Stats>::List(const List<T, Stats>& rhs)
         {
-            Node* lhsNode = nullptr;
-            Node* rhsNode = rhs.mHead;
-
-            //  create the head node
-            if (rhsNode) {								
-                lhsNode = new Node{ rhsNode->mData, nullptr };
-                mHead = lhsNode;
-
-                //  iterate to next rhs node
-                rhsNode = rhsNode->mNext;
-            }
-
-            //  create rest of list
-            while (rhsNode && lhsNode) {
-
-                //  create a copy of the rhs node
-                //  link it to lhs list
-                lhsNode->mNext = new Node{ rhsNode->mData, nullptr };
-
-                //  iterate to next lhs node
-                lhsNode = lhsNode->mNext;
-
-                //  iterate to next rhs node
-                rhsNode = rhsNode->mNext;
+            try {
+                //  each copy is appended at the tail in O(1)
+                for (const Node* node = rhs.mHead.mNext; node; node = node->mNext) {
+                    internalInsert(new Node(node->mData));
+                }
+            } catch (...) {
+                //  a copy threw, release what has been built so far
+                clear();
+                throw;
             }
-
-            mSize = rhs.mSize;
         }
 
-        template <typename T>
-        List<T>::List(List<T>&& rhs) noexcept
+        template <typename T, typename Stats>
+        List<T, Stats>::List(List<T, Stats>&& rhs) noexcept
         {
             using std::swap;
             swap(*this, rhs);
         }
 
-        template <typename T>
-        List<T>::~List()
+        template <typename T, typename Stats>
+        List<T, Stats>::~List()
         {
             try {
                 clear();
@@ -163,14 +235,14 @@ namespace utils {
             }
         }
 
-        template <typename T>
-        List<T>& List<T>::operator=(const List<T>& rhs)
+        template <typename T, typename Stats>
+        List<T, Stats>& List<T, Stats>::operator=(const List<T, Stats>& rhs)
         {
             //  check for self assignment
             if (this != &rhs) {
 
                 //  make a copy of rhs
-                List<T> rhsCopy(rhs);
+                List<T, Stats> rhsCopy(rhs);
 
                 //  swap
                 using std::swap;
@@ -180,12 +252,12 @@ namespace utils {
             return *this;
         }
 
-        template <typename T>
-        List<T>& List<T>::operator=(List<T>&& rhs) noexcept
+        template <typename T, typename Stats>
+        List<T, Stats>& List<T, Stats>::operator=(List<T, Stats>&& rhs) noexcept
         {
             //  check for self move
             if (this != &rhs) {
-                
+
                 //  swap
                 using std::swap;
                 swap(*this, rhs);
@@ -194,64 +266,279 @@ namespace utils {
             return *this;
         }
 
-        template<typename T>
+        template<typename T, typename Stats>
         template<typename ...Args>
-        void List<T>::emplace(Args&&... args)
+        void List<T, Stats>::emplace(Args&&... args)
         {
-            //  forward to the relevant insert
-            internalInsert(new Node{ std::forward<Args>(args)... , nullptr });
+            //  forward to the relevant constructor
+            internalInsert(new Node(std::forward<Args>(args)...));
         }
 
-        template <typename T>
-        void List<T>::insert(const T& t)
+        template <typename T, typename Stats>
+        void List<T, Stats>::insert(const T& t)
         {
-            internalInsert(new Node{ t, nullptr });
+            internalInsert(new Node(t));
         }
 
-        template <typename T>
-        void List<T>::insert(T&& t)
+        template <typename T, typename Stats>
+        void List<T, Stats>::insert(T&& t)
         {
-            internalInsert(new Node{ std::move(t), nullptr });			
+            internalInsert(new Node(std::move(t)));
         }
 
-        template <typename T>
-        void List<T>::remove(const T& t)
+        template<typename T, typename Stats>
+        template<typename ...Args>
+        typename List<T, Stats>::iterator List<T, Stats>::emplace_after(const_iterator pos, Args&&... args)
         {
-            Node* node = mHead;
-            Node* prev = nullptr;
+            return iterator(internalInsertAfter(pos.mLink, new Node(std::forward<Args>(args)...)));
+        }
+
+        template <typename T, typename Stats>
+        typename List<T, Stats>::iterator List<T, Stats>::insert_after(const_iterator pos, const T& t)
+        {
+            return iterator(internalInsertAfter(pos.mLink, new Node(t)));
+        }
+
+        template <typename T, typename Stats>
+        typename List<T, Stats>::iterator List<T, Stats>::insert_after(const_iterator pos, T&& t)
+        {
+            return iterator(internalInsertAfter(pos.mLink, new Node(std::move(t))));
+        }
+
+        //  removes the first element equal to t
+        template <typename T, typename Stats>
+        void List<T, Stats>::remove(const T& t)
+        {
+            Link* prev = &mHead;
+            std::size_t visited = 0;
+
+            while (prev->mNext) {
+                ++visited;
 
-            while (node) {
                 //  found?
-                if (node->mData == t) {
-                    if (prev) {
-                        //  unlink from list, delete and decrease size of list
-                        Node* next = node->mNext;
-                        delete node;
-                        node = nullptr;
-                        prev->mNext = next;						
-                        --mSize;
-                    } else {
-                        //  remove head
-                        //  decrease size of list
-                        Node* newHead = node->mNext;
-                        delete node;
-                        node = nullptr;
-                        mHead = newHead;
-                        --mSize;
-                    }
+                if (prev->mNext->mData == t) {
+                    //  unlink from list, delete and decrease size of list
+                    internalEraseAfter(prev);
+                    break;
+                }
+
+                //  data not found
+                //  iterate to next node
+                prev = prev->mNext;
+            }
+
+            this->onWalk(visited);
+        }
+
+        //  removes every element pred returns true for in a single pass
+        //  returns the number of elements removed
+        template <typename T, typename Stats>
+        template <typename Predicate>
+        std::size_t List<T, Stats>::remove_if(Predicate pred)
+        {
+            std::size_t removed = 0;
+            std::size_t visited = 0;
+            Link* prev = &mHead;
+
+            while (prev->mNext) {
+                ++visited;
+                if (pred(prev->mNext->mData)) {
+                    //  unlink, prev now points at the following node
+                    internalEraseAfter(prev);
+                    ++removed;
+                } else {
+                    prev = prev->mNext;
+                }
+            }
+
+            this->onWalk(visited);
+            return removed;
+        }
+
+        //  erases the element following pos in O(1)
+        //  returns an iterator to the element after the erased one
+        template <typename T, typename Stats>
+        typename List<T, Stats>::iterator List<T, Stats>::erase_after(const_iterator pos)
+        {
+            return iterator(internalEraseAfter(pos.mLink)->mNext);
+        }
+
+        //  erases the elements in the open range (first, last)
+        template <typename T, typename Stats>
+        typename List<T, Stats>::iterator List<T, Stats>::erase_after(const_iterator first, const_iterator last)
+        {
+            while (first.mLink->mNext != last.mLink) {
+                internalEraseAfter(first.mLink);
+            }
+
+            return iterator(last.mLink);
+        }
+
+        //  moves every element of other after pos, no allocation and O(1)
+        template <typename T, typename Stats>
+        void List<T, Stats>::splice_after(const_iterator pos, List<T, Stats>& other)
+        {
+            if (this == &other || other.mHead.mNext == nullptr) return;
+
+            Link* link = pos.mLink;
+
+            //  stitch other's chain between pos and its successor
+            other.mTail->mNext = link->mNext;
+            link->mNext = other.mHead.mNext;
+
+            if (mTail == nullptr || link == mTail) {
+                //  spliced onto the end of this list
+                mTail = other.mTail;
+            }
+
+            mSize += other.mSize;
+
+            other.mHead.mNext = nullptr;
+            other.mTail = nullptr;
+            other.mSize = 0;
+        }
+
+        //  moves the elements in the open range (first, last) of other after pos,
+        //  no allocation, linear only in the length of the range
+        template <typename T, typename Stats>
+        void List<T, Stats>::splice_after(const_iterator pos, List<T, Stats>& other, const_iterator first, const_iterator last)
+        {
+            Link* before = first.mLink;
+            if (before->mNext == last.mLink || pos.mLink == before) return;
+
+            //  find the last node of the range and count it
+            Node* rangeFirst = before->mNext;
+            Node* rangeLast = rangeFirst;
+            std::size_t count = 1;
+            while (rangeLast->mNext != last.mLink) {
+                rangeLast = rangeLast->mNext;
+                ++count;
+            }
+
+            //  unlink from other
+            before->mNext = static_cast<Node*>(last.mLink);
+            if (other.mTail == rangeLast) {
+                other.mTail = (before == &other.mHead) ? nullptr : static_cast<Node*>(before);
+            }
+
+            other.mSize -= count;
+
+            //  link into this list after pos
+            Link* link = pos.mLink;
+            rangeLast->mNext = link->mNext;
+            link->mNext = rangeFirst;
+
+            if (mTail == nullptr || link == mTail) {
+                mTail = rangeLast;
+            }
+
+            mSize += count;
+        }
+
+        //  stable bottom-up merge sort
+        //  nodes are taken off the front one at a time and carried up a fixed set of bins,
+        //  bin i holding a sorted run of 2^i nodes, so runs are merged while still hot in cache
+        //  only mNext pointers are relinked so no node is allocated, copied or moved
+        //  O(n log n) compares, non-recursive, with O(1) extra memory (one pointer per bin)
+        template <typename T, typename Stats>
+        template <typename Compare>
+        void List<T, Stats>::sort(Compare comp)
+        {
+            if (mSize < 2) return;
+
+            enum { BIN_COUNT = 64 };
+            Node* bins[BIN_COUNT] = {};
+            Node* tail = nullptr;
+
+            Node* node = mHead.mNext;
+            while (node) {
+                //  detach the next node as a run of one
+                Node* carry = node;
+                node = node->mNext;
+                carry->mNext = nullptr;
+
+                //  bins hold earlier elements so they go on the left to keep the sort stable
+                std::size_t i = 0;
+                for (; i < BIN_COUNT - 1 && bins[i]; ++i) {
+                    carry = mergeChains(bins[i], carry, comp, tail);
+                    bins[i] = nullptr;
+                }
+
+                if (bins[i]) {
+                    carry = mergeChains(bins[i], carry, comp, tail);
+                }
+
+                bins[i] = carry;
+            }
+
+            //  fold the remaining runs together, higher bins hold the earlier elements
+            Node* result = nullptr;
+            for (std::size_t i = 0; i < BIN_COUNT; ++i) {
+                if (bins[i]) {
+                    result = result ? mergeChains(bins[i], result, comp, tail) : bins[i];
+                }
+            }
+
+            mHead.mNext = result;
+
+            //  the final merge leaves tail on the last node, but a single run may not have been merged
+            while (tail->mNext) {
+                tail = tail->mNext;
+            }
+
+            mTail = tail;
+        }
+
+        //  merges the sorted other into this sorted list by relinking, other is left empty
+        //  elements from this list come before equal elements from other
+        template <typename T, typename Stats>
+        template <typename Compare>
+        void List<T, Stats>::merge(List<T, Stats>& other, Compare comp)
+        {
+            if (this == &other || other.mHead.mNext == nullptr) return;
+
+            Node* tail = nullptr;
+            mHead.mNext = mergeChains(mHead.mNext, other.mHead.mNext, comp, tail);
+
+            //  other's last element ends up last unless it sorts strictly before ours
+            if (mTail == nullptr || !comp(other.mTail->mData, mTail->mData)) {
+                mTail = other.mTail;
+            }
+
+            mSize += other.mSize;
+
+            other.mHead.mNext = nullptr;
+            other.mTail = nullptr;
+            other.mSize = 0;
+        }
+
+        //  removes every element that compares equal to the one before it
+        //  returns the number of elements removed
+        template <typename T, typename Stats>
+        template <typename BinaryPredicate>
+        std::size_t List<T, Stats>::unique(BinaryPredicate pred)
+        {
+            std::size_t removed = 0;
+            Node* node = mHead.mNext;
+
+            while (node && node->mNext) {
+                if (pred(node->mData, node->mNext->mData)) {
+                    //  duplicate of node, unlink it and compare again
+                    internalEraseAfter(node);
+                    ++removed;
                 } else {
-                    //  data not found
-                    //  iterate to next node
-                    prev = node;
                     node = node->mNext;
                 }
             }
+
+            return removed;
         }
 
-        template<typename T>
-        void List<T>::clear()
+        template<typename T, typename Stats>
+        void List<T, Stats>::clear()
         {
-            Node* node = mHead;
+            Node* node = mHead.mNext;
+            const std::size_t freed = mSize;
             while (node) {
                 //  store the pointer to the next node
                 Node* next = node->mNext;
@@ -268,31 +555,106 @@ namespace utils {
                 node = next;
             }
 
-            mHead = nullptr;
+            mHead.mNext = nullptr;
+            mTail = nullptr;
             mSize = 0;
+            this->onFree(freed);
         }
 
-        template <typename T>
-        void List<T>::internalInsert(Node* node)
+        template <typename T, typename Stats>
+        MemoryUsage List<T, Stats>::memory_usage() const
         {
-            Node* tail = mHead;
-
-            //  find the tail of the list
-            while (tail && tail->mNext) {
-                tail = tail->mNext;
-            }
+            MemoryUsage usage;
+            usage.mPayload = mSize * sizeof(T);
+            usage.mOverhead = sizeof(*this) + mSize * (sizeof(Node) - sizeof(T));
+            return usage;
+        }
 
-            if (tail) {
+        //  appends to the tail in O(1), the tail is kept so there is no walk to count
+        //  every node handed in has just been allocated
+        template <typename T, typename Stats>
+        void List<T, Stats>::internalInsert(Node* node)
+        {
+            if (mTail) {
                 //  list has a tail
                 //  append this node to the end of the list
-                tail->mNext = node;
+                mTail->mNext = node;
             } else {
                 //  empty list
                 //  append to head
-                mHead = node;
+                mHead.mNext = node;
             }
 
+            mTail = node;
             ++mSize;
+            this->onAllocate(1);
+        }
+
+        //  merges two sorted null terminated chains, ties are taken from left
+        //  returns the new head and sets tail to the last node linked before one chain ran out
+        template <typename T, typename Stats>
+        template <typename Compare>
+        typename List<T, Stats>::Node* List<T, Stats>::mergeChains(Node* left, Node* right, Compare& comp, Node*& tail)
+        {
+            Link head;
+            Link* last = &head;
+
+            while (left && right) {
+                if (comp(right->mData, left->mData)) {
+                    last->mNext = right;
+                    right = right->mNext;
+                } else {
+                    last->mNext = left;
+                    left = left->mNext;
+                }
+
+                last = last->mNext;
+            }
+
+            //  append whichever chain is left over, tail is only set once a node was linked,
+            //  with an empty side last is still the head on the stack
+            last->mNext = left ? left : right;
+            if (last != &head) {
+                tail = static_cast<Node*>(last);
+            }
+
+            return head.mNext;
+        }
+
+        template <typename T, typename Stats>
+        typename List<T, Stats>::Link* List<T, Stats>::internalInsertAfter(Link* pos, Node* node)
+        {
+            node->mNext = pos->mNext;
+            pos->mNext = node;
+
+            //  inserted after the last node
+            if (node->mNext == nullptr) {
+                mTail = node;
+            }
+
+            ++mSize;
+            this->onAllocate(1);
+
+            return node;
+        }
+
+        //  unlinks and deletes the node after pos, returns pos
+        template <typename T, typename Stats>
+        typename List<T, Stats>::Link* List<T, Stats>::internalEraseAfter(Link* pos)
+        {
+            Node* node = pos->mNext;
+            pos->mNext = node->mNext;
+
+            //  erased the last node, pos becomes the tail
+            if (mTail == node) {
+                mTail = (pos == &mHead) ? nullptr : static_cast<Node*>(pos);
+            }
+
+            --mSize;
+            delete node;
+            this->onFree(1);
+
+            return pos;
         }
     }
 }
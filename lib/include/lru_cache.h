@@ -0,0 +1,437 @@
+#ifndef H_UTILS_STORAGE_LRU_CACHE_H
+#define H_UTILS_STORAGE_LRU_CACHE_H
+
+//  includes
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include "intrusive_list.h"
+
+namespace utils {
+    namespace storage {
+
+        enum E_EVICTION_POLICY
+        {
+            //  every hit moves the entry to the most recently used end
+            LRU_EP,
+            //  second chance, a hit only sets a reference bit and eviction skips referenced entries once
+            CLOCK_EP
+        };
+
+        //  EntryWeigher
+        //  capacity counted in entries, supply a functor returning bytes to bound memory instead
+        struct EntryWeigher {
+            template<typename Key, typename Data>
+            std::size_t operator()(const Key&, const Data&) const { return 1; }
+        };
+
+        //  LruCache
+        //  bounded key/value cache, a hash index finds entries and an intrusive recency list
+        //  threaded through the index's own nodes orders them, so get/put/evict are O(1)
+        //  with a single allocation per entry
+        //  not thread safe, see ShardedLruCache
+        template<typename Key, typename Data, E_EVICTION_POLICY Policy = LRU_EP, typename Weigher = EntryWeigher, typename Hash = std::hash<Key>>
+        class LruCache {
+
+        public:
+            enum E_INSERT_RESULT
+            {
+                OVERWRITE_SAME_VALUE_IR,
+                OVERWRITE_DIFFERENT_VALUE_IR,
+                NEW_INSERT_IR
+            };
+
+            //  first is false when the entry alone outweighs the capacity and was not stored
+            typedef std::pair<bool, E_INSERT_RESULT> INSERT_RESULT;
+
+        private:
+            struct Entry : IntrusiveHook<> {
+                explicit Entry(const Data& data) : mData(data) {}
+                explicit Entry(Data&& data) : mData(std::move(data)) {}
+
+                Data mData;
+                //  points into the index node that owns this entry, node based maps never move it
+                const Key* mKey = nullptr;
+                std::size_t mWeight = 0;
+                bool mReferenced = false;
+            };
+
+            typedef std::unordered_map<Key, Entry, Hash> Index;
+            //  least recently used at the front
+            typedef IntrusiveList<Entry> Recency;
+
+        public:
+            explicit LruCache(const std::size_t capacity, const Weigher& weigher = Weigher());
+            LruCache(const LruCache& rhs) = delete;
+            LruCache& operator=(const LruCache& rhs) = delete;
+
+            //  returns null on a miss, the pointer is valid until the entry is evicted or erased
+            Data* find(const Key& k);
+            bool get(const Key& k, Data& d);
+
+            INSERT_RESULT put(const Key& k, const Data& d) { return internalPut(k, d); }
+            INSERT_RESULT put(const Key& k, Data&& d) { return internalPut(k, std::move(d)); }
+
+            bool erase(const Key& k);
+            void clear();
+
+            //  does not count as a use
+            bool contains(const Key& k) const { return mIndex.find(k) != mIndex.end(); }
+
+            std::size_t getSize() const { return mIndex.size(); }
+            std::size_t getWeight() const { return mWeight; }
+            std::size_t getCapacity() const { return mCapacity; }
+            std::uint64_t getHits() const { return mHits; }
+            std::uint64_t getMisses() const { return mMisses; }
+            bool empty() const { return mIndex.empty(); }
+
+        private:
+            template<typename Value>
+            INSERT_RESULT internalPut(const Key& k, Value&& d);
+            void touch(Entry& entry);
+            void evictUntil(const std::size_t capacity);
+            void remove(typename Index::iterator it);
+
+        private:
+            Index mIndex;
+            Recency mRecency;
+            Weigher mWeigher;
+            std::size_t mCapacity;
+            std::size_t mWeight = 0;
+            std::uint64_t mHits = 0;
+            std::uint64_t mMisses = 0;
+        };
+
+        //  ShardedLruCache
+        //  thread safe cache made of independently locked LruCache shards picked by key hash,
+        //  the capacity is split evenly between the shards
+        //  values are copied out since another thread may evict them at any time
+        template<typename Key, typename Data, E_EVICTION_POLICY Policy = LRU_EP, typename Weigher = EntryWeigher, typename Hash = std::hash<Key>>
+        class ShardedLruCache {
+
+            typedef LruCache<Key, Data, Policy, Weigher, Hash> Cache;
+
+            //  one lock per shard, padded so shards do not share a cache line
+            struct alignas(64) Shard {
+                Shard(const std::size_t capacity, const Weigher& weigher) : mCache(capacity, weigher) {}
+
+                std::mutex mMutex;
+                Cache mCache;
+            };
+
+        public:
+            typedef typename Cache::INSERT_RESULT INSERT_RESULT;
+
+            //  shardCount is rounded up to a power of two, zero picks one per hardware thread, then
+            //  halved while it is above capacity so no shard is left with nothing to hold
+            explicit ShardedLruCache(const std::size_t capacity, std::size_t shardCount = 0, const Weigher& weigher = Weigher(), const Hash& hash = Hash());
+            ~ShardedLruCache();
+            ShardedLruCache(const ShardedLruCache& rhs) = delete;
+            ShardedLruCache& operator=(const ShardedLruCache& rhs) = delete;
+
+            bool get(const Key& k, Data& d);
+            INSERT_RESULT put(const Key& k, const Data& d);
+            bool erase(const Key& k);
+            bool contains(const Key& k);
+            void clear();
+
+            //  sums over the shards, each one locked in turn so the totals are not a snapshot
+            std::size_t getSize();
+            std::uint64_t getHits();
+            std::uint64_t getMisses();
+            std::size_t getShardCount() const { return mShardCount; }
+
+        private:
+            Shard& shardFor(const Key& k);
+
+        private:
+            void* mRaw = nullptr;
+            Shard* mShards = nullptr;
+            std::size_t mShardCount = 1;
+            unsigned mShardBits = 0;
+            Hash mHash;
+        };
+
+        template<typename Key, typename Data, E_EVICTION_POLICY Policy, typename Weigher, typename Hash>
+        LruCache<Key, Data, Policy, Weigher, Hash>::LruCache(const std::size_t capacity, const Weigher& weigher) :
+            mWeigher(weigher),
+            mCapacity(capacity)
+        {
+        }
+
+        template<typename Key, typename Data, E_EVICTION_POLICY Policy, typename Weigher, typename Hash>
+        Data* LruCache<Key, Data, Policy, Weigher, Hash>::find(const Key& k)
+        {
+            typename Index::iterator it = mIndex.find(k);
+            if (it == mIndex.end()) {
+                ++mMisses;
+                return nullptr;
+            }
+
+            ++mHits;
+            touch(it->second);
+            return &it->second.mData;
+        }
+
+        template<typename Key, typename Data, E_EVICTION_POLICY Policy, typename Weigher, typename Hash>
+        bool LruCache<Key, Data, Policy, Weigher, Hash>::get(const Key& k, Data& d)
+        {
+            Data* found = find(k);
+            if (found == nullptr) return false;
+
+            d = *found;
+            return true;
+        }
+
+        template<typename Key, typename Data, E_EVICTION_POLICY Policy, typename Weigher, typename Hash>
+        template<typename Value>
+        typename LruCache<Key, Data, Policy, Weigher, Hash>::INSERT_RESULT LruCache<Key, Data, Policy, Weigher, Hash>::internalPut(const Key& k, Value&& d)
+        {
+            const std::size_t weight = mWeigher(k, d);
+            typename Index::iterator it = mIndex.find(k);
+
+            if (weight > mCapacity) {
+                //  would flush the whole cache and still not fit, drop any stale value too
+                if (it != mIndex.end()) {
+                    remove(it);
+                }
+
+                return INSERT_RESULT(false, NEW_INSERT_IR);
+            }
+
+            if (it != mIndex.end()) {
+                Entry& entry = it->second;
+                const E_INSERT_RESULT result = (entry.mData == d) ? OVERWRITE_SAME_VALUE_IR : OVERWRITE_DIFFERENT_VALUE_IR;
+
+                //  the new value may be heavier, make room with the entry unlinked so it cannot be the victim
+                mRecency.erase(entry);
+                mWeight -= entry.mWeight;
+                evictUntil(mCapacity - weight);
+
+                entry.mData = std::forward<Value>(d);
+                entry.mWeight = weight;
+                entry.mReferenced = false;
+                mRecency.push_back(entry);
+                mWeight += weight;
+
+                return INSERT_RESULT(true, result);
+            }
+
+            evictUntil(mCapacity - weight);
+
+            const typename Index::iterator inserted = mIndex.emplace(k, Entry(std::forward<Value>(d))).first;
+            Entry& entry = inserted->second;
+            entry.mKey = &inserted->first;
+            entry.mWeight = weight;
+            mRecency.push_back(entry);
+            mWeight += weight;
+
+            return INSERT_RESULT(true, NEW_INSERT_IR);
+        }
+
+        template<typename Key, typename Data, E_EVICTION_POLICY Policy, typename Weigher, typename Hash>
+        bool LruCache<Key, Data, Policy, Weigher, Hash>::erase(const Key& k)
+        {
+            typename Index::iterator it = mIndex.find(k);
+            if (it == mIndex.end()) return false;
+
+            remove(it);
+            return true;
+        }
+
+        template<typename Key, typename Data, E_EVICTION_POLICY Policy, typename Weigher, typename Hash>
+        void LruCache<Key, Data, Policy, Weigher, Hash>::clear()
+        {
+            mRecency.clear();
+            mIndex.clear();
+            mWeight = 0;
+        }
+
+        template<typename Key, typename Data, E_EVICTION_POLICY Policy, typename Weigher, typename Hash>
+        void LruCache<Key, Data, Policy, Weigher, Hash>::touch(Entry& entry)
+        {
+            if (Policy == CLOCK_EP) {
+                entry.mReferenced = true;
+            } else {
+                mRecency.erase(entry);
+                mRecency.push_back(entry);
+            }
+        }
+
+        //  evicts from the cold end until the total weight is at most capacity
+        template<typename Key, typename Data, E_EVICTION_POLICY Policy, typename Weigher, typename Hash>
+        void LruCache<Key, Data, Policy, Weigher, Hash>::evictUntil(const std::size_t capacity)
+        {
+            while (mWeight > capacity && !mRecency.empty()) {
+                Entry& victim = mRecency.front();
+
+                if (Policy == CLOCK_EP && victim.mReferenced) {
+                    //  second chance, the hand moves past it and clears the bit
+                    victim.mReferenced = false;
+                    mRecency.pop_front();
+                    mRecency.push_back(victim);
+                    continue;
+                }
+
+                remove(mIndex.find(*victim.mKey));
+            }
+        }
+
+        template<typename Key, typename Data, E_EVICTION_POLICY Policy, typename Weigher, typename Hash>
+        void LruCache<Key, Data, Policy, Weigher, Hash>::remove(typename Index::iterator it)
+        {
+            Entry& entry = it->second;
+            if (entry.isLinked()) {
+                mRecency.erase(entry);
+            }
+
+            mWeight -= entry.mWeight;
+            mIndex.erase(it);
+        }
+
+        template<typename Key, typename Data, E_EVICTION_POLICY Policy, typename Weigher, typename Hash>
+        ShardedLruCache<Key, Data, Policy, Weigher, Hash>::ShardedLruCache(const std::size_t capacity, std::size_t shardCount, const Weigher& weigher, const Hash& hash) :
+            mHash(hash)
+        {
+            if (shardCount == 0) {
+                shardCount = std::thread::hardware_concurrency();
+            }
+
+            while (mShardCount < shardCount) {
+                mShardCount <<= 1;
+                ++mShardBits;
+            }
+
+            while (mShardCount > 1 && mShardCount > capacity) {
+                mShardCount >>= 1;
+                --mShardBits;
+            }
+
+            //  cache line aligned block of shards, aligned by hand since new ignores over alignment before C++17
+            mRaw = ::operator new(sizeof(Shard) * mShardCount + alignof(Shard));
+            const std::uintptr_t aligned = (reinterpret_cast<std::uintptr_t>(mRaw) + alignof(Shard) - 1) & ~static_cast<std::uintptr_t>(alignof(Shard) - 1);
+            mShards = reinterpret_cast<Shard*>(aligned);
+
+            //  spread the remainder so the shard capacities add up to capacity
+            std::size_t built = 0;
+            try {
+                for (; built < mShardCount; ++built) {
+                    new (&mShards[built]) Shard(capacity / mShardCount + (built < capacity % mShardCount ? 1 : 0), weigher);
+                }
+            } catch (...) {
+                //  a shard threw, the destructor will not run so release what has been built so far
+                while (built > 0) {
+                    mShards[--built].~Shard();
+                }
+
+                ::operator delete(mRaw);
+                throw;
+            }
+        }
+
+        template<typename Key, typename Data, E_EVICTION_POLICY Policy, typename Weigher, typename Hash>
+        ShardedLruCache<Key, Data, Policy, Weigher, Hash>::~ShardedLruCache()
+        {
+            for (std::size_t i = 0; i < mShardCount; ++i) {
+                mShards[i].~Shard();
+            }
+
+            ::operator delete(mRaw);
+        }
+
+        template<typename Key, typename Data, E_EVICTION_POLICY Policy, typename Weigher, typename Hash>
+        bool ShardedLruCache<Key, Data, Policy, Weigher, Hash>::get(const Key& k, Data& d)
+        {
+            Shard& shard = shardFor(k);
+            std::lock_guard<std::mutex> lock(shard.mMutex);
+            return shard.mCache.get(k, d);
+        }
+
+        template<typename Key, typename Data, E_EVICTION_POLICY Policy, typename Weigher, typename Hash>
+        typename ShardedLruCache<Key, Data, Policy, Weigher, Hash>::INSERT_RESULT ShardedLruCache<Key, Data, Policy, Weigher, Hash>::put(const Key& k, const Data& d)
+        {
+            Shard& shard = shardFor(k);
+            std::lock_guard<std::mutex> lock(shard.mMutex);
+            return shard.mCache.put(k, d);
+        }
+
+        template<typename Key, typename Data, E_EVICTION_POLICY Policy, typename Weigher, typename Hash>
+        bool ShardedLruCache<Key, Data, Policy, Weigher, Hash>::erase(const Key& k)
+        {
+            Shard& shard = shardFor(k);
+            std::lock_guard<std::mutex> lock(shard.mMutex);
+            return shard.mCache.erase(k);
+        }
+
+        template<typename Key, typename Data, E_EVICTION_POLICY Policy, typename Weigher, typename Hash>
+        bool ShardedLruCache<Key, Data, Policy, Weigher, Hash>::contains(const Key& k)
+        {
+            Shard& shard = shardFor(k);
+            std::lock_guard<std::mutex> lock(shard.mMutex);
+            return shard.mCache.contains(k);
+        }
+
+        template<typename Key, typename Data, E_EVICTION_POLICY Policy, typename Weigher, typename Hash>
+        void ShardedLruCache<Key, Data, Policy, Weigher, Hash>::clear()
+        {
+            for (std::size_t i = 0; i < mShardCount; ++i) {
+                std::lock_guard<std::mutex> lock(mShards[i].mMutex);
+                mShards[i].mCache.clear();
+            }
+        }
+
+        template<typename Key, typename Data, E_EVICTION_POLICY Policy, typename Weigher, typename Hash>
+        std::size_t ShardedLruCache<Key, Data, Policy, Weigher, Hash>::getSize()
+        {
+            std::size_t size = 0;
+            for (std::size_t i = 0; i < mShardCount; ++i) {
+                std::lock_guard<std::mutex> lock(mShards[i].mMutex);
+                size += mShards[i].mCache.getSize();
+            }
+
+            return size;
+        }
+
+        template<typename Key, typename Data, E_EVICTION_POLICY Policy, typename Weigher, typename Hash>
+        std::uint64_t ShardedLruCache<Key, Data, Policy, Weigher, Hash>::getHits()
+        {
+            std::uint64_t hits = 0;
+            for (std::size_t i = 0; i < mShardCount; ++i) {
+                std::lock_guard<std::mutex> lock(mShards[i].mMutex);
+                hits += mShards[i].mCache.getHits();
+            }
+
+            return hits;
+        }
+
+        template<typename Key, typename Data, E_EVICTION_POLICY Policy, typename Weigher, typename Hash>
+        std::uint64_t ShardedLruCache<Key, Data, Policy, Weigher, Hash>::getMisses()
+        {
+            std::uint64_t misses = 0;
+            for (std::size_t i = 0; i < mShardCount; ++i) {
+                std::lock_guard<std::mutex> lock(mShards[i].mMutex);
+                misses += mShards[i].mCache.getMisses();
+            }
+
+            return misses;
+        }
+
+        //  the top bits of a multiplicative mix pick the shard, the index uses the low bits
+        //  of the raw hash so the two choices stay independent
+        template<typename Key, typename Data, E_EVICTION_POLICY Policy, typename Weigher, typename Hash>
+        typename ShardedLruCache<Key, Data, Policy, Weigher, Hash>::Shard& ShardedLruCache<Key, Data, Policy, Weigher, Hash>::shardFor(const Key& k)
+        {
+            if (mShardBits == 0) return mShards[0];
+
+            const std::uint64_t mixed = static_cast<std::uint64_t>(mHash(k)) * 0x9E3779B97F4A7C15ull;
+            return mShards[mixed >> (64 - mShardBits)];
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,243 @@
+#ifndef H_UTILS_STORAGE_MAPPED_BST_H
+#define H_UTILS_STORAGE_MAPPED_BST_H
+
+//  includes
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "bst.h"
+#include "eytzinger.h"
+#include "mapped_file.h"
+
+namespace utils {
+    namespace storage {
+
+        //  MappedBST
+        //  read only view of a BST written to disk by write() and mapped straight back into memory,
+        //  opening it costs a header check, lookups run on the mapped pages with no deserialization
+        //  and several processes opening the same file share one copy in the page cache
+        //
+        //  file layout, all fields in the writer's native byte order
+        //      header      magic, format version, byte order tag, key/data size and alignment, count
+        //      keys        count keys in Eytzinger order, the implicit binary tree a heap uses,
+        //                  so a search touches the top levels of the tree in the same few cache lines
+        //      data        count values, data[i] belongs to keys[i]
+        //  both arrays start on a 64 byte boundary
+        //
+        //  Key and Data must be trivially copyable, and the file is only valid for the same
+        //  key/data layout and byte order, open() checks all of that and throws std::runtime_error
+        //  the keys are ordered by Compare, so a file must be opened with the Compare it was written with
+        template<typename Key, typename Data, typename Compare = std::less<Key>>
+        class MappedBST
+        {
+            static_assert(std::is_trivially_copyable<Key>::value, "mapped keys must be trivially copyable");
+            static_assert(std::is_trivially_copyable<Data>::value, "mapped data must be trivially copyable");
+
+        public:
+            enum { FORMAT_VERSION = 1 };
+
+        private:
+            enum { ALIGNMENT = 64 };
+
+            static const std::uint32_t BYTE_ORDER_TAG = 0x01020304u;
+
+            struct Header
+            {
+                char mMagic[8];
+                std::uint32_t mVersion;
+                std::uint32_t mByteOrder;
+                std::uint32_t mKeySize;
+                std::uint32_t mKeyAlign;
+                std::uint32_t mDataSize;
+                std::uint32_t mDataAlign;
+                std::uint64_t mCount;
+                std::uint64_t mKeysOffset;
+                std::uint64_t mDataOffset;
+                std::uint64_t mFileSize;
+            };
+
+        public:
+            MappedBST() = default;
+            explicit MappedBST(const std::string& path) { open(path); }
+
+            //  writes tree to path in the mapped format, throws std::runtime_error if the file cannot be written
+            template<typename Stats>
+            static void write(const BST<Key, Data, Stats>& tree, const std::string& path);
+
+            void open(const std::string& path);
+            void close();
+
+            const Data* find(const Key& k) const;
+            bool contains(const Key& k) const { return find(k) != nullptr; }
+
+            //  f(key, data) for every element, in key order
+            template<typename Function>
+            void forEach(Function f) const { forEachHelper(1, f); }
+
+            std::size_t getSize() const { return mCount; }
+            bool empty() const { return mCount == 0; }
+            bool isOpen() const { return mFile.isOpen(); }
+
+        private:
+            static std::uint64_t alignUp(const std::uint64_t offset) { return (offset + ALIGNMENT - 1) & ~static_cast<std::uint64_t>(ALIGNMENT - 1); }
+
+            //  in order over the sorted items fills the implicit tree rooted at index (1 based)
+            static void layout(const std::vector<std::pair<Key, Data>>& sorted, std::size_t& next, const std::size_t index, std::vector<Key>& keys, std::vector<Data>& data);
+
+            template<typename Function>
+            void forEachHelper(const std::size_t index, Function& f) const;
+
+        private:
+            MappedFile mFile;
+            const Key* mKeys = nullptr;
+            const Data* mData = nullptr;
+            std::size_t mCount = 0;
+            Compare mLess;
+        };
+
+        template<typename Key, typename Data, typename Compare>
+        template<typename Stats>
+        void MappedBST<Key, Data, Compare>::write(const BST<Key, Data, Stats>& tree, const std::string& path)
+        {
+            std::vector<std::pair<Key, Data>> sorted;
+            tree.forEach([&](const Key& k, const Data& d) { sorted.push_back(std::make_pair(k, d)); });
+
+            //  the tree is in operator< order, find searches in Compare order
+            Compare less;
+            std::stable_sort(sorted.begin(), sorted.end(), [&less](const std::pair<Key, Data>& lhs, const std::pair<Key, Data>& rhs) { return less(lhs.first, rhs.first); });
+
+            std::vector<Key> keys(sorted.size());
+            std::vector<Data> data(sorted.size());
+            std::size_t next = 0;
+            layout(sorted, next, 1, keys, data);
+
+            Header header;
+            std::memset(&header, 0, sizeof(header));
+            std::memcpy(header.mMagic, "UTLSBST", 8);
+            header.mVersion = FORMAT_VERSION;
+            header.mByteOrder = BYTE_ORDER_TAG;
+            header.mKeySize = sizeof(Key);
+            header.mKeyAlign = alignof(Key);
+            header.mDataSize = sizeof(Data);
+            header.mDataAlign = alignof(Data);
+            header.mCount = sorted.size();
+            header.mKeysOffset = alignUp(sizeof(Header));
+            header.mDataOffset = alignUp(header.mKeysOffset + sizeof(Key) * keys.size());
+            header.mFileSize = header.mDataOffset + sizeof(Data) * data.size();
+
+            std::ofstream out(path, std::ios::binary | std::ios::trunc);
+            const char padding[ALIGNMENT] = {};
+
+            out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            out.write(padding, static_cast<std::streamsize>(header.mKeysOffset - sizeof(header)));
+            out.write(reinterpret_cast<const char*>(keys.data()), static_cast<std::streamsize>(sizeof(Key) * keys.size()));
+            out.write(padding, static_cast<std::streamsize>(header.mDataOffset - header.mKeysOffset - sizeof(Key) * keys.size()));
+            out.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(sizeof(Data) * data.size()));
+
+            if (!out) {
+                throw std::runtime_error("cannot write " + path);
+            }
+        }
+
+        template<typename Key, typename Data, typename Compare>
+        void MappedBST<Key, Data, Compare>::open(const std::string& path)
+        {
+            close();
+
+            MappedFile file(path);
+
+            if (file.getSize() < sizeof(Header)) {
+                throw std::runtime_error(path + " is too small to be a mapped BST");
+            }
+
+            Header header;
+            std::memcpy(&header, file.getData(), sizeof(header));
+
+            if (std::memcmp(header.mMagic, "UTLSBST", 8) != 0) {
+                throw std::runtime_error(path + " is not a mapped BST");
+            }
+
+            if (header.mVersion != FORMAT_VERSION || header.mByteOrder != BYTE_ORDER_TAG) {
+                throw std::runtime_error(path + " has an unsupported version or byte order");
+            }
+
+            if (header.mKeySize != sizeof(Key) || header.mKeyAlign != alignof(Key) || header.mDataSize != sizeof(Data) || header.mDataAlign != alignof(Data)) {
+                throw std::runtime_error(path + " was written for different key or data types");
+            }
+
+            //  bounds are checked by division so a huge count cannot wrap round to a small size
+            const std::uint64_t size = file.getSize();
+            if (header.mFileSize != size || header.mKeysOffset < sizeof(Header) || header.mKeysOffset > header.mDataOffset || header.mDataOffset > size ||
+                header.mCount > (header.mDataOffset - header.mKeysOffset) / sizeof(Key) || header.mCount > (size - header.mDataOffset) / sizeof(Data)) {
+                throw std::runtime_error(path + " is truncated or corrupt");
+            }
+
+            //  the mapping starts on a page boundary, so aligned offsets mean aligned arrays
+            if (header.mKeysOffset % alignof(Key) != 0 || header.mDataOffset % alignof(Data) != 0) {
+                throw std::runtime_error(path + " has misaligned arrays");
+            }
+
+            const char* base = static_cast<const char*>(file.getData());
+            mKeys = reinterpret_cast<const Key*>(base + header.mKeysOffset);
+            mData = reinterpret_cast<const Data*>(base + header.mDataOffset);
+            mCount = static_cast<std::size_t>(header.mCount);
+            mFile = std::move(file);
+        }
+
+        template<typename Key, typename Data, typename Compare>
+        void MappedBST<Key, Data, Compare>::close()
+        {
+            mFile.close();
+            mKeys = nullptr;
+            mData = nullptr;
+            mCount = 0;
+        }
+
+        //  branch free descent, every step goes to child 2i or 2i + 1, the path taken spells out
+        //  the comparisons so the lower bound is recovered by stripping the trailing right turns
+        template<typename Key, typename Data, typename Compare>
+        const Data* MappedBST<Key, Data, Compare>::find(const Key& k) const
+        {
+            //  the file is usually far larger than the cache, so the descent prefetches
+            const std::size_t index = detail::eytzingerLowerBound<true>(mKeys, mCount, k, mLess);
+            if (index == 0 || mLess(k, mKeys[index - 1])) {
+                return nullptr;
+            }
+
+            return &mData[index - 1];
+        }
+
+        template<typename Key, typename Data, typename Compare>
+        void MappedBST<Key, Data, Compare>::layout(const std::vector<std::pair<Key, Data>>& sorted, std::size_t& next, const std::size_t index, std::vector<Key>& keys, std::vector<Data>& data)
+        {
+            if (index > sorted.size()) return;
+
+            layout(sorted, next, 2 * index, keys, data);
+            keys[index - 1] = sorted[next].first;
+            data[index - 1] = sorted[next].second;
+            ++next;
+            layout(sorted, next, 2 * index + 1, keys, data);
+        }
+
+        template<typename Key, typename Data, typename Compare>
+        template<typename Function>
+        void MappedBST<Key, Data, Compare>::forEachHelper(const std::size_t index, Function& f) const
+        {
+            if (index > mCount) return;
+
+            forEachHelper(2 * index, f);
+            f(mKeys[index - 1], mData[index - 1]);
+            forEachHelper(2 * index + 1, f);
+        }
+    }
+}
+
+#endif
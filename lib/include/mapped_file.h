@@ -0,0 +1,299 @@
+#ifndef H_UTILS_STORAGE_MAPPED_FILE_H
+#define H_UTILS_STORAGE_MAPPED_FILE_H
+
+//  includes
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace utils {
+    namespace storage {
+
+        //  MappedFile
+        //  a whole file mapped into memory, pages are shared with every other process
+        //  mapping the same file and loaded lazily by the OS as they are touched
+        //  open() maps an existing file read only, create() makes a new one of a fixed size read-write,
+        //  written pages go back to the file through the page cache rather than counting as the
+        //  process's own memory
+        //  throws std::runtime_error if the file cannot be opened, created or mapped
+        class MappedFile {
+
+        public:
+            MappedFile() = default;
+            explicit MappedFile(const std::string& path) { open(path); }
+            MappedFile(MappedFile&& rhs) noexcept { takeOver(rhs); }
+            ~MappedFile() { close(); }
+
+            MappedFile(const MappedFile&) = delete;
+            MappedFile& operator=(const MappedFile&) = delete;
+            MappedFile& operator=(MappedFile&& rhs) noexcept;
+
+            void open(const std::string& path);
+            //  replaces any file at path with one of size zeroed bytes, its blocks are reserved on disk
+            //  before it is mapped, so a full disk throws std::runtime_error here rather than faulting
+            //  (SIGBUS) on a later store through the mapping, the file is removed again if it throws
+            void create(const std::string& path, const std::size_t size);
+            void close();
+
+            //  hints for the bytes in [offset, offset + length), prefetch starts reading in the pages
+            //  they touch, evict drops the whole pages inside them from the mapping, written data is
+            //  kept and read back from the file if they are touched again
+            //  both are no-ops where the OS has no such hint
+            void prefetch(const std::size_t offset, const std::size_t length) const;
+            void evict(const std::size_t offset, const std::size_t length) const;
+
+            const void* getData() const { return mData; }
+            //  nullptr unless the file was made by create()
+            void* getWritableData() const { return mWritable ? mData : nullptr; }
+            std::size_t getSize() const { return mSize; }
+            bool isOpen() const { return mData != nullptr; }
+
+        private:
+            void takeOver(MappedFile& rhs);
+#ifndef _WIN32
+            void advise(const std::size_t offset, const std::size_t length, const bool inner, const int advice) const;
+#endif
+
+        private:
+            void* mData = nullptr;
+            std::size_t mSize = 0;
+            bool mWritable = false;
+#ifdef _WIN32
+            HANDLE mFile = INVALID_HANDLE_VALUE;
+            HANDLE mMapping = nullptr;
+#endif
+        };
+
+        inline MappedFile& MappedFile::operator=(MappedFile&& rhs) noexcept
+        {
+            //  check for self move
+            if (this != &rhs) {
+                close();
+                takeOver(rhs);
+            }
+
+            return *this;
+        }
+
+#ifdef _WIN32
+        inline void MappedFile::open(const std::string& path)
+        {
+            close();
+
+            mFile = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+            if (mFile == INVALID_HANDLE_VALUE) {
+                throw std::runtime_error("cannot open " + path);
+            }
+
+            LARGE_INTEGER size;
+            if (!GetFileSizeEx(mFile, &size) || size.QuadPart == 0) {
+                close();
+                throw std::runtime_error("cannot map empty or unreadable file " + path);
+            }
+
+            mMapping = CreateFileMappingA(mFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            void* data = mMapping ? MapViewOfFile(mMapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+            if (data == nullptr) {
+                close();
+                throw std::runtime_error("cannot map " + path);
+            }
+
+            mData = data;
+            mSize = static_cast<std::size_t>(size.QuadPart);
+        }
+
+        inline void MappedFile::create(const std::string& path, const std::size_t size)
+        {
+            close();
+
+            if (size == 0) {
+                throw std::runtime_error("cannot map empty file " + path);
+            }
+
+            mFile = CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+            if (mFile == INVALID_HANDLE_VALUE) {
+                throw std::runtime_error("cannot create " + path);
+            }
+
+            //  the mapping extends the file to its own size, a file that is not sparse gets its clusters
+            //  there and then, so a full disk fails here
+            const unsigned long long size64 = size;
+            mMapping = CreateFileMappingA(mFile, nullptr, PAGE_READWRITE, static_cast<DWORD>(size64 >> 32), static_cast<DWORD>(size64 & 0xffffffffu), nullptr);
+            void* data = mMapping ? MapViewOfFile(mMapping, FILE_MAP_WRITE, 0, 0, 0) : nullptr;
+            if (data == nullptr) {
+                close();
+                DeleteFileA(path.c_str());
+                throw std::runtime_error("cannot map " + path);
+            }
+
+            mData = data;
+            mSize = size;
+            mWritable = true;
+        }
+
+        inline void MappedFile::close()
+        {
+            if (mData) UnmapViewOfFile(mData);
+            if (mMapping) CloseHandle(mMapping);
+            if (mFile != INVALID_HANDLE_VALUE) CloseHandle(mFile);
+
+            mData = nullptr;
+            mSize = 0;
+            mWritable = false;
+            mMapping = nullptr;
+            mFile = INVALID_HANDLE_VALUE;
+        }
+
+        //  the OS reads ahead on its own, and a view cannot drop pages short of unmapping
+        inline void MappedFile::prefetch(const std::size_t, const std::size_t) const {}
+        inline void MappedFile::evict(const std::size_t, const std::size_t) const {}
+
+        inline void MappedFile::takeOver(MappedFile& rhs)
+        {
+            mData = rhs.mData;
+            mSize = rhs.mSize;
+            mWritable = rhs.mWritable;
+            mFile = rhs.mFile;
+            mMapping = rhs.mMapping;
+
+            rhs.mData = nullptr;
+            rhs.mSize = 0;
+            rhs.mWritable = false;
+            rhs.mFile = INVALID_HANDLE_VALUE;
+            rhs.mMapping = nullptr;
+        }
+#else
+        inline void MappedFile::open(const std::string& path)
+        {
+            close();
+
+            const int fd = ::open(path.c_str(), O_RDONLY);
+            if (fd < 0) {
+                throw std::runtime_error("cannot open " + path);
+            }
+
+            struct stat info;
+            if (::fstat(fd, &info) != 0 || info.st_size == 0) {
+                ::close(fd);
+                throw std::runtime_error("cannot map empty or unreadable file " + path);
+            }
+
+            //  the mapping keeps its own reference to the file, the descriptor is not needed after this
+            void* data = ::mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_SHARED, fd, 0);
+            ::close(fd);
+
+            if (data == MAP_FAILED) {
+                throw std::runtime_error("cannot map " + path);
+            }
+
+            mData = data;
+            mSize = static_cast<std::size_t>(info.st_size);
+        }
+
+        inline void MappedFile::create(const std::string& path, const std::size_t size)
+        {
+            close();
+
+            if (size == 0) {
+                throw std::runtime_error("cannot map empty file " + path);
+            }
+
+            const int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0600);
+            if (fd < 0) {
+                throw std::runtime_error("cannot create " + path);
+            }
+
+            //  ftruncate alone would leave a sparse file whose blocks are only found, or not, when a page
+            //  is first written through the mapping
+#ifdef __APPLE__
+            fstore_t store = { F_ALLOCATEALL, F_PEOFPOSMODE, 0, static_cast<off_t>(size), 0 };
+            const bool reserved = ::fcntl(fd, F_PREALLOCATE, &store) != -1 && ::ftruncate(fd, static_cast<off_t>(size)) == 0;
+#else
+            const bool reserved = ::posix_fallocate(fd, 0, static_cast<off_t>(size)) == 0;
+#endif
+            if (!reserved) {
+                ::close(fd);
+                ::unlink(path.c_str());
+                throw std::runtime_error("no room on disk for " + std::to_string(size) + " bytes of " + path);
+            }
+
+            void* data = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            ::close(fd);
+
+            if (data == MAP_FAILED) {
+                ::unlink(path.c_str());
+                throw std::runtime_error("cannot map " + path);
+            }
+
+            mData = data;
+            mSize = size;
+            mWritable = true;
+        }
+
+        inline void MappedFile::close()
+        {
+            if (mData) {
+                ::munmap(mData, mSize);
+            }
+
+            mData = nullptr;
+            mSize = 0;
+            mWritable = false;
+        }
+
+        inline void MappedFile::prefetch(const std::size_t offset, const std::size_t length) const
+        {
+            advise(offset, length, false, MADV_WILLNEED);
+        }
+
+        inline void MappedFile::evict(const std::size_t offset, const std::size_t length) const
+        {
+            //  a partial page at either end still holds bytes in use
+            advise(offset, length, true, MADV_DONTNEED);
+        }
+
+        //  madvise works on whole pages, the range is clipped to the mapping and then
+        //  rounded out to the pages it touches or in to the pages it covers
+        inline void MappedFile::advise(const std::size_t offset, const std::size_t length, const bool inner, const int advice) const
+        {
+            if (mData == nullptr || offset >= mSize || length == 0) return;
+
+            const std::size_t page = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+            const std::size_t end = length < mSize - offset ? offset + length : mSize;
+            const std::size_t first = inner ? (offset + page - 1) / page * page : offset / page * page;
+            const std::size_t last = inner && end != mSize ? end / page * page : end;
+            if (first < last) {
+                ::madvise(static_cast<char*>(mData) + first, last - first, advice);
+            }
+        }
+
+        inline void MappedFile::takeOver(MappedFile& rhs)
+        {
+            mData = rhs.mData;
+            mSize = rhs.mSize;
+            mWritable = rhs.mWritable;
+
+            rhs.mData = nullptr;
+            rhs.mSize = 0;
+            rhs.mWritable = false;
+        }
+#endif
+    }
+}
+
+#endif
@@ -0,0 +1,148 @@
+#ifndef H_UTILS_STORAGE_NODE_POOL_H
+#define H_UTILS_STORAGE_NODE_POOL_H
+
+//  includes
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace utils {
+    namespace storage {
+
+        //  NodePool
+        //  slab of nodes addressed by 32 bit indices instead of pointers, for the Pooled containers
+        //  nodes are carved from chunks of 2^ChunkBits slots, so neighbouring nodes share cache lines,
+        //  there is no per node allocator header and a node never moves once created
+        //  freed slots are kept on a free list threaded through the slots themselves
+        //  the pool only manages storage, its owner must destroy every node it created before the pool goes
+        template<typename Node, unsigned ChunkBits = 10>
+        class NodePool {
+
+            friend void swap(NodePool<Node, ChunkBits>& lhs, NodePool<Node, ChunkBits>& rhs) noexcept
+            {
+                using std::swap;
+                swap(lhs.mChunks, rhs.mChunks);
+                swap(lhs.mFreeHead, rhs.mFreeHead);
+                swap(lhs.mNextUnused, rhs.mNextUnused);
+            }
+
+        public:
+            typedef std::uint32_t Index;
+
+            //  the null index
+            static const Index NIL = 0xFFFFFFFFu;
+
+            enum { CHUNK_SIZE = 1 << ChunkBits };
+
+        private:
+            union Slot {
+                typename std::aligned_storage<sizeof(Node), alignof(Node)>::type mNode;
+                Index mNextFree;
+            };
+
+        public:
+            NodePool() = default;
+            NodePool(NodePool&& rhs) noexcept { swap(*this, rhs); }
+            ~NodePool() { release(); }
+
+            NodePool(const NodePool&) = delete;
+            NodePool& operator=(const NodePool&) = delete;
+            NodePool& operator=(NodePool&& rhs) noexcept;
+
+            //  constructs a node in a free slot, throws std::length_error past 2^32 - 1 nodes
+            template<typename ...Args>
+            Index create(Args&&... args);
+            void destroy(const Index index);
+
+            Node& operator[](const Index index) { return *reinterpret_cast<Node*>(&slot(index).mNode); }
+            const Node& operator[](const Index index) const { return *reinterpret_cast<const Node*>(&slot(index).mNode); }
+
+            //  frees every chunk, every node must already have been destroyed
+            void release();
+
+            //  bytes held by the chunks and the chunk table
+            std::size_t getMemoryUsage() const { return mChunks.size() * (sizeof(Slot) * CHUNK_SIZE) + mChunks.capacity() * sizeof(Slot*); }
+
+        private:
+            Slot& slot(const Index index) const { return mChunks[index >> ChunkBits][index & (CHUNK_SIZE - 1)]; }
+
+        private:
+            std::vector<Slot*> mChunks;
+            Index mFreeHead = NIL;
+            //  slots below this have been handed out at least once
+            std::size_t mNextUnused = 0;
+        };
+
+        template<typename Node, unsigned ChunkBits>
+        NodePool<Node, ChunkBits>& NodePool<Node, ChunkBits>::operator=(NodePool<Node, ChunkBits>&& rhs) noexcept
+        {
+            //  check for self move
+            if (this != &rhs) {
+                release();
+                swap(*this, rhs);
+            }
+
+            return *this;
+        }
+
+        template<typename Node, unsigned ChunkBits>
+        template<typename ...Args>
+        typename NodePool<Node, ChunkBits>::Index NodePool<Node, ChunkBits>::create(Args&&... args)
+        {
+            Index index;
+
+            if (mFreeHead != NIL) {
+                index = mFreeHead;
+                //  the node overwrites the link, but the slot is only unlinked once its constructor has not thrown
+                const Index next = slot(index).mNextFree;
+                new (&slot(index).mNode) Node(std::forward<Args>(args)...);
+                mFreeHead = next;
+                return index;
+            }
+
+            if (mNextUnused >= NIL) {
+                throw std::length_error("node pool is out of 32 bit indices");
+            }
+
+            if ((mNextUnused >> ChunkBits) == mChunks.size()) {
+                //  the table grows geometrically, the chunk is only let go once it is in the table
+                std::unique_ptr<Slot[]> chunk(new Slot[CHUNK_SIZE]);
+                mChunks.push_back(chunk.get());
+                chunk.release();
+            }
+
+            index = static_cast<Index>(mNextUnused);
+            new (&slot(index).mNode) Node(std::forward<Args>(args)...);
+            ++mNextUnused;
+            return index;
+        }
+
+        template<typename Node, unsigned ChunkBits>
+        void NodePool<Node, ChunkBits>::destroy(const Index index)
+        {
+            (*this)[index].~Node();
+            slot(index).mNextFree = mFreeHead;
+            mFreeHead = index;
+        }
+
+        template<typename Node, unsigned ChunkBits>
+        void NodePool<Node, ChunkBits>::release()
+        {
+            for (Slot* chunk : mChunks) {
+                delete[] chunk;
+            }
+
+            mChunks.clear();
+            mChunks.shrink_to_fit();
+            mFreeHead = NIL;
+            mNextUnused = 0;
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,163 @@
+#ifndef H_UTILS_CONCURRENCY_PARALLEL_ALGORITHM_H
+#define H_UTILS_CONCURRENCY_PARALLEL_ALGORITHM_H
+
+//  includes
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <utility>
+#include <vector>
+#include "thread_pool.h"
+
+namespace utils {
+    namespace concurrency {
+
+        //  ranges smaller than this are handled sequentially
+        enum { PARALLEL_SORT_GRAIN = 1 << 13 };
+
+        namespace detail {
+
+            //  stable merge of [first1, last1) and [first2, last2) into out, the larger run is cut at its
+            //  middle and the other at the matching bound so both halves merge independently
+            template<typename In, typename Out, typename Compare>
+            void parallelMerge(In first1, In last1, In first2, In last2, Out out, Compare& comp, ThreadPool& pool)
+            {
+                const std::size_t size1 = static_cast<std::size_t>(last1 - first1);
+                const std::size_t size2 = static_cast<std::size_t>(last2 - first2);
+
+                if (size1 + size2 < PARALLEL_SORT_GRAIN) {
+                    std::merge(std::make_move_iterator(first1), std::make_move_iterator(last1), std::make_move_iterator(first2), std::make_move_iterator(last2), out, comp);
+                    return;
+                }
+
+                In cut1;
+                In cut2;
+                if (size1 >= size2) {
+                    //  equal elements of the second run stay after the cut element of the first
+                    cut1 = first1 + size1 / 2;
+                    cut2 = std::lower_bound(first2, last2, *cut1, comp);
+                }
+                else {
+                    cut2 = first2 + size2 / 2;
+                    cut1 = std::upper_bound(first1, last1, *cut2, comp);
+                }
+
+                Out middle = out + (cut1 - first1) + (cut2 - first2);
+
+                forkJoin(&pool, true,
+                    [&]() { parallelMerge(first1, cut1, first2, cut2, out, comp, pool); },
+                    [&]() { parallelMerge(cut1, last1, cut2, last2, middle, comp, pool); });
+            }
+
+            //  sorts [first, last) and leaves the result in place, scratch is the same size
+            template<typename It, typename Scratch, typename Compare>
+            void parallelSortHelper(It first, It last, Scratch scratch, Compare& comp, ThreadPool& pool)
+            {
+                const std::size_t size = static_cast<std::size_t>(last - first);
+
+                if (size < PARALLEL_SORT_GRAIN) {
+                    std::stable_sort(first, last, comp);
+                    return;
+                }
+
+                const std::size_t half = size / 2;
+
+                forkJoin(&pool, true,
+                    [&]() { parallelSortHelper(first, first + half, scratch, comp, pool); },
+                    [&]() { parallelSortHelper(first + half, last, scratch + half, comp, pool); });
+
+                //  merge into scratch, then move back in parallel chunks
+                parallelMerge(first, first + half, first + half, last, scratch, comp, pool);
+
+                const std::size_t chunks = (size + PARALLEL_SORT_GRAIN - 1) / PARALLEL_SORT_GRAIN;
+                TaskGroup group(pool);
+                for (std::size_t chunk = 0; chunk < chunks; ++chunk) {
+                    group.run([=]() {
+                        const std::size_t lo = chunk * PARALLEL_SORT_GRAIN;
+                        const std::size_t hi = std::min(size, lo + PARALLEL_SORT_GRAIN);
+                        std::move(scratch + lo, scratch + hi, first + lo);
+                    });
+                }
+
+                group.wait();
+            }
+        }
+
+        //  stable sort, a merge sort whose halves and merges are both split into fork-join tasks
+        //  uses a scratch buffer the size of the range, sequential std::stable_sort without a pool
+        template<typename It, typename Compare>
+        void parallelSort(It first, It last, Compare comp, ThreadPool* pool)
+        {
+            if (pool == nullptr || last - first < PARALLEL_SORT_GRAIN) {
+                std::stable_sort(first, last, comp);
+                return;
+            }
+
+            std::vector<typename std::iterator_traits<It>::value_type> scratch(first, last);
+            detail::parallelSortHelper(first, last, scratch.begin(), comp, *pool);
+        }
+
+        //  copies a sorted range to out keeping only the last element of every run of equivalent ones,
+        //  returns the end of the output, out must be random access and must not overlap the input
+        //  survivors are flagged and counted per chunk in parallel, then every chunk copies its own
+        template<typename In, typename Out, typename Compare>
+        Out parallelUniqueCopy(In first, In last, Out out, Compare comp, ThreadPool* pool)
+        {
+            const std::size_t size = static_cast<std::size_t>(last - first);
+
+            if (pool == nullptr || size < PARALLEL_SORT_GRAIN) {
+                for (std::size_t i = 0; i < size; ++i) {
+                    if (i + 1 == size || comp(first[i], first[i + 1])) {
+                        *out++ = first[i];
+                    }
+                }
+
+                return out;
+            }
+
+            const std::size_t chunks = (size + PARALLEL_SORT_GRAIN - 1) / PARALLEL_SORT_GRAIN;
+            std::vector<char> survives(size);
+            std::vector<std::size_t> offsets(chunks + 1, 0);
+
+            {
+                TaskGroup group(*pool);
+                for (std::size_t chunk = 0; chunk < chunks; ++chunk) {
+                    group.run([&, chunk]() {
+                        const std::size_t hi = std::min(size, (chunk + 1) * PARALLEL_SORT_GRAIN);
+                        std::size_t kept = 0;
+                        for (std::size_t i = chunk * PARALLEL_SORT_GRAIN; i < hi; ++i) {
+                            survives[i] = (i + 1 == size || comp(first[i], first[i + 1])) ? 1 : 0;
+                            kept += survives[i];
+                        }
+
+                        offsets[chunk + 1] = kept;
+                    });
+                }
+
+                group.wait();
+            }
+
+            for (std::size_t chunk = 0; chunk < chunks; ++chunk) {
+                offsets[chunk + 1] += offsets[chunk];
+            }
+
+            TaskGroup group(*pool);
+            for (std::size_t chunk = 0; chunk < chunks; ++chunk) {
+                group.run([&, chunk]() {
+                    const std::size_t hi = std::min(size, (chunk + 1) * PARALLEL_SORT_GRAIN);
+                    Out target = out + offsets[chunk];
+                    for (std::size_t i = chunk * PARALLEL_SORT_GRAIN; i < hi; ++i) {
+                        if (survives[i]) {
+                            *target++ = first[i];
+                        }
+                    }
+                });
+            }
+
+            group.wait();
+            return out + offsets[chunks];
+        }
+    }
+}
+
+#endif
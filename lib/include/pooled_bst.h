@@ -0,0 +1,310 @@
+#ifndef H_UTILS_STORAGE_POOLED_BST_H
+#define H_UTILS_STORAGE_POOLED_BST_H
+
+//  includes
+#include <cstddef>
+#include <utility>
+#include "node_pool.h"
+
+namespace utils {
+    namespace storage {
+
+        //  PooledBST
+        //  BST with the same insert/remove behaviour, but its nodes live in a NodePool and link through
+        //  32 bit indices, for BST<uint32_t, uint32_t> a node shrinks from 24 bytes plus the allocator's
+        //  header to 16 bytes with none
+        template<typename Key, typename Data>
+        class PooledBST
+        {
+            friend void swap(PooledBST<Key, Data>& lhs, PooledBST<Key, Data>& rhs) noexcept
+            {
+                using std::swap;
+                swap(lhs.mPool, rhs.mPool);
+                swap(lhs.mRoot, rhs.mRoot);
+                swap(lhs.mSize, rhs.mSize);
+            }
+
+        public:
+            enum E_INSERT_RESULT
+            {
+                OVERWRITE_SAME_VALUE_IR,
+                OVERWRITE_DIFFERENT_VALUE_IR,
+                NEW_INSERT_IR
+            };
+
+            typedef std::pair<bool, E_INSERT_RESULT> INSERT_RESULT;
+
+        private:
+            struct Node;
+            typedef NodePool<Node> Pool;
+            typedef typename Pool::Index Index;
+
+            struct Node
+            {
+                Node(const Key& k, const Data& d) : mKey(k), mData(d) {}
+
+                Key mKey;
+                Data mData;
+                Index mLeft = Pool::NIL;
+                Index mRight = Pool::NIL;
+            };
+
+        public:
+            PooledBST() = default;
+            PooledBST(const PooledBST& rhs);
+            PooledBST(PooledBST&& rhs) noexcept { swap(*this, rhs); }
+            ~PooledBST() { clear(); }
+
+            PooledBST& operator=(const PooledBST& rhs);
+            PooledBST& operator=(PooledBST&& rhs) noexcept;
+
+            INSERT_RESULT insert(const Key& k, const Data& d);
+            bool remove(const Key& k);
+
+            Data* find(const Key& k);
+            const Data* find(const Key& k) const;
+            bool contains(const Key& k) const { return find(k) != nullptr; }
+
+            //  f(key, data) for every element, in key order
+            template<typename Function>
+            void forEach(Function f) const { forEachHelper(mRoot, f); }
+
+            void clear();
+
+            std::size_t getSize() const { return mSize; }
+            bool empty() const { return mSize == 0; }
+            std::size_t getMemoryUsage() const { return sizeof(*this) + mPool.getMemoryUsage(); }
+
+        private:
+            Index insertHelper(const Index node, const Key& k, const Data& d, INSERT_RESULT& insertResult);
+            Index removeHelper(const Index node, const Key& k, bool& removed);
+            Index findLeftMostNode(const Index node, Index& result);
+            Index copyHelper(const PooledBST& rhs, const Index node);
+            void destroy(const Index node);
+            template<typename Function>
+            void forEachHelper(const Index node, Function& f) const;
+
+        private:
+            Pool mPool;
+            Index mRoot = Pool::NIL;
+            std::size_t mSize = 0;
+        };
+
+        template<typename Key, typename Data>
+        PooledBST<Key, Data>::PooledBST(const PooledBST<Key, Data>& rhs) :
+            mSize(rhs.mSize)
+        {
+            mRoot = copyHelper(rhs, rhs.mRoot);
+        }
+
+        template<typename Key, typename Data>
+        PooledBST<Key, Data>& PooledBST<Key, Data>::operator=(const PooledBST<Key, Data>& rhs)
+        {
+            //  check for self assignment
+            if (this != &rhs) {
+                PooledBST copy(rhs);
+                swap(*this, copy);
+            }
+
+            return *this;
+        }
+
+        template<typename Key, typename Data>
+        PooledBST<Key, Data>& PooledBST<Key, Data>::operator=(PooledBST<Key, Data>&& rhs) noexcept
+        {
+            //  check for self move
+            if (this != &rhs) {
+                clear();
+                swap(*this, rhs);
+            }
+
+            return *this;
+        }
+
+        template<typename Key, typename Data>
+        typename PooledBST<Key, Data>::INSERT_RESULT PooledBST<Key, Data>::insert(const Key& k, const Data& d)
+        {
+            INSERT_RESULT insertResult;
+            mRoot = insertHelper(mRoot, k, d, insertResult);
+            return insertResult;
+        }
+
+        template<typename Key, typename Data>
+        bool PooledBST<Key, Data>::remove(const Key& k)
+        {
+            bool removed = false;
+            mRoot = removeHelper(mRoot, k, removed);
+            return removed;
+        }
+
+        template<typename Key, typename Data>
+        Data* PooledBST<Key, Data>::find(const Key& k)
+        {
+            return const_cast<Data*>(static_cast<const PooledBST*>(this)->find(k));
+        }
+
+        template<typename Key, typename Data>
+        const Data* PooledBST<Key, Data>::find(const Key& k) const
+        {
+            Index node = mRoot;
+            while (node != Pool::NIL) {
+                const Node& current = mPool[node];
+
+                if (k < current.mKey) {
+                    node = current.mLeft;
+                }
+                else if (k > current.mKey) {
+                    node = current.mRight;
+                }
+                else {
+                    return &current.mData;
+                }
+            }
+
+            return nullptr;
+        }
+
+        //  destroys every node and hands the slab back
+        template<typename Key, typename Data>
+        void PooledBST<Key, Data>::clear()
+        {
+            destroy(mRoot);
+            mPool.release();
+            mRoot = Pool::NIL;
+            mSize = 0;
+        }
+
+        template<typename Key, typename Data>
+        typename PooledBST<Key, Data>::Index PooledBST<Key, Data>::insertHelper(const Index node, const Key& k, const Data& d, INSERT_RESULT& insertResult)
+        {
+            if (node == Pool::NIL) {
+                insertResult.first = true;
+                insertResult.second = NEW_INSERT_IR;
+                ++mSize;
+                return mPool.create(k, d);
+            }
+
+            //  nodes never move, so the reference survives the pool growing further down
+            Node& current = mPool[node];
+
+            if (current.mKey < k) {
+                const Index right = insertHelper(current.mRight, k, d, insertResult);
+                current.mRight = right;
+            }
+            else if (current.mKey > k) {
+                const Index left = insertHelper(current.mLeft, k, d, insertResult);
+                current.mLeft = left;
+            }
+            else {
+                insertResult.first = true;
+
+                if (current.mData == d) {
+                    insertResult.second = OVERWRITE_SAME_VALUE_IR;
+                }
+                else {
+                    insertResult.second = OVERWRITE_DIFFERENT_VALUE_IR;
+                }
+
+                current.mData = d;
+            }
+
+            return node;
+        }
+
+        template<typename Key, typename Data>
+        typename PooledBST<Key, Data>::Index PooledBST<Key, Data>::removeHelper(const Index node, const Key& k, bool& removed)
+        {
+            if (node == Pool::NIL) {
+                return Pool::NIL;
+            }
+
+            Node& current = mPool[node];
+            Index result = node;
+
+            if (k < current.mKey) {
+                current.mLeft = removeHelper(current.mLeft, k, removed);
+            }
+            else if (k > current.mKey) {
+                current.mRight = removeHelper(current.mRight, k, removed);
+            }
+            else {
+                if (current.mLeft == Pool::NIL || current.mRight == Pool::NIL) {
+                    result = current.mLeft == Pool::NIL ? current.mRight : current.mLeft;
+                }
+                else {
+                    //  the leftmost node of the right subtree takes this node's place
+                    current.mRight = findLeftMostNode(current.mRight, result);
+                    mPool[result].mLeft = current.mLeft;
+                    mPool[result].mRight = current.mRight;
+                }
+
+                mPool.destroy(node);
+                --mSize;
+                removed = true;
+            }
+
+            return result;
+        }
+
+        template<typename Key, typename Data>
+        typename PooledBST<Key, Data>::Index PooledBST<Key, Data>::findLeftMostNode(const Index node, Index& result)
+        {
+            Node& current = mPool[node];
+
+            if (current.mLeft == Pool::NIL) {
+                result = node;
+                return current.mRight;
+            }
+
+            current.mLeft = findLeftMostNode(current.mLeft, result);
+            return node;
+        }
+
+        template<typename Key, typename Data>
+        typename PooledBST<Key, Data>::Index PooledBST<Key, Data>::copyHelper(const PooledBST<Key, Data>& rhs, const Index node)
+        {
+            if (node == Pool::NIL) {
+                return Pool::NIL;
+            }
+
+            const Node& source = rhs.mPool[node];
+            const Index copy = mPool.create(source.mKey, source.mData);
+            try {
+                const Index left = copyHelper(rhs, source.mLeft);
+                mPool[copy].mLeft = left;
+                const Index right = copyHelper(rhs, source.mRight);
+                mPool[copy].mRight = right;
+            } catch (...) {
+                //  a copy threw, the pool does not destroy nodes so release this subtree by hand
+                destroy(copy);
+                throw;
+            }
+
+            return copy;
+        }
+
+        template<typename Key, typename Data>
+        void PooledBST<Key, Data>::destroy(const Index node)
+        {
+            if (node == Pool::NIL) return;
+
+            destroy(mPool[node].mLeft);
+            destroy(mPool[node].mRight);
+            mPool.destroy(node);
+        }
+
+        template<typename Key, typename Data>
+        template<typename Function>
+        void PooledBST<Key, Data>::forEachHelper(const Index node, Function& f) const
+        {
+            if (node == Pool::NIL) return;
+
+            const Node& current = mPool[node];
+            forEachHelper(current.mLeft, f);
+            f(current.mKey, current.mData);
+            forEachHelper(current.mRight, f);
+        }
+    }
+}
+
+#endif
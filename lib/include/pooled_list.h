@@ -0,0 +1,235 @@
+#ifndef H_UTILS_STORAGE_POOLED_LIST_H
+#define H_UTILS_STORAGE_POOLED_LIST_H
+
+//  includes
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include "node_pool.h"
+
+namespace utils {
+    namespace storage {
+
+        //  PooledList
+        //  singly linked list like List, but its nodes live in a NodePool and link through a 32 bit
+        //  index, for List<uint32_t> a node shrinks from 16 bytes plus the allocator's header to 8
+        template<typename T>
+        class PooledList
+        {
+            friend void swap(PooledList<T>& lhs, PooledList<T>& rhs) noexcept
+            {
+                using std::swap;
+                swap(lhs.mPool, rhs.mPool);
+                swap(lhs.mHead, rhs.mHead);
+                swap(lhs.mTail, rhs.mTail);
+                swap(lhs.mSize, rhs.mSize);
+            }
+
+        private:
+            struct Node;
+            typedef NodePool<Node> Pool;
+            typedef typename Pool::Index Index;
+
+            struct Node
+            {
+                template<typename ...Args>
+                explicit Node(Args&&... args) : mData(std::forward<Args>(args)...) {}
+
+                T mData;
+                Index mNext = Pool::NIL;
+            };
+
+            //  Iterator
+            //  forward iterator over the list, stays valid until the element it refers to is removed
+            template<typename Value>
+            class Iterator {
+                friend class PooledList<T>;
+
+            public:
+                typedef std::forward_iterator_tag iterator_category;
+                typedef T value_type;
+                typedef std::ptrdiff_t difference_type;
+                typedef Value* pointer;
+                typedef Value& reference;
+
+                Iterator() = default;
+
+                //  allow iterator -> const_iterator but not the other way round
+                template<typename Other, typename = typename std::enable_if<std::is_same<const Other, Value>::value>::type>
+                Iterator(const Iterator<Other>& rhs) : mPool(rhs.mPool), mIndex(rhs.mIndex) {}
+
+                reference operator*() const { return (*mPool)[mIndex].mData; }
+                pointer operator->() const { return &(*mPool)[mIndex].mData; }
+
+                Iterator& operator++() { mIndex = (*mPool)[mIndex].mNext; return *this; }
+                Iterator operator++(int) { Iterator copy(*this); ++(*this); return copy; }
+
+                bool operator==(const Iterator& rhs) const { return mIndex == rhs.mIndex; }
+                bool operator!=(const Iterator& rhs) const { return mIndex != rhs.mIndex; }
+
+            private:
+                template<typename Other> friend class Iterator;
+
+                Iterator(Pool* pool, const Index index) : mPool(pool), mIndex(index) {}
+
+                Pool* mPool = nullptr;
+                Index mIndex = Pool::NIL;
+            };
+
+        public:
+            typedef Iterator<T> iterator;
+            typedef Iterator<const T> const_iterator;
+
+        public:
+            PooledList() = default;
+            PooledList(const PooledList& rhs);
+            PooledList(PooledList&& rhs) noexcept { swap(*this, rhs); }
+            ~PooledList() { clear(); }
+
+            PooledList& operator=(const PooledList& rhs);
+            PooledList& operator=(PooledList&& rhs) noexcept;
+
+            //  append to the back of the list
+            template<typename ...Args>
+            void emplace(Args&&... args);
+            void insert(const T& t) { emplace(t); }
+            void insert(T&& t) { emplace(std::move(t)); }
+
+            //  removes the first element equal to t
+            void remove(const T& t);
+
+            void clear();
+
+            T& front() { return mPool[mHead].mData; }
+            const T& front() const { return mPool[mHead].mData; }
+            T& back() { return mPool[mTail].mData; }
+            const T& back() const { return mPool[mTail].mData; }
+
+            iterator begin() { return iterator(&mPool, mHead); }
+            const_iterator begin() const { return const_iterator(const_cast<Pool*>(&mPool), mHead); }
+            iterator end() { return iterator(&mPool, Pool::NIL); }
+            const_iterator end() const { return const_iterator(const_cast<Pool*>(&mPool), Pool::NIL); }
+            const_iterator cbegin() const { return begin(); }
+            const_iterator cend() const { return end(); }
+
+            bool empty() const { return mSize == 0; }
+            std::size_t getSize() const { return mSize; }
+            std::size_t getMemoryUsage() const { return sizeof(*this) + mPool.getMemoryUsage(); }
+
+        private:
+            Pool mPool;
+            Index mHead = Pool::NIL;
+            Index mTail = Pool::NIL;
+            std::size_t mSize = 0;
+        };
+
+        template<typename T>
+        PooledList<T>::PooledList(const PooledList<T>& rhs)
+        {
+            try {
+                for (const T& t : rhs) {
+                    emplace(t);
+                }
+            } catch (...) {
+                //  a copy threw, release what has been built so far
+                clear();
+                throw;
+            }
+        }
+
+        template<typename T>
+        PooledList<T>& PooledList<T>::operator=(const PooledList<T>& rhs)
+        {
+            //  check for self assignment
+            if (this != &rhs) {
+                PooledList copy(rhs);
+                swap(*this, copy);
+            }
+
+            return *this;
+        }
+
+        template<typename T>
+        PooledList<T>& PooledList<T>::operator=(PooledList<T>&& rhs) noexcept
+        {
+            //  check for self move
+            if (this != &rhs) {
+                clear();
+                swap(*this, rhs);
+            }
+
+            return *this;
+        }
+
+        template<typename T>
+        template<typename ...Args>
+        void PooledList<T>::emplace(Args&&... args)
+        {
+            //  if the constructor throws the list is unchanged
+            const Index node = mPool.create(std::forward<Args>(args)...);
+
+            if (mTail == Pool::NIL) {
+                mHead = node;
+            }
+            else {
+                mPool[mTail].mNext = node;
+            }
+
+            mTail = node;
+            ++mSize;
+        }
+
+        template<typename T>
+        void PooledList<T>::remove(const T& t)
+        {
+            Index prev = Pool::NIL;
+            Index node = mHead;
+
+            while (node != Pool::NIL) {
+                Node& current = mPool[node];
+
+                //  found?
+                if (current.mData == t) {
+                    //  unlink from list, destroy and decrease size of list
+                    if (prev == Pool::NIL) {
+                        mHead = current.mNext;
+                    }
+                    else {
+                        mPool[prev].mNext = current.mNext;
+                    }
+
+                    if (mTail == node) {
+                        mTail = prev;
+                    }
+
+                    mPool.destroy(node);
+                    --mSize;
+                    return;
+                }
+
+                prev = node;
+                node = current.mNext;
+            }
+        }
+
+        //  destroys every node and hands the slab back
+        template<typename T>
+        void PooledList<T>::clear()
+        {
+            Index node = mHead;
+            while (node != Pool::NIL) {
+                const Index next = mPool[node].mNext;
+                mPool.destroy(node);
+                node = next;
+            }
+
+            mPool.release();
+            mHead = Pool::NIL;
+            mTail = Pool::NIL;
+            mSize = 0;
+        }
+    }
+}
+
+#endif
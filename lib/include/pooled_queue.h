@@ -0,0 +1,201 @@
+#ifndef H_UTILS_STORAGE_POOLED_QUEUE_H
+#define H_UTILS_STORAGE_POOLED_QUEUE_H
+
+//  includes
+#include <cstddef>
+#include <stdexcept>
+#include <utility>
+#include "node_pool.h"
+
+namespace utils {
+    namespace storage {
+
+        //  PooledQueue
+        //  Queue with its nodes in a NodePool linked through a 32 bit index,
+        //  it also keeps the tail so push_back is O(1)
+        template<typename T>
+        class PooledQueue {
+
+            friend void swap(PooledQueue<T>& lhs, PooledQueue<T>& rhs) noexcept
+            {
+                using std::swap;
+                swap(lhs.mPool, rhs.mPool);
+                swap(lhs.mHead, rhs.mHead);
+                swap(lhs.mTail, rhs.mTail);
+                swap(lhs.mSize, rhs.mSize);
+            }
+
+        private:
+            struct Node;
+            typedef NodePool<Node> Pool;
+            typedef typename Pool::Index Index;
+
+            struct Node {
+                template<typename ...Args>
+                explicit Node(Args&&... args) : mData(std::forward<Args>(args)...) {}
+
+                T mData;
+                Index mNext = Pool::NIL;
+            };
+
+        public:
+            PooledQueue() = default;
+            PooledQueue(const PooledQueue<T>& rhs);
+            PooledQueue(PooledQueue<T>&& rhs) noexcept { swap(*this, rhs); }
+            ~PooledQueue() { clear(); }
+
+            PooledQueue<T>& operator=(const PooledQueue<T>& rhs);
+            PooledQueue<T>& operator=(PooledQueue<T>&& rhs) noexcept;
+
+            T& front();
+            const T& front() const;
+            void pop_front() noexcept;
+
+            template<typename ...Args>
+            void emplace_front(Args&&... args);
+
+            template<typename ...Args>
+            void emplace_back(Args&&... args);
+
+            void push_front(const T& data) { emplace_front(data); }
+            void push_front(T&& data) { emplace_front(std::move(data)); }
+            void push_back(const T& data) { emplace_back(data); }
+            void push_back(T&& data) { emplace_back(std::move(data)); }
+
+            void clear();
+
+            bool empty() const { return mSize == 0; }
+            std::size_t getSize() const { return mSize; }
+            std::size_t getMemoryUsage() const { return sizeof(*this) + mPool.getMemoryUsage(); }
+
+        private:
+            Pool mPool;
+            Index mHead = Pool::NIL;
+            Index mTail = Pool::NIL;
+            std::size_t mSize = 0;
+        };
+
+        template<typename T>
+        PooledQueue<T>::PooledQueue(const PooledQueue<T>& rhs)
+        {
+            try {
+                for (Index node = rhs.mHead; node != Pool::NIL; node = rhs.mPool[node].mNext) {
+                    emplace_back(rhs.mPool[node].mData);
+                }
+            } catch (...) {
+                //  a copy threw, release what has been built so far
+                clear();
+                throw;
+            }
+        }
+
+        template<typename T>
+        PooledQueue<T>& PooledQueue<T>::operator=(const PooledQueue<T>& rhs)
+        {
+            //  check for self-assignment
+            if (this != &rhs) {
+                PooledQueue<T> rhsCopy(rhs);
+                swap(*this, rhsCopy);
+            }
+
+            return *this;
+        }
+
+        template<typename T>
+        PooledQueue<T>& PooledQueue<T>::operator=(PooledQueue<T>&& rhs) noexcept
+        {
+            //  check for self-move
+            if (this != &rhs) {
+                clear();
+                swap(*this, rhs);
+            }
+
+            return *this;
+        }
+
+        template<typename T>
+        T& PooledQueue<T>::front()
+        {
+            if (mHead != Pool::NIL) {
+                return mPool[mHead].mData;
+            } else {
+                throw std::logic_error("trying to get front of empty queue");
+            }
+        }
+
+        template<typename T>
+        const T& PooledQueue<T>::front() const
+        {
+            if (mHead != Pool::NIL) {
+                return mPool[mHead].mData;
+            } else {
+                throw std::logic_error("trying to get front of empty queue");
+            }
+        }
+
+        template<typename T>
+        void PooledQueue<T>::pop_front() noexcept
+        {
+            if (mHead != Pool::NIL) {
+                const Index oldHead = mHead;
+                mHead = mPool[oldHead].mNext;
+                if (mHead == Pool::NIL) {
+                    mTail = Pool::NIL;
+                }
+
+                mPool.destroy(oldHead);
+                --mSize;
+            }
+        }
+
+        template<typename T>
+        template<typename ...Args>
+        void PooledQueue<T>::emplace_front(Args&&... args)
+        {
+            //  if the constructor throws the queue is unchanged
+            const Index node = mPool.create(std::forward<Args>(args)...);
+            mPool[node].mNext = mHead;
+            mHead = node;
+            if (mTail == Pool::NIL) {
+                mTail = node;
+            }
+
+            ++mSize;
+        }
+
+        template<typename T>
+        template<typename ...Args>
+        void PooledQueue<T>::emplace_back(Args&&... args)
+        {
+            //  if the constructor throws the queue is unchanged
+            const Index node = mPool.create(std::forward<Args>(args)...);
+            if (mTail == Pool::NIL) {
+                mHead = node;
+            } else {
+                mPool[mTail].mNext = node;
+            }
+
+            mTail = node;
+            ++mSize;
+        }
+
+        //  destroys every node and hands the slab back
+        template<typename T>
+        void PooledQueue<T>::clear()
+        {
+            Index node = mHead;
+            while (node != Pool::NIL) {
+                const Index next = mPool[node].mNext;
+                mPool.destroy(node);
+                node = next;
+            }
+
+            mPool.release();
+            mHead = Pool::NIL;
+            mTail = Pool::NIL;
+            mSize = 0;
+        }
+    }  //  storage
+}  //  utils
+
+#endif
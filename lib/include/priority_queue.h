@@ -0,0 +1,605 @@
+#ifndef H_UTILS_STORAGE_PRIORITY_QUEUE_H
+#define H_UTILS_STORAGE_PRIORITY_QUEUE_H
+
+//  includes
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <new>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace utils {
+    namespace storage {
+
+        //  default observer, PriorityQueue reports every element that lands on a new index to it
+        struct NoHeapObserver {
+            template<typename T>
+            void operator()(const T&, const std::size_t) {}
+        };
+
+        //  PriorityQueue
+        //  implicit D-ary heap, top() is the element no other element compares greater than
+        //  the array is offset by D - 1 slots and aligned to a cache line so the D children
+        //  of a node are contiguous and never straddle a line when D * sizeof(T) divides 64,
+        //  a sift down then costs one cache miss per level with a tree a quarter (D=4)
+        //  or a third (D=8) as deep as a binary heap
+        template<typename T, typename Compare = std::less<T>, std::size_t D = 4, typename Observer = NoHeapObserver>
+        class PriorityQueue {
+
+            static_assert(D >= 2, "a heap needs at least two children per node");
+
+        public:
+            friend void swap(PriorityQueue& lhs, PriorityQueue& rhs) noexcept
+            {
+                using std::swap;
+                swap(lhs.mRaw, rhs.mRaw);
+                swap(lhs.mElements, rhs.mElements);
+                swap(lhs.mCapacity, rhs.mCapacity);
+                swap(lhs.mSize, rhs.mSize);
+                swap(lhs.mLess, rhs.mLess);
+                swap(lhs.mObserver, rhs.mObserver);
+            }
+
+        private:
+            enum { DEFAULT_SIZE = 16, CACHE_LINE = 64 };
+
+        public:
+            explicit PriorityQueue(const Compare& comp = Compare(), const Observer& observer = Observer());
+            template<typename InputIt>
+            PriorityQueue(InputIt first, InputIt last, const Compare& comp = Compare());
+            PriorityQueue(const PriorityQueue& rhs);
+            PriorityQueue(PriorityQueue&& rhs) noexcept;
+            ~PriorityQueue() noexcept;
+
+            PriorityQueue& operator=(const PriorityQueue& rhs);
+            PriorityQueue& operator=(PriorityQueue&& rhs) noexcept;
+
+            void push(const T& t);
+            void push(T&& t);
+            template<typename ...Args>
+            void emplace(Args&&... args);
+
+            //  no op on an empty queue
+            void pop();
+
+            //  it is up to the caller to make sure the queue is non-empty
+            const T& top() const { return mElements[0]; }
+
+            //  replaces the contents with [first, last) and builds the heap bottom up in O(n)
+            template<typename InputIt>
+            void heapify(InputIt first, InputIt last);
+
+            void reserve(const std::size_t capacity);
+            void clear();
+
+            bool empty() const { return mSize == 0; }
+            std::size_t getSize() const { return mSize; }
+            std::size_t getCapacity() const { return mCapacity; }
+
+            //  positional access for wrappers that track where elements live
+            const T& at(const std::size_t index) const { return mElements[index]; }
+            T& at(const std::size_t index) { return mElements[index]; }
+            void update(const std::size_t index);
+            void erase(const std::size_t index);
+
+            Observer& getObserver() { return mObserver; }
+            const Observer& getObserver() const { return mObserver; }
+
+        private:
+            void grow();
+            void reallocate(const std::size_t capacity);
+            void siftUp(std::size_t index);
+            void siftDown(std::size_t index);
+            std::size_t greatestChild(const std::size_t first, const std::size_t size) const;
+            void place(const std::size_t index, T&& t);
+            void destroyAll() noexcept;
+
+        private:
+            void* mRaw = nullptr;
+            T* mElements = nullptr;
+            std::size_t mCapacity = 0;
+            std::size_t mSize = 0;
+            Compare mLess;
+            Observer mObserver;
+        };
+
+        template<typename T, typename Compare, std::size_t D, typename Observer>
+        PriorityQueue<T, Compare, D, Observer>::PriorityQueue(const Compare& comp, const Observer& observer)
+            : mLess(comp)
+            , mObserver(observer)
+        {
+        }
+
+        template<typename T, typename Compare, std::size_t D, typename Observer>
+        template<typename InputIt>
+        PriorityQueue<T, Compare, D, Observer>::PriorityQueue(InputIt first, InputIt last, const Compare& comp)
+            : mLess(comp)
+        {
+            heapify(first, last);
+        }
+
+        template<typename T, typename Compare, std::size_t D, typename Observer>
+        PriorityQueue<T, Compare, D, Observer>::PriorityQueue(const PriorityQueue& rhs)
+            : mLess(rhs.mLess)
+            , mObserver(rhs.mObserver)
+        {
+            reserve(rhs.mSize);
+
+            try {
+                for (; mSize < rhs.mSize; ++mSize) {
+                    new (mElements + mSize) T(rhs.mElements[mSize]);
+                }
+            } catch (...) {
+                destroyAll();
+                throw;
+            }
+        }
+
+        template<typename T, typename Compare, std::size_t D, typename Observer>
+        PriorityQueue<T, Compare, D, Observer>::PriorityQueue(PriorityQueue&& rhs) noexcept
+        {
+            using std::swap;
+            swap(*this, rhs);
+        }
+
+        template<typename T, typename Compare, std::size_t D, typename Observer>
+        PriorityQueue<T, Compare, D, Observer>::~PriorityQueue() noexcept
+        {
+            try {
+                destroyAll();
+            } catch (...) {
+                //  T's destructor could be set to noexcept(false) and throw during the delete call
+                //  do not allow any exceptions to propogate from a destructor
+            }
+        }
+
+        template<typename T, typename Compare, std::size_t D, typename Observer>
+        PriorityQueue<T, Compare, D, Observer>& PriorityQueue<T, Compare, D, Observer>::operator=(const PriorityQueue& rhs)
+        {
+            //  check for self assignment
+            if (this != &rhs) {
+
+                //  make a copy
+                PriorityQueue rhsCopy(rhs);
+
+                //  swap with copy
+                using std::swap;
+                swap(*this, rhsCopy);
+            }
+
+            return *this;
+        }
+
+        template<typename T, typename Compare, std::size_t D, typename Observer>
+        PriorityQueue<T, Compare, D, Observer>& PriorityQueue<T, Compare, D, Observer>::operator=(PriorityQueue&& rhs) noexcept
+        {
+            //  check for self move
+            if (this != &rhs) {
+                using std::swap;
+                swap(*this, rhs);
+            }
+
+            return *this;
+        }
+
+        template<typename T, typename Compare, std::size_t D, typename Observer>
+        void PriorityQueue<T, Compare, D, Observer>::push(const T& t)
+        {
+            emplace(t);
+        }
+
+        template<typename T, typename Compare, std::size_t D, typename Observer>
+        void PriorityQueue<T, Compare, D, Observer>::push(T&& t)
+        {
+            emplace(std::move(t));
+        }
+
+        template<typename T, typename Compare, std::size_t D, typename Observer>
+        template<typename ...Args>
+        void PriorityQueue<T, Compare, D, Observer>::emplace(Args&&... args)
+        {
+            if (mSize == mCapacity) {
+                grow();
+            }
+
+            //  T constructor may throw, the slot is only counted once constructed
+            new (mElements + mSize) T(std::forward<Args>(args)...);
+            ++mSize;
+
+            siftUp(mSize - 1);
+        }
+
+        template<typename T, typename Compare, std::size_t D, typename Observer>
+        void PriorityQueue<T, Compare, D, Observer>::pop()
+        {
+            if (empty()) return;
+
+            const std::size_t last = mSize - 1;
+
+            //  bottom up: walk the hole from the root to a leaf promoting the greatest child,
+            //  without comparing against the element that will fill it, then let that element
+            //  rise from the leaf, which is usually only a level or two
+            std::size_t index = 0;
+            for (;;) {
+                const std::size_t first = index * D + 1;
+                if (first >= last) break;
+
+                const std::size_t best = greatestChild(first, last);
+                place(index, std::move(mElements[best]));
+                index = best;
+            }
+
+            if (index != last) {
+                place(index, std::move(mElements[last]));
+            }
+
+            (mElements + last)->~T();
+            --mSize;
+
+            if (index < mSize) {
+                siftUp(index);
+            }
+        }
+
+        template<typename T, typename Compare, std::size_t D, typename Observer>
+        template<typename InputIt>
+        void PriorityQueue<T, Compare, D, Observer>::heapify(InputIt first, InputIt last)
+        {
+            clear();
+
+            for (; first != last; ++first) {
+                if (mSize == mCapacity) {
+                    grow();
+                }
+
+                new (mElements + mSize) T(*first);
+                ++mSize;
+            }
+
+            if (mSize < 2) {
+                if (mSize == 1) {
+                    mObserver(mElements[0], 0);
+                }
+
+                return;
+            }
+
+            //  leaves need no work, sift every internal node down starting from the last one
+            for (std::size_t i = 0; i < mSize; ++i) {
+                mObserver(mElements[i], i);
+            }
+
+            for (std::size_t i = (mSize - 2) / D + 1; i-- > 0;) {
+                siftDown(i);
+            }
+        }
+
+        template<typename T, typename Compare, std::size_t D, typename Observer>
+        void PriorityQueue<T, Compare, D, Observer>::reserve(const std::size_t capacity)
+        {
+            if (capacity > mCapacity) {
+                reallocate(capacity);
+            }
+        }
+
+        template<typename T, typename Compare, std::size_t D, typename Observer>
+        void PriorityQueue<T, Compare, D, Observer>::clear()
+        {
+            for (std::size_t i = 0; i < mSize; ++i) {
+                (mElements + i)->~T();
+            }
+
+            mSize = 0;
+        }
+
+        //  restores the heap after the element at index has been changed in place
+        template<typename T, typename Compare, std::size_t D, typename Observer>
+        void PriorityQueue<T, Compare, D, Observer>::update(const std::size_t index)
+        {
+            if (index > 0 && mLess(mElements[(index - 1) / D], mElements[index])) {
+                siftUp(index);
+            } else {
+                siftDown(index);
+            }
+        }
+
+        //  removes the element at index in O(D log n)
+        template<typename T, typename Compare, std::size_t D, typename Observer>
+        void PriorityQueue<T, Compare, D, Observer>::erase(const std::size_t index)
+        {
+            const std::size_t last = mSize - 1;
+
+            if (index != last) {
+                //  fill the hole with the last element and restore the heap from there
+                mElements[index] = std::move(mElements[last]);
+                mObserver(mElements[index], index);
+            }
+
+            (mElements + last)->~T();
+            --mSize;
+
+            if (index < mSize) {
+                update(index);
+            }
+        }
+
+        template<typename T, typename Compare, std::size_t D, typename Observer>
+        void PriorityQueue<T, Compare, D, Observer>::grow()
+        {
+            if (mCapacity > std::numeric_limits<std::size_t>::max() / (2 * sizeof(T))) {
+                throw std::length_error("priority queue cannot grow any larger");
+            }
+
+            reallocate(mCapacity == 0 ? static_cast<std::size_t>(DEFAULT_SIZE) : mCapacity * 2);
+        }
+
+        //  moves the elements into a new cache line aligned block with room for capacity elements
+        template<typename T, typename Compare, std::size_t D, typename Observer>
+        void PriorityQueue<T, Compare, D, Observer>::reallocate(const std::size_t capacity)
+        {
+            //  D - 1 unused slots in front of the root put every group of siblings at a multiple of D slots
+            void* raw = ::operator new((capacity + D - 1) * sizeof(T) + CACHE_LINE);
+            const std::uintptr_t aligned = (reinterpret_cast<std::uintptr_t>(raw) + CACHE_LINE - 1) & ~static_cast<std::uintptr_t>(CACHE_LINE - 1);
+            T* elements = reinterpret_cast<T*>(aligned) + (D - 1);
+
+            std::size_t current = 0;
+            try {
+                for (; current < mSize; ++current) {
+                    new (elements + current) T(std::move_if_noexcept(mElements[current]));
+                }
+            } catch (...) {
+                for (std::size_t i = 0; i < current; ++i) {
+                    (elements + i)->~T();
+                }
+
+                ::operator delete(raw);
+                throw;
+            }
+
+            const std::size_t size = mSize;
+            destroyAll();
+
+            mRaw = raw;
+            mElements = elements;
+            mCapacity = capacity;
+            mSize = size;
+        }
+
+        //  hole based, the moving element is only written once at its final index
+        template<typename T, typename Compare, std::size_t D, typename Observer>
+        void PriorityQueue<T, Compare, D, Observer>::siftUp(std::size_t index)
+        {
+            T value(std::move(mElements[index]));
+
+            while (index > 0) {
+                const std::size_t parent = (index - 1) / D;
+                if (!mLess(mElements[parent], value)) break;
+
+                place(index, std::move(mElements[parent]));
+                index = parent;
+            }
+
+            place(index, std::move(value));
+        }
+
+        template<typename T, typename Compare, std::size_t D, typename Observer>
+        void PriorityQueue<T, Compare, D, Observer>::siftDown(std::size_t index)
+        {
+            T value(std::move(mElements[index]));
+
+            for (;;) {
+                const std::size_t first = index * D + 1;
+                if (first >= mSize) break;
+
+                const std::size_t best = greatestChild(first, mSize);
+                if (!mLess(value, mElements[best])) break;
+
+                place(index, std::move(mElements[best]));
+                index = best;
+            }
+
+            place(index, std::move(value));
+        }
+
+        //  the greatest of the up to D children starting at first, all on the same cache line
+        //  a full group has a constant trip count and a select the compiler can make branchless,
+        //  random keys would otherwise mispredict on most of those compares
+        template<typename T, typename Compare, std::size_t D, typename Observer>
+        std::size_t PriorityQueue<T, Compare, D, Observer>::greatestChild(const std::size_t first, const std::size_t size) const
+        {
+            std::size_t best = first;
+
+            if (first + D <= size) {
+                for (std::size_t child = 1; child < D; ++child) {
+                    best = mLess(mElements[best], mElements[first + child]) ? first + child : best;
+                }
+            } else {
+                for (std::size_t child = first + 1; child < size; ++child) {
+                    best = mLess(mElements[best], mElements[child]) ? child : best;
+                }
+            }
+
+            return best;
+        }
+
+        template<typename T, typename Compare, std::size_t D, typename Observer>
+        void PriorityQueue<T, Compare, D, Observer>::place(const std::size_t index, T&& t)
+        {
+            mElements[index] = std::move(t);
+            mObserver(mElements[index], index);
+        }
+
+        template<typename T, typename Compare, std::size_t D, typename Observer>
+        void PriorityQueue<T, Compare, D, Observer>::destroyAll() noexcept
+        {
+            if (!mRaw) return;
+
+            for (std::size_t i = 0; i < mSize; ++i) {
+                (mElements + i)->~T();
+            }
+
+            ::operator delete(mRaw);
+
+            mRaw = nullptr;
+            mElements = nullptr;
+            mCapacity = 0;
+            mSize = 0;
+        }
+
+        //  IndexedPriorityQueue
+        //  PriorityQueue whose elements can be reached again through the Handle returned by push,
+        //  so a queued element can have its priority changed or be removed in O(D log n),
+        //  the usual shape for Dijkstra or A* open sets
+        template<typename T, typename Compare = std::less<T>, std::size_t D = 4>
+        class IndexedPriorityQueue {
+
+        public:
+            typedef std::size_t Handle;
+
+        private:
+            struct Entry {
+                T mValue;
+                Handle mHandle;
+            };
+
+            struct EntryCompare {
+                EntryCompare() = default;
+                explicit EntryCompare(const Compare& comp) : mLess(comp) {}
+
+                bool operator()(const Entry& lhs, const Entry& rhs) const { return mLess(lhs.mValue, rhs.mValue); }
+
+                Compare mLess;
+            };
+
+            //  keeps the heap index of every live handle up to date
+            struct PositionObserver {
+                void operator()(const Entry& entry, const std::size_t index) { mPositions[entry.mHandle] = index; }
+
+                std::vector<std::size_t> mPositions;
+            };
+
+            enum : std::size_t { FREE_HANDLE = ~static_cast<std::size_t>(0) };
+
+        public:
+            explicit IndexedPriorityQueue(const Compare& comp = Compare()) : mHeap(EntryCompare(comp)) {}
+
+            Handle push(const T& t);
+            void pop();
+            const T& top() const { return mHeap.top().mValue; }
+            Handle topHandle() const { return mHeap.top().mHandle; }
+
+            //  value must compare greater than the current one, moves the element towards the top
+            void decrease_key(const Handle handle, const T& value);
+            //  any new value, moves the element whichever way it needs to go
+            void update(const Handle handle, const T& value);
+            void erase(const Handle handle);
+
+            bool contains(const Handle handle) const;
+            const T& get(const Handle handle) const { return mHeap.at(positions()[handle]).mValue; }
+
+            void reserve(const std::size_t capacity);
+            void clear();
+
+            bool empty() const { return mHeap.empty(); }
+            std::size_t getSize() const { return mHeap.getSize(); }
+
+        private:
+            std::vector<std::size_t>& positions() { return mHeap.getObserver().mPositions; }
+            const std::vector<std::size_t>& positions() const { return mHeap.getObserver().mPositions; }
+            void release(const Handle handle);
+
+        private:
+            PriorityQueue<Entry, EntryCompare, D, PositionObserver> mHeap;
+            std::vector<Handle> mFreeHandles;
+        };
+
+        template<typename T, typename Compare, std::size_t D>
+        typename IndexedPriorityQueue<T, Compare, D>::Handle IndexedPriorityQueue<T, Compare, D>::push(const T& t)
+        {
+            //  reuse a released handle before growing the position table
+            Handle handle;
+            if (!mFreeHandles.empty()) {
+                handle = mFreeHandles.back();
+                mFreeHandles.pop_back();
+            } else {
+                handle = positions().size();
+                positions().push_back(FREE_HANDLE);
+            }
+
+            try {
+                mHeap.push(Entry{ t, handle });
+            } catch (...) {
+                mFreeHandles.push_back(handle);
+                throw;
+            }
+
+            return handle;
+        }
+
+        template<typename T, typename Compare, std::size_t D>
+        void IndexedPriorityQueue<T, Compare, D>::pop()
+        {
+            if (empty()) return;
+
+            const Handle handle = topHandle();
+            mHeap.pop();
+            release(handle);
+        }
+
+        template<typename T, typename Compare, std::size_t D>
+        void IndexedPriorityQueue<T, Compare, D>::decrease_key(const Handle handle, const T& value)
+        {
+            //  the element can only move up, update() picks the direction by comparing with the parent
+            update(handle, value);
+        }
+
+        template<typename T, typename Compare, std::size_t D>
+        void IndexedPriorityQueue<T, Compare, D>::update(const Handle handle, const T& value)
+        {
+            const std::size_t index = positions()[handle];
+            mHeap.at(index).mValue = value;
+            mHeap.update(index);
+        }
+
+        template<typename T, typename Compare, std::size_t D>
+        void IndexedPriorityQueue<T, Compare, D>::erase(const Handle handle)
+        {
+            mHeap.erase(positions()[handle]);
+            release(handle);
+        }
+
+        template<typename T, typename Compare, std::size_t D>
+        bool IndexedPriorityQueue<T, Compare, D>::contains(const Handle handle) const
+        {
+            return handle < positions().size() && positions()[handle] != FREE_HANDLE;
+        }
+
+        template<typename T, typename Compare, std::size_t D>
+        void IndexedPriorityQueue<T, Compare, D>::reserve(const std::size_t capacity)
+        {
+            mHeap.reserve(capacity);
+            positions().reserve(capacity);
+        }
+
+        template<typename T, typename Compare, std::size_t D>
+        void IndexedPriorityQueue<T, Compare, D>::clear()
+        {
+            mHeap.clear();
+            positions().clear();
+            mFreeHandles.clear();
+        }
+
+        template<typename T, typename Compare, std::size_t D>
+        void IndexedPriorityQueue<T, Compare, D>::release(const Handle handle)
+        {
+            positions()[handle] = FREE_HANDLE;
+            mFreeHandles.push_back(handle);
+        }
+    }
+}
+
+#endif
@@ -3,19 +3,25 @@
 
 //  includes
 #include <stdexcept>
+#include <utility>
+#include "container_stats.h"
 
 namespace utils {
     namespace storage {
 
-        template<typename T>
-        class Queue {
+        template<typename T, typename Stats = NoStats>
+        class Queue : private Stats {
 
         //  friends
-        friend void swap(Queue<T>& lhs, Queue<T>& rhs) noexcept
+        friend void swap(Queue<T, Stats>& lhs, Queue<T, Stats>& rhs) noexcept
         {
             Node* temp = lhs.mHead;
             lhs.mHead = rhs.mHead;
             rhs.mHead = temp;				
+
+            //  the statistics follow the elements
+            using std::swap;
+            swap(static_cast<Stats&>(lhs), static_cast<Stats&>(rhs));
         }
 
         private:
@@ -26,12 +32,12 @@ namespace utils {
 
         public:
             Queue() = default;
-            Queue(const Queue<T>& rhs);
-            Queue(Queue<T>&& rhs) noexcept;
+            Queue(const Queue<T, Stats>& rhs);
+            Queue(Queue<T, Stats>&& rhs) noexcept;
             ~Queue();
 
-            Queue<T>& operator=(const Queue<T>& rhs);
-            Queue<T>& operator=(Queue<T>&& rhs) noexcept;
+            Queue<T, Stats>& operator=(const Queue<T, Stats>& rhs);
+            Queue<T, Stats>& operator=(Queue<T, Stats>&& rhs) noexcept;
 
             T& front();
             const T& front() const;
@@ -50,6 +56,11 @@ namespace utils {
 
             void clear();
 
+            //  counts kept by the Stats policy, all zero under NoStats
+            ContainerStats stats() const { return Stats::snapshot(); }
+            //  the elements as payload, the object and node links as overhead, walks the queue
+            MemoryUsage memory_usage() const;
+
         private:
             Node* deepCopy(Node* node);
 
@@ -59,23 +70,23 @@ namespace utils {
         };  //  Queue
 
         //  Queue
-        template<typename T>
-        Queue<T>::Queue(const Queue<T>& rhs)
+        template<typename T, typename Stats>
+        Queue<T, Stats>::Queue(const Queue<T, Stats>& rhs)
         {
             if (rhs.mHead) {
                 mHead = deepCopy(rhs.mHead);
             }
         }
 
-        template<typename T>
-        Queue<T>::Queue(Queue<T>&& rhs) noexcept
+        template<typename T, typename Stats>
+        Queue<T, Stats>::Queue(Queue<T, Stats>&& rhs) noexcept
         {
             using std::swap;
             swap(*this, rhs);
         }
 
-        template<typename T>
-        Queue<T>::~Queue()
+        template<typename T, typename Stats>
+        Queue<T, Stats>::~Queue()
         {
             try {
                 clear();
@@ -85,14 +96,14 @@ namespace utils {
             }
         }
 
-        template<typename T>
-        Queue<T>& Queue<T>::operator=(const Queue<T>& rhs)
+        template<typename T, typename Stats>
+        Queue<T, Stats>& Queue<T, Stats>::operator=(const Queue<T, Stats>& rhs)
         {
             //  check for self-assignment
             if (this != &rhs) {
 
                 //  make a copy of rhs
-                Queue<T> rhsCopy(rhs);
+                Queue<T, Stats> rhsCopy(rhs);
 
                 //  swap that copy with this object
                 using std::swap;
@@ -102,8 +113,8 @@ namespace utils {
             return *this;
         }
 
-        template<typename T>
-        Queue<T>& Queue<T>::operator=(Queue<T>&& rhs) noexcept
+        template<typename T, typename Stats>
+        Queue<T, Stats>& Queue<T, Stats>::operator=(Queue<T, Stats>&& rhs) noexcept
         {
             //  check for self-move
             if (this != &rhs) {
@@ -116,8 +127,8 @@ namespace utils {
             return *this;
         }
 
-        template<typename T>
-        typename Queue<T>::Node* Queue<T>::deepCopy(typename Queue<T>::Node* node)
+        template<typename T, typename Stats>
+        typename Queue<T, Stats>::Node* Queue<T, Stats>::deepCopy(typename Queue<T, Stats>::Node* node)
         {
             if (nullptr == node->mNext) {
                 //  at tail
@@ -125,7 +136,9 @@ namespace utils {
                 //  if an exception is thrown here allow it to progate out of this function
                 //  to be handled by the calling code
                 //  no memory will be leaked
-                return new Node{ node->mData, nullptr };
+                Node* tail = new Node{ node->mData, nullptr };
+                this->onAllocate(1);
+                return tail;
             }
 
             Node* next = deepCopy(node->mNext);
@@ -133,6 +146,7 @@ namespace utils {
 
             try {
                 current = new Node{ node->mData, next };
+                this->onAllocate(1);
             } catch (...) {
                 //  something went wrong
                 //  recursively deallocate any nodes that have been allocated up to this point
@@ -142,6 +156,7 @@ namespace utils {
                     Node* copy = i->mNext;
                     //  delete current node
                     delete i;
+                    this->onFree(1);
                     //  iterate to next node
                     i = copy;
                 }
@@ -150,8 +165,8 @@ namespace utils {
             return current;
         }
 
-        template<typename T>
-        T& Queue<T>::front()
+        template<typename T, typename Stats>
+        T& Queue<T, Stats>::front()
         {
             if (mHead) {
                 return mHead->mData;
@@ -160,8 +175,8 @@ namespace utils {
             }
         }
 
-        template<typename T>
-        const T& Queue<T>::front() const
+        template<typename T, typename Stats>
+        const T& Queue<T, Stats>::front() const
         {
             if (mHead) {
                 return mHead->mData;
@@ -170,62 +185,69 @@ namespace utils {
             }
         }
 
-        template<typename T>
-        void Queue<T>::pop_front() noexcept
+        template<typename T, typename Stats>
+        void Queue<T, Stats>::pop_front() noexcept
         {
             if (mHead) {
                 Node* newHead = mHead->mNext;
                 Node* oldHead = mHead;
                 mHead = newHead;
                 delete oldHead;
+                this->onFree(1);
             }
         }
 
-        template<typename T>
+        template<typename T, typename Stats>
         template<typename ...Args>
-        void Queue<T>::emplace_front(Args&&... args)
+        void Queue<T, Stats>::emplace_front(Args&&... args)
         {
             push_front(std::forward<Args>(args)...);
         }
 
-        template<typename T>
+        template<typename T, typename Stats>
         template<typename ...Args>
-        void Queue<T>::emplace_back(Args&&... args)
+        void Queue<T, Stats>::emplace_back(Args&&... args)
         {
             push_back(std::forward<Args>(args)...);
         }
 
-        template<typename T>
-        void Queue<T>::push_front(const T& data)
+        template<typename T, typename Stats>
+        void Queue<T, Stats>::push_front(const T& data)
         {
             Node* prevHead = mHead;
             Node* newHead = new Node{ data, prevHead };
             //  if new throws queue will still be in the same state it was before call to push_front
             //  only once we successfully get to this stage do we set the head pointer
             mHead = newHead;
+            this->onAllocate(1);
         }
 
-        template<typename T>
-        void Queue<T>::push_front(T&& data)
+        template<typename T, typename Stats>
+        void Queue<T, Stats>::push_front(T&& data)
         {
             Node* prevHead = mHead;
             Node* newHead = new Node{ std::move(data), prevHead };
             //  if new throws queue will still be in the same state it was before call to push_front
             //  only once we successfully get to this stage do we set the head pointer
             mHead = newHead;
+            this->onAllocate(1);
         }
 
-        template<typename T>
-        void Queue<T>::push_back(const T& data)
+        template<typename T, typename Stats>
+        void Queue<T, Stats>::push_back(const T& data)
         {
             //  find the tail
             Node* tail = mHead;
+            std::size_t visited = 0;
             while (tail) {
+                ++visited;
                 if (nullptr == tail->mNext) break;
 
                 tail = tail->mNext;
             }
 
+            this->onWalk(visited);
+
             if (tail) {
                 Node* newHead = new Node{ data, nullptr };
                 //  if new throws the queue will still be in the same state it was before call to push_back
@@ -236,19 +258,25 @@ namespace utils {
                 mHead = newHead;
             }
 
+            this->onAllocate(1);
+
         }
 
-        template<typename T>
-        void Queue<T>::push_back(T&& data)
+        template<typename T, typename Stats>
+        void Queue<T, Stats>::push_back(T&& data)
         {
             //  find the tail
             Node* tail = mHead;
+            std::size_t visited = 0;
             while (tail) {
+                ++visited;
                 if (nullptr == tail->mNext) break;
 
                 tail = tail->mNext;
             }
 
+            this->onWalk(visited);
+
             if (tail) {
                 Node* newHead = new Node{ std::move(data), nullptr };
                 //  if new throws queue will still be in the same state as before push_back was called
@@ -259,20 +287,39 @@ namespace utils {
                 mHead = newHead;
             }
 
+            this->onAllocate(1);
+
         }
 
-        template<typename T>
-        void Queue<T>::clear()
+        template<typename T, typename Stats>
+        void Queue<T, Stats>::clear()
         {
             //  iterate through the queue and destroy all the nodes
             Node* node = mHead;
+            std::size_t freed = 0;
             while (node) {
                 Node* next = node->mNext;
                 delete node;
+                ++freed;
                 node = next;
             }
 
             mHead = nullptr;
+            this->onFree(freed);
+        }
+
+        template<typename T, typename Stats>
+        MemoryUsage Queue<T, Stats>::memory_usage() const
+        {
+            std::size_t count = 0;
+            for (const Node* node = mHead; node; node = node->mNext) {
+                ++count;
+            }
+
+            MemoryUsage usage;
+            usage.mPayload = count * sizeof(T);
+            usage.mOverhead = sizeof(*this) + count * (sizeof(Node) - sizeof(T));
+            return usage;
         }
     }  //  storage
 }  //  utils
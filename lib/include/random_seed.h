@@ -0,0 +1,36 @@
+#ifndef H_UTILS_STORAGE_RANDOM_SEED_H
+#define H_UTILS_STORAGE_RANDOM_SEED_H
+
+//  includes
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace utils {
+    namespace storage {
+        namespace detail {
+
+            //  a different non zero seed on every call, for the containers that draw random priorities
+            //  so two of them filled the same way do not end up with the same shape
+            //  a shared counter keeps calls apart, the clock keeps runs apart, splitmix64 mixes both
+            inline std::uint32_t randomSeed()
+            {
+                static std::atomic<std::uint64_t> counter(0);
+                std::uint64_t x = counter.fetch_add(0x9E3779B97F4A7C15ull, std::memory_order_relaxed) ^
+                    static_cast<std::uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+
+                x ^= x >> 30;
+                x *= 0xBF58476D1CE4E5B9ull;
+                x ^= x >> 27;
+                x *= 0x94D049BB133111EBull;
+                x ^= x >> 31;
+
+                //  xorshift never leaves zero
+                const std::uint32_t seed = static_cast<std::uint32_t>(x ^ (x >> 32));
+                return seed != 0 ? seed : 0x9E3779B9u;
+            }
+        }
+    }
+}
+
+#endif
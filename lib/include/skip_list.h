@@ -0,0 +1,454 @@
+#ifndef H_UTILS_STORAGE_SKIP_LIST_H
+#define H_UTILS_STORAGE_SKIP_LIST_H
+
+//  includes
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <new>
+#include <utility>
+#include "epoch.h"
+
+namespace utils {
+    namespace storage {
+
+        //  ConcurrentSkipList
+        //  lock-free ordered map, any number of threads may insert, erase, find and iterate at once
+        //  every level is a singly linked list updated with CAS, a node is deleted by first marking
+        //  the low bit of its next pointers (logical deletion) and then unlinking it (physical deletion),
+        //  unlinked nodes and replaced values are freed through the epoch domain once no reader can see them
+        //  iteration is weakly consistent, it sees every element present for its whole duration
+        template<typename Key, typename Data, typename Compare = std::less<Key>>
+        class ConcurrentSkipList
+        {
+        public:
+            enum E_INSERT_RESULT
+            {
+                OVERWRITE_SAME_VALUE_IR,
+                OVERWRITE_DIFFERENT_VALUE_IR,
+                NEW_INSERT_IR
+            };
+
+            typedef std::pair<bool, E_INSERT_RESULT> INSERT_RESULT;
+
+            enum { MAX_LEVEL = 24 };
+
+        private:
+            typedef std::atomic<std::uintptr_t> Link;
+
+            //  set on a node's state by insert and erase when they are done with it,
+            //  whichever sets its bit second unlinks the node for good and retires it
+            enum { INSERT_DONE = 1, ERASE_DONE = 2 };
+
+            //  Node
+            //  the node's tower of next links is allocated directly after it
+            struct Node
+            {
+                Node(const Key& k, const unsigned height) : mKey(k), mHeight(height) {}
+
+                Link* levels() { return reinterpret_cast<Link*>(this + 1); }
+
+                Key mKey;
+                std::atomic<Data*> mData{ nullptr };
+                std::atomic<unsigned> mState{ 0 };
+                const unsigned mHeight;
+            };
+
+        public:
+            ConcurrentSkipList();
+            ConcurrentSkipList(const ConcurrentSkipList& rhs) = delete;
+            ~ConcurrentSkipList();
+
+            ConcurrentSkipList& operator=(const ConcurrentSkipList& rhs) = delete;
+
+            INSERT_RESULT insert(const Key& k, const Data& d);
+            bool erase(const Key& k);
+
+            bool find(const Key& k, Data& d) const;
+            bool contains(const Key& k) const;
+
+            //  f(key, data) for every element, in key order
+            template<typename Function>
+            void forEach(Function f) const;
+
+            //  f(key, data) for every element in [lo, hi), in key order
+            template<typename Function>
+            void forEachInRange(const Key& lo, const Key& hi, Function f) const;
+
+            //  exact when no operation is in flight
+            std::size_t getSize() const { return mSize.load(std::memory_order_relaxed); }
+
+        private:
+            static Node* pointer(const std::uintptr_t link) { return reinterpret_cast<Node*>(link & ~static_cast<std::uintptr_t>(1)); }
+            static bool isMarked(const std::uintptr_t link) { return (link & 1) != 0; }
+            static std::uintptr_t toLink(Node* node) { return reinterpret_cast<std::uintptr_t>(node); }
+
+            Link& nextOf(Node* node, const unsigned level) const { return node ? node->levels()[level] : mHead[level]; }
+
+            bool locate(const Key& k, Node** preds, Node** succs, const bool pastEqual);
+            Node* lowerBound(const Key& k) const;
+            void finish(Node* node, const unsigned done);
+
+            static unsigned randomHeight();
+            static Node* createNode(const Key& k, const Data& d, const unsigned height);
+            static void destroyNode(void* node);
+            static void destroyData(void* data);
+
+        private:
+            mutable Link mHead[MAX_LEVEL];
+            std::atomic<std::size_t> mSize{ 0 };
+            Compare mLess;
+        };
+
+        template<typename Key, typename Data, typename Compare>
+        ConcurrentSkipList<Key, Data, Compare>::ConcurrentSkipList()
+        {
+            for (unsigned i = 0; i < MAX_LEVEL; ++i) {
+                mHead[i].store(0, std::memory_order_relaxed);
+            }
+        }
+
+        //  must not race with any other operation
+        template<typename Key, typename Data, typename Compare>
+        ConcurrentSkipList<Key, Data, Compare>::~ConcurrentSkipList()
+        {
+            //  nodes already erased have been unlinked and retired, everything left on level 0 is live
+            Node* node = pointer(mHead[0].load(std::memory_order_acquire));
+            while (node) {
+                Node* next = pointer(node->levels()[0].load(std::memory_order_relaxed));
+                destroyNode(node);
+                node = next;
+            }
+        }
+
+        template<typename Key, typename Data, typename Compare>
+        typename ConcurrentSkipList<Key, Data, Compare>::INSERT_RESULT ConcurrentSkipList<Key, Data, Compare>::insert(const Key& k, const Data& d)
+        {
+            using utils::concurrency::EpochDomain;
+            utils::concurrency::EpochGuard guard;
+
+            Node* preds[MAX_LEVEL];
+            Node* succs[MAX_LEVEL];
+            Node* node = nullptr;
+
+            for (;;) {
+                if (locate(k, preds, succs, false)) {
+                    //  key present, swap in a new value and retire the old one
+                    Data* fresh = new Data(d);
+                    Data* old = succs[0]->mData.exchange(fresh, std::memory_order_acq_rel);
+
+                    INSERT_RESULT insertResult(true, (*old == d) ? OVERWRITE_SAME_VALUE_IR : OVERWRITE_DIFFERENT_VALUE_IR);
+                    EpochDomain::instance().retire(old, &destroyData);
+
+                    if (node) {
+                        //  lost a race with another insert of the same key, node was never published
+                        destroyNode(node);
+                    }
+
+                    return insertResult;
+                }
+
+                if (node == nullptr) {
+                    node = createNode(k, d, randomHeight());
+                }
+
+                for (unsigned i = 0; i < node->mHeight; ++i) {
+                    node->levels()[i].store(toLink(succs[i]), std::memory_order_relaxed);
+                }
+
+                //  linking level 0 is what makes the node part of the map
+                std::uintptr_t expected = toLink(succs[0]);
+                if (nextOf(preds[0], 0).compare_exchange_strong(expected, toLink(node), std::memory_order_release, std::memory_order_relaxed)) {
+                    break;
+                }
+            }
+
+            mSize.fetch_add(1, std::memory_order_relaxed);
+
+            //  link the upper levels, giving up as soon as an erase has marked the node
+            for (unsigned level = 1; level < node->mHeight; ++level) {
+                for (;;) {
+                    std::uintptr_t mine = node->levels()[level].load(std::memory_order_acquire);
+                    if (isMarked(mine)) {
+                        finish(node, INSERT_DONE);
+                        return INSERT_RESULT(true, NEW_INSERT_IR);
+                    }
+
+                    //  point at the current successor, fails only if an erase marked it meanwhile
+                    if (mine != toLink(succs[level]) &&
+                        !node->levels()[level].compare_exchange_strong(mine, toLink(succs[level]), std::memory_order_acq_rel)) {
+                        finish(node, INSERT_DONE);
+                        return INSERT_RESULT(true, NEW_INSERT_IR);
+                    }
+
+                    std::uintptr_t expected = toLink(succs[level]);
+                    if (nextOf(preds[level], level).compare_exchange_strong(expected, toLink(node), std::memory_order_release, std::memory_order_relaxed)) {
+                        break;
+                    }
+
+                    //  the neighbourhood changed, search again
+                    locate(k, preds, succs, false);
+                    if (succs[0] != node) {
+                        //  node has already been erased
+                        finish(node, INSERT_DONE);
+                        return INSERT_RESULT(true, NEW_INSERT_IR);
+                    }
+                }
+            }
+
+            finish(node, INSERT_DONE);
+            return INSERT_RESULT(true, NEW_INSERT_IR);
+        }
+
+        template<typename Key, typename Data, typename Compare>
+        bool ConcurrentSkipList<Key, Data, Compare>::erase(const Key& k)
+        {
+            utils::concurrency::EpochGuard guard;
+
+            Node* preds[MAX_LEVEL];
+            Node* succs[MAX_LEVEL];
+
+            if (!locate(k, preds, succs, false)) {
+                return false;
+            }
+
+            Node* victim = succs[0];
+
+            //  mark the upper levels top down so no new link can be built through them
+            for (unsigned level = victim->mHeight - 1; level > 0; --level) {
+                std::uintptr_t link = victim->levels()[level].load(std::memory_order_acquire);
+                while (!isMarked(link)) {
+                    victim->levels()[level].compare_exchange_weak(link, link | 1, std::memory_order_acq_rel);
+                }
+            }
+
+            //  marking level 0 is the logical deletion, only one eraser can win it
+            std::uintptr_t link = victim->levels()[0].load(std::memory_order_acquire);
+            for (;;) {
+                if (isMarked(link)) {
+                    //  erased by another thread first
+                    return false;
+                }
+
+                if (victim->levels()[0].compare_exchange_weak(link, link | 1, std::memory_order_acq_rel)) {
+                    break;
+                }
+            }
+
+            mSize.fetch_sub(1, std::memory_order_relaxed);
+            finish(victim, ERASE_DONE);
+
+            return true;
+        }
+
+        template<typename Key, typename Data, typename Compare>
+        bool ConcurrentSkipList<Key, Data, Compare>::find(const Key& k, Data& d) const
+        {
+            utils::concurrency::EpochGuard guard;
+
+            Node* node = lowerBound(k);
+            if (node == nullptr || mLess(k, node->mKey)) {
+                return false;
+            }
+
+            d = *node->mData.load(std::memory_order_acquire);
+            return true;
+        }
+
+        template<typename Key, typename Data, typename Compare>
+        bool ConcurrentSkipList<Key, Data, Compare>::contains(const Key& k) const
+        {
+            utils::concurrency::EpochGuard guard;
+
+            Node* node = lowerBound(k);
+            return node != nullptr && !mLess(k, node->mKey);
+        }
+
+        template<typename Key, typename Data, typename Compare>
+        template<typename Function>
+        void ConcurrentSkipList<Key, Data, Compare>::forEach(Function f) const
+        {
+            utils::concurrency::EpochGuard guard;
+
+            Node* node = pointer(mHead[0].load(std::memory_order_acquire));
+            while (node) {
+                const std::uintptr_t next = node->levels()[0].load(std::memory_order_acquire);
+                if (!isMarked(next)) {
+                    f(node->mKey, *node->mData.load(std::memory_order_acquire));
+                }
+
+                node = pointer(next);
+            }
+        }
+
+        template<typename Key, typename Data, typename Compare>
+        template<typename Function>
+        void ConcurrentSkipList<Key, Data, Compare>::forEachInRange(const Key& lo, const Key& hi, Function f) const
+        {
+            utils::concurrency::EpochGuard guard;
+
+            Node* node = lowerBound(lo);
+            while (node && mLess(node->mKey, hi)) {
+                const std::uintptr_t next = node->levels()[0].load(std::memory_order_acquire);
+                if (!isMarked(next)) {
+                    f(node->mKey, *node->mData.load(std::memory_order_acquire));
+                }
+
+                node = pointer(next);
+            }
+        }
+
+        //  fills preds/succs with the nodes either side of k on every level, unlinking marked nodes on the way
+        //  with pastEqual the search runs past nodes equal to k, used to sweep up a deleted node
+        //  returns true if an unmarked node with key k was found on level 0
+        template<typename Key, typename Data, typename Compare>
+        bool ConcurrentSkipList<Key, Data, Compare>::locate(const Key& k, Node** preds, Node** succs, const bool pastEqual)
+        {
+        retry:
+            Node* pred = nullptr;
+
+            for (unsigned level = MAX_LEVEL; level-- > 0;) {
+                Node* curr = pointer(nextOf(pred, level).load(std::memory_order_acquire));
+
+                while (curr) {
+                    std::uintptr_t succ = curr->levels()[level].load(std::memory_order_acquire);
+
+                    //  curr is deleted, snip it out of this level
+                    while (isMarked(succ)) {
+                        std::uintptr_t expected = toLink(curr);
+                        if (!nextOf(pred, level).compare_exchange_strong(expected, succ & ~static_cast<std::uintptr_t>(1),
+                            std::memory_order_acq_rel, std::memory_order_relaxed)) {
+                            //  pred changed under us, start again from the top
+                            goto retry;
+                        }
+
+                        curr = pointer(succ);
+                        if (curr == nullptr) break;
+
+                        succ = curr->levels()[level].load(std::memory_order_acquire);
+                    }
+
+                    if (curr == nullptr) break;
+
+                    if (mLess(curr->mKey, k) || (pastEqual && !mLess(k, curr->mKey))) {
+                        pred = curr;
+                        curr = pointer(succ);
+                    } else {
+                        break;
+                    }
+                }
+
+                preds[level] = pred;
+                succs[level] = curr;
+            }
+
+            return succs[0] != nullptr && !mLess(k, succs[0]->mKey);
+        }
+
+        //  read only search, returns the first live node with key >= k
+        template<typename Key, typename Data, typename Compare>
+        typename ConcurrentSkipList<Key, Data, Compare>::Node* ConcurrentSkipList<Key, Data, Compare>::lowerBound(const Key& k) const
+        {
+            Node* pred = nullptr;
+            Node* curr = nullptr;
+
+            for (unsigned level = MAX_LEVEL; level-- > 0;) {
+                curr = pointer(nextOf(pred, level).load(std::memory_order_acquire));
+
+                while (curr) {
+                    const std::uintptr_t succ = curr->levels()[level].load(std::memory_order_acquire);
+
+                    if (isMarked(succ)) {
+                        //  deleted, step over it without unlinking
+                        curr = pointer(succ);
+                    } else if (mLess(curr->mKey, k)) {
+                        pred = curr;
+                        curr = pointer(succ);
+                    } else {
+                        break;
+                    }
+                }
+            }
+
+            return curr;
+        }
+
+        //  insert and erase both report in here, the second to arrive sweeps the node off
+        //  every level it may still be linked on and retires it
+        template<typename Key, typename Data, typename Compare>
+        void ConcurrentSkipList<Key, Data, Compare>::finish(Node* node, const unsigned done)
+        {
+            const unsigned previous = node->mState.fetch_or(done, std::memory_order_acq_rel);
+            if (previous == 0) return;
+
+            Node* preds[MAX_LEVEL];
+            Node* succs[MAX_LEVEL];
+            locate(node->mKey, preds, succs, true);
+
+            utils::concurrency::EpochDomain::instance().retire(node, &destroyNode);
+        }
+
+        //  geometric with p = 1/2, capped at MAX_LEVEL
+        template<typename Key, typename Data, typename Compare>
+        unsigned ConcurrentSkipList<Key, Data, Compare>::randomHeight()
+        {
+            //  xorshift per thread, seeded from the thread's own address
+            thread_local std::uint64_t state = reinterpret_cast<std::uintptr_t>(&state) | 1;
+            state ^= state << 13;
+            state ^= state >> 7;
+            state ^= state << 17;
+
+            unsigned height = 1;
+            std::uint64_t bits = state;
+            while ((bits & 1) && height < MAX_LEVEL) {
+                ++height;
+                bits >>= 1;
+            }
+
+            return height;
+        }
+
+        template<typename Key, typename Data, typename Compare>
+        typename ConcurrentSkipList<Key, Data, Compare>::Node* ConcurrentSkipList<Key, Data, Compare>::createNode(const Key& k, const Data& d, const unsigned height)
+        {
+            void* memory = ::operator new(sizeof(Node) + height * sizeof(Link));
+            Node* node = nullptr;
+
+            try {
+                node = new (memory) Node(k, height);
+                for (unsigned i = 0; i < height; ++i) {
+                    new (node->levels() + i) Link(0);
+                }
+
+                node->mData.store(new Data(d), std::memory_order_relaxed);
+            } catch (...) {
+                if (node) {
+                    node->~Node();
+                }
+
+                ::operator delete(memory);
+                throw;
+            }
+
+            return node;
+        }
+
+        template<typename Key, typename Data, typename Compare>
+        void ConcurrentSkipList<Key, Data, Compare>::destroyNode(void* pointer)
+        {
+            Node* node = static_cast<Node*>(pointer);
+            delete node->mData.load(std::memory_order_relaxed);
+            node->~Node();
+            ::operator delete(pointer);
+        }
+
+        template<typename Key, typename Data, typename Compare>
+        void ConcurrentSkipList<Key, Data, Compare>::destroyData(void* data)
+        {
+            delete static_cast<Data*>(data);
+        }
+    }
+}
+
+#endif
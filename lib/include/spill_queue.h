@@ -0,0 +1,341 @@
+#ifndef H_UTILS_STORAGE_SPILL_QUEUE_H
+#define H_UTILS_STORAGE_SPILL_QUEUE_H
+
+//  includes
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include "mapped_file.h"
+#include "pooled_queue.h"
+
+namespace utils {
+    namespace storage {
+
+        //  TrivialCodec
+        //  the default SpillQueue codec, the bytes of T as they are
+        //  a codec for any other T provides the same three functions, getSize(t) bytes are handed
+        //  to encode and the same bytes, possibly unaligned, to decode
+        template<typename T>
+        struct TrivialCodec
+        {
+            static_assert(std::is_trivially_copyable<T>::value, "give SpillQueue a codec for a T that is not trivially copyable");
+
+            static std::size_t getSize(const T&) { return sizeof(T); }
+            static void encode(const T& t, void* out) { std::memcpy(out, &t, sizeof(T)); }
+
+            static T decode(const void* in, const std::size_t)
+            {
+                T t;
+                std::memcpy(&t, in, sizeof(T));
+                return t;
+            }
+        };
+
+        //  SpillQueue
+        //  FIFO queue that keeps at most memoryLimit elements in memory, past that the middle of the
+        //  queue goes to append-only segment files mapped into memory, so a burst is bounded by disk
+        //  instead of RAM
+        //
+        //  the front half of the limit is a PooledQueue the head is popped from, the back half a
+        //  PooledQueue new elements go to while anything is spilled, a full tail is encoded onto
+        //  the end of the last segment in one pass, and an empty head is refilled from the first
+        //  segment in one sequential read, so push_back and pop_front stay O(1) amortized
+        //
+        //  segments are named <pathPrefix>.<n>.seg, written once front to back and read once front to
+        //  back, the pages behind the read position are dropped, the ones ahead are prefetched, and a
+        //  segment is deleted as soon as it has been read
+        //  a record is its encoded size as 32 bits followed by the encoded bytes
+        //  every segment's blocks are reserved on disk when it is created, so a full disk makes
+        //  push_back throw std::runtime_error, with the queue as it was before the call, instead of
+        //  the process faulting on a store into the mapping
+        template<typename T, typename Codec = TrivialCodec<T>>
+        class SpillQueue {
+
+        //  friends
+        friend void swap(SpillQueue<T, Codec>& lhs, SpillQueue<T, Codec>& rhs) noexcept
+        {
+            using std::swap;
+            swap(lhs.mPathPrefix, rhs.mPathPrefix);
+            swap(lhs.mHeadLimit, rhs.mHeadLimit);
+            swap(lhs.mTailLimit, rhs.mTailLimit);
+            swap(lhs.mSegmentBytes, rhs.mSegmentBytes);
+            swap(lhs.mHead, rhs.mHead);
+            swap(lhs.mTail, rhs.mTail);
+            swap(lhs.mSegments, rhs.mSegments);
+            swap(lhs.mSpilled, rhs.mSpilled);
+            swap(lhs.mNextSegment, rhs.mNextSegment);
+        }
+
+        public:
+            enum
+            {
+                DEFAULT_SEGMENT_BYTES = 64 << 20,
+                //  bytes past the read position asked for at each refill
+                READAHEAD_BYTES = 1 << 20
+            };
+
+        private:
+            typedef std::uint32_t RecordSize;
+
+            struct Segment
+            {
+                MappedFile mFile;
+                std::string mPath;
+                std::size_t mWriteOffset;
+                std::size_t mReadOffset;
+            };
+
+        public:
+            //  memoryLimit is the number of elements kept in memory, at least 2, and segmentBytes
+            //  the size of each segment file, at least a record header, a record larger than that
+            //  gets a segment of its own
+            SpillQueue(const std::string& pathPrefix, const std::size_t memoryLimit, const std::size_t segmentBytes = DEFAULT_SEGMENT_BYTES);
+            SpillQueue(SpillQueue<T, Codec>&& rhs) noexcept;
+            ~SpillQueue() { clear(); }
+
+            SpillQueue(const SpillQueue<T, Codec>&) = delete;
+            SpillQueue<T, Codec>& operator=(const SpillQueue<T, Codec>&) = delete;
+            SpillQueue<T, Codec>& operator=(SpillQueue<T, Codec>&& rhs) noexcept;
+
+            //  throw std::logic_error on an empty queue
+            T& front();
+            const T& front() const;
+            void pop_front();
+
+            template<typename ...Args>
+            void emplace_back(Args&&... args);
+
+            void push_back(const T& data) { emplace_back(data); }
+            void push_back(T&& data) { emplace_back(std::move(data)); }
+
+            //  empties the queue and deletes every segment file
+            void clear();
+
+            bool empty() const { return mHead.empty(); }
+            std::size_t getSize() const { return mHead.getSize() + mSpilled + mTail.getSize(); }
+            std::size_t getMemoryCount() const { return mHead.getSize() + mTail.getSize(); }
+            std::size_t getSpilledCount() const { return mSpilled; }
+            std::size_t getSegmentCount() const { return mSegments.size(); }
+
+        private:
+            //  encodes the whole tail onto the segments
+            void spill();
+            //  fills the empty head from the segments, or with the tail once nothing is spilled
+            void refill();
+            //  a segment at the back with room for bytes more
+            Segment& writableSegment(const std::size_t bytes);
+            void removeFrontSegment();
+
+        private:
+            std::string mPathPrefix;
+            std::size_t mHeadLimit;
+            std::size_t mTailLimit;
+            std::size_t mSegmentBytes;
+
+            //  an empty head means an empty queue, everything else only holds elements behind it
+            PooledQueue<T> mHead;
+            PooledQueue<T> mTail;
+            std::deque<Segment> mSegments;
+            std::size_t mSpilled = 0;
+            std::size_t mNextSegment = 0;
+
+        };  //  SpillQueue
+
+        template<typename T, typename Codec>
+        SpillQueue<T, Codec>::SpillQueue(const std::string& pathPrefix, const std::size_t memoryLimit, const std::size_t segmentBytes)
+            : mPathPrefix(pathPrefix), mHeadLimit(memoryLimit / 2), mTailLimit(memoryLimit - memoryLimit / 2), mSegmentBytes(segmentBytes)
+        {
+            if (memoryLimit < 2) {
+                throw std::invalid_argument("a spill queue needs room for at least two elements in memory");
+            }
+
+            if (segmentBytes < sizeof(RecordSize)) {
+                throw std::invalid_argument("a spill queue segment needs room for at least one record header");
+            }
+        }
+
+        template<typename T, typename Codec>
+        SpillQueue<T, Codec>::SpillQueue(SpillQueue<T, Codec>&& rhs) noexcept
+            : mHeadLimit(0), mTailLimit(0), mSegmentBytes(0)
+        {
+            swap(*this, rhs);
+        }
+
+        template<typename T, typename Codec>
+        SpillQueue<T, Codec>& SpillQueue<T, Codec>::operator=(SpillQueue<T, Codec>&& rhs) noexcept
+        {
+            //  check for self move
+            if (this != &rhs) {
+                clear();
+                swap(*this, rhs);
+            }
+
+            return *this;
+        }
+
+        template<typename T, typename Codec>
+        T& SpillQueue<T, Codec>::front()
+        {
+            if (mHead.empty()) {
+                throw std::logic_error("trying to get front of empty queue");
+            }
+
+            return mHead.front();
+        }
+
+        template<typename T, typename Codec>
+        const T& SpillQueue<T, Codec>::front() const
+        {
+            if (mHead.empty()) {
+                throw std::logic_error("trying to get front of empty queue");
+            }
+
+            return mHead.front();
+        }
+
+        template<typename T, typename Codec>
+        void SpillQueue<T, Codec>::pop_front()
+        {
+            if (mHead.empty()) return;
+
+            mHead.pop_front();
+            if (mHead.empty()) {
+                refill();
+            }
+        }
+
+        template<typename T, typename Codec>
+        template<typename ...Args>
+        void SpillQueue<T, Codec>::emplace_back(Args&&... args)
+        {
+            //  the head only takes new elements while nothing is queued behind it
+            if (mSpilled == 0 && mTail.empty() && mHead.getSize() < mHeadLimit) {
+                mHead.emplace_back(std::forward<Args>(args)...);
+                return;
+            }
+
+            //  spilled before the new element goes in, so a spill that throws leaves it out
+            if (mTail.getSize() >= mTailLimit) {
+                spill();
+            }
+
+            mTail.emplace_back(std::forward<Args>(args)...);
+        }
+
+        template<typename T, typename Codec>
+        void SpillQueue<T, Codec>::clear()
+        {
+            mHead.clear();
+            mTail.clear();
+            while (!mSegments.empty()) {
+                removeFrontSegment();
+            }
+
+            mSpilled = 0;
+        }
+
+        //  an element is only popped from the tail once its record is complete, if anything
+        //  throws the elements not yet spilled are still in the tail and the order is kept
+        template<typename T, typename Codec>
+        void SpillQueue<T, Codec>::spill()
+        {
+            while (!mTail.empty()) {
+                const T& t = mTail.front();
+                const std::size_t size = Codec::getSize(t);
+                if (size > std::numeric_limits<RecordSize>::max()) {
+                    throw std::length_error("element too large to spill");
+                }
+
+                Segment& segment = writableSegment(sizeof(RecordSize) + size);
+                char* out = static_cast<char*>(segment.mFile.getWritableData()) + segment.mWriteOffset;
+                const RecordSize recordSize = static_cast<RecordSize>(size);
+                std::memcpy(out, &recordSize, sizeof(RecordSize));
+                Codec::encode(t, out + sizeof(RecordSize));
+
+                segment.mWriteOffset += sizeof(RecordSize) + size;
+                ++mSpilled;
+                mTail.pop_front();
+            }
+        }
+
+        template<typename T, typename Codec>
+        void SpillQueue<T, Codec>::refill()
+        {
+            if (mSpilled == 0) {
+                //  the tail is already in order and within its own limit
+                swap(mHead, mTail);
+                return;
+            }
+
+            while (mHead.getSize() < mHeadLimit && mSpilled > 0) {
+                Segment& segment = mSegments.front();
+                if (segment.mReadOffset == segment.mWriteOffset) {
+                    removeFrontSegment();
+                    continue;
+                }
+
+                const char* in = static_cast<const char*>(segment.mFile.getData()) + segment.mReadOffset;
+                RecordSize recordSize;
+                std::memcpy(&recordSize, in, sizeof(RecordSize));
+                mHead.push_back(Codec::decode(in + sizeof(RecordSize), recordSize));
+
+                segment.mReadOffset += sizeof(RecordSize) + recordSize;
+                --mSpilled;
+            }
+
+            if (mSegments.empty()) return;
+
+            //  done with everything before the read position, the next stretch is wanted soon
+            Segment& segment = mSegments.front();
+            if (segment.mReadOffset == segment.mWriteOffset && mSegments.size() > 1) {
+                removeFrontSegment();
+            }
+            else {
+                segment.mFile.evict(0, segment.mReadOffset);
+                segment.mFile.prefetch(segment.mReadOffset, READAHEAD_BYTES);
+            }
+        }
+
+        template<typename T, typename Codec>
+        typename SpillQueue<T, Codec>::Segment& SpillQueue<T, Codec>::writableSegment(const std::size_t bytes)
+        {
+            if (!mSegments.empty()) {
+                Segment& last = mSegments.back();
+                if (last.mFile.getSize() - last.mWriteOffset >= bytes) {
+                    return last;
+                }
+
+                //  sealed, written pages are left to the page cache until they are read back
+                last.mFile.evict(last.mReadOffset, last.mWriteOffset - last.mReadOffset);
+            }
+
+            Segment segment;
+            segment.mPath = mPathPrefix + "." + std::to_string(mNextSegment) + ".seg";
+            segment.mFile.create(segment.mPath, bytes > mSegmentBytes ? bytes : mSegmentBytes);
+            segment.mWriteOffset = 0;
+            segment.mReadOffset = 0;
+
+            mSegments.push_back(std::move(segment));
+            ++mNextSegment;
+            return mSegments.back();
+        }
+
+        template<typename T, typename Codec>
+        void SpillQueue<T, Codec>::removeFrontSegment()
+        {
+            Segment& segment = mSegments.front();
+            segment.mFile.close();
+            std::remove(segment.mPath.c_str());
+            mSegments.pop_front();
+        }
+    }
+}
+
+#endif
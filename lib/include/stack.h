@@ -4,15 +4,16 @@
 //  includes
 #include <memory>
 #include <limits>	//  needed for clang build
+#include "container_stats.h"
 
 namespace utils {
     namespace storage {
 
-        template<typename T>
-        class Stack {
+        template<typename T, typename Stats = NoStats>
+        class Stack : private Stats {
 
         public:
-            friend void swap(Stack<T>& lhs, Stack<T>& rhs) noexcept
+            friend void swap(Stack<T, Stats>& lhs, Stack<T, Stats>& rhs) noexcept
             {
                 std::size_t tempCapacity(lhs.mCapacity);
                 lhs.mCapacity = rhs.mCapacity;
@@ -25,6 +26,10 @@ namespace utils {
                 T* tempBase(lhs.mBase);
                 lhs.mBase = rhs.mBase;
                 rhs.mBase = tempBase;
+
+                //  the statistics follow the elements
+                using std::swap;
+                swap(static_cast<Stats&>(lhs), static_cast<Stats&>(rhs));
             }
 
         private:
@@ -32,12 +37,12 @@ namespace utils {
 
         public:
             Stack() = default;
-            Stack(const Stack<T>& rhs);
-            Stack(Stack<T>&& rhs) noexcept;
+            Stack(const Stack<T, Stats>& rhs);
+            Stack(Stack<T, Stats>&& rhs) noexcept;
             ~Stack() noexcept;
 
-            Stack& operator=(const Stack<T>& rhs);
-            Stack& operator=(Stack<T>&& rhs) noexcept;
+            Stack& operator=(const Stack<T, Stats>& rhs);
+            Stack& operator=(Stack<T, Stats>&& rhs) noexcept;
 
             bool empty() const;
             void pop();
@@ -52,6 +57,11 @@ namespace utils {
             std::size_t getCapacity() const { return mCapacity; }
             std::size_t getSize() const { return mSize; }
 
+            //  counts kept by the Stats policy, all zero under NoStats
+            ContainerStats stats() const { return Stats::snapshot(); }
+            //  the elements as payload, the object and unused capacity as overhead
+            MemoryUsage memory_usage() const;
+
         private:
             bool resize(const std::size_t newCapacity);
             T* safeDeepCopy(const T* const source, const std::size_t capacity, const std::size_t size);
@@ -64,8 +74,8 @@ namespace utils {
             T* mBase = nullptr;
         };
 
-        template<typename T>
-        Stack<T>::Stack(const Stack<T>& rhs)
+        template<typename T, typename Stats>
+        Stack<T, Stats>::Stack(const Stack<T, Stats>& rhs)
         {
             try {
                 mBase = safeDeepCopy(rhs.mBase, rhs.mCapacity, rhs.mSize);
@@ -73,19 +83,23 @@ namespace utils {
                 throw;
             }
 
+            if (mBase) {
+                this->onAllocate(1);
+            }
+
             mCapacity = rhs.mCapacity;
             mSize = rhs.mSize;
         }
 
-        template<typename T>
-        Stack<T>::Stack(Stack<T>&& rhs) noexcept
+        template<typename T, typename Stats>
+        Stack<T, Stats>::Stack(Stack<T, Stats>&& rhs) noexcept
         {
             using std::swap;
             swap(*this, rhs);
         }
 
-        template<typename T>
-        Stack<T>::~Stack() noexcept
+        template<typename T, typename Stats>
+        Stack<T, Stats>::~Stack() noexcept
         {
             try {
                 clear();
@@ -95,14 +109,14 @@ namespace utils {
             }
         }
 
-        template<typename T>
-        Stack<T>& Stack<T>::operator=(const Stack<T>& rhs)
+        template<typename T, typename Stats>
+        Stack<T, Stats>& Stack<T, Stats>::operator=(const Stack<T, Stats>& rhs)
         {
             //  check for self assignment
             if (this != &rhs) {
 
                 //  make a copy
-                Stack<T> rhsCopy(rhs);
+                Stack<T, Stats> rhsCopy(rhs);
 
                 //  swap with copy
                 using std::swap;
@@ -114,8 +128,8 @@ namespace utils {
             return *this;
         }
 
-        template<typename T>
-        Stack<T>& Stack<T>::operator=(Stack<T>&& rhs) noexcept
+        template<typename T, typename Stats>
+        Stack<T, Stats>& Stack<T, Stats>::operator=(Stack<T, Stats>&& rhs) noexcept
         {
             //  check for self move
             if (this != &rhs) {
@@ -130,8 +144,8 @@ namespace utils {
         }
 
         //  no op on an empty stack
-        template<typename T>
-        void Stack<T>::pop()
+        template<typename T, typename Stats>
+        void Stack<T, Stats>::pop()
         {
             if (empty()) return;
 
@@ -140,8 +154,8 @@ namespace utils {
             --mSize;
         }
 
-        template<typename T>
-        bool Stack<T>::push(const T& t)
+        template<typename T, typename Stats>
+        bool Stack<T, Stats>::push(const T& t)
         {
             if ((mSize + 1) > mCapacity) {
                 if (mCapacity < (std::numeric_limits<std::size_t>::max() / 3)) {
@@ -173,8 +187,8 @@ namespace utils {
             return true;
         }
 
-        template<typename T>
-        bool Stack<T>::push(T&& t)
+        template<typename T, typename Stats>
+        bool Stack<T, Stats>::push(T&& t)
         {
             if ((mSize + 1) > mCapacity) {
                 if (mCapacity < (std::numeric_limits<std::size_t>::max() / 3)) {
@@ -207,42 +221,47 @@ namespace utils {
 
         //  returns a const reference to the top element in the stack
         //  it is up to the caller to make sure stack is non-empty using Empty() function
-        template<typename T>
-        const T& Stack<T>::top() const
+        template<typename T, typename Stats>
+        const T& Stack<T, Stats>::top() const
         {
             return *(mBase + (mSize - 1));
         }
 
         //  returns a reference to the top element in the stack
         //  it is up to the caller to make sure stack is non-empty using Empty() function
-        template<typename T>
-        T& Stack<T>::top()
+        template<typename T, typename Stats>
+        T& Stack<T, Stats>::top()
         {
             return *(mBase + (mSize - 1));
         }
 
-        template<typename T>
+        template<typename T, typename Stats>
         template<class... Args>
-        void Stack<T>::emplace(Args&&... args)
+        void Stack<T, Stats>::emplace(Args&&... args)
         {
             //  depending on type deduction call the right push method
             push(std::forward<Args>(args)...);
         }
 
         //  checks size of stack and returns true (if empty) or false 
-        template<typename T>
-        bool Stack<T>::empty() const
+        template<typename T, typename Stats>
+        bool Stack<T, Stats>::empty() const
         {
             return mSize == 0;
         }
 
         //  increases the size of the stack by allocating a larger block of memory
         //  and copying the stacks elements to it.
-        template<typename T>
-        bool Stack<T>::resize(const std::size_t newCapacity)
+        template<typename T, typename Stats>
+        bool Stack<T, Stats>::resize(const std::size_t newCapacity)
         {
             try {
                 T* p = move(mBase, newCapacity, mSize);
+                this->onAllocate(1);
+                this->onResize(mSize * sizeof(T));
+
+                //  the old block is finished with once everything is in the new one
+                clear();
                 mBase = p;
                 mCapacity = newCapacity;
                 return true;
@@ -251,8 +270,8 @@ namespace utils {
             }
         }
 
-        template<typename T>
-        T* Stack<T>::safeDeepCopy(const T* const source, const std::size_t capacity, const std::size_t size)
+        template<typename T, typename Stats>
+        T* Stack<T, Stats>::safeDeepCopy(const T* const source, const std::size_t capacity, const std::size_t size)
         {
             T* p = nullptr;
             std::size_t current = 0;
@@ -281,8 +300,8 @@ namespace utils {
             }
         }
 
-        template<typename T>
-        T* Stack<T>::move(const T* const source, const std::size_t capacity, const std::size_t size)
+        template<typename T, typename Stats>
+        T* Stack<T, Stats>::move(const T* const source, const std::size_t capacity, const std::size_t size)
         {
             T* p = nullptr;
             std::size_t current = 0;
@@ -310,8 +329,8 @@ namespace utils {
             }
         }
 
-        template<typename T>
-        void Stack<T>::clear()
+        template<typename T, typename Stats>
+        void Stack<T, Stats>::clear()
         {
             if (!mBase) return;
 
@@ -320,6 +339,16 @@ namespace utils {
             }
 
             ::operator delete (mBase);
+            this->onFree(1);
+        }
+
+        template<typename T, typename Stats>
+        MemoryUsage Stack<T, Stats>::memory_usage() const
+        {
+            MemoryUsage usage;
+            usage.mPayload = mSize * sizeof(T);
+            usage.mOverhead = sizeof(*this) + (mCapacity - mSize) * sizeof(T);
+            return usage;
         }
     }
 }
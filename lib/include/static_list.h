@@ -0,0 +1,284 @@
+#ifndef H_UTILS_STORAGE_STATIC_LIST_H
+#define H_UTILS_STORAGE_STATIC_LIST_H
+
+//  includes
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include "static_storage.h"
+
+namespace utils {
+    namespace storage {
+        namespace detail {
+
+            //  everything StaticList does, it only adds the destructor
+            template<typename T, std::size_t N>
+            class StaticListCore
+            {
+                static_assert(N > 0, "a static list needs room for at least one element");
+
+            public:
+                //  end of a chain, one past the last slot
+                static constexpr std::size_t NIL = N;
+
+            private:
+                //  Iterator
+                //  forward iterator over the list, stays valid until the element it refers to is removed
+                template<typename Value>
+                class Iterator {
+                    friend class StaticListCore<T, N>;
+
+                public:
+                    typedef std::forward_iterator_tag iterator_category;
+                    typedef T value_type;
+                    typedef std::ptrdiff_t difference_type;
+                    typedef Value* pointer;
+                    typedef Value& reference;
+
+                    constexpr Iterator() : mList(nullptr), mIndex(NIL) {}
+
+                    //  allow iterator -> const_iterator but not the other way round
+                    template<typename Other, typename = typename std::enable_if<std::is_same<const Other, Value>::value>::type>
+                    constexpr Iterator(const Iterator<Other>& rhs) : mList(rhs.mList), mIndex(rhs.mIndex) {}
+
+                    constexpr reference operator*() const { return mList->mSlots[mIndex]; }
+                    constexpr pointer operator->() const { return &mList->mSlots[mIndex]; }
+
+                    constexpr Iterator& operator++() { mIndex = mList->mNext[mIndex]; return *this; }
+                    constexpr Iterator operator++(int) { Iterator copy(*this); ++(*this); return copy; }
+
+                    constexpr bool operator==(const Iterator& rhs) const { return mIndex == rhs.mIndex; }
+                    constexpr bool operator!=(const Iterator& rhs) const { return mIndex != rhs.mIndex; }
+
+                private:
+                    template<typename Other> friend class Iterator;
+
+                    constexpr Iterator(StaticListCore* list, const std::size_t index) : mList(list), mIndex(index) {}
+
+                    StaticListCore* mList;
+                    std::size_t mIndex;
+                };
+
+            public:
+                typedef Iterator<T> iterator;
+                typedef Iterator<const T> const_iterator;
+
+            public:
+                constexpr StaticListCore();
+                constexpr StaticListCore(const StaticListCore& rhs);
+                constexpr StaticListCore(StaticListCore&& rhs) noexcept(std::is_nothrow_move_constructible<T>::value);
+
+                constexpr StaticListCore& operator=(const StaticListCore& rhs);
+                constexpr StaticListCore& operator=(StaticListCore&& rhs) noexcept(std::is_nothrow_move_constructible<T>::value);
+
+                //  append to the back of the list, false and the list unchanged when it is full
+                template<typename ...Args>
+                constexpr bool try_emplace(Args&&... args);
+                constexpr bool try_insert(const T& t) { return try_emplace(t); }
+                constexpr bool try_insert(T&& t) { return try_emplace(std::move(t)); }
+
+                //  removes the first element equal to t, its slot is the next one used
+                constexpr void remove(const T& t);
+
+                constexpr void clear();
+
+                //  it is up to the caller to make sure the list is non-empty
+                constexpr T& front() { return mSlots[mHead]; }
+                constexpr const T& front() const { return mSlots[mHead]; }
+                constexpr T& back() { return mSlots[mTail]; }
+                constexpr const T& back() const { return mSlots[mTail]; }
+
+                constexpr iterator begin() { return iterator(this, mHead); }
+                constexpr const_iterator begin() const { return const_iterator(const_cast<StaticListCore*>(this), mHead); }
+                constexpr iterator end() { return iterator(this, NIL); }
+                constexpr const_iterator end() const { return const_iterator(const_cast<StaticListCore*>(this), NIL); }
+                constexpr const_iterator cbegin() const { return begin(); }
+                constexpr const_iterator cend() const { return end(); }
+
+                constexpr bool empty() const { return mSize == 0; }
+                constexpr bool full() const { return mSize == N; }
+                constexpr std::size_t getSize() const { return mSize; }
+                static constexpr std::size_t getCapacity() { return N; }
+
+            private:
+                //  takes the element in slot index off the free list and links it at the tail
+                constexpr void link(const std::size_t index);
+                //  puts every slot on the free list in order, only for an empty list
+                constexpr void resetFree();
+
+            private:
+                StaticSlots<T, N> mSlots;
+                //  next element of a live slot, next free slot of a free one
+                std::size_t mNext[N];
+                std::size_t mHead;
+                std::size_t mTail;
+                std::size_t mFree;
+                std::size_t mSize;
+            };
+
+            template<typename T, std::size_t N>
+            constexpr std::size_t StaticListCore<T, N>::NIL;
+
+            //  every slot starts on the free list, in order
+            template<typename T, std::size_t N>
+            constexpr StaticListCore<T, N>::StaticListCore() : mNext(), mHead(NIL), mTail(NIL), mFree(0), mSize(0)
+            {
+                resetFree();
+            }
+
+            //  copies go through assignment, ClearOnDestroy cleans up after a throwing copy of a non trivial T
+            template<typename T, std::size_t N>
+            constexpr StaticListCore<T, N>::StaticListCore(const StaticListCore<T, N>& rhs) : StaticListCore()
+            {
+                *this = rhs;
+            }
+
+            //  elements are moved one by one, rhs keeps its moved from elements
+            template<typename T, std::size_t N>
+            constexpr StaticListCore<T, N>::StaticListCore(StaticListCore<T, N>&& rhs) noexcept(std::is_nothrow_move_constructible<T>::value) : StaticListCore()
+            {
+                *this = std::move(rhs);
+            }
+
+            //  copy-and-swap would copy every element three times, clear and copy instead,
+            //  the free list is put back in order first, so the copy lands in slots 0 to n - 1 however
+            //  either list's slots were scattered, if a copy throws the list keeps the elements copied so far
+            template<typename T, std::size_t N>
+            constexpr StaticListCore<T, N>& StaticListCore<T, N>::operator=(const StaticListCore<T, N>& rhs)
+            {
+                //  check for self assignment
+                if (this != &rhs) {
+                    clear();
+                    resetFree();
+                    for (std::size_t index = rhs.mHead; index != NIL; index = rhs.mNext[index]) {
+                        try_emplace(rhs.mSlots[index]);
+                    }
+                }
+
+                return *this;
+            }
+
+            template<typename T, std::size_t N>
+            constexpr StaticListCore<T, N>& StaticListCore<T, N>::operator=(StaticListCore<T, N>&& rhs) noexcept(std::is_nothrow_move_constructible<T>::value)
+            {
+                //  check for self move
+                if (this != &rhs) {
+                    clear();
+                    resetFree();
+                    for (std::size_t index = rhs.mHead; index != NIL; index = rhs.mNext[index]) {
+                        try_emplace(std::move(rhs.mSlots[index]));
+                    }
+                }
+
+                return *this;
+            }
+
+            template<typename T, std::size_t N>
+            template<typename ...Args>
+            constexpr bool StaticListCore<T, N>::try_emplace(Args&&... args)
+            {
+                if (mFree == NIL) {
+                    return false;
+                }
+
+                //  if the constructor throws the slot is still free and the list is unchanged
+                mSlots.construct(mFree, std::forward<Args>(args)...);
+                link(mFree);
+                return true;
+            }
+
+            template<typename T, std::size_t N>
+            constexpr void StaticListCore<T, N>::remove(const T& t)
+            {
+                std::size_t prev = NIL;
+                std::size_t index = mHead;
+
+                while (index != NIL) {
+                    //  found?
+                    if (mSlots[index] == t) {
+                        //  unlink from list, destroy and hand the slot back
+                        const std::size_t next = mNext[index];
+                        if (prev == NIL) {
+                            mHead = next;
+                        }
+                        else {
+                            mNext[prev] = next;
+                        }
+
+                        if (mTail == index) {
+                            mTail = prev;
+                        }
+
+                        mSlots.destroy(index);
+                        mNext[index] = mFree;
+                        mFree = index;
+                        --mSize;
+                        return;
+                    }
+
+                    prev = index;
+                    index = mNext[index];
+                }
+            }
+
+            //  destroys every element and puts the slots back on the free list
+            template<typename T, std::size_t N>
+            constexpr void StaticListCore<T, N>::clear()
+            {
+                std::size_t index = mHead;
+                while (index != NIL) {
+                    const std::size_t next = mNext[index];
+                    mSlots.destroy(index);
+                    mNext[index] = mFree;
+                    mFree = index;
+                    index = next;
+                }
+
+                mHead = NIL;
+                mTail = NIL;
+                mSize = 0;
+            }
+
+            template<typename T, std::size_t N>
+            constexpr void StaticListCore<T, N>::link(const std::size_t index)
+            {
+                mFree = mNext[index];
+                mNext[index] = NIL;
+
+                if (mTail == NIL) {
+                    mHead = index;
+                }
+                else {
+                    mNext[mTail] = index;
+                }
+
+                mTail = index;
+                ++mSize;
+            }
+
+            template<typename T, std::size_t N>
+            constexpr void StaticListCore<T, N>::resetFree()
+            {
+                for (std::size_t i = 0; i < N; ++i) {
+                    mNext[i] = i + 1;
+                }
+
+                mFree = 0;
+            }
+        }
+
+        //  StaticList
+        //  singly linked list of up to N elements kept in an array inside the object, linked by
+        //  slot index with the unused slots on a free list, it never allocates and try_insert
+        //  reports a full list instead of growing
+        //  for a trivial T it is a literal type and every operation is constexpr,
+        //  so a list can be built in a constant expression
+        template<typename T, std::size_t N>
+        class StaticList : public detail::ClearOnDestroy<detail::StaticListCore<T, N>, std::is_trivial<T>::value>
+        {
+        };
+    }
+}
+
+#endif
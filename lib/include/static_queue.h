@@ -0,0 +1,214 @@
+#ifndef H_UTILS_STORAGE_STATIC_QUEUE_H
+#define H_UTILS_STORAGE_STATIC_QUEUE_H
+
+//  includes
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include "static_storage.h"
+
+namespace utils {
+    namespace storage {
+        namespace detail {
+
+            //  everything StaticQueue does, it only adds the destructor
+            template<typename T, std::size_t N>
+            class StaticQueueCore
+            {
+                static_assert(N > 0, "a static queue needs room for at least one element");
+
+            public:
+                constexpr StaticQueueCore() : mHead(0), mSize(0) {}
+                constexpr StaticQueueCore(const StaticQueueCore& rhs);
+                constexpr StaticQueueCore(StaticQueueCore&& rhs) noexcept(std::is_nothrow_move_constructible<T>::value);
+
+                constexpr StaticQueueCore& operator=(const StaticQueueCore& rhs);
+                constexpr StaticQueueCore& operator=(StaticQueueCore&& rhs) noexcept(std::is_nothrow_move_constructible<T>::value);
+
+                //  throw std::logic_error on an empty queue
+                constexpr T& front();
+                constexpr const T& front() const;
+                constexpr T& back();
+                constexpr const T& back() const;
+
+                //  no op on an empty queue
+                constexpr void pop_front();
+
+                //  false, and the queue unchanged, when it is full
+                template<typename ...Args>
+                constexpr bool try_emplace_front(Args&&... args);
+                template<typename ...Args>
+                constexpr bool try_emplace_back(Args&&... args);
+
+                constexpr bool try_push_front(const T& data) { return try_emplace_front(data); }
+                constexpr bool try_push_front(T&& data) { return try_emplace_front(std::move(data)); }
+                constexpr bool try_push_back(const T& data) { return try_emplace_back(data); }
+                constexpr bool try_push_back(T&& data) { return try_emplace_back(std::move(data)); }
+
+                constexpr void clear();
+
+                constexpr bool empty() const { return mSize == 0; }
+                constexpr bool full() const { return mSize == N; }
+                constexpr std::size_t getSize() const { return mSize; }
+                static constexpr std::size_t getCapacity() { return N; }
+
+            private:
+                //  slot of the element index places from the front
+                constexpr std::size_t slot(const std::size_t index) const { return mHead + index < N ? mHead + index : mHead + index - N; }
+
+            private:
+                StaticSlots<T, N> mSlots;
+                std::size_t mHead;
+                std::size_t mSize;
+            };
+
+            //  copies go through assignment, ClearOnDestroy cleans up after a throwing copy of a non trivial T
+            template<typename T, std::size_t N>
+            constexpr StaticQueueCore<T, N>::StaticQueueCore(const StaticQueueCore<T, N>& rhs) : mHead(0), mSize(0)
+            {
+                *this = rhs;
+            }
+
+            //  elements are moved one by one, rhs keeps its moved from elements
+            template<typename T, std::size_t N>
+            constexpr StaticQueueCore<T, N>::StaticQueueCore(StaticQueueCore<T, N>&& rhs) noexcept(std::is_nothrow_move_constructible<T>::value) : mHead(0), mSize(0)
+            {
+                *this = std::move(rhs);
+            }
+
+            //  copy-and-swap would copy every element three times, clear and copy instead,
+            //  the copy starts at slot 0 whatever rhs's head, if a copy throws the queue keeps
+            //  the elements copied so far
+            template<typename T, std::size_t N>
+            constexpr StaticQueueCore<T, N>& StaticQueueCore<T, N>::operator=(const StaticQueueCore<T, N>& rhs)
+            {
+                //  check for self assignment
+                if (this != &rhs) {
+                    clear();
+                    for (; mSize < rhs.mSize; ++mSize) {
+                        mSlots.construct(mSize, rhs.mSlots[rhs.slot(mSize)]);
+                    }
+                }
+
+                return *this;
+            }
+
+            template<typename T, std::size_t N>
+            constexpr StaticQueueCore<T, N>& StaticQueueCore<T, N>::operator=(StaticQueueCore<T, N>&& rhs) noexcept(std::is_nothrow_move_constructible<T>::value)
+            {
+                //  check for self move
+                if (this != &rhs) {
+                    clear();
+                    for (; mSize < rhs.mSize; ++mSize) {
+                        mSlots.construct(mSize, std::move(rhs.mSlots[rhs.slot(mSize)]));
+                    }
+                }
+
+                return *this;
+            }
+
+            template<typename T, std::size_t N>
+            constexpr T& StaticQueueCore<T, N>::front()
+            {
+                if (mSize == 0) {
+                    throw std::logic_error("trying to get front of empty queue");
+                }
+
+                return mSlots[mHead];
+            }
+
+            template<typename T, std::size_t N>
+            constexpr const T& StaticQueueCore<T, N>::front() const
+            {
+                if (mSize == 0) {
+                    throw std::logic_error("trying to get front of empty queue");
+                }
+
+                return mSlots[mHead];
+            }
+
+            template<typename T, std::size_t N>
+            constexpr T& StaticQueueCore<T, N>::back()
+            {
+                if (mSize == 0) {
+                    throw std::logic_error("trying to get back of empty queue");
+                }
+
+                return mSlots[slot(mSize - 1)];
+            }
+
+            template<typename T, std::size_t N>
+            constexpr const T& StaticQueueCore<T, N>::back() const
+            {
+                if (mSize == 0) {
+                    throw std::logic_error("trying to get back of empty queue");
+                }
+
+                return mSlots[slot(mSize - 1)];
+            }
+
+            template<typename T, std::size_t N>
+            constexpr void StaticQueueCore<T, N>::pop_front()
+            {
+                if (mSize == 0) return;
+
+                mSlots.destroy(mHead);
+                mHead = slot(1);
+                --mSize;
+            }
+
+            template<typename T, std::size_t N>
+            template<typename ...Args>
+            constexpr bool StaticQueueCore<T, N>::try_emplace_front(Args&&... args)
+            {
+                if (mSize == N) {
+                    return false;
+                }
+
+                //  if the constructor throws the queue is unchanged
+                const std::size_t head = mHead == 0 ? N - 1 : mHead - 1;
+                mSlots.construct(head, std::forward<Args>(args)...);
+                mHead = head;
+                ++mSize;
+                return true;
+            }
+
+            template<typename T, std::size_t N>
+            template<typename ...Args>
+            constexpr bool StaticQueueCore<T, N>::try_emplace_back(Args&&... args)
+            {
+                if (mSize == N) {
+                    return false;
+                }
+
+                //  if the constructor throws the queue is unchanged
+                mSlots.construct(slot(mSize), std::forward<Args>(args)...);
+                ++mSize;
+                return true;
+            }
+
+            template<typename T, std::size_t N>
+            constexpr void StaticQueueCore<T, N>::clear()
+            {
+                while (mSize > 0) {
+                    pop_front();
+                }
+
+                mHead = 0;
+            }
+        }
+
+        //  StaticQueue
+        //  Queue as a ring buffer of N elements inside the object, it never allocates and both
+        //  ends are O(1), the try_push functions report a full queue instead of growing
+        //  for a trivial T it is a literal type and every operation is constexpr,
+        //  so a queue can be built in a constant expression
+        template<typename T, std::size_t N>
+        class StaticQueue : public detail::ClearOnDestroy<detail::StaticQueueCore<T, N>, std::is_trivial<T>::value>
+        {
+        };
+    }
+}
+
+#endif
@@ -0,0 +1,142 @@
+#ifndef H_UTILS_STORAGE_STATIC_STACK_H
+#define H_UTILS_STORAGE_STATIC_STACK_H
+
+//  includes
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include "static_storage.h"
+
+namespace utils {
+    namespace storage {
+        namespace detail {
+
+            //  everything StaticStack does, it only adds the destructor
+            template<typename T, std::size_t N>
+            class StaticStackCore
+            {
+                static_assert(N > 0, "a static stack needs room for at least one element");
+
+            public:
+                constexpr StaticStackCore() : mSize(0) {}
+                constexpr StaticStackCore(const StaticStackCore& rhs);
+                constexpr StaticStackCore(StaticStackCore&& rhs) noexcept(std::is_nothrow_move_constructible<T>::value);
+
+                constexpr StaticStackCore& operator=(const StaticStackCore& rhs);
+                constexpr StaticStackCore& operator=(StaticStackCore&& rhs) noexcept(std::is_nothrow_move_constructible<T>::value);
+
+                //  false, and the stack unchanged, when it is full
+                constexpr bool try_push(const T& t) { return try_emplace(t); }
+                constexpr bool try_push(T&& t) { return try_emplace(std::move(t)); }
+                template<typename ...Args>
+                constexpr bool try_emplace(Args&&... args);
+
+                //  no op on an empty stack
+                constexpr void pop();
+
+                //  it is up to the caller to make sure the stack is non-empty
+                constexpr T& top() { return mSlots[mSize - 1]; }
+                constexpr const T& top() const { return mSlots[mSize - 1]; }
+
+                constexpr void clear();
+
+                constexpr bool empty() const { return mSize == 0; }
+                constexpr bool full() const { return mSize == N; }
+                constexpr std::size_t getSize() const { return mSize; }
+                static constexpr std::size_t getCapacity() { return N; }
+
+            private:
+                StaticSlots<T, N> mSlots;
+                std::size_t mSize;
+            };
+
+            //  copies go through assignment, ClearOnDestroy cleans up after a throwing copy of a non trivial T
+            template<typename T, std::size_t N>
+            constexpr StaticStackCore<T, N>::StaticStackCore(const StaticStackCore<T, N>& rhs) : mSize(0)
+            {
+                *this = rhs;
+            }
+
+            //  elements are moved one by one, rhs keeps its moved from elements
+            template<typename T, std::size_t N>
+            constexpr StaticStackCore<T, N>::StaticStackCore(StaticStackCore<T, N>&& rhs) noexcept(std::is_nothrow_move_constructible<T>::value) : mSize(0)
+            {
+                *this = std::move(rhs);
+            }
+
+            //  copy-and-swap would copy every element three times, clear and copy instead,
+            //  if a copy throws the stack keeps the elements copied so far
+            template<typename T, std::size_t N>
+            constexpr StaticStackCore<T, N>& StaticStackCore<T, N>::operator=(const StaticStackCore<T, N>& rhs)
+            {
+                //  check for self assignment
+                if (this != &rhs) {
+                    clear();
+                    for (; mSize < rhs.mSize; ++mSize) {
+                        mSlots.construct(mSize, rhs.mSlots[mSize]);
+                    }
+                }
+
+                return *this;
+            }
+
+            template<typename T, std::size_t N>
+            constexpr StaticStackCore<T, N>& StaticStackCore<T, N>::operator=(StaticStackCore<T, N>&& rhs) noexcept(std::is_nothrow_move_constructible<T>::value)
+            {
+                //  check for self move
+                if (this != &rhs) {
+                    clear();
+                    for (; mSize < rhs.mSize; ++mSize) {
+                        mSlots.construct(mSize, std::move(rhs.mSlots[mSize]));
+                    }
+                }
+
+                return *this;
+            }
+
+            template<typename T, std::size_t N>
+            template<typename ...Args>
+            constexpr bool StaticStackCore<T, N>::try_emplace(Args&&... args)
+            {
+                if (mSize == N) {
+                    return false;
+                }
+
+                //  if the constructor throws the stack is unchanged
+                mSlots.construct(mSize, std::forward<Args>(args)...);
+                ++mSize;
+                return true;
+            }
+
+            template<typename T, std::size_t N>
+            constexpr void StaticStackCore<T, N>::pop()
+            {
+                if (mSize == 0) return;
+
+                --mSize;
+                mSlots.destroy(mSize);
+            }
+
+            template<typename T, std::size_t N>
+            constexpr void StaticStackCore<T, N>::clear()
+            {
+                while (mSize > 0) {
+                    --mSize;
+                    mSlots.destroy(mSize);
+                }
+            }
+        }
+
+        //  StaticStack
+        //  Stack with room for N elements inside the object, it never allocates,
+        //  try_push reports a full stack instead of growing
+        //  for a trivial T it is a literal type and every operation is constexpr,
+        //  so a stack can be built in a constant expression
+        template<typename T, std::size_t N>
+        class StaticStack : public detail::ClearOnDestroy<detail::StaticStackCore<T, N>, std::is_trivial<T>::value>
+        {
+        };
+    }
+}
+
+#endif
@@ -0,0 +1,112 @@
+#ifndef H_UTILS_STORAGE_STATIC_STORAGE_H
+#define H_UTILS_STORAGE_STATIC_STORAGE_H
+
+//  includes
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace utils {
+    namespace storage {
+        namespace detail {
+
+            //  StaticSlots
+            //  N slots for T inside the object, which slots hold a live T is up to the container
+            //  for a trivial T the slots are a plain array, constructing one is an assignment and
+            //  destroying one does nothing, so every operation can run in a constant expression
+            template<typename T, std::size_t N, bool Trivial = std::is_trivial<T>::value>
+            class StaticSlots
+            {
+            public:
+                constexpr StaticSlots() : mSlots() {}
+
+                constexpr T& operator[](const std::size_t index) { return mSlots[index]; }
+                constexpr const T& operator[](const std::size_t index) const { return mSlots[index]; }
+
+                template<typename ...Args>
+                constexpr void construct(const std::size_t index, Args&&... args) { mSlots[index] = T(std::forward<Args>(args)...); }
+                constexpr void destroy(const std::size_t) {}
+
+            private:
+                T mSlots[N];
+            };
+
+            //  any other T lives in raw storage, built with placement new and destroyed by hand
+            template<typename T, std::size_t N>
+            class StaticSlots<T, N, false>
+            {
+            public:
+                StaticSlots() = default;
+
+                //  copying raw bytes would duplicate objects behind their owners' backs,
+                //  the container copies the live slots itself
+                StaticSlots(const StaticSlots&) = delete;
+                StaticSlots& operator=(const StaticSlots&) = delete;
+
+                T& operator[](const std::size_t index) { return *reinterpret_cast<T*>(&mSlots[index]); }
+                const T& operator[](const std::size_t index) const { return *reinterpret_cast<const T*>(&mSlots[index]); }
+
+                template<typename ...Args>
+                void construct(const std::size_t index, Args&&... args) { new (&mSlots[index]) T(std::forward<Args>(args)...); }
+                void destroy(const std::size_t index) { (*this)[index].~T(); }
+
+            private:
+                typename std::aligned_storage<sizeof(T), alignof(T)>::type mSlots[N];
+            };
+
+            //  ClearOnDestroy
+            //  gives Core a destructor that calls clear() when T has a destructor of its own,
+            //  and none at all otherwise so a container of trivial T stays a literal type
+            //  copies start from an empty Core and fill it through assignment, a constexpr Core
+            //  cannot catch, so the elements already made are destroyed here if one throws
+            template<typename Core, bool Trivial>
+            class ClearOnDestroy : public Core
+            {
+            public:
+                ClearOnDestroy() = default;
+
+                ClearOnDestroy(const ClearOnDestroy& rhs) : Core()
+                {
+                    try {
+                        Core::operator=(rhs);
+                    } catch (...) {
+                        this->clear();
+                        throw;
+                    }
+                }
+
+                ClearOnDestroy(ClearOnDestroy&& rhs) noexcept(std::is_nothrow_move_assignable<Core>::value) : Core()
+                {
+                    moveFrom(rhs, std::integral_constant<bool, std::is_nothrow_move_assignable<Core>::value>());
+                }
+
+                ~ClearOnDestroy() { this->clear(); }
+
+                ClearOnDestroy& operator=(const ClearOnDestroy&) = default;
+                ClearOnDestroy& operator=(ClearOnDestroy&&) = default;
+
+            private:
+                //  a rethrow inside a noexcept constructor would only terminate, so the catch is left out there
+                void moveFrom(ClearOnDestroy& rhs, std::true_type) { Core::operator=(std::move(rhs)); }
+
+                void moveFrom(ClearOnDestroy& rhs, std::false_type)
+                {
+                    try {
+                        Core::operator=(std::move(rhs));
+                    } catch (...) {
+                        this->clear();
+                        throw;
+                    }
+                }
+            };
+
+            template<typename Core>
+            class ClearOnDestroy<Core, true> : public Core
+            {
+            };
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,222 @@
+#ifndef H_UTILS_CONCURRENCY_THREAD_POOL_H
+#define H_UTILS_CONCURRENCY_THREAD_POOL_H
+
+//  includes
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace utils {
+    namespace concurrency {
+
+        //  ThreadPool
+        //  fixed set of worker threads taking tasks from one shared queue
+        //  meant for coarse grained fork-join work, see TaskGroup
+        class ThreadPool {
+
+        public:
+            //  zero starts one worker per hardware thread
+            explicit ThreadPool(std::size_t threadCount = 0);
+            ~ThreadPool();
+
+            ThreadPool(const ThreadPool&) = delete;
+            ThreadPool& operator=(const ThreadPool&) = delete;
+
+            template<typename Function>
+            void submit(Function&& f);
+
+            //  runs one queued task on the calling thread, returns false if there was none
+            bool runPendingTask();
+
+            std::size_t getThreadCount() const { return mThreads.size(); }
+
+        private:
+            void workerLoop();
+
+        private:
+            std::vector<std::thread> mThreads;
+            std::deque<std::function<void()>> mTasks;
+            std::mutex mMutex;
+            std::condition_variable mWake;
+            bool mStopping = false;
+        };
+
+        //  TaskGroup
+        //  forks tasks into a pool and joins them, a thread waiting on the group keeps running
+        //  queued tasks instead of blocking, so groups may nest to any depth without deadlock
+        //  the first exception thrown by a task is rethrown from wait()
+        class TaskGroup {
+
+        public:
+            explicit TaskGroup(ThreadPool& pool) : mPool(pool) {}
+            ~TaskGroup();
+
+            TaskGroup(const TaskGroup&) = delete;
+            TaskGroup& operator=(const TaskGroup&) = delete;
+
+            template<typename Function>
+            void run(Function&& f);
+
+            void wait();
+
+        private:
+            ThreadPool& mPool;
+            std::atomic<std::size_t> mPending{ 0 };
+            std::exception_ptr mError;
+            std::mutex mErrorMutex;
+        };
+
+        //  runs left and right, the first as a task of pool when a pool is given and parallel is set
+        template<typename Left, typename Right>
+        void forkJoin(ThreadPool* pool, const bool parallel, Left&& left, Right&& right)
+        {
+            if (pool == nullptr || !parallel) {
+                left();
+                right();
+                return;
+            }
+
+            TaskGroup group(*pool);
+            group.run(std::forward<Left>(left));
+            right();
+            group.wait();
+        }
+
+        inline ThreadPool::ThreadPool(std::size_t threadCount)
+        {
+            if (threadCount == 0) {
+                threadCount = std::thread::hardware_concurrency();
+            }
+
+            if (threadCount == 0) {
+                threadCount = 1;
+            }
+
+            mThreads.reserve(threadCount);
+            for (std::size_t i = 0; i < threadCount; ++i) {
+                mThreads.emplace_back([this]() { workerLoop(); });
+            }
+        }
+
+        //  finishes every queued task before the workers exit
+        inline ThreadPool::~ThreadPool()
+        {
+            {
+                std::lock_guard<std::mutex> lock(mMutex);
+                mStopping = true;
+            }
+
+            mWake.notify_all();
+
+            for (std::thread& thread : mThreads) {
+                thread.join();
+            }
+        }
+
+        template<typename Function>
+        void ThreadPool::submit(Function&& f)
+        {
+            {
+                std::lock_guard<std::mutex> lock(mMutex);
+                mTasks.emplace_back(std::forward<Function>(f));
+            }
+
+            mWake.notify_one();
+        }
+
+        inline bool ThreadPool::runPendingTask()
+        {
+            std::function<void()> task;
+
+            {
+                std::lock_guard<std::mutex> lock(mMutex);
+                if (mTasks.empty()) {
+                    return false;
+                }
+
+                task = std::move(mTasks.front());
+                mTasks.pop_front();
+            }
+
+            task();
+            return true;
+        }
+
+        inline void ThreadPool::workerLoop()
+        {
+            for (;;) {
+                std::function<void()> task;
+
+                {
+                    std::unique_lock<std::mutex> lock(mMutex);
+                    mWake.wait(lock, [this]() { return mStopping || !mTasks.empty(); });
+
+                    if (mTasks.empty()) {
+                        //  only reached when stopping
+                        return;
+                    }
+
+                    task = std::move(mTasks.front());
+                    mTasks.pop_front();
+                }
+
+                task();
+            }
+        }
+
+        inline TaskGroup::~TaskGroup()
+        {
+            //  tasks reference the group, it must outlive them even if the owner never waited
+            while (mPending.load(std::memory_order_acquire) != 0) {
+                if (!mPool.runPendingTask()) {
+                    std::this_thread::yield();
+                }
+            }
+        }
+
+        template<typename Function>
+        void TaskGroup::run(Function&& f)
+        {
+            mPending.fetch_add(1, std::memory_order_relaxed);
+
+            mPool.submit([this, f]() mutable {
+                try {
+                    f();
+                }
+                catch (...) {
+                    std::lock_guard<std::mutex> lock(mErrorMutex);
+                    if (!mError) {
+                        mError = std::current_exception();
+                    }
+                }
+
+                mPending.fetch_sub(1, std::memory_order_acq_rel);
+            });
+        }
+
+        inline void TaskGroup::wait()
+        {
+            while (mPending.load(std::memory_order_acquire) != 0) {
+                if (!mPool.runPendingTask()) {
+                    std::this_thread::yield();
+                }
+            }
+
+            std::lock_guard<std::mutex> lock(mErrorMutex);
+            if (mError) {
+                std::exception_ptr error = mError;
+                mError = nullptr;
+                std::rethrow_exception(error);
+            }
+        }
+    }
+}
+
+#endif
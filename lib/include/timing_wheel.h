@@ -0,0 +1,259 @@
+#ifndef H_UTILS_STORAGE_TIMING_WHEEL_H
+#define H_UTILS_STORAGE_TIMING_WHEEL_H
+
+//  includes
+#include <cstddef>
+#include <cstdint>
+#include "intrusive_queue.h"
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace utils {
+    namespace storage {
+
+        struct TimerHookTag {};
+
+        //  Timer
+        //  intrusive timer entry, derive from it and hand the object to a TimingWheel,
+        //  the wheel never allocates or copies timers
+        class Timer : public IntrusiveHook<TimerHookTag> {
+
+            template<typename> friend class TimingWheel;
+
+        public:
+            std::uint64_t getDeadline() const { return mDeadline; }
+            bool isScheduled() const { return isLinked(); }
+
+        private:
+            std::uint64_t mDeadline = 0;
+            unsigned char mLevel = 0;
+            unsigned char mSlot = 0;
+        };
+
+        //  TimingWheel
+        //  hierarchical timing wheel over an abstract tick count chosen by the caller
+        //  level l has 64 slots each spanning 64^l ticks, 11 levels cover the whole 64 bit range
+        //  a timer sits on the lowest level whose current rotation contains its deadline,
+        //  when time reaches the start of its slot it is cascaded down a level, so each timer
+        //  moves at most once per level and schedule/cancel are O(1)
+        //  every slot is an intrusive FIFO and every level keeps a 64 bit occupancy mask,
+        //  advance() jumps straight to the next occupied slot rather than walking every tick
+        template<typename TimerType = Timer>
+        class TimingWheel {
+
+        private:
+            enum { SLOT_BITS = 6, SLOTS = 1 << SLOT_BITS, LEVELS = 11, DUE_LEVEL = LEVELS };
+
+            typedef IntrusiveQueue<TimerType, BaseHook<TimerType, TimerHookTag>> Bucket;
+
+        public:
+            explicit TimingWheel(const std::uint64_t now = 0) : mNow(now) {}
+            TimingWheel(const TimingWheel& rhs) = delete;
+            TimingWheel& operator=(const TimingWheel& rhs) = delete;
+
+            //  a deadline at or before now fires on the next advance()
+            void schedule(TimerType& timer, const std::uint64_t deadline);
+            //  no op if the timer is not scheduled
+            void cancel(TimerType& timer);
+
+            //  moves time forward to now and calls onExpire(timer) for every timer due by then,
+            //  in deadline order, the timer is unscheduled before the call so it may reschedule itself
+            //  returns the number of timers fired
+            template<typename Function>
+            std::size_t advance(const std::uint64_t now, Function onExpire);
+
+            std::uint64_t getNow() const { return mNow; }
+            std::size_t getSize() const { return mSize; }
+            bool empty() const { return mSize == 0; }
+
+        private:
+            static unsigned digit(const std::uint64_t time, const unsigned level) { return static_cast<unsigned>(time >> (level * SLOT_BITS)) & (SLOTS - 1); }
+            static unsigned lowestBit(const std::uint64_t bits);
+            static unsigned highestBit(const std::uint64_t bits);
+
+            void place(TimerType& timer);
+            std::uint64_t slotStart(const unsigned level, const unsigned slot) const;
+            template<typename Function>
+            std::size_t fireBucket(Bucket& bucket, Function& onExpire);
+
+        private:
+            Bucket mWheel[LEVELS][SLOTS];
+            std::uint64_t mOccupied[LEVELS] = {};
+            Bucket mDue;
+            std::uint64_t mNow;
+            std::size_t mSize = 0;
+        };
+
+        template<typename TimerType>
+        void TimingWheel<TimerType>::schedule(TimerType& timer, const std::uint64_t deadline)
+        {
+            cancel(timer);
+
+            timer.mDeadline = deadline;
+            place(timer);
+            ++mSize;
+        }
+
+        template<typename TimerType>
+        void TimingWheel<TimerType>::cancel(TimerType& timer)
+        {
+            if (!timer.isScheduled()) return;
+
+            if (timer.mLevel == DUE_LEVEL) {
+                mDue.unlink(timer);
+            } else {
+                Bucket& bucket = mWheel[timer.mLevel][timer.mSlot];
+                bucket.unlink(timer);
+
+                if (bucket.empty()) {
+                    mOccupied[timer.mLevel] &= ~(static_cast<std::uint64_t>(1) << timer.mSlot);
+                }
+            }
+
+            --mSize;
+        }
+
+        template<typename TimerType>
+        template<typename Function>
+        std::size_t TimingWheel<TimerType>::advance(const std::uint64_t now, Function onExpire)
+        {
+            std::size_t fired = fireBucket(mDue, onExpire);
+
+            while (mNow < now) {
+                //  the earliest start of an occupied slot later in the current rotation of any level,
+                //  kept to starts at or before now without ever forming now + 1, which wraps at the last tick
+                std::uint64_t next = now;
+                bool found = false;
+
+                for (unsigned level = 0; level < LEVELS; ++level) {
+                    //  slots at or before the current one are always empty, mask them off
+                    const std::uint64_t ahead = mOccupied[level] & ~((static_cast<std::uint64_t>(2) << digit(mNow, level)) - 1);
+                    if (ahead == 0) continue;
+
+                    const std::uint64_t start = slotStart(level, lowestBit(ahead));
+                    if (start <= now && (!found || start < next)) {
+                        next = start;
+                        found = true;
+                    }
+                }
+
+                if (!found) {
+                    //  nothing due before now
+                    mNow = now;
+                    break;
+                }
+
+                mNow = next;
+
+                //  cascade every slot starting exactly now, highest level first so timers can fall all the way
+                for (unsigned level = LEVELS - 1; level > 0; --level) {
+                    const std::uint64_t lowBits = (static_cast<std::uint64_t>(1) << (level * SLOT_BITS)) - 1;
+                    const unsigned slot = digit(mNow, level);
+
+                    if ((mNow & lowBits) != 0 || !(mOccupied[level] & (static_cast<std::uint64_t>(1) << slot))) continue;
+
+                    Bucket& bucket = mWheel[level][slot];
+                    mOccupied[level] &= ~(static_cast<std::uint64_t>(1) << slot);
+
+                    while (!bucket.empty()) {
+                        TimerType& timer = bucket.front();
+                        bucket.pop_front();
+                        place(timer);
+                    }
+                }
+
+                //  level 0 slots hold a single deadline, fire it
+                const unsigned slot = digit(mNow, 0);
+                if (mOccupied[0] & (static_cast<std::uint64_t>(1) << slot)) {
+                    mOccupied[0] &= ~(static_cast<std::uint64_t>(1) << slot);
+                    fired += fireBucket(mWheel[0][slot], onExpire);
+                }
+
+                //  cascaded timers that landed exactly on now, and anything the callbacks scheduled in the past
+                fired += fireBucket(mDue, onExpire);
+            }
+
+            return fired;
+        }
+
+        //  links the timer into the lowest level whose current rotation holds its deadline
+        template<typename TimerType>
+        void TimingWheel<TimerType>::place(TimerType& timer)
+        {
+            if (timer.mDeadline <= mNow) {
+                timer.mLevel = DUE_LEVEL;
+                mDue.push_back(timer);
+                return;
+            }
+
+            //  the highest 6 bit digit where deadline and now differ picks the level,
+            //  the deadline's digit there is always ahead of now's
+            const unsigned level = highestBit(timer.mDeadline ^ mNow) / SLOT_BITS;
+            const unsigned slot = digit(timer.mDeadline, level);
+
+            timer.mLevel = static_cast<unsigned char>(level);
+            timer.mSlot = static_cast<unsigned char>(slot);
+            mWheel[level][slot].push_back(timer);
+            mOccupied[level] |= static_cast<std::uint64_t>(1) << slot;
+        }
+
+        //  first tick covered by slot on level in the current rotation
+        template<typename TimerType>
+        std::uint64_t TimingWheel<TimerType>::slotStart(const unsigned level, const unsigned slot) const
+        {
+            const unsigned shift = level * SLOT_BITS;
+            const unsigned rotationShift = shift + SLOT_BITS;
+
+            //  the top level's rotation spans every tick
+            const std::uint64_t rotation = rotationShift >= 64 ? 0 : (mNow >> rotationShift) << rotationShift;
+
+            return rotation | (static_cast<std::uint64_t>(slot) << shift);
+        }
+
+        template<typename TimerType>
+        template<typename Function>
+        std::size_t TimingWheel<TimerType>::fireBucket(Bucket& bucket, Function& onExpire)
+        {
+            std::size_t fired = 0;
+
+            while (!bucket.empty()) {
+                TimerType& timer = bucket.front();
+                bucket.pop_front();
+                --mSize;
+                ++fired;
+
+                onExpire(timer);
+            }
+
+            return fired;
+        }
+
+        template<typename TimerType>
+        unsigned TimingWheel<TimerType>::lowestBit(const std::uint64_t bits)
+        {
+#ifdef _MSC_VER
+            unsigned long index;
+            _BitScanForward64(&index, bits);
+            return static_cast<unsigned>(index);
+#else
+            return static_cast<unsigned>(__builtin_ctzll(bits));
+#endif
+        }
+
+        template<typename TimerType>
+        unsigned TimingWheel<TimerType>::highestBit(const std::uint64_t bits)
+        {
+#ifdef _MSC_VER
+            unsigned long index;
+            _BitScanReverse64(&index, bits);
+            return static_cast<unsigned>(index);
+#else
+            return 63 - static_cast<unsigned>(__builtin_clzll(bits));
+#endif
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,647 @@
+#ifndef H_UTILS_STORAGE_TREAP_H
+#define H_UTILS_STORAGE_TREAP_H
+
+//  includes
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <utility>
+#include "random_seed.h"
+#include "thread_pool.h"
+
+namespace utils {
+    namespace storage {
+
+        //  Treap
+        //  ordered map kept balanced by random node priorities, a binary search tree on keys
+        //  and a max heap on priorities, so the expected depth is O(log n) whatever the insert order
+        //  split and join are the primitive operations, every range operation is built from them
+        //  and costs O(log n) plus the cost of destroying whatever it removes
+        //  every node also records the size of its subtree so counts come for free
+        //  union, intersection and difference follow the same split/join scheme and can fork their
+        //  two recursive halves into a thread pool
+        template<typename Key, typename Data, typename Compare = std::less<Key>>
+        class Treap
+        {
+            friend void swap(Treap<Key, Data, Compare>& lhs, Treap<Key, Data, Compare>& rhs) noexcept
+            {
+                Node* tempRoot(lhs.mRoot);
+                lhs.mRoot = rhs.mRoot;
+                rhs.mRoot = tempRoot;
+
+                std::uint32_t tempSeed(lhs.mSeed);
+                lhs.mSeed = rhs.mSeed;
+                rhs.mSeed = tempSeed;
+
+                using std::swap;
+                swap(lhs.mLess, rhs.mLess);
+            }
+
+        public:
+            enum E_INSERT_RESULT
+            {
+                OVERWRITE_SAME_VALUE_IR,
+                OVERWRITE_DIFFERENT_VALUE_IR,
+                NEW_INSERT_IR
+            };
+
+            typedef std::pair<bool, E_INSERT_RESULT> INSERT_RESULT;
+
+            //  below this many nodes in both trees the set operations stop forking tasks
+            enum { PARALLEL_GRAIN = 1 << 12 };
+
+        private:
+            struct Node
+            {
+                Key mKey;
+                Data mData;
+                std::uint32_t mPriority;
+                std::size_t mSize;
+                Node* mLeft;
+                Node* mRight;
+            };
+
+        public:
+            Treap() = default;
+            Treap(const Treap& rhs);
+            Treap(Treap&& rhs) noexcept;
+            ~Treap();
+
+            Treap& operator=(const Treap& rhs);
+            Treap& operator=(Treap&& rhs) noexcept;
+
+            INSERT_RESULT insert(const Key& k, const Data& d);
+            bool remove(const Key& k);
+
+            Data* find(const Key& k);
+            const Data* find(const Key& k) const;
+            bool contains(const Key& k) const { return find(k) != nullptr; }
+
+            //  moves every key not less than k into the returned treap
+            Treap split(const Key& k);
+            //  appends rhs, every key of which must be greater than every key here, rhs is left empty
+            //  throws std::invalid_argument if the key ranges overlap
+            void join(Treap& rhs);
+
+            //  removes [lo, hi), returns the number of elements removed
+            std::size_t erase_range(const Key& lo, const Key& hi);
+            //  moves [lo, hi) into the returned treap
+            Treap extract_range(const Key& lo, const Key& hi);
+
+            //  set operations, rhs is consumed and left empty, where a key is in both the data here wins
+            //  expected work is O(m log(n / m + 1)) for sizes m <= n, with a pool the depth is O(log n log m)
+            void set_union(Treap& rhs, concurrency::ThreadPool* pool = nullptr);
+            void set_intersection(Treap& rhs, concurrency::ThreadPool* pool = nullptr);
+            //  removes every key that is in rhs
+            void set_difference(Treap& rhs, concurrency::ThreadPool* pool = nullptr);
+
+            //  f(key, data) for every element, in key order
+            template<typename Function>
+            void forEach(Function f) const { forEachHelper(mRoot, f); }
+
+            void clear();
+
+            std::size_t getSize() const { return sizeOf(mRoot); }
+            std::size_t getHeight() const { return heightOf(mRoot); }
+            bool empty() const { return mRoot == nullptr; }
+
+        private:
+            static std::size_t sizeOf(const Node* node) { return node ? node->mSize : 0; }
+            static std::size_t heightOf(const Node* node);
+            static void update(Node* node) { node->mSize = 1 + sizeOf(node->mLeft) + sizeOf(node->mRight); }
+
+            //  left gets the keys less than k, right the rest
+            void splitNode(Node* node, const Key& k, Node*& left, Node*& right) const;
+            //  every key in left is less than every key in right
+            static Node* joinNodes(Node* left, Node* right);
+            //  as splitNode, but a node with key k is detached and returned rather than put on the right
+            Node* splitOut(Node* node, const Key& k, Node*& left, Node*& right) const;
+
+            //  ours wins ties, both trees are consumed
+            Node* unionNodes(Node* ours, Node* theirs, concurrency::ThreadPool* pool) const;
+            Node* intersectNodes(Node* ours, Node* theirs, concurrency::ThreadPool* pool) const;
+            Node* differenceNodes(Node* ours, Node* theirs, concurrency::ThreadPool* pool) const;
+
+            Node* insertHelper(Node* node, Node* fresh);
+            Node* removeHelper(Node* node, const Key& k, bool& removed);
+            template<typename Function>
+            static void forEachHelper(const Node* node, Function& f);
+            static Node* copyHelper(const Node* node);
+            static void destroy(Node* node);
+
+            std::uint32_t nextPriority();
+
+        private:
+            Node* mRoot = nullptr;
+            //  xorshift state, seeded apart for every treap so two filled alike are shaped differently
+            std::uint32_t mSeed = detail::randomSeed();
+            Compare mLess;
+        };
+
+        template<typename Key, typename Data, typename Compare>
+        Treap<Key, Data, Compare>::Treap(const Treap<Key, Data, Compare>& rhs) :
+            mRoot(copyHelper(rhs.mRoot)),
+            mSeed(detail::randomSeed()),
+            mLess(rhs.mLess)
+        {
+        }
+
+        template<typename Key, typename Data, typename Compare>
+        Treap<Key, Data, Compare>::Treap(Treap<Key, Data, Compare>&& rhs) noexcept :
+            mRoot(rhs.mRoot),
+            mSeed(rhs.mSeed),
+            mLess(rhs.mLess)
+        {
+            rhs.mRoot = nullptr;
+        }
+
+        template<typename Key, typename Data, typename Compare>
+        Treap<Key, Data, Compare>::~Treap()
+        {
+            destroy(mRoot);
+        }
+
+        template<typename Key, typename Data, typename Compare>
+        Treap<Key, Data, Compare>& Treap<Key, Data, Compare>::operator=(const Treap<Key, Data, Compare>& rhs)
+        {
+            //  check for self assignment
+            if (this != &rhs) {
+                Treap copy(rhs);
+                swap(*this, copy);
+            }
+
+            return *this;
+        }
+
+        template<typename Key, typename Data, typename Compare>
+        Treap<Key, Data, Compare>& Treap<Key, Data, Compare>::operator=(Treap<Key, Data, Compare>&& rhs) noexcept
+        {
+            //  check for self move
+            if (this != &rhs) {
+                clear();
+                swap(*this, rhs);
+            }
+
+            return *this;
+        }
+
+        template<typename Key, typename Data, typename Compare>
+        typename Treap<Key, Data, Compare>::INSERT_RESULT Treap<Key, Data, Compare>::insert(const Key& k, const Data& d)
+        {
+            Data* existing = find(k);
+            if (existing) {
+                const INSERT_RESULT insertResult(true, (*existing == d) ? OVERWRITE_SAME_VALUE_IR : OVERWRITE_DIFFERENT_VALUE_IR);
+                *existing = d;
+                return insertResult;
+            }
+
+            mRoot = insertHelper(mRoot, new Node{ k, d, nextPriority(), 1, nullptr, nullptr });
+            return INSERT_RESULT(true, NEW_INSERT_IR);
+        }
+
+        template<typename Key, typename Data, typename Compare>
+        bool Treap<Key, Data, Compare>::remove(const Key& k)
+        {
+            bool removed = false;
+            mRoot = removeHelper(mRoot, k, removed);
+            return removed;
+        }
+
+        template<typename Key, typename Data, typename Compare>
+        Data* Treap<Key, Data, Compare>::find(const Key& k)
+        {
+            return const_cast<Data*>(static_cast<const Treap*>(this)->find(k));
+        }
+
+        template<typename Key, typename Data, typename Compare>
+        const Data* Treap<Key, Data, Compare>::find(const Key& k) const
+        {
+            const Node* node = mRoot;
+            while (node) {
+                if (mLess(k, node->mKey)) {
+                    node = node->mLeft;
+                }
+                else if (mLess(node->mKey, k)) {
+                    node = node->mRight;
+                }
+                else {
+                    return &node->mData;
+                }
+            }
+
+            return nullptr;
+        }
+
+        template<typename Key, typename Data, typename Compare>
+        Treap<Key, Data, Compare> Treap<Key, Data, Compare>::split(const Key& k)
+        {
+            Treap upper;
+            upper.mLess = mLess;
+
+            splitNode(mRoot, k, mRoot, upper.mRoot);
+            return upper;
+        }
+
+        template<typename Key, typename Data, typename Compare>
+        void Treap<Key, Data, Compare>::join(Treap<Key, Data, Compare>& rhs)
+        {
+            if (this == &rhs || rhs.mRoot == nullptr) return;
+
+            if (mRoot) {
+                //  the rightmost key here against the leftmost key there, both O(log n) walks
+                const Node* last = mRoot;
+                while (last->mRight) last = last->mRight;
+
+                const Node* first = rhs.mRoot;
+                while (first->mLeft) first = first->mLeft;
+
+                if (!mLess(last->mKey, first->mKey)) {
+                    throw std::invalid_argument("joined treap keys must all be greater");
+                }
+            }
+
+            mRoot = joinNodes(mRoot, rhs.mRoot);
+            rhs.mRoot = nullptr;
+        }
+
+        template<typename Key, typename Data, typename Compare>
+        std::size_t Treap<Key, Data, Compare>::erase_range(const Key& lo, const Key& hi)
+        {
+            Treap middle = extract_range(lo, hi);
+            return middle.getSize();
+        }
+
+        template<typename Key, typename Data, typename Compare>
+        Treap<Key, Data, Compare> Treap<Key, Data, Compare>::extract_range(const Key& lo, const Key& hi)
+        {
+            Treap middle;
+            middle.mLess = mLess;
+
+            if (!mLess(lo, hi)) return middle;
+
+            Node* left;
+            Node* rest;
+            Node* right;
+            splitNode(mRoot, lo, left, rest);
+            splitNode(rest, hi, middle.mRoot, right);
+            mRoot = joinNodes(left, right);
+
+            return middle;
+        }
+
+        template<typename Key, typename Data, typename Compare>
+        void Treap<Key, Data, Compare>::set_union(Treap<Key, Data, Compare>& rhs, concurrency::ThreadPool* pool)
+        {
+            if (this == &rhs) return;
+
+            mRoot = unionNodes(mRoot, rhs.mRoot, pool);
+            rhs.mRoot = nullptr;
+        }
+
+        template<typename Key, typename Data, typename Compare>
+        void Treap<Key, Data, Compare>::set_intersection(Treap<Key, Data, Compare>& rhs, concurrency::ThreadPool* pool)
+        {
+            if (this == &rhs) return;
+
+            mRoot = intersectNodes(mRoot, rhs.mRoot, pool);
+            rhs.mRoot = nullptr;
+        }
+
+        template<typename Key, typename Data, typename Compare>
+        void Treap<Key, Data, Compare>::set_difference(Treap<Key, Data, Compare>& rhs, concurrency::ThreadPool* pool)
+        {
+            if (this == &rhs) {
+                clear();
+                return;
+            }
+
+            mRoot = differenceNodes(mRoot, rhs.mRoot, pool);
+            rhs.mRoot = nullptr;
+        }
+
+        template<typename Key, typename Data, typename Compare>
+        void Treap<Key, Data, Compare>::clear()
+        {
+            destroy(mRoot);
+            mRoot = nullptr;
+        }
+
+        template<typename Key, typename Data, typename Compare>
+        std::size_t Treap<Key, Data, Compare>::heightOf(const Node* node)
+        {
+            if (node == nullptr) {
+                return 0;
+            }
+
+            const std::size_t left = heightOf(node->mLeft);
+            const std::size_t right = heightOf(node->mRight);
+            return 1 + (left > right ? left : right);
+        }
+
+        template<typename Key, typename Data, typename Compare>
+        void Treap<Key, Data, Compare>::splitNode(Node* node, const Key& k, Node*& left, Node*& right) const
+        {
+            if (node == nullptr) {
+                left = nullptr;
+                right = nullptr;
+                return;
+            }
+
+            if (mLess(node->mKey, k)) {
+                //  node and its left subtree stay on the left, split the right subtree
+                splitNode(node->mRight, k, node->mRight, right);
+                left = node;
+            }
+            else {
+                splitNode(node->mLeft, k, left, node->mLeft);
+                right = node;
+            }
+
+            update(node);
+        }
+
+        template<typename Key, typename Data, typename Compare>
+        typename Treap<Key, Data, Compare>::Node* Treap<Key, Data, Compare>::joinNodes(Node* left, Node* right)
+        {
+            if (left == nullptr) return right;
+            if (right == nullptr) return left;
+
+            //  the higher priority root stays on top
+            if (left->mPriority > right->mPriority) {
+                left->mRight = joinNodes(left->mRight, right);
+                update(left);
+                return left;
+            }
+
+            right->mLeft = joinNodes(left, right->mLeft);
+            update(right);
+            return right;
+        }
+
+        template<typename Key, typename Data, typename Compare>
+        typename Treap<Key, Data, Compare>::Node* Treap<Key, Data, Compare>::splitOut(Node* node, const Key& k, Node*& left, Node*& right) const
+        {
+            if (node == nullptr) {
+                left = nullptr;
+                right = nullptr;
+                return nullptr;
+            }
+
+            Node* found;
+
+            if (mLess(node->mKey, k)) {
+                found = splitOut(node->mRight, k, node->mRight, right);
+                left = node;
+            }
+            else if (mLess(k, node->mKey)) {
+                found = splitOut(node->mLeft, k, left, node->mLeft);
+                right = node;
+            }
+            else {
+                left = node->mLeft;
+                right = node->mRight;
+                node->mLeft = nullptr;
+                node->mRight = nullptr;
+                update(node);
+                return node;
+            }
+
+            update(node);
+            return found;
+        }
+
+        //  the root with the higher priority stays on top, the other tree is split around its key
+        //  and the two sides are merged recursively, which keeps the result a valid treap
+        template<typename Key, typename Data, typename Compare>
+        typename Treap<Key, Data, Compare>::Node* Treap<Key, Data, Compare>::unionNodes(Node* ours, Node* theirs, concurrency::ThreadPool* pool) const
+        {
+            if (ours == nullptr) return theirs;
+            if (theirs == nullptr) return ours;
+
+            const std::size_t work = ours->mSize + theirs->mSize;
+            Node* left;
+            Node* right;
+            Node* root;
+
+            if (ours->mPriority >= theirs->mPriority) {
+                root = ours;
+                delete splitOut(theirs, ours->mKey, left, right);
+
+                concurrency::forkJoin(pool, work >= PARALLEL_GRAIN,
+                    [&]() { root->mLeft = unionNodes(root->mLeft, left, pool); },
+                    [&]() { root->mRight = unionNodes(root->mRight, right, pool); });
+            }
+            else {
+                root = theirs;
+                Node* duplicate = splitOut(ours, theirs->mKey, left, right);
+                if (duplicate) {
+                    root->mData = std::move(duplicate->mData);
+                    delete duplicate;
+                }
+
+                concurrency::forkJoin(pool, work >= PARALLEL_GRAIN,
+                    [&]() { root->mLeft = unionNodes(left, root->mLeft, pool); },
+                    [&]() { root->mRight = unionNodes(right, root->mRight, pool); });
+            }
+
+            update(root);
+            return root;
+        }
+
+        template<typename Key, typename Data, typename Compare>
+        typename Treap<Key, Data, Compare>::Node* Treap<Key, Data, Compare>::intersectNodes(Node* ours, Node* theirs, concurrency::ThreadPool* pool) const
+        {
+            if (ours == nullptr || theirs == nullptr) {
+                destroy(ours);
+                destroy(theirs);
+                return nullptr;
+            }
+
+            const std::size_t work = ours->mSize + theirs->mSize;
+            Node* left;
+            Node* right;
+            Node* root;
+            Node* duplicate;
+
+            if (ours->mPriority >= theirs->mPriority) {
+                root = ours;
+                duplicate = splitOut(theirs, ours->mKey, left, right);
+
+                concurrency::forkJoin(pool, work >= PARALLEL_GRAIN,
+                    [&]() { left = intersectNodes(root->mLeft, left, pool); },
+                    [&]() { right = intersectNodes(root->mRight, right, pool); });
+            }
+            else {
+                root = theirs;
+                duplicate = splitOut(ours, theirs->mKey, left, right);
+
+                concurrency::forkJoin(pool, work >= PARALLEL_GRAIN,
+                    [&]() { left = intersectNodes(left, root->mLeft, pool); },
+                    [&]() { right = intersectNodes(right, root->mRight, pool); });
+
+                if (duplicate) {
+                    root->mData = std::move(duplicate->mData);
+                }
+            }
+
+            const bool found = duplicate != nullptr;
+            delete duplicate;
+
+            if (!found) {
+                //  the root's key is only on one side, it goes and its subtrees are joined
+                delete root;
+                return joinNodes(left, right);
+            }
+
+            root->mLeft = left;
+            root->mRight = right;
+            update(root);
+            return root;
+        }
+
+        template<typename Key, typename Data, typename Compare>
+        typename Treap<Key, Data, Compare>::Node* Treap<Key, Data, Compare>::differenceNodes(Node* ours, Node* theirs, concurrency::ThreadPool* pool) const
+        {
+            if (ours == nullptr) {
+                destroy(theirs);
+                return nullptr;
+            }
+
+            if (theirs == nullptr) return ours;
+
+            const std::size_t work = ours->mSize + theirs->mSize;
+            Node* left;
+            Node* right;
+
+            if (ours->mPriority >= theirs->mPriority) {
+                Node* root = ours;
+                Node* duplicate = splitOut(theirs, ours->mKey, left, right);
+
+                concurrency::forkJoin(pool, work >= PARALLEL_GRAIN,
+                    [&]() { left = differenceNodes(root->mLeft, left, pool); },
+                    [&]() { right = differenceNodes(root->mRight, right, pool); });
+
+                if (duplicate == nullptr) {
+                    root->mLeft = left;
+                    root->mRight = right;
+                    update(root);
+                    return root;
+                }
+
+                delete duplicate;
+                delete root;
+                return joinNodes(left, right);
+            }
+
+            Node* root = theirs;
+            delete splitOut(ours, theirs->mKey, left, right);
+
+            concurrency::forkJoin(pool, work >= PARALLEL_GRAIN,
+                [&]() { left = differenceNodes(left, root->mLeft, pool); },
+                [&]() { right = differenceNodes(right, root->mRight, pool); });
+
+            delete root;
+            return joinNodes(left, right);
+        }
+
+        //  descends to where fresh belongs by priority, then splits the subtree there around it,
+        //  the key is known not to be present
+        template<typename Key, typename Data, typename Compare>
+        typename Treap<Key, Data, Compare>::Node* Treap<Key, Data, Compare>::insertHelper(Node* node, Node* fresh)
+        {
+            if (node == nullptr || fresh->mPriority > node->mPriority) {
+                splitNode(node, fresh->mKey, fresh->mLeft, fresh->mRight);
+                update(fresh);
+                return fresh;
+            }
+
+            if (mLess(fresh->mKey, node->mKey)) {
+                node->mLeft = insertHelper(node->mLeft, fresh);
+            }
+            else {
+                node->mRight = insertHelper(node->mRight, fresh);
+            }
+
+            update(node);
+            return node;
+        }
+
+        template<typename Key, typename Data, typename Compare>
+        typename Treap<Key, Data, Compare>::Node* Treap<Key, Data, Compare>::removeHelper(Node* node, const Key& k, bool& removed)
+        {
+            if (node == nullptr) {
+                return nullptr;
+            }
+
+            if (mLess(k, node->mKey)) {
+                node->mLeft = removeHelper(node->mLeft, k, removed);
+            }
+            else if (mLess(node->mKey, k)) {
+                node->mRight = removeHelper(node->mRight, k, removed);
+            }
+            else {
+                //  the children are key ordered already, joining them takes the node's place
+                Node* result = joinNodes(node->mLeft, node->mRight);
+                delete node;
+                removed = true;
+                return result;
+            }
+
+            update(node);
+            return node;
+        }
+
+        template<typename Key, typename Data, typename Compare>
+        template<typename Function>
+        void Treap<Key, Data, Compare>::forEachHelper(const Node* node, Function& f)
+        {
+            if (node == nullptr) return;
+
+            forEachHelper(node->mLeft, f);
+            f(node->mKey, node->mData);
+            forEachHelper(node->mRight, f);
+        }
+
+        template<typename Key, typename Data, typename Compare>
+        typename Treap<Key, Data, Compare>::Node* Treap<Key, Data, Compare>::copyHelper(const Node* node)
+        {
+            if (node == nullptr) {
+                return nullptr;
+            }
+
+            Node* copy = new Node{ node->mKey, node->mData, node->mPriority, node->mSize, nullptr, nullptr };
+            try {
+                copy->mLeft = copyHelper(node->mLeft);
+                copy->mRight = copyHelper(node->mRight);
+            } catch (...) {
+                //  a copy threw, release the part of this subtree built so far
+                destroy(copy);
+                throw;
+            }
+
+            return copy;
+        }
+
+        template<typename Key, typename Data, typename Compare>
+        void Treap<Key, Data, Compare>::destroy(Node* node)
+        {
+            if (node == nullptr) return;
+
+            destroy(node->mLeft);
+            destroy(node->mRight);
+            delete node;
+        }
+
+        template<typename Key, typename Data, typename Compare>
+        std::uint32_t Treap<Key, Data, Compare>::nextPriority()
+        {
+            mSeed ^= mSeed << 13;
+            mSeed ^= mSeed >> 17;
+            mSeed ^= mSeed << 5;
+            return mSeed;
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,331 @@
+#ifndef H_UTILS_STORAGE_UNROLLED_LIST_H
+#define H_UTILS_STORAGE_UNROLLED_LIST_H
+
+
+//  includes
+#include <cstddef>
+#include <initializer_list>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace utils {
+    namespace storage {
+
+        //  number of elements that fit in one cache line alongside the node header
+        //  (count + next pointer), never less than one
+        template <typename T>
+        constexpr std::size_t unrolledListDefaultFactor()
+        {
+            return (64 - sizeof(std::size_t) - sizeof(void*)) / sizeof(T) > 0
+                ? (64 - sizeof(std::size_t) - sizeof(void*)) / sizeof(T)
+                : 1;
+        }
+
+        //  UnrolledList
+        //  same interface as List but every node stores up to N elements,
+        //  inserts fill the tail node before allocating and removal keeps nodes at least half full
+        //  where possible, so a list of n elements allocates roughly n / N nodes
+        //  and a scan touches one node per N elements
+        template <typename T, std::size_t N = unrolledListDefaultFactor<T>()>
+        class UnrolledList {
+
+            static_assert(N > 0, "unroll factor must be at least one");
+
+            friend void swap(UnrolledList<T, N>& lhs, UnrolledList<T, N>& rhs) noexcept
+            {
+                Node* tempHead(lhs.mHead);
+                lhs.mHead = rhs.mHead;
+                rhs.mHead = tempHead;
+
+                Node* tempTail(lhs.mTail);
+                lhs.mTail = rhs.mTail;
+                rhs.mTail = tempTail;
+
+                std::size_t tempSize(lhs.mSize);
+                lhs.mSize = rhs.mSize;
+                rhs.mSize = tempSize;
+            }
+
+        private:
+            //  Node
+            //  elements live in raw storage, only the first mCount are constructed
+            struct Node {
+                std::size_t mCount = 0;
+                Node* mNext = nullptr;
+                typename std::aligned_storage<sizeof(T), alignof(T)>::type mElements[N];
+
+                T* at(const std::size_t i) { return reinterpret_cast<T*>(&mElements[i]); }
+                const T* at(const std::size_t i) const { return reinterpret_cast<const T*>(&mElements[i]); }
+            };
+
+        public:
+            UnrolledList() = default;
+            explicit UnrolledList(const std::size_t size, const T& defaultVal = T{});
+            explicit UnrolledList(const std::initializer_list<T>& il);
+            UnrolledList(const UnrolledList& rhs);
+            UnrolledList(UnrolledList&& rhs) noexcept;
+            ~UnrolledList();
+
+            UnrolledList& operator=(const UnrolledList& rhs);
+            UnrolledList& operator=(UnrolledList&& rhs) noexcept;
+
+            template<typename ...Args>
+            void emplace(Args&&... args);
+
+            void insert(const T& t);
+            void insert(T&& t);
+
+            void remove(const T& t);
+            void clear();
+
+            std::size_t getSize() const { return mSize; }
+            std::size_t getNodeCount() const;
+            static constexpr std::size_t getUnrollFactor() { return N; }
+
+        private:
+            T* reserveBack();
+            void destroyNode(Node* node);
+
+        private:
+            Node* mHead = nullptr;
+            Node* mTail = nullptr;
+            std::size_t mSize = 0;
+        };
+
+        //  custom constructor - create a list of N size
+        template <typename T, std::size_t N>
+        UnrolledList<T, N>::UnrolledList(const std::size_t size, const T& defaultVal)
+        {
+            for (std::size_t i = 0; i < size; ++i) {
+                insert(defaultVal);
+            }
+        }
+
+        //  custom constructor - create a list populated with data
+        template <typename T, std::size_t N>
+        UnrolledList<T, N>::UnrolledList(const std::initializer_list<T>& il)
+        {
+            for (const T& t : il) {
+                insert(t);
+            }
+        }
+
+        template <typename T, std::size_t N>
+        UnrolledList<T, N>::UnrolledList(const UnrolledList<T, N>& rhs)
+        {
+            try {
+                for (const Node* node = rhs.mHead; node; node = node->mNext) {
+                    for (std::size_t i = 0; i < node->mCount; ++i) {
+                        insert(*node->at(i));
+                    }
+                }
+            } catch (...) {
+                //  a copy threw, release what has been built so far
+                clear();
+                throw;
+            }
+        }
+
+        template <typename T, std::size_t N>
+        UnrolledList<T, N>::UnrolledList(UnrolledList<T, N>&& rhs) noexcept
+        {
+            using std::swap;
+            swap(*this, rhs);
+        }
+
+        template <typename T, std::size_t N>
+        UnrolledList<T, N>::~UnrolledList()
+        {
+            try {
+                clear();
+            } catch (...) {
+                //  T's destructor could be set to noexcept(false) and throw during the delete call
+                //  do not allow any exceptions to propogate from a destructor
+            }
+        }
+
+        template <typename T, std::size_t N>
+        UnrolledList<T, N>& UnrolledList<T, N>::operator=(const UnrolledList<T, N>& rhs)
+        {
+            //  check for self assignment
+            if (this != &rhs) {
+
+                //  make a copy of rhs
+                UnrolledList<T, N> rhsCopy(rhs);
+
+                //  swap
+                using std::swap;
+                swap(*this, rhsCopy);
+            }
+
+            return *this;
+        }
+
+        template <typename T, std::size_t N>
+        UnrolledList<T, N>& UnrolledList<T, N>::operator=(UnrolledList<T, N>&& rhs) noexcept
+        {
+            //  check for self move
+            if (this != &rhs) {
+
+                //  swap
+                using std::swap;
+                swap(*this, rhs);
+            }
+
+            return *this;
+        }
+
+        template <typename T, std::size_t N>
+        template <typename ...Args>
+        void UnrolledList<T, N>::emplace(Args&&... args)
+        {
+            T* slot = reserveBack();
+
+            //  T constructor may throw, the slot is only counted once constructed
+            new (slot) T(std::forward<Args>(args)...);
+
+            ++mTail->mCount;
+            ++mSize;
+        }
+
+        template <typename T, std::size_t N>
+        void UnrolledList<T, N>::insert(const T& t)
+        {
+            emplace(t);
+        }
+
+        template <typename T, std::size_t N>
+        void UnrolledList<T, N>::insert(T&& t)
+        {
+            emplace(std::move(t));
+        }
+
+        //  removes the first element equal to t, matching List::remove
+        //  the elements after it in the same node are shifted down by one,
+        //  a node that drops below half full is merged with its successor when both fit in one node
+        template <typename T, std::size_t N>
+        void UnrolledList<T, N>::remove(const T& t)
+        {
+            Node* node = mHead;
+            Node* prev = nullptr;
+            std::size_t index = 0;
+
+            //  find the first match
+            for (; node; prev = node, node = node->mNext) {
+                for (index = 0; index < node->mCount; ++index) {
+                    if (*node->at(index) == t) break;
+                }
+
+                if (index < node->mCount) break;
+            }
+
+            //  not found
+            if (node == nullptr) return;
+
+            //  close the gap inside the node
+            for (std::size_t i = index + 1; i < node->mCount; ++i) {
+                *node->at(i - 1) = std::move(*node->at(i));
+            }
+
+            node->at(node->mCount - 1)->~T();
+            --node->mCount;
+            --mSize;
+
+            if (node->mCount == 0) {
+                //  node is empty, unlink and release it
+                Node* next = node->mNext;
+                if (prev) {
+                    prev->mNext = next;
+                } else {
+                    mHead = next;
+                }
+
+                if (mTail == node) {
+                    mTail = prev;
+                }
+
+                delete node;
+                return;
+            }
+
+            Node* next = node->mNext;
+            if (next && node->mCount < N / 2 && node->mCount + next->mCount <= N) {
+                //  underfull, pull the successor's elements in and release it
+                for (std::size_t i = 0; i < next->mCount; ++i) {
+                    new (node->at(node->mCount + i)) T(std::move(*next->at(i)));
+                }
+
+                node->mCount += next->mCount;
+                node->mNext = next->mNext;
+
+                if (mTail == next) {
+                    mTail = node;
+                }
+
+                destroyNode(next);
+            }
+        }
+
+        template <typename T, std::size_t N>
+        void UnrolledList<T, N>::clear()
+        {
+            Node* node = mHead;
+            while (node) {
+                //  store the pointer to the next node
+                Node* next = node->mNext;
+
+                //  destroy elements and release the node
+                destroyNode(node);
+
+                //  iterate to next node
+                node = next;
+            }
+
+            mHead = nullptr;
+            mTail = nullptr;
+            mSize = 0;
+        }
+
+        template <typename T, std::size_t N>
+        std::size_t UnrolledList<T, N>::getNodeCount() const
+        {
+            std::size_t count = 0;
+            for (const Node* node = mHead; node; node = node->mNext) {
+                ++count;
+            }
+
+            return count;
+        }
+
+        //  returns the raw slot the next element will be constructed in
+        //  allocates a new tail node when the current one is full
+        template <typename T, std::size_t N>
+        T* UnrolledList<T, N>::reserveBack()
+        {
+            if (mTail == nullptr) {
+                //  empty list
+                mHead = new Node;
+                mTail = mHead;
+            } else if (mTail->mCount == N) {
+                //  tail is full, link a new node
+                mTail->mNext = new Node;
+                mTail = mTail->mNext;
+            }
+
+            return mTail->at(mTail->mCount);
+        }
+
+        template <typename T, std::size_t N>
+        void UnrolledList<T, N>::destroyNode(Node* node)
+        {
+            for (std::size_t i = 0; i < node->mCount; ++i) {
+                node->at(i)->~T();
+            }
+
+            delete node;
+        }
+    }
+}
+
+#endif
@@ -0,0 +1 @@
+#include "../include/adaptive_radix_tree.h"
\ No newline at end of file
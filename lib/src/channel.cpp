@@ -0,0 +1 @@
+#include "../include/channel.h"
\ No newline at end of file
@@ -0,0 +1 @@
+#include "../include/const_map.h"
\ No newline at end of file
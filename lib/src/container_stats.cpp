@@ -0,0 +1 @@
+#include "../include/container_stats.h"
\ No newline at end of file
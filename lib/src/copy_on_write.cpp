@@ -0,0 +1 @@
+#include "../include/copy_on_write.h"
\ No newline at end of file
@@ -0,0 +1 @@
+#include "../include/epoch.h"
\ No newline at end of file
@@ -0,0 +1 @@
+#include "../include/eytzinger.h"
\ No newline at end of file
@@ -0,0 +1 @@
+#include "../include/flat_map.h"
\ No newline at end of file
@@ -0,0 +1 @@
+#include "../include/interval_tree.h"
\ No newline at end of file
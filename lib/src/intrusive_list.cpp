@@ -0,0 +1 @@
+#include "../include/intrusive_list.h"
\ No newline at end of file
@@ -0,0 +1 @@
+#include "../include/intrusive_queue.h"
\ No newline at end of file
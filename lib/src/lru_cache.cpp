@@ -0,0 +1 @@
+#include "../include/lru_cache.h"
\ No newline at end of file
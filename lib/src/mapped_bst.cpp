@@ -0,0 +1 @@
+#include "../include/mapped_bst.h"
\ No newline at end of file
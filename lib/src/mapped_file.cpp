@@ -0,0 +1 @@
+#include "../include/mapped_file.h"
\ No newline at end of file
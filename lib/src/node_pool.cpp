@@ -0,0 +1 @@
+#include "../include/node_pool.h"
\ No newline at end of file
@@ -0,0 +1 @@
+#include "../include/parallel_algorithm.h"
\ No newline at end of file
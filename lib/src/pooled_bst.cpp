@@ -0,0 +1 @@
+#include "../include/pooled_bst.h"
\ No newline at end of file
@@ -0,0 +1 @@
+#include "../include/pooled_list.h"
\ No newline at end of file
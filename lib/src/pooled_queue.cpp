@@ -0,0 +1 @@
+#include "../include/pooled_queue.h"
\ No newline at end of file
@@ -0,0 +1 @@
+#include "../include/priority_queue.h"
\ No newline at end of file
@@ -0,0 +1 @@
+#include "../include/random_seed.h"
\ No newline at end of file
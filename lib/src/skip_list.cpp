@@ -0,0 +1 @@
+#include "../include/skip_list.h"
\ No newline at end of file
@@ -0,0 +1 @@
+#include "../include/spill_queue.h"
\ No newline at end of file
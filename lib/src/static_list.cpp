@@ -0,0 +1 @@
+#include "../include/static_list.h"
\ No newline at end of file
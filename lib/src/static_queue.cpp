@@ -0,0 +1 @@
+#include "../include/static_queue.h"
\ No newline at end of file
@@ -0,0 +1 @@
+#include "../include/static_stack.h"
\ No newline at end of file
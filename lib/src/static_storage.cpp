@@ -0,0 +1 @@
+#include "../include/static_storage.h"
\ No newline at end of file
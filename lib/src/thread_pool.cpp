@@ -0,0 +1 @@
+#include "../include/thread_pool.h"
\ No newline at end of file
@@ -0,0 +1 @@
+#include "../include/timing_wheel.h"
\ No newline at end of file
@@ -0,0 +1 @@
+#include "../include/treap.h"
\ No newline at end of file
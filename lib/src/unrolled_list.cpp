@@ -0,0 +1 @@
+#include "../include/unrolled_list.h"
\ No newline at end of file
@@ -4,6 +4,7 @@
 #include "../../lib/include/list.h"
 #include "../../lib/include/queue.h"
 #include "../../lib/include/bst.h"
+#include "../../lib/include/unrolled_list.h"
 
 int main()
 {
@@ -11,6 +12,7 @@ int main()
     using utils::storage::List;
     using utils::storage::Queue;
     using utils::storage::BST;
+    using utils::storage::UnrolledList;
 
 
     Stack<int> stack;
@@ -76,6 +78,12 @@ int main()
     list.insert(4);
     list.clear();
 
+    UnrolledList<int> unrolledList;
+    unrolledList.insert(1);
+    unrolledList.emplace(2);
+    unrolledList.remove(1);
+    unrolledList.clear();
+
     Queue<int> queue;
     queue.push_back(1);
     queue.push_front(4);
@@ -0,0 +1,146 @@
+#include "../include/alloc_counter.h"
+#include <cstdlib>
+#include <new>
+#ifdef _MSC_VER
+#include <malloc.h>
+#endif
+
+//  replaces every global operator new and delete of the binary it is linked into,
+//  each call is counted for the calling thread and then handed to malloc and free
+
+namespace {
+    //  plain data so the thread's copy needs no constructor and cannot allocate itself
+    thread_local std::size_t tAllocations = 0;
+    thread_local std::size_t tFrees = 0;
+    thread_local std::size_t tBytes = 0;
+
+    void* countedAlloc(std::size_t size)
+    {
+        //  new of zero bytes must still return a unique pointer
+        if (size == 0) {
+            size = 1;
+        }
+
+        void* p = std::malloc(size);
+        if (p) {
+            ++tAllocations;
+            tBytes += size;
+        }
+
+        return p;
+    }
+
+    void countedFree(void* p)
+    {
+        if (p) {
+            ++tFrees;
+            std::free(p);
+        }
+    }
+
+#ifdef __cpp_aligned_new
+    void* countedAlignedAlloc(std::size_t size, std::size_t alignment)
+    {
+        if (size == 0) {
+            size = 1;
+        }
+
+        //  posix_memalign wants at least pointer alignment
+        if (alignment < sizeof(void*)) {
+            alignment = sizeof(void*);
+        }
+
+#ifdef _MSC_VER
+        void* p = _aligned_malloc(size, alignment);
+#else
+        void* p = nullptr;
+        if (posix_memalign(&p, alignment, size) != 0) {
+            p = nullptr;
+        }
+#endif
+
+        if (p) {
+            ++tAllocations;
+            tBytes += size;
+        }
+
+        return p;
+    }
+
+    void countedAlignedFree(void* p)
+    {
+        if (p) {
+            ++tFrees;
+#ifdef _MSC_VER
+            _aligned_free(p);
+#else
+            std::free(p);
+#endif
+        }
+    }
+#endif
+
+    void* throwingAlloc(const std::size_t size, const std::size_t alignment = 0)
+    {
+        for (;;) {
+#ifdef __cpp_aligned_new
+            void* p = alignment != 0 ? countedAlignedAlloc(size, alignment) : countedAlloc(size);
+#else
+            (void)alignment;
+            void* p = countedAlloc(size);
+#endif
+            if (p) {
+                return p;
+            }
+
+            //  give the new handler a chance to free some memory, as the standard operator new does
+            std::new_handler handler = std::get_new_handler();
+            if (!handler) {
+                throw std::bad_alloc();
+            }
+
+            handler();
+        }
+    }
+}
+
+namespace utils {
+    namespace test {
+
+        AllocCounts threadAllocCounts()
+        {
+            AllocCounts counts;
+            counts.mAllocations = tAllocations;
+            counts.mFrees = tFrees;
+            counts.mBytes = tBytes;
+            return counts;
+        }
+    }
+}
+
+void* operator new(std::size_t size) { return throwingAlloc(size); }
+void* operator new[](std::size_t size) { return throwingAlloc(size); }
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept { return countedAlloc(size); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return countedAlloc(size); }
+
+void operator delete(void* p) noexcept { countedFree(p); }
+void operator delete[](void* p) noexcept { countedFree(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { countedFree(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { countedFree(p); }
+void operator delete(void* p, std::size_t) noexcept { countedFree(p); }
+void operator delete[](void* p, std::size_t) noexcept { countedFree(p); }
+
+//  the over aligned forms only exist from C++17, or where the compiler offers them earlier
+#ifdef __cpp_aligned_new
+void* operator new(std::size_t size, std::align_val_t alignment) { return throwingAlloc(size, static_cast<std::size_t>(alignment)); }
+void* operator new[](std::size_t size, std::align_val_t alignment) { return throwingAlloc(size, static_cast<std::size_t>(alignment)); }
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept { return countedAlignedAlloc(size, static_cast<std::size_t>(alignment)); }
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept { return countedAlignedAlloc(size, static_cast<std::size_t>(alignment)); }
+
+void operator delete(void* p, std::align_val_t) noexcept { countedAlignedFree(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { countedAlignedFree(p); }
+void operator delete(void* p, std::align_val_t, const std::nothrow_t&) noexcept { countedAlignedFree(p); }
+void operator delete[](void* p, std::align_val_t, const std::nothrow_t&) noexcept { countedAlignedFree(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { countedAlignedFree(p); }
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept { countedAlignedFree(p); }
+#endif
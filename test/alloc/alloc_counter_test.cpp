@@ -0,0 +1,36 @@
+#include "gtest/gtest.h"
+#include <cstddef>
+#include <cstdint>
+#include "../include/alloc_counter.h"
+
+namespace {
+	//  over aligned where the compiler has the aligned operators, plain otherwise
+#ifdef __cpp_aligned_new
+	struct alignas(64) Wide
+#else
+	struct alignas(alignof(std::max_align_t)) Wide
+#endif
+	{
+		char mBytes[64];
+	};
+
+	//  the pointers escape through here, or the compiler may drop a new and delete pair altogether
+	Wide* volatile sWide;
+}
+
+TEST(alloc_counter, aligned)
+{
+	using utils::test::AllocScope;
+
+	AllocScope scope;
+	Wide* wide = new Wide;
+	sWide = wide;
+	Wide* wides = new Wide[4];
+	sWide = wides;
+
+	const bool aligned = reinterpret_cast<std::uintptr_t>(wide) % alignof(Wide) == 0 && reinterpret_cast<std::uintptr_t>(wides) % alignof(Wide) == 0;
+	delete wide;
+	delete[] wides;
+
+	ASSERT_TRUE(aligned && scope.allocations() == 2 && scope.frees() == 2 && scope.bytes() >= 5 * sizeof(Wide));
+}
@@ -0,0 +1,113 @@
+#include "gtest/gtest.h"
+#include <utility>
+#include "../include/alloc_counter.h"
+#include "../../lib/include/list.h"
+#include "../../lib/include/pooled_list.h"
+#include "../../lib/include/unrolled_list.h"
+
+TEST(list_alloc, budgets)
+{
+	using utils::storage::List;
+	using utils::test::AllocScope;
+
+	AllocScope scope;
+	List<int> list;
+	List<int> other;
+	ASSERT_TRUE(scope.allocations() == 0);
+
+	for (int i = 0; i < 1000; ++i) {
+		list.insert(1000 - i);
+	}
+
+	other.insert_after(other.before_begin(), 0);
+	ASSERT_TRUE(scope.allocations() == 1001);
+
+	scope.reset();
+	List<int> copy(list);
+	ASSERT_TRUE(scope.allocations() == 1000);
+
+	//  moving, swapping and relinking never touch the allocator
+	scope.reset();
+	List<int> moved(std::move(copy));
+	copy = std::move(moved);
+	using std::swap;
+	swap(list, copy);
+	list.sort();
+	list.merge(other);
+	list.splice_after(list.before_begin(), copy);
+	ASSERT_TRUE(scope.allocations() == 0);
+	ASSERT_TRUE(scope.frees() == 0);
+
+	scope.reset();
+	list.remove(0);
+	ASSERT_TRUE(scope.frees() == 1);
+
+	list.clear();
+	ASSERT_TRUE(scope.frees() == 2001);
+	ASSERT_TRUE(scope.allocations() == 0);
+}
+
+TEST(pooled_list_alloc, budgets)
+{
+	using utils::storage::PooledList;
+	using utils::test::AllocScope;
+
+	const int count = 10000;
+	const std::size_t chunks = (count + 1023) / 1024;
+
+	AllocScope scope;
+	PooledList<int> list;
+	for (int i = 0; i < count; ++i) {
+		list.insert(i);
+	}
+
+	ASSERT_TRUE(scope.allocations() <= 2 * chunks);
+
+	scope.reset();
+	list.remove(5);
+	list.insert(5);
+	PooledList<int> moved(std::move(list));
+	using std::swap;
+	swap(moved, list);
+	ASSERT_TRUE(scope.allocations() == 0);
+
+	scope.reset();
+	list.clear();
+	ASSERT_TRUE(scope.allocations() == 0);
+	ASSERT_TRUE(scope.frees() <= 2 * chunks);
+}
+
+TEST(unrolled_list_alloc, budgets)
+{
+	using utils::storage::UnrolledList;
+	using utils::test::AllocScope;
+
+	//  one node per N elements
+	typedef UnrolledList<int, 8> List;
+	const int count = 8000;
+
+	AllocScope scope;
+	List list;
+	for (int i = 0; i < count; ++i) {
+		list.insert(i);
+	}
+
+	ASSERT_TRUE(scope.allocations() == count / 8);
+
+	scope.reset();
+	List copy(list);
+	ASSERT_TRUE(scope.allocations() <= count / 8);
+
+	scope.reset();
+	List moved(std::move(copy));
+	using std::swap;
+	swap(moved, list);
+	ASSERT_TRUE(scope.allocations() == 0);
+	ASSERT_TRUE(scope.frees() == 0);
+
+	scope.reset();
+	list.clear();
+	moved.clear();
+	ASSERT_TRUE(scope.allocations() == 0);
+	ASSERT_TRUE(scope.frees() <= 2 * (count / 8));
+}
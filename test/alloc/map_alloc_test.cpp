@@ -0,0 +1,78 @@
+#include "gtest/gtest.h"
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include "../include/alloc_counter.h"
+#include "../../lib/include/adaptive_radix_tree.h"
+#include "../../lib/include/flat_map.h"
+
+TEST(flat_map_alloc, budgets)
+{
+	using utils::storage::FlatMap;
+	using utils::test::AllocScope;
+
+	FlatMap<int, int> map;
+	map.reserve(1000);
+
+	//  reserved, so inserts and removes only shift
+	AllocScope scope;
+	for (int i = 0; i < 1000; ++i) {
+		map.insert((i * 7919) % 1000, i);
+	}
+
+	map.remove(5);
+	ASSERT_TRUE(scope.allocations() == 0);
+
+	//  a key array and a data array
+	FlatMap<int, int> copy(map);
+	ASSERT_TRUE(scope.allocations() == 2);
+
+	scope.reset();
+	FlatMap<int, int> moved(std::move(copy));
+	using std::swap;
+	swap(moved, map);
+	map.clear();
+	ASSERT_TRUE(scope.allocations() == 0);
+	ASSERT_TRUE(scope.frees() == 0);
+}
+
+TEST(adaptive_radix_tree_alloc, budgets)
+{
+	using utils::storage::AdaptiveRadixTree;
+	using utils::test::AllocScope;
+
+	const std::uint32_t count = 10000;
+
+	AllocScope scope;
+	AdaptiveRadixTree<std::uint32_t, int> tree;
+	for (std::uint32_t i = 0; i < count; ++i) {
+		tree.insert(i * 2654435761u, 0);
+	}
+
+	//  a leaf per key, plus at most one new or regrown inner node
+	ASSERT_TRUE(scope.allocations() <= 2 * count);
+	ASSERT_TRUE(scope.frees() < count);
+
+	//  an overwrite reuses the leaf
+	scope.reset();
+	tree.insert(0, 1);
+	ASSERT_TRUE(scope.allocations() == 0);
+
+	scope.reset();
+	AdaptiveRadixTree<std::uint32_t, int> copy(tree);
+	const std::size_t live = scope.allocations();
+	ASSERT_TRUE(live <= 2 * count);
+
+	scope.reset();
+	AdaptiveRadixTree<std::uint32_t, int> moved(std::move(copy));
+	using std::swap;
+	swap(moved, tree);
+	ASSERT_TRUE(scope.allocations() == 0);
+	ASSERT_TRUE(scope.frees() == 0);
+
+	//  clear frees exactly what a copy allocated
+	scope.reset();
+	tree.clear();
+	ASSERT_TRUE(scope.frees() == live);
+	ASSERT_TRUE(scope.allocations() == 0);
+}
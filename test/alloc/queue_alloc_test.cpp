@@ -0,0 +1,92 @@
+#include "gtest/gtest.h"
+#include <utility>
+#include "../include/alloc_counter.h"
+#include "../../lib/include/pooled_queue.h"
+#include "../../lib/include/queue.h"
+
+TEST(queue_alloc, budgets)
+{
+	using utils::storage::Queue;
+	using utils::test::AllocScope;
+
+	AllocScope scope;
+	{
+		Queue<int> queue;
+		ASSERT_TRUE(scope.allocations() == 0);
+
+		//  one node per element whichever end it goes on
+		for (int i = 0; i < 500; ++i) {
+			queue.push_back(i);
+			queue.push_front(-i);
+		}
+
+		ASSERT_TRUE(scope.allocations() == 1000);
+
+		scope.reset();
+		Queue<int> copy(queue);
+		ASSERT_TRUE(scope.allocations() == 1000);
+
+		scope.reset();
+		Queue<int> moved(std::move(copy));
+		copy = std::move(moved);
+		using std::swap;
+		swap(queue, copy);
+		ASSERT_TRUE(scope.allocations() == 0);
+		ASSERT_TRUE(scope.frees() == 0);
+
+		scope.reset();
+		queue.pop_front();
+		ASSERT_TRUE(scope.frees() == 1);
+
+		queue.clear();
+		ASSERT_TRUE(scope.frees() == 1000);
+		ASSERT_TRUE(scope.allocations() == 0);
+		scope.reset();
+	}
+
+	//  the copy's nodes
+	ASSERT_TRUE(scope.frees() == 1000);
+}
+
+TEST(pooled_queue_alloc, budgets)
+{
+	using utils::storage::PooledQueue;
+	using utils::test::AllocScope;
+
+	//  nodes come out of 1024 node chunks, each chunk is one block and one slot in the chunk table
+	const int count = 10000;
+	const std::size_t chunks = (count + 1023) / 1024;
+
+	AllocScope scope;
+	PooledQueue<int> queue;
+	for (int i = 0; i < count; ++i) {
+		queue.push_back(i);
+	}
+
+	ASSERT_TRUE(scope.allocations() <= 2 * chunks);
+
+	//  popped slots are reused before anything new is allocated
+	scope.reset();
+	for (int i = 0; i < count; ++i) {
+		queue.pop_front();
+		queue.push_back(i);
+	}
+
+	ASSERT_TRUE(scope.allocations() == 0);
+	ASSERT_TRUE(scope.frees() == 0);
+
+	scope.reset();
+	PooledQueue<int> moved(std::move(queue));
+	using std::swap;
+	swap(moved, queue);
+	ASSERT_TRUE(scope.allocations() == 0);
+
+	PooledQueue<int> copy(queue);
+	ASSERT_TRUE(scope.allocations() <= 2 * chunks);
+
+	scope.reset();
+	copy.clear();
+	queue.clear();
+	ASSERT_TRUE(scope.allocations() == 0);
+	ASSERT_TRUE(scope.frees() <= 4 * chunks);
+}
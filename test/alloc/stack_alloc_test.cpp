@@ -0,0 +1,88 @@
+#include "gtest/gtest.h"
+#include <utility>
+#include "../include/alloc_counter.h"
+#include "../../lib/include/priority_queue.h"
+#include "../../lib/include/stack.h"
+
+TEST(stack_alloc, budgets)
+{
+	using utils::storage::Stack;
+	using utils::test::AllocScope;
+
+	//  growth doubles from 5, so n pushes allocate one block per doubling
+	const int count = 10000;
+	std::size_t doublings = 1;
+	for (int capacity = 5; capacity < count; capacity *= 2) {
+		++doublings;
+	}
+
+	AllocScope scope;
+	{
+		Stack<int> stack;
+		ASSERT_TRUE(scope.allocations() == 0);
+
+		for (int i = 0; i < count; ++i) {
+			stack.push(i);
+		}
+
+		ASSERT_TRUE(scope.allocations() == doublings);
+		ASSERT_TRUE(scope.frees() == doublings - 1);
+
+		//  one block, sized as the original
+		scope.reset();
+		Stack<int> copy(stack);
+		ASSERT_TRUE(scope.allocations() == 1);
+
+		scope.reset();
+		Stack<int> moved(std::move(copy));
+		copy = std::move(moved);
+		using std::swap;
+		swap(stack, copy);
+		ASSERT_TRUE(scope.allocations() == 0);
+		ASSERT_TRUE(scope.frees() == 0);
+
+		//  popping never gives memory back
+		scope.reset();
+		while (!stack.empty()) {
+			stack.pop();
+		}
+
+		ASSERT_TRUE(scope.allocations() + scope.frees() == 0);
+		scope.reset();
+	}
+
+	//  each stack frees its one block
+	ASSERT_TRUE(scope.frees() == 2);
+}
+
+TEST(priority_queue_alloc, budgets)
+{
+	using utils::storage::PriorityQueue;
+	using utils::test::AllocScope;
+
+	PriorityQueue<int> queue;
+	queue.reserve(1000);
+
+	AllocScope scope;
+	for (int i = 0; i < 1000; ++i) {
+		queue.push((i * 7919) % 1000);
+	}
+
+	//  reserved, so neither push nor pop allocates
+	while (queue.getSize() > 500) {
+		queue.pop();
+	}
+
+	ASSERT_TRUE(scope.allocations() == 0);
+
+	PriorityQueue<int> copy(queue);
+	ASSERT_TRUE(scope.allocations() == 1);
+
+	scope.reset();
+	PriorityQueue<int> moved(std::move(copy));
+	using std::swap;
+	swap(moved, queue);
+	queue.clear();
+	ASSERT_TRUE(scope.allocations() == 0);
+	ASSERT_TRUE(scope.frees() == 0);
+}
@@ -0,0 +1,68 @@
+#include "gtest/gtest.h"
+#include <utility>
+#include "../include/alloc_counter.h"
+#include "../../lib/include/static_list.h"
+#include "../../lib/include/static_queue.h"
+#include "../../lib/include/static_stack.h"
+
+namespace {
+	//  not trivial, so the containers take the placement new path
+	struct Tracked
+	{
+		Tracked(const int value) : mValue(value) {}
+		Tracked(const Tracked& rhs) : mValue(rhs.mValue) {}
+		~Tracked() {}
+
+		bool operator==(const Tracked& rhs) const { return mValue == rhs.mValue; }
+
+		int mValue;
+	};
+}
+
+TEST(static_alloc, budgets)
+{
+	using utils::storage::StaticList;
+	using utils::storage::StaticQueue;
+	using utils::storage::StaticStack;
+	using utils::test::AllocScope;
+
+	//  nothing on any path ever reaches the heap
+	AllocScope scope;
+	{
+		StaticStack<Tracked, 64> stack;
+		StaticQueue<Tracked, 64> queue;
+		StaticList<Tracked, 64> list;
+
+		for (int i = 0; i < 100; ++i) {
+			stack.try_push(Tracked(i));
+			queue.try_push_back(Tracked(i));
+			list.try_insert(Tracked(i));
+		}
+
+		for (int i = 0; i < 32; ++i) {
+			stack.pop();
+			queue.pop_front();
+			list.remove(Tracked(i * 2));
+		}
+
+		StaticStack<Tracked, 64> stackCopy(stack);
+		StaticQueue<Tracked, 64> queueCopy(queue);
+		StaticList<Tracked, 64> listCopy(list);
+
+		StaticStack<Tracked, 64> stackMoved(std::move(stackCopy));
+		StaticQueue<Tracked, 64> queueMoved(std::move(queueCopy));
+		StaticList<Tracked, 64> listMoved(std::move(listCopy));
+
+		using std::swap;
+		swap(stack, stackMoved);
+		swap(queue, queueMoved);
+		swap(list, listMoved);
+
+		stack.clear();
+		queue.clear();
+		list.clear();
+	}
+
+	ASSERT_TRUE(scope.allocations() == 0);
+	ASSERT_TRUE(scope.frees() == 0);
+}
@@ -0,0 +1,150 @@
+#include "gtest/gtest.h"
+#include <utility>
+#include <vector>
+#include "../include/alloc_counter.h"
+#include "../../lib/include/bst.h"
+#include "../../lib/include/interval_tree.h"
+#include "../../lib/include/pooled_bst.h"
+#include "../../lib/include/treap.h"
+
+namespace {
+	//  keys in an order that keeps an unbalanced tree shallow
+	std::vector<int> shuffledKeys(const int count)
+	{
+		std::vector<int> keys;
+		for (int i = 0; i < count; ++i) {
+			keys.push_back((i * 7919) % count);
+		}
+
+		return keys;
+	}
+}
+
+TEST(bst_alloc, budgets)
+{
+	using utils::storage::BST;
+	using utils::test::AllocScope;
+
+	const std::vector<int> keys = shuffledKeys(1000);
+
+	AllocScope scope;
+	BST<int, int> bst;
+	for (const int key : keys) {
+		bst.insert(key, key);
+	}
+
+	ASSERT_TRUE(scope.allocations() == 1000);
+
+	//  an overwrite reuses the node
+	scope.reset();
+	bst.insert(keys[10], -1);
+	ASSERT_TRUE(scope.allocations() == 0);
+
+	bst.remove(keys[10]);
+	ASSERT_TRUE(scope.frees() == 1);
+
+	scope.reset();
+	bst.clear();
+	ASSERT_TRUE(scope.frees() == 999);
+	ASSERT_TRUE(scope.allocations() == 0);
+}
+
+TEST(treap_alloc, budgets)
+{
+	using utils::storage::Treap;
+	using utils::test::AllocScope;
+
+	const std::vector<int> keys = shuffledKeys(1000);
+
+	AllocScope scope;
+	Treap<int, int> treap;
+	for (const int key : keys) {
+		treap.insert(key, key);
+	}
+
+	treap.insert(keys[0], -1);
+	ASSERT_TRUE(scope.allocations() == 1000);
+
+	scope.reset();
+	Treap<int, int> copy(treap);
+	ASSERT_TRUE(scope.allocations() == 1000);
+
+	scope.reset();
+	Treap<int, int> moved(std::move(copy));
+	copy = std::move(moved);
+	using std::swap;
+	swap(treap, copy);
+	ASSERT_TRUE(scope.allocations() == 0);
+	ASSERT_TRUE(scope.frees() == 0);
+
+	scope.reset();
+	treap.clear();
+	copy.clear();
+	ASSERT_TRUE(scope.frees() == 2000);
+	ASSERT_TRUE(scope.allocations() == 0);
+}
+
+TEST(interval_tree_alloc, budgets)
+{
+	using utils::storage::IntervalTree;
+	using utils::test::AllocScope;
+
+	AllocScope scope;
+	IntervalTree<int, int> tree;
+	for (int i = 0; i < 1000; ++i) {
+		tree.insert(i, i + 10, i);
+	}
+
+	ASSERT_TRUE(scope.allocations() == 1000);
+
+	scope.reset();
+	IntervalTree<int, int> copy(tree);
+	ASSERT_TRUE(scope.allocations() == 1000);
+
+	//  queries only read
+	scope.reset();
+	std::size_t hits = 0;
+	tree.query_overlapping(500, [&hits](const int&, const int&, const int&) { ++hits; });
+	IntervalTree<int, int> moved(std::move(copy));
+	using std::swap;
+	swap(moved, tree);
+	ASSERT_TRUE(hits == 10);
+	ASSERT_TRUE(scope.allocations() == 0);
+	ASSERT_TRUE(scope.frees() == 0);
+
+	scope.reset();
+	tree.clear();
+	moved.clear();
+	ASSERT_TRUE(scope.frees() == 2000);
+}
+
+TEST(pooled_bst_alloc, budgets)
+{
+	using utils::storage::PooledBST;
+	using utils::test::AllocScope;
+
+	const std::vector<int> keys = shuffledKeys(10000);
+	const std::size_t chunks = (keys.size() + 1023) / 1024;
+
+	AllocScope scope;
+	PooledBST<int, int> bst;
+	for (const int key : keys) {
+		bst.insert(key, key);
+	}
+
+	ASSERT_TRUE(scope.allocations() <= 2 * chunks);
+
+	//  a removed node's slot is the next one handed out
+	scope.reset();
+	bst.remove(keys[0]);
+	bst.insert(keys[0], 0);
+	PooledBST<int, int> moved(std::move(bst));
+	using std::swap;
+	swap(moved, bst);
+	ASSERT_TRUE(scope.allocations() == 0);
+
+	scope.reset();
+	bst.clear();
+	ASSERT_TRUE(scope.allocations() == 0);
+	ASSERT_TRUE(scope.frees() <= 2 * chunks);
+}
@@ -0,0 +1,45 @@
+#ifndef H_UTILS_TEST_ALLOC_COUNTER_H
+#define H_UTILS_TEST_ALLOC_COUNTER_H
+
+//  includes
+#include <cstddef>
+
+namespace utils {
+    namespace test {
+
+        //  AllocCounts
+        //  global operator new and delete calls made by one thread
+        struct AllocCounts
+        {
+            std::size_t mAllocations = 0;
+            std::size_t mFrees = 0;
+            std::size_t mBytes = 0;
+        };
+
+        //  totals for the calling thread since it started
+        //  only counted in a binary that links alloc_counter.cpp, which replaces the global
+        //  operator new and delete, elsewhere the totals stay at zero
+        AllocCounts threadAllocCounts();
+
+        //  AllocScope
+        //  allocations made by this thread between construction and the call,
+        //  other threads (a pool's workers) are not counted
+        class AllocScope
+        {
+        public:
+            AllocScope() : mStart(threadAllocCounts()) {}
+
+            std::size_t allocations() const { return threadAllocCounts().mAllocations - mStart.mAllocations; }
+            std::size_t frees() const { return threadAllocCounts().mFrees - mStart.mFrees; }
+            std::size_t bytes() const { return threadAllocCounts().mBytes - mStart.mBytes; }
+
+            //  start counting again from here
+            void reset() { mStart = threadAllocCounts(); }
+
+        private:
+            AllocCounts mStart;
+        };
+    }
+}
+
+#endif
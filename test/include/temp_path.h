@@ -0,0 +1,42 @@
+#ifndef H_UTILS_TEST_TEMP_PATH_H
+#define H_UTILS_TEST_TEMP_PATH_H
+
+//  includes
+#include <cstdlib>
+#include <string>
+
+namespace utils {
+    namespace test {
+
+        //  path of name in the system's temporary directory, so tests that write files
+        //  leave nothing behind in the directory they were run from
+        inline std::string tempPath(const std::string& name)
+        {
+#ifdef _WIN32
+            const char* names[] = { "TEMP", "TMP" };
+            const char* fallback = ".";
+            const char separator = '\\';
+#else
+            const char* names[] = { "TMPDIR", "TMP" };
+            const char* fallback = "/tmp";
+            const char separator = '/';
+#endif
+            std::string directory = fallback;
+            for (const char* variable : names) {
+                const char* value = std::getenv(variable);
+                if (value != nullptr && *value != '\0') {
+                    directory = value;
+                    break;
+                }
+            }
+
+            if (directory.back() != '/' && directory.back() != '\\') {
+                directory += separator;
+            }
+
+            return directory + name;
+        }
+    }
+}
+
+#endif
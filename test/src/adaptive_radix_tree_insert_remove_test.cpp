@@ -0,0 +1,61 @@
+#include "gtest/gtest.h"
+#include <cstdint>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+#include "../../lib/include/adaptive_radix_tree.h"
+
+TEST(adaptive_radix_tree, insert_remove)
+{
+	using utils::storage::AdaptiveRadixTree;
+	typedef AdaptiveRadixTree<std::string, int> StringTree;
+
+	//  keys that are prefixes of each other and long shared runs past the stored prefix
+	const std::string parts[] = { "", "a", "ab", "/usr/", "/usr/local/lib/a/long/shared/path/", "x" };
+	std::mt19937 rng(7);
+	StringTree tree;
+	std::map<std::string, int> reference;
+	bool matches = true;
+
+	for (int i = 0; matches && i < 20000; ++i) {
+		std::string key;
+		for (unsigned n = rng() % 4; n > 0; --n) {
+			key += parts[rng() % 6];
+		}
+		key += static_cast<char>('a' + rng() % 26);
+
+		if (rng() % 3 != 0) {
+			const int value = static_cast<int>(rng() % 3);
+			const bool existed = reference.count(key) != 0;
+			const StringTree::INSERT_RESULT result = tree.insert(key, value);
+			matches = existed ? result.second != StringTree::NEW_INSERT_IR : result.second == StringTree::NEW_INSERT_IR;
+			reference[key] = value;
+		}
+		else {
+			matches = tree.remove(key) == (reference.erase(key) == 1);
+		}
+	}
+
+	std::vector<std::string> keys;
+	tree.forEach([&](const std::string& k, const int& d) { keys.push_back(k); matches = matches && reference[k] == d; });
+
+	bool ordered = keys.size() == reference.size();
+	std::size_t i = 0;
+	for (auto it = reference.begin(); ordered && it != reference.end(); ++it, ++i) {
+		ordered = keys[i] == it->first;
+	}
+
+	//  signed integers sort through their bytes too
+	AdaptiveRadixTree<std::int64_t, int> numbers;
+	for (std::int64_t n = -300; n < 300; ++n) {
+		numbers.insert(n * 1000003, static_cast<int>(n));
+	}
+
+	std::int64_t previous = INT64_MIN;
+	bool numbersOrdered = true;
+	numbers.forEach([&](const std::int64_t& k, const int&) { numbersOrdered = numbersOrdered && k > previous; previous = k; });
+
+	ASSERT_TRUE(matches && ordered && tree.getSize() == reference.size());
+	ASSERT_TRUE(numbersOrdered && numbers.getSize() == 600 && *numbers.find(-5 * 1000003) == -5 && !numbers.contains(1));
+}
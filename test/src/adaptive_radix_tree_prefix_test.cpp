@@ -0,0 +1,36 @@
+#include "gtest/gtest.h"
+#include <string>
+#include "../../lib/include/adaptive_radix_tree.h"
+
+TEST(adaptive_radix_tree, prefix)
+{
+	using utils::storage::AdaptiveRadixTree;
+
+	AdaptiveRadixTree<std::string, int> tree;
+	tree.insert("/usr", 0);
+	tree.insert("/usr/lib/a", 1);
+	tree.insert("/usr/lib/b", 2);
+	tree.insert("/usr/libexec", 3);
+	tree.insert("/usr/lib/a/very/long/name", 4);
+	tree.insert("/var/log", 5);
+
+	auto scan = [&](const std::string& prefix) {
+		std::string joined;
+		tree.forEachWithPrefix(prefix, [&](const std::string& k, const int&) { joined += k + " "; });
+		return joined;
+	};
+
+	const std::string lib = scan("/usr/lib/");
+	const std::string libs = scan("/usr/lib");
+	//  the mismatch is past the bytes a node stores of its prefix
+	const std::string deep = scan("/usr/lib/a/very/long/nam");
+	const std::string none = scan("/usr/lib/a/very/long/nbm");
+
+	AdaptiveRadixTree<std::string, int> copy(tree);
+	copy.remove("/usr/lib/a");
+	copy.remove("/usr");
+
+	ASSERT_TRUE(lib == "/usr/lib/a /usr/lib/a/very/long/name /usr/lib/b " && libs == lib + "/usr/libexec ");
+	ASSERT_TRUE(deep == "/usr/lib/a/very/long/name " && none.empty() && scan("").size() == 75);
+	ASSERT_TRUE(copy.getSize() == 4 && tree.getSize() == 6 && copy.contains("/usr/lib/a/very/long/name") && !copy.contains("/usr"));
+}
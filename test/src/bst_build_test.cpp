@@ -0,0 +1,67 @@
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <random>
+#include <utility>
+#include <vector>
+#include "../../lib/include/bst.h"
+#include "../../lib/include/thread_pool.h"
+
+namespace {
+	template <typename Node>
+	int height(const Node* node)
+	{
+		return node ? 1 + std::max(height(node->mLeft), height(node->mRight)) : 0;
+	}
+
+	template <typename Node>
+	void inOrder(const Node* node, std::vector<std::pair<int, int>>& out)
+	{
+		if (node == nullptr) return;
+
+		inOrder(node->mLeft, out);
+		out.push_back(std::make_pair(node->mKey, node->mData));
+		inOrder(node->mRight, out);
+	}
+}
+
+TEST(bst, build)
+{
+	using utils::concurrency::ThreadPool;
+	using utils::storage::BST;
+
+	//  every key twice, the second copy carries the value that must win
+	const int count = 100000;
+	std::vector<std::pair<int, int>> items;
+	for (int i = 0; i < count; ++i) {
+		items.push_back(std::make_pair(i, -1));
+		items.push_back(std::make_pair(i, i));
+	}
+
+	std::mt19937 rng(5);
+	std::shuffle(items.begin(), items.end(), rng);
+	std::stable_sort(items.begin(), items.end(), [](const std::pair<int, int>& lhs, const std::pair<int, int>& rhs) { return (lhs.second < 0) > (rhs.second < 0); });
+
+	ThreadPool pool(4);
+	BST<int, int> sequential;
+	BST<int, int> parallel;
+	sequential.insert(-5, 0);
+	sequential.build(items.begin(), items.end());
+	parallel.build(items.begin(), items.end(), &pool);
+
+	std::vector<std::pair<int, int>> sequentialItems;
+	std::vector<std::pair<int, int>> parallelItems;
+	inOrder(sequential.mRoot, sequentialItems);
+	inOrder(parallel.mRoot, parallelItems);
+
+	bool expected = parallelItems.size() == static_cast<std::size_t>(count);
+	for (int i = 0; expected && i < count; ++i) {
+		expected = parallelItems[i].first == i && parallelItems[i].second == i;
+	}
+
+	//  perfectly balanced, 100000 keys fit in 17 levels
+	ASSERT_TRUE(expected && sequentialItems == parallelItems && height(parallel.mRoot) == 17);
+
+	parallel.clear();
+	sequential.clear();
+	ASSERT_TRUE(parallel.mRoot == nullptr && sequential.mRoot == nullptr);
+}
@@ -0,0 +1,38 @@
+#include "gtest/gtest.h"
+#include <vector>
+#include "../../lib/include/bst.h"
+#include "../../lib/include/thread_pool.h"
+
+TEST(bst, parallel_reduce)
+{
+	using utils::concurrency::ThreadPool;
+	using utils::storage::BST;
+
+	const int count = 50000;
+	std::vector<std::pair<int, long long>> items;
+	for (int i = 0; i < count; ++i) {
+		items.push_back(std::make_pair(i, static_cast<long long>(i)));
+	}
+
+	ThreadPool pool(4);
+	BST<int, long long> tree;
+	tree.build(items.begin(), items.end(), &pool);
+
+	//  map over every value in place, then sum
+	tree.parallel_for_each([](const int&, long long& d) { d *= 2; }, pool);
+	const long long sum = tree.parallel_reduce(0LL, [](const int&, const long long& d) { return d; }, [](long long lhs, long long rhs) { return lhs + rhs; }, pool);
+
+	//  concatenation is associative but not commutative, so this checks the combine order
+	const std::vector<int> keys = tree.parallel_reduce(std::vector<int>(),
+		[](const int& k, const long long&) { return std::vector<int>(1, k); },
+		[](std::vector<int> lhs, const std::vector<int>& rhs) { lhs.insert(lhs.end(), rhs.begin(), rhs.end()); return lhs; },
+		pool);
+
+	bool ordered = keys.size() == static_cast<std::size_t>(count);
+	for (int i = 0; ordered && i < count; ++i) {
+		ordered = keys[i] == i;
+	}
+
+	ASSERT_TRUE(sum == 2LL * count * (count - 1) / 2 && ordered);
+	tree.clear();
+}
@@ -0,0 +1,43 @@
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <map>
+#include <random>
+#include <vector>
+#include "../../lib/include/bst.h"
+
+TEST(bst, remove)
+{
+	using utils::storage::BST;
+
+	BST<int, int> bst;
+	std::map<int, int> expected;
+
+	std::vector<int> keys;
+	for (int i = 0; i < 2000; ++i) {
+		keys.push_back(i);
+	}
+
+	std::mt19937 rng(11);
+	std::shuffle(keys.begin(), keys.end(), rng);
+	for (const int key : keys) {
+		bst.insert(key, key * 2);
+		expected[key] = key * 2;
+	}
+
+	//  the root is removed over and over as the tree empties
+	ASSERT_TRUE(!bst.remove(-1));
+	for (const int key : keys) {
+		ASSERT_TRUE(bst.remove(key));
+		ASSERT_TRUE(!bst.remove(key));
+		expected.erase(key);
+
+		if (key % 100 == 0) {
+			std::vector<int> seen;
+			bst.forEach([&seen](const int& k, const int& d) { seen.push_back(k); ASSERT_TRUE(d == k * 2); });
+			ASSERT_TRUE(seen.size() == expected.size());
+			ASSERT_TRUE(std::equal(seen.begin(), seen.end(), expected.begin(), [](const int k, const std::pair<const int, int>& e) { return k == e.first; }));
+		}
+	}
+
+	ASSERT_TRUE(bst.mRoot == nullptr);
+}
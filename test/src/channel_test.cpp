@@ -0,0 +1,178 @@
+#include "gtest/gtest.h"
+#include "../../lib/include/channel.h"
+
+//  only built when the compiler has coroutines, configure with UTILS_COROUTINES=ON
+#ifdef UTILS_HAS_COROUTINES
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+	using utils::concurrency::Channel;
+	using utils::concurrency::PoolExecutor;
+	using utils::concurrency::SingleThreadExecutor;
+	using utils::concurrency::Task;
+	using utils::concurrency::ThreadPool;
+
+	Task produce(Channel<int>& channel, const int count, std::size_t& largest)
+	{
+		for (int i = 0; i < count; ++i) {
+			co_await channel.send(i);
+			if (channel.getSize() > largest) {
+				largest = channel.getSize();
+			}
+		}
+
+		channel.close();
+	}
+
+	Task consume(Channel<int>& channel, std::vector<int>& received)
+	{
+		while (auto value = co_await channel.receive()) {
+			received.push_back(*value);
+		}
+	}
+
+	Task consumeBatches(Channel<int>& channel, std::vector<std::size_t>& sizes, int& sum)
+	{
+		for (;;) {
+			std::vector<int> batch = co_await channel.receive_batch(3);
+			if (batch.empty()) break;
+
+			sizes.push_back(batch.size());
+			for (const int value : batch) {
+				sum += value;
+			}
+		}
+	}
+
+	Task sendAfterClose(Channel<int>& channel)
+	{
+		channel.close();
+		co_await channel.send(1);
+	}
+
+	Task relay(Channel<int>& in, Channel<int>& out)
+	{
+		while (auto value = co_await in.receive()) {
+			co_await out.send(*value * 2);
+		}
+
+		out.close();
+	}
+
+	Task total(Channel<int>& in, long long& sum)
+	{
+		while (auto value = co_await in.receive()) {
+			sum += *value;
+		}
+	}
+}
+
+TEST(channel, backpressure)
+{
+	SingleThreadExecutor executor;
+	Channel<int> channel(executor, 2);
+	std::size_t largest = 0;
+	std::vector<int> received;
+
+	executor.spawn(produce(channel, 100, largest));
+	executor.spawn(consume(channel, received));
+	executor.run();
+
+	//  the producer never got more than the capacity ahead
+	ASSERT_TRUE(largest <= 2);
+	ASSERT_TRUE(received.size() == 100);
+	for (int i = 0; i < 100; ++i) {
+		ASSERT_TRUE(received[i] == i);
+	}
+
+	ASSERT_TRUE(executor.getPendingCount() == 0);
+}
+
+TEST(channel, batch)
+{
+	SingleThreadExecutor executor;
+	Channel<int> channel(executor, 8);
+	std::size_t largest = 0;
+	std::vector<std::size_t> sizes;
+	int sum = 0;
+
+	executor.spawn(produce(channel, 50, largest));
+	executor.spawn(consumeBatches(channel, sizes, sum));
+	executor.run();
+
+	ASSERT_TRUE(sum == 49 * 50 / 2);
+	bool bounded = true;
+	bool batched = false;
+	for (const std::size_t size : sizes) {
+		bounded = bounded && size >= 1 && size <= 3;
+		batched = batched || size > 1;
+	}
+
+	ASSERT_TRUE(bounded && batched);
+}
+
+TEST(channel, closed)
+{
+	SingleThreadExecutor executor;
+	Channel<int> channel(executor, 1);
+	executor.spawn(sendAfterClose(channel));
+
+	bool threw = false;
+	try {
+		executor.run();
+	} catch (const std::logic_error&) {
+		threw = true;
+	}
+
+	ASSERT_TRUE(threw);
+
+	//  a receiver left waiting on a channel nobody closes
+	Channel<int> idle(executor, 1);
+	std::vector<int> received;
+	executor.spawn(consume(idle, received));
+
+	threw = false;
+	try {
+		executor.run();
+	} catch (const std::logic_error&) {
+		threw = true;
+	}
+
+	ASSERT_TRUE(threw);
+	idle.close();
+	executor.run();
+	ASSERT_TRUE(received.empty());
+}
+
+TEST(channel, pool)
+{
+	//  a chain of stages, each one on whichever worker resumes it
+	ThreadPool pool(4);
+	PoolExecutor executor(pool);
+
+	const int COUNT = 10000;
+	const int STAGES = 4;
+	std::vector<Channel<int>*> channels;
+	for (int i = 0; i <= STAGES; ++i) {
+		channels.push_back(new Channel<int>(executor, 16));
+	}
+
+	std::size_t largest = 0;
+	long long sum = 0;
+	executor.spawn(produce(*channels[0], COUNT, largest));
+	for (int i = 0; i < STAGES; ++i) {
+		executor.spawn(relay(*channels[i], *channels[i + 1]));
+	}
+
+	executor.spawn(total(*channels[STAGES], sum));
+	executor.join();
+
+	ASSERT_TRUE(sum == (1LL << STAGES) * COUNT * (COUNT - 1) / 2);
+
+	for (Channel<int>* channel : channels) {
+		delete channel;
+	}
+}
+#endif
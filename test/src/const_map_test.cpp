@@ -0,0 +1,97 @@
+#include "gtest/gtest.h"
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include "../../lib/include/const_map.h"
+
+namespace {
+	using utils::storage::ConstMap;
+	using utils::storage::makeConstMap;
+
+	enum E_OPCODE { NOP_OP, LOAD_OP, STORE_OP, ADD_OP, JUMP_OP, HALT_OP };
+
+	constexpr auto opcodes = makeConstMap<int, E_OPCODE>({
+		{ 0x90, NOP_OP }, { 0x8b, LOAD_OP }, { 0x89, STORE_OP },
+		{ 0x01, ADD_OP }, { 0xe9, JUMP_OP }, { 0xf4, HALT_OP } });
+
+	static_assert(opcodes.getSize() == 6, "");
+	static_assert(*opcodes.find(0x89) == STORE_OP, "");
+	static_assert(opcodes.at(0x01) == ADD_OP, "");
+	static_assert(opcodes.at(0xf4) == HALT_OP, "");
+	static_assert(!opcodes.contains(0x00), "");
+	static_assert(!opcodes.contains(0x02), "");
+	static_assert(!opcodes.contains(0xff), "");
+
+	//  lambdas are not literal types before C++17
+	struct WeighOrder
+	{
+		constexpr void operator()(const int, const E_OPCODE op) { *mSum += op * mPosition++; }
+
+		int* mSum;
+		int mPosition;
+	};
+
+	constexpr int sumInOrder()
+	{
+		int sum = 0;
+		opcodes.forEach(WeighOrder{ &sum, 1 });
+		return sum;
+	}
+
+	//  key order is ADD, STORE, LOAD, NOP, JUMP, HALT
+	static_assert(sumInOrder() == ADD_OP * 1 + STORE_OP * 2 + LOAD_OP * 3 + NOP_OP * 4 + JUMP_OP * 5 + HALT_OP * 6, "");
+
+	//  a custom order
+	constexpr auto reversed = makeConstMap<int, int>({ { 1, 10 }, { 2, 20 }, { 3, 30 } }, std::greater<int>());
+	static_assert(reversed.at(2) == 20 && !reversed.contains(4), "");
+}
+
+TEST(const_map, find)
+{
+	//  every size up to a few full levels, every key present and every gap absent
+	constexpr int COUNT = 40;
+	ConstMap<int, int, COUNT>::Entry entries[COUNT] = {};
+	for (int i = 0; i < COUNT; ++i) {
+		entries[i].mKey = ((i * 7) % COUNT) * 2;
+		entries[i].mData = -entries[i].mKey;
+	}
+
+	const ConstMap<int, int, COUNT> map(entries);
+	for (int k = -1; k <= COUNT * 2; ++k) {
+		const int* data = map.find(k);
+		if (k >= 0 && k % 2 == 0 && k < COUNT * 2) {
+			ASSERT_TRUE(data != nullptr && *data == -k);
+		}
+		else {
+			ASSERT_TRUE(data == nullptr);
+		}
+	}
+
+	int previous = -1;
+	bool ordered = true;
+	map.forEach([&](const int k, const int) { ordered = ordered && k > previous; previous = k; });
+	ASSERT_TRUE(ordered);
+
+	bool threw = false;
+	try {
+		map.at(1);
+	} catch (const std::out_of_range&) {
+		threw = true;
+	}
+
+	ASSERT_TRUE(threw);
+
+	//  duplicates are rejected
+	threw = false;
+	try {
+		makeConstMap<int, int>({ { 1, 1 }, { 2, 2 }, { 1, 3 } });
+	} catch (const std::logic_error&) {
+		threw = true;
+	}
+
+	ASSERT_TRUE(threw);
+
+	//  not a literal type, built at run time
+	const auto names = makeConstMap<std::string, int>({ { "b", 2 }, { "a", 1 }, { "c", 3 } });
+	ASSERT_TRUE(names.at("a") == 1 && names.at("c") == 3 && !names.contains("d"));
+}
@@ -0,0 +1,122 @@
+#include "gtest/gtest.h"
+#include "../../lib/include/bst.h"
+#include "../../lib/include/container_stats.h"
+#include "../../lib/include/list.h"
+#include "../../lib/include/queue.h"
+#include "../../lib/include/stack.h"
+
+TEST(container_stats, counts)
+{
+	using utils::storage::BST;
+	using utils::storage::ContainerStats;
+	using utils::storage::CountingStats;
+	using utils::storage::List;
+	using utils::storage::Queue;
+	using utils::storage::Stack;
+
+	//  statistics off costs nothing
+	ASSERT_TRUE(sizeof(Stack<int>) == 2 * sizeof(std::size_t) + sizeof(int*));
+	ASSERT_TRUE(sizeof(Queue<int>) == sizeof(void*));
+	ASSERT_TRUE(sizeof(BST<int, int>) == sizeof(void*));
+
+	{
+		//  capacity goes 5, 10, 20, 40
+		Stack<int, CountingStats> stack;
+		for (int i = 0; i < 40; ++i) {
+			stack.push(i);
+		}
+
+		const ContainerStats stats = stack.stats();
+		ASSERT_TRUE(stats.mResizes == 4);
+		ASSERT_TRUE(stats.mBytesCopied == (5 + 10 + 20) * sizeof(int));
+		ASSERT_TRUE(stats.mAllocations == 4);
+		ASSERT_TRUE(stats.mFrees == 3);
+		ASSERT_TRUE(stack.memory_usage().mPayload == 40 * sizeof(int));
+
+		Stack<int> quiet;
+		quiet.push(1);
+		ASSERT_TRUE(quiet.stats().mResizes == 0);
+	}
+
+	{
+		//  each push_back walks the whole queue to find its tail
+		Queue<int, CountingStats> queue;
+		for (int i = 0; i < 10; ++i) {
+			queue.push_back(i);
+		}
+
+		queue.pop_front();
+		ContainerStats stats = queue.stats();
+		ASSERT_TRUE(stats.mWalks == 10);
+		ASSERT_TRUE(stats.mNodesVisited == 45);
+		ASSERT_TRUE(stats.mLongestWalk == 9);
+		ASSERT_TRUE(stats.mAllocations == 10);
+		ASSERT_TRUE(stats.mFrees == 1);
+		ASSERT_TRUE(queue.memory_usage().mPayload == 9 * sizeof(int));
+
+		queue.clear();
+		ASSERT_TRUE(queue.stats().mFrees == 10);
+		ASSERT_TRUE(queue.memory_usage().mPayload == 0);
+	}
+
+	{
+		List<int, CountingStats> list;
+		for (int i = 0; i < 10; ++i) {
+			list.insert(i);
+		}
+
+		list.remove(9);
+		list.remove(100);
+		ContainerStats stats = list.stats();
+		ASSERT_TRUE(stats.mAllocations == 10);
+		ASSERT_TRUE(stats.mFrees == 1);
+		ASSERT_TRUE(stats.mWalks == 2);
+		ASSERT_TRUE(stats.mNodesVisited == 10 + 9);
+
+		//  a moved list takes its statistics with it
+		List<int, CountingStats> moved(std::move(list));
+		ASSERT_TRUE(moved.stats().mAllocations == 10);
+		ASSERT_TRUE(moved.memory_usage().mPayload == 9 * sizeof(int));
+		ASSERT_TRUE(moved.memory_usage().mOverhead >= 9 * sizeof(void*));
+	}
+
+	{
+		//  sorted keys build a chain, depth i for key i
+		BST<int, int, CountingStats> bst;
+		for (int i = 0; i < 100; ++i) {
+			bst.insert(i, i);
+		}
+
+		bst.insert(0, 1);
+		ContainerStats stats = bst.stats();
+		ASSERT_TRUE(stats.mHeight == 100);
+		ASSERT_TRUE(stats.mAllocations == 100);
+		ASSERT_TRUE(stats.mInsertDepths[0] == 1);
+		ASSERT_TRUE(stats.mInsertDepths[10] == 1);
+		ASSERT_TRUE(stats.mInsertDepths[ContainerStats::DEPTH_BUCKETS - 1] == 100 - (ContainerStats::DEPTH_BUCKETS - 1));
+
+		bst.remove(99);
+		bst.remove(0);
+		stats = bst.stats();
+		ASSERT_TRUE(stats.mRemoveDepths[ContainerStats::DEPTH_BUCKETS - 1] == 1);
+		ASSERT_TRUE(stats.mRemoveDepths[0] == 1);
+		ASSERT_TRUE(stats.mFrees == 2);
+		ASSERT_TRUE(stats.mHeight == 98);
+		ASSERT_TRUE(bst.memory_usage().mPayload == 98 * 2 * sizeof(int));
+
+		bst.clear();
+		ASSERT_TRUE(bst.stats().mFrees == 100);
+		ASSERT_TRUE(bst.stats().mHeight == 0);
+
+		//  a balanced build
+		std::vector<std::pair<int, int>> items;
+		for (int i = 0; i < 1023; ++i) {
+			items.push_back(std::make_pair(i, i));
+		}
+
+		bst.build(items.begin(), items.end());
+		ASSERT_TRUE(bst.stats().mHeight == 10);
+		ASSERT_TRUE(bst.stats().mAllocations == 100 + 1023);
+		bst.clear();
+	}
+}
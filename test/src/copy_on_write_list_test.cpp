@@ -0,0 +1,20 @@
+#include "gtest/gtest.h"
+#include "../../lib/include/copy_on_write.h"
+
+TEST(copy_on_write, list)
+{
+	using utils::storage::CowList;
+	using utils::storage::List;
+	CowList<int> original(List<int>{ 1, 2, 3 });
+
+	CowList<int> copy1 = original;
+	CowList<int> copy2 = original;
+
+	//  copies share one list until someone writes
+	bool shared = (&copy1.read() == &original.read()) && original.useCount() == 3;
+
+	copy1.write().insert(4);
+
+	ASSERT_TRUE(shared && copy1.read().getSize() == 4 && original.read().getSize() == 3 &&
+		!copy1.isShared() && original.useCount() == 2 && &copy2.read() == &original.read());
+}
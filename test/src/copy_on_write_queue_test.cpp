@@ -0,0 +1,19 @@
+#include "gtest/gtest.h"
+#include "../../lib/include/copy_on_write.h"
+
+TEST(copy_on_write, queue)
+{
+	using utils::storage::CowQueue;
+	CowQueue<int> original;
+	original.write().push_back(1);
+	original.write().push_back(2);
+
+	CowQueue<int> copy = original;
+	copy.write().pop_front();
+
+	//  a sole owner writes in place
+	const int* before = &original.read().front();
+	original.write().front() = 5;
+
+	ASSERT_TRUE(copy.read().front() == 2 && original.read().front() == 5 && &original.read().front() == before);
+}
@@ -0,0 +1,126 @@
+#include "gtest/gtest.h"
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+#include "../../lib/include/flat_map.h"
+#include "../../lib/include/thread_pool.h"
+
+namespace {
+	//  every copy and move counts against the budget, the one that finds it empty throws
+	//  a negative budget never runs out
+	struct Fragile
+	{
+		static int sBudget;
+
+		Fragile() : mValue(0) {}
+		explicit Fragile(const int value) : mValue(value) {}
+		Fragile(const Fragile& rhs) : mValue(rhs.mValue) { spend(); }
+		Fragile(Fragile&& rhs) : mValue(rhs.mValue) { spend(); }
+		Fragile& operator=(const Fragile& rhs) { spend(); mValue = rhs.mValue; return *this; }
+		Fragile& operator=(Fragile&& rhs) { spend(); mValue = rhs.mValue; return *this; }
+
+		bool operator==(const Fragile& rhs) const { return mValue == rhs.mValue; }
+
+		static void spend()
+		{
+			if (sBudget == 0) throw std::runtime_error("copy failed");
+			if (sBudget > 0) --sBudget;
+		}
+
+		int mValue;
+	};
+
+	int Fragile::sBudget = -1;
+}
+
+TEST(flat_map, insert_batch)
+{
+	using utils::concurrency::ThreadPool;
+	using utils::storage::FlatMap;
+
+	FlatMap<int, int> map;
+	for (int i = 0; i < 1000; i += 2) {
+		map.insert(i, 0);
+	}
+
+	//  unsorted, overlapping the map and with duplicates inside the batch
+	std::vector<std::pair<int, int>> batch;
+	for (int i = 1999; i >= 0; i -= 3) {
+		batch.push_back(std::make_pair(i, 1));
+		batch.push_back(std::make_pair(i, 2));
+	}
+
+	std::size_t expectedAdded = 0;
+	for (int i = 1999; i >= 0; i -= 3) {
+		expectedAdded += (i < 1000 && i % 2 == 0) ? 0 : 1;
+	}
+
+	const std::size_t added = map.insert_batch(batch.begin(), batch.end());
+
+	bool merged = true;
+	int previous = -1;
+	map.forEach([&](const int& k, const int& d) {
+		const bool fromBatch = (1999 - k) % 3 == 0;
+		merged = merged && k > previous && d == (fromBatch ? 2 : 0);
+		previous = k;
+	});
+
+	//  a pooled batch large enough to be sorted in parallel lands the same way
+	ThreadPool pool(2);
+	std::vector<std::pair<int, int>> large;
+	for (int i = 0; i < 50000; ++i) {
+		large.push_back(std::make_pair((i * 7919) % 50000, i));
+	}
+
+	FlatMap<int, int> pooled;
+	const std::size_t pooledAdded = pooled.insert_batch(large.begin(), large.end(), &pool);
+
+	ASSERT_TRUE(added == expectedAdded && merged && map.getSize() == 500 + expectedAdded);
+	ASSERT_TRUE(pooledAdded == 50000 && pooled.getSize() == 50000 && *pooled.find(7919) == 1 && pooled.lower_bound(25000) == 25000);
+}
+
+TEST(flat_map, insert_batch_throws)
+{
+	using utils::storage::FlatMap;
+
+	//  string keys move without throwing, so only the data can fail halfway through a merge
+	const auto key = [](const int i) { return std::string(1, static_cast<char>('0' + i / 10)) + static_cast<char>('0' + i % 10); };
+
+	FlatMap<std::string, Fragile> map;
+	for (int i = 0; i < 100; i += 2) {
+		map.insert(key(i), Fragile(i));
+	}
+
+	std::vector<std::pair<std::string, Fragile>> batch;
+	for (int i = 0; i < 100; i += 3) {
+		batch.push_back(std::make_pair(key(i), Fragile(-i)));
+	}
+
+	//  fail at every copy or move in turn, the map must come out as it went in each time
+	bool intact = true;
+	bool threw = true;
+	for (int budget = 0; threw; ++budget) {
+		Fragile::sBudget = budget;
+		threw = false;
+		try {
+			map.insert_batch(batch.begin(), batch.end());
+		}
+		catch (const std::runtime_error&) {
+			threw = true;
+		}
+
+		Fragile::sBudget = -1;
+		if (threw) {
+			int count = 0;
+			map.forEach([&](const std::string& k, const Fragile& d) {
+				intact = intact && k == key(2 * count) && d.mValue == 2 * count;
+				++count;
+			});
+
+			intact = intact && count == 50;
+		}
+	}
+
+	ASSERT_TRUE(intact && map.getSize() == 50 + 17 && map.find(key(3))->mValue == -3 && map.find(key(6))->mValue == -6 && map.find(key(4))->mValue == 4);
+}
@@ -0,0 +1,32 @@
+#include "gtest/gtest.h"
+#include <string>
+#include "../../lib/include/flat_map.h"
+
+TEST(flat_map, insert)
+{
+	using utils::storage::FlatMap;
+	typedef FlatMap<int, std::string> StringMap;
+
+	StringMap map;
+	for (int i = 99; i >= 0; --i) {
+		map.insert(i * 2, std::to_string(i));
+	}
+
+	const StringMap::INSERT_RESULT added = map.insert(7, "odd");
+	const StringMap::INSERT_RESULT same = map.insert(7, "odd");
+	const StringMap::INSERT_RESULT different = map.insert(8, "eight");
+
+	//  the linear finish of the search covers every position of a small window
+	bool bounds = true;
+	for (int k = -1; k <= 200; ++k) {
+		const std::size_t index = map.lower_bound(k);
+		std::size_t count = 0;
+		map.forEach([&](const int& key, const std::string&) { count += key < k ? 1 : 0; });
+		bounds = bounds && index == count;
+	}
+
+	const bool removed = map.remove(7) && !map.remove(7);
+
+	ASSERT_TRUE(added.second == StringMap::NEW_INSERT_IR && same.second == StringMap::OVERWRITE_SAME_VALUE_IR && different.second == StringMap::OVERWRITE_DIFFERENT_VALUE_IR);
+	ASSERT_TRUE(bounds && removed && map.getSize() == 100 && *map.find(8) == "eight" && !map.contains(7) && map.find(200) == nullptr);
+}
@@ -0,0 +1,42 @@
+#include "gtest/gtest.h"
+#include <functional>
+#include <vector>
+#include "../../lib/include/priority_queue.h"
+
+TEST(indexed_priority_queue, decrease_key)
+{
+	using utils::storage::IndexedPriorityQueue;
+
+	//  shortest paths from node 0 over a small weighted graph
+	struct Edge { int mTo; int mWeight; };
+	std::vector<std::vector<Edge>> graph{
+		{ { 1, 4 }, { 2, 1 } },
+		{ { 3, 1 } },
+		{ { 1, 2 }, { 3, 5 } },
+		{}
+	};
+
+	std::vector<int> distance(graph.size(), 1000);
+	std::vector<std::size_t> handles(graph.size());
+	IndexedPriorityQueue<int, std::greater<int>> open;
+
+	distance[0] = 0;
+	for (std::size_t node = 0; node < graph.size(); ++node) {
+		handles[node] = open.push(distance[node]);
+	}
+
+	while (!open.empty()) {
+		const std::size_t handle = open.topHandle();
+		const int node = static_cast<int>(handle);
+		open.pop();
+
+		for (const Edge& edge : graph[node]) {
+			if (open.contains(handles[edge.mTo]) && distance[node] + edge.mWeight < distance[edge.mTo]) {
+				distance[edge.mTo] = distance[node] + edge.mWeight;
+				open.decrease_key(handles[edge.mTo], distance[edge.mTo]);
+			}
+		}
+	}
+
+	ASSERT_TRUE(distance == std::vector<int>({ 0, 3, 1, 4 }));
+}
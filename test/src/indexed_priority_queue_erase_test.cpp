@@ -0,0 +1,20 @@
+#include "gtest/gtest.h"
+#include "../../lib/include/priority_queue.h"
+
+TEST(indexed_priority_queue, erase)
+{
+	using utils::storage::IndexedPriorityQueue;
+	IndexedPriorityQueue<int> q;
+
+	auto a = q.push(10);
+	auto b = q.push(30);
+	auto c = q.push(20);
+
+	q.erase(b);
+	q.update(a, 40);
+
+	//  the erased handle is handed out again
+	auto d = q.push(5);
+
+	ASSERT_TRUE(q.top() == 40 && q.topHandle() == a && q.get(c) == 20 && d == b && q.getSize() == 3 && q.contains(d));
+}
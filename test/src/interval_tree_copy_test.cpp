@@ -0,0 +1,50 @@
+#include "gtest/gtest.h"
+#include <stdexcept>
+#include "../../lib/include/interval_tree.h"
+
+namespace {
+	//  copies fine until the budget runs out, a negative budget never runs out
+	struct Fragile
+	{
+		static int sBudget;
+
+		explicit Fragile(const int value) : mValue(value) {}
+		Fragile(const Fragile& rhs) : mValue(rhs.mValue)
+		{
+			if (sBudget == 0) throw std::runtime_error("copy failed");
+			if (sBudget > 0) --sBudget;
+		}
+
+		Fragile& operator=(const Fragile&) = default;
+		bool operator==(const Fragile& rhs) const { return mValue == rhs.mValue; }
+
+		int mValue;
+	};
+
+	int Fragile::sBudget = -1;
+}
+
+TEST(interval_tree, copy)
+{
+	using utils::storage::IntervalTree;
+
+	//  a copy that throws halfway releases what it built, the leak checker would see the rest
+	IntervalTree<int, Fragile> source;
+	for (int i = 0; i < 100; ++i) {
+		source.insert(i, i + 10, Fragile(i));
+	}
+
+	Fragile::sBudget = 50;
+	bool threw = false;
+	try {
+		IntervalTree<int, Fragile> copy(source);
+	}
+	catch (const std::runtime_error&) {
+		threw = true;
+	}
+
+	Fragile::sBudget = -1;
+	IntervalTree<int, Fragile> copy(source);
+
+	ASSERT_TRUE(threw && copy.getSize() == 100 && copy.find(42, 52)->mValue == 42);
+}
@@ -0,0 +1,41 @@
+#include "gtest/gtest.h"
+#include <stdexcept>
+#include "../../lib/include/interval_tree.h"
+
+TEST(interval_tree, insert_remove)
+{
+	using utils::storage::IntervalTree;
+	typedef IntervalTree<int, int> IntTree;
+
+	IntTree tree;
+	const IntTree::INSERT_RESULT added = tree.insert(10, 20, 1);
+	const IntTree::INSERT_RESULT same = tree.insert(10, 20, 1);
+	const IntTree::INSERT_RESULT different = tree.insert(10, 20, 2);
+	tree.insert(10, 30, 3);
+	tree.insert(0, 100, 4);
+	tree.insert(25, 26, 5);
+
+	bool threw = false;
+	try {
+		tree.insert(5, 5, 0);
+	} catch (const std::invalid_argument&) {
+		threw = true;
+	}
+
+	//  the long interval is the only one over 50, once it is gone the subtree maxima have to drop
+	int before = 0;
+	tree.query_overlapping(50, [&](const int&, const int&, const int&) { ++before; });
+	const bool removed = tree.remove(0, 100) && !tree.remove(0, 100);
+	int after = 0;
+	tree.query_overlapping(50, [&](const int&, const int&, const int&) { ++after; });
+
+	int touching = 0;
+	tree.query_overlapping(20, 25, [&](const int&, const int&, const int& d) { touching += d; });
+
+	IntTree copy(tree);
+	tree.clear();
+
+	ASSERT_TRUE(added.second == IntTree::NEW_INSERT_IR && same.second == IntTree::OVERWRITE_SAME_VALUE_IR && different.second == IntTree::OVERWRITE_DIFFERENT_VALUE_IR);
+	ASSERT_TRUE(threw && before == 1 && removed && after == 0 && touching == 3);
+	ASSERT_TRUE(tree.empty() && copy.getSize() == 3 && *copy.find(10, 30) == 3 && !copy.contains(0, 100));
+}
@@ -0,0 +1,50 @@
+#include "gtest/gtest.h"
+#include <random>
+#include <tuple>
+#include <vector>
+#include "../../lib/include/interval_tree.h"
+
+TEST(interval_tree, query)
+{
+	using utils::storage::IntervalTree;
+	typedef std::tuple<int, int, int> Interval;
+
+	std::mt19937 rng(3);
+	IntervalTree<int, int> tree;
+	std::vector<Interval> intervals;
+	for (int i = 0; i < 2000; ++i) {
+		const int lo = static_cast<int>(rng() % 10000);
+		const int hi = lo + 1 + static_cast<int>(rng() % (i % 10 == 0 ? 2000 : 50));
+		if (tree.insert(lo, hi, i).second == IntervalTree<int, int>::NEW_INSERT_IR) {
+			intervals.push_back(Interval(lo, hi, i));
+		}
+	}
+
+	//  every query against a scan of all the intervals, including the edges of half open ranges
+	bool matches = true;
+	for (int q = 0; matches && q < 500; ++q) {
+		const int point = static_cast<int>(rng() % 10100) - 50;
+		const int lo = static_cast<int>(rng() % 10100) - 50;
+		const int hi = lo + static_cast<int>(rng() % 100);
+
+		std::vector<Interval> atPoint;
+		std::vector<Interval> inRange;
+		tree.query_overlapping(point, [&](const int& l, const int& h, const int& d) { atPoint.push_back(Interval(l, h, d)); });
+		tree.query_overlapping(lo, hi, [&](const int& l, const int& h, const int& d) { inRange.push_back(Interval(l, h, d)); });
+
+		std::size_t expectedAtPoint = 0;
+		std::size_t expectedInRange = 0;
+		for (const Interval& interval : intervals) {
+			expectedAtPoint += (std::get<0>(interval) <= point && point < std::get<1>(interval)) ? 1 : 0;
+			expectedInRange += (lo < hi && std::get<0>(interval) < hi && lo < std::get<1>(interval)) ? 1 : 0;
+		}
+
+		for (std::size_t i = 1; i < atPoint.size(); ++i) {
+			matches = matches && atPoint[i - 1] < atPoint[i];
+		}
+
+		matches = matches && atPoint.size() == expectedAtPoint && inRange.size() == expectedInRange;
+	}
+
+	ASSERT_TRUE(matches && tree.getSize() == intervals.size() && tree.getHeight() < 40);
+}
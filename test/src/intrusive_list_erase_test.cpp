@@ -0,0 +1,40 @@
+#include "gtest/gtest.h"
+#include "../../lib/include/intrusive_list.h"
+
+namespace {
+	struct Tag1 {};
+	struct Tag2 {};
+
+	//  one object in two lists at once through two tagged hooks
+	struct Item : utils::storage::IntrusiveHook<Tag1>, utils::storage::IntrusiveHook<Tag2> {
+		explicit Item(int value) : mValue(value) {}
+		int mValue;
+	};
+}
+
+TEST(intrusive_list, erase)
+{
+	using utils::storage::IntrusiveList;
+	using utils::storage::BaseHook;
+	Item items[] = { Item(1), Item(2), Item(3), Item(4) };
+	IntrusiveList<Item, BaseHook<Item, Tag1>> all;
+	IntrusiveList<Item, BaseHook<Item, Tag2>> even;
+
+	for (Item& item : items) {
+		all.push_back(item);
+		if (item.mValue % 2 == 0) {
+			even.push_back(item);
+		}
+	}
+
+	//  erase from the middle of both lists in O(1)
+	all.erase(items[1]);
+	even.erase(items[1]);
+
+	int sum = 0;
+	for (const Item& item : all) {
+		sum += item.mValue;
+	}
+
+	ASSERT_TRUE(sum == 8 && all.getSize() == 3 && even.getSize() == 1 && &even.front() == &items[3]);
+}
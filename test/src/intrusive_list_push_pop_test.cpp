@@ -0,0 +1,27 @@
+#include "gtest/gtest.h"
+#include "../../lib/include/intrusive_list.h"
+
+namespace {
+	struct Item : utils::storage::IntrusiveHook<> {
+		explicit Item(int value) : mValue(value) {}
+		int mValue;
+	};
+}
+
+TEST(intrusive_list, push_pop)
+{
+	using utils::storage::IntrusiveList;
+	Item a(1), b(2), c(3);
+	IntrusiveList<Item> l;
+
+	l.push_back(b);
+	l.push_back(c);
+	l.push_front(a);
+
+	ASSERT_TRUE(l.getSize() == 3 && &l.front() == &a && &l.back() == &c);
+
+	l.pop_front();
+	l.pop_back();
+
+	ASSERT_TRUE(l.getSize() == 1 && &l.front() == &b && !a.isLinked() && b.isLinked() && !c.isLinked());
+}
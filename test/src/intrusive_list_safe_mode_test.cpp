@@ -0,0 +1,42 @@
+//  safe mode asserts, so they must stay on whatever the build type
+#undef NDEBUG
+#define UTILS_INTRUSIVE_SAFE_MODE
+
+#include "gtest/gtest.h"
+#include <utility>
+#include "../../lib/include/intrusive_list.h"
+
+namespace {
+	//  hook types of their own, safe mode changes the hook layout and no other test may share it
+	struct SafeTag {};
+
+	struct Item : utils::storage::IntrusiveHook<SafeTag> {
+		explicit Item(int value) : mValue(value) {}
+		int mValue;
+	};
+
+	typedef utils::storage::IntrusiveList<Item, utils::storage::BaseHook<Item, SafeTag>> ItemList;
+}
+
+TEST(intrusive_list, safe_mode)
+{
+	Item item(1);
+	ItemList first;
+	ItemList second;
+	first.push_back(item);
+
+	//  a second container, or the same one twice, is caught before any link is touched
+	ASSERT_DEATH(second.push_back(item), "already linked");
+	ASSERT_DEATH(first.push_front(item), "already linked");
+	ASSERT_DEATH(second.erase(item), "not linked into this container");
+
+	//  moving a list hands its elements over
+	ItemList moved(std::move(first));
+	ASSERT_DEATH(first.erase(item), "not linked into this container");
+
+	moved.erase(item);
+	second.push_back(item);
+	second.pop_back();
+
+	ASSERT_TRUE(!item.isLinked() && moved.empty() && second.empty());
+}
@@ -0,0 +1,31 @@
+#include "gtest/gtest.h"
+#include "../../lib/include/intrusive_queue.h"
+
+namespace {
+	struct Request {
+		int mId = 0;
+		utils::storage::IntrusiveHook<> mHook;
+	};
+}
+
+TEST(intrusive_queue, member_hook)
+{
+	using utils::storage::IntrusiveQueue;
+	using utils::storage::IntrusiveHook;
+	using utils::storage::MemberHook;
+	typedef IntrusiveQueue<Request, MemberHook<Request, void, &Request::mHook>> RequestQueue;
+
+	Request requests[3];
+	RequestQueue q;
+	for (int i = 0; i < 3; ++i) {
+		requests[i].mId = i;
+		q.push_back(requests[i]);
+	}
+
+	//  cancel the middle request, then move the queue
+	q.unlink(requests[1]);
+	RequestQueue moved(std::move(q));
+	moved.pop_front();
+
+	ASSERT_TRUE(q.empty() && moved.getSize() == 1 && moved.front().mId == 2 && !requests[0].mHook.isLinked());
+}
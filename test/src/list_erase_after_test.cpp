@@ -0,0 +1,22 @@
+#include "gtest/gtest.h"
+#include "../../lib/include/list.h"
+
+TEST(list, erase_after)
+{
+	using utils::storage::List;
+	List<int> l{ 1, 2, 3, 4 };
+
+	//  erase the head, then the tail
+	l.erase_after(l.before_begin());
+	auto it = l.begin();
+	++it;
+	l.erase_after(it);
+
+	//  the tail must have moved back so appending still links correctly
+	l.insert(5);
+
+	auto inserted = l.insert_after(l.begin(), 6);
+	l.erase_after(inserted, l.end());
+
+	ASSERT_TRUE(l.getSize() == 2 && l.front() == 2 && l.back() == 6);
+}
@@ -0,0 +1,20 @@
+#include "gtest/gtest.h"
+#include "../../lib/include/list.h"
+
+TEST(list, iterator)
+{
+	using utils::storage::List;
+	List<int> l{ 1, 2, 3 };
+
+	int sum = 0;
+	for (int& i : l) {
+		i *= 2;
+	}
+
+	const List<int>& cl = l;
+	for (List<int>::const_iterator it = cl.begin(); it != cl.end(); ++it) {
+		sum += *it;
+	}
+
+	ASSERT_TRUE(sum == 12 && l.front() == 2 && l.back() == 6);
+}
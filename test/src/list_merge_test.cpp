@@ -0,0 +1,39 @@
+#include "gtest/gtest.h"
+#include "../../lib/include/list.h"
+
+TEST(list, merge)
+{
+	using utils::storage::List;
+	List<int> l1{ 1, 3, 5 };
+	List<int> l2{ 0, 2, 4, 6, 8 };
+
+	l1.merge(l2);
+	l1.insert(9);
+
+	int expected = 0;
+	bool ordered = true;
+	for (int i : l1) {
+		ordered = ordered && (i == expected);
+		expected = (expected == 6) ? 8 : expected + 1;
+	}
+
+	ASSERT_TRUE(ordered && l1.getSize() == 9 && l2.getSize() == 0);
+}
+
+TEST(list, merge_into_empty)
+{
+	using utils::storage::List;
+	List<int> l1;
+	List<int> l2{ 1, 2, 3 };
+
+	l1.merge(l2);
+	l1.insert(4);
+
+	int expected = 1;
+	bool ordered = true;
+	for (int i : l1) {
+		ordered = ordered && (i == expected++);
+	}
+
+	ASSERT_TRUE(ordered && expected == 5 && l1.getSize() == 4 && l2.getSize() == 0);
+}
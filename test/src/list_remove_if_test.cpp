@@ -0,0 +1,18 @@
+#include "gtest/gtest.h"
+#include "../../lib/include/list.h"
+
+TEST(list, remove_if)
+{
+	using utils::storage::List;
+	List<int> l{ 1, 2, 3, 4, 5, 6 };
+
+	std::size_t removed = l.remove_if([](const int i) { return i % 2 == 0; });
+	l.insert(7);
+
+	int sum = 0;
+	for (int i : l) {
+		sum += i;
+	}
+
+	ASSERT_TRUE(removed == 3 && l.getSize() == 4 && sum == 16);
+}
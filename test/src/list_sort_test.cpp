@@ -0,0 +1,22 @@
+#include "gtest/gtest.h"
+#include <utility>
+#include "../../lib/include/list.h"
+
+TEST(list, sort)
+{
+	using utils::storage::List;
+	List<std::pair<int, int>> l{ { 3, 0 }, { 1, 1 }, { 2, 2 }, { 1, 3 }, { 5, 4 }, { 3, 5 }, { 0, 6 } };
+
+	//  sort on the first member only so the second shows stability
+	l.sort([](const std::pair<int, int>& lhs, const std::pair<int, int>& rhs) { return lhs.first < rhs.first; });
+	l.insert({ 9, 7 });
+
+	std::pair<int, int> expected[] = { { 0, 6 }, { 1, 1 }, { 1, 3 }, { 2, 2 }, { 3, 0 }, { 3, 5 }, { 5, 4 }, { 9, 7 } };
+	int index = 0;
+	bool same = true;
+	for (const auto& p : l) {
+		same = same && (p == expected[index++]);
+	}
+
+	ASSERT_TRUE(same && l.getSize() == 8);
+}
@@ -0,0 +1,30 @@
+#include "gtest/gtest.h"
+#include "../../lib/include/list.h"
+
+TEST(list, splice_after)
+{
+	using utils::storage::List;
+	List<int> l1{ 1, 2 };
+	List<int> l2{ 3, 4, 5, 6 };
+
+	//  move 4 and 5 to the end of l1
+	auto first = l2.begin();
+	auto last = first;
+	++last;
+	++last;
+	++last;
+	l1.splice_after(++l1.begin(), l2, first, last);
+
+	//  move everything left in l2 to the front of l1
+	l1.splice_after(l1.before_begin(), l2);
+	l1.insert(7);
+
+	int expected[] = { 3, 6, 1, 2, 4, 5, 7 };
+	int index = 0;
+	bool same = true;
+	for (int i : l1) {
+		same = same && (i == expected[index++]);
+	}
+
+	ASSERT_TRUE(same && l1.getSize() == 7 && l2.getSize() == 0 && l2.begin() == l2.end());
+}
@@ -0,0 +1,19 @@
+#include "gtest/gtest.h"
+#include "../../lib/include/list.h"
+
+TEST(list, unique)
+{
+	using utils::storage::List;
+	List<int> l{ 4, 1, 4, 2, 1, 4, 4 };
+
+	l.sort();
+	std::size_t removed = l.unique();
+	l.insert(5);
+
+	int sum = 0;
+	for (int i : l) {
+		sum += i;
+	}
+
+	ASSERT_TRUE(removed == 4 && l.getSize() == 4 && sum == 12);
+}
@@ -0,0 +1,23 @@
+#include "gtest/gtest.h"
+#include "../../lib/include/lru_cache.h"
+
+TEST(lru_cache, clock)
+{
+	using utils::storage::LruCache;
+	using utils::storage::CLOCK_EP;
+
+	LruCache<int, int, CLOCK_EP> cache(3);
+	cache.put(1, 10);
+	cache.put(2, 20);
+	cache.put(3, 30);
+
+	//  1 and 3 are referenced, the hand gives them a second chance and takes 2
+	cache.find(1);
+	cache.find(3);
+	cache.put(4, 40);
+
+	//  the reference bits were cleared on the way past, so 1 is the next victim
+	cache.put(5, 50);
+
+	ASSERT_TRUE(cache.getSize() == 3 && !cache.contains(1) && !cache.contains(2) && cache.contains(3) && cache.contains(4) && cache.contains(5));
+}
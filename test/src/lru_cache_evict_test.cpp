@@ -0,0 +1,27 @@
+#include "gtest/gtest.h"
+#include <string>
+#include "../../lib/include/lru_cache.h"
+
+TEST(lru_cache, evict)
+{
+	using utils::storage::LruCache;
+	typedef LruCache<int, std::string> Cache;
+
+	Cache cache(3);
+	cache.put(1, "one");
+	cache.put(2, "two");
+	cache.put(3, "three");
+
+	//  using 1 makes 2 the least recently used, so 4 pushes 2 out
+	std::string value;
+	const bool hit = cache.get(1, value);
+	cache.put(4, "four");
+
+	//  overwriting counts as a use as well
+	const Cache::INSERT_RESULT result = cache.put(3, "drei");
+	cache.put(5, "five");
+
+	ASSERT_TRUE(hit && value == "one" && result.second == Cache::OVERWRITE_DIFFERENT_VALUE_IR);
+	ASSERT_TRUE(cache.getSize() == 3 && !cache.contains(1) && !cache.contains(2) && *cache.find(3) == "drei" && cache.contains(4) && cache.contains(5));
+	ASSERT_TRUE(cache.getHits() == 2 && cache.getMisses() == 0);
+}
@@ -0,0 +1,29 @@
+#include "gtest/gtest.h"
+#include <string>
+#include "../../lib/include/lru_cache.h"
+
+namespace {
+	struct LengthWeigher {
+		std::size_t operator()(const int&, const std::string& s) const { return s.size(); }
+	};
+}
+
+TEST(lru_cache, weight)
+{
+	using utils::storage::LruCache;
+	using utils::storage::LRU_EP;
+
+	//  capacity in bytes of payload
+	LruCache<int, std::string, LRU_EP, LengthWeigher> cache(10);
+	cache.put(1, "aaaa");
+	cache.put(2, "bbbb");
+
+	//  needs 6 bytes, only the oldest has to go
+	cache.put(3, "cccccc");
+	const bool afterThird = !cache.contains(1) && cache.contains(2) && cache.getWeight() == 10;
+
+	//  heavier than the whole cache, rejected without flushing anything
+	const bool stored = cache.put(4, std::string(11, 'd')).first;
+
+	ASSERT_TRUE(afterThird && !stored && cache.getSize() == 2 && cache.getWeight() == 10);
+}
@@ -0,0 +1,83 @@
+#include "gtest/gtest.h"
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <vector>
+#include "../../lib/include/bst.h"
+#include "../../lib/include/mapped_bst.h"
+#include "../include/temp_path.h"
+
+TEST(mapped_bst, round_trip)
+{
+	using utils::storage::BST;
+	using utils::storage::MappedBST;
+
+	const std::string path = utils::test::tempPath("mapped_bst_round_trip.bin");
+
+	//  odd keys only, so every even key is a miss that falls between two stored ones
+	const int count = 10000;
+	std::vector<std::pair<int, double>> items;
+	for (int i = 0; i < count; ++i) {
+		items.push_back(std::make_pair(2 * i + 1, i * 0.5));
+	}
+
+	BST<int, double> tree;
+	tree.build(items.begin(), items.end());
+	MappedBST<int, double>::write(tree, path);
+	tree.clear();
+
+	MappedBST<int, double> mapped(path);
+
+	bool found = mapped.getSize() == static_cast<std::size_t>(count);
+	for (int i = 0; found && i < count; ++i) {
+		const double* d = mapped.find(2 * i + 1);
+		found = d != nullptr && *d == i * 0.5 && !mapped.contains(2 * i) && !mapped.contains(2 * i + 2 + 2 * count);
+	}
+
+	std::vector<int> keys;
+	mapped.forEach([&](const int& k, const double&) { keys.push_back(k); });
+
+	bool ordered = keys.size() == static_cast<std::size_t>(count);
+	for (int i = 0; ordered && i < count; ++i) {
+		ordered = keys[i] == 2 * i + 1;
+	}
+
+	mapped.close();
+	std::remove(path.c_str());
+
+	ASSERT_TRUE(found && ordered && !mapped.isOpen());
+}
+
+TEST(mapped_bst, compare)
+{
+	using utils::storage::BST;
+	using utils::storage::MappedBST;
+
+	const std::string path = utils::test::tempPath("mapped_bst_compare.bin");
+
+	BST<int, int> tree;
+	for (int i = 0; i < 100; ++i) {
+		tree.insert(2 * i, -i);
+	}
+
+	//  written and searched in descending order
+	MappedBST<int, int, std::greater<int>>::write(tree, path);
+	tree.clear();
+
+	MappedBST<int, int, std::greater<int>> mapped(path);
+
+	bool found = true;
+	for (int i = 0; i < 100; ++i) {
+		const int* d = mapped.find(2 * i);
+		found = found && d != nullptr && *d == -i && !mapped.contains(2 * i + 1);
+	}
+
+	std::vector<int> keys;
+	mapped.forEach([&](const int& k, const int&) { keys.push_back(k); });
+	const bool descending = keys.size() == 100 && keys.front() == 198 && keys.back() == 0;
+
+	mapped.close();
+	std::remove(path.c_str());
+
+	ASSERT_TRUE(found && descending);
+}
@@ -0,0 +1,84 @@
+#include "gtest/gtest.h"
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include "../../lib/include/bst.h"
+#include "../../lib/include/mapped_bst.h"
+#include "../include/temp_path.h"
+
+namespace {
+	template <typename Mapped>
+	bool opens(const std::string& path)
+	{
+		try {
+			Mapped mapped(path);
+			return true;
+		}
+		catch (const std::runtime_error&) {
+			return false;
+		}
+	}
+
+	//  the header as write() lays it out, magic and six 32 bit fields come first
+	const std::size_t COUNT_OFFSET = 32;
+	const std::size_t KEYS_OFFSET = 40;
+
+	//  a copy of bytes with the 64 bit header field at offset set to value
+	std::string patched(std::string bytes, const std::size_t offset, const std::uint64_t value)
+	{
+		std::memcpy(&bytes[offset], &value, sizeof(value));
+		return bytes;
+	}
+}
+
+TEST(mapped_bst, validation)
+{
+	using utils::storage::BST;
+	using utils::storage::MappedBST;
+
+	const std::string path = utils::test::tempPath("mapped_bst_validation.bin");
+
+	BST<int, int> tree;
+	tree.insert(1, 1);
+	tree.insert(2, 4);
+	MappedBST<int, int>::write(tree, path);
+	tree.clear();
+
+	//  the same file is refused for a different data type
+	const bool sameTypes = opens<MappedBST<int, int>>(path);
+	const bool otherTypes = opens<MappedBST<int, long long>>(path);
+
+	//  a truncated copy and garbage are refused too
+	std::ifstream in(path, std::ios::binary);
+	std::string bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+	in.close();
+
+	std::ofstream(path, std::ios::binary | std::ios::trunc).write(bytes.data(), static_cast<std::streamsize>(bytes.size() - 1));
+	const bool truncated = opens<MappedBST<int, int>>(path);
+
+	std::ofstream(path, std::ios::binary | std::ios::trunc) << std::string(bytes.size(), 'x');
+	const bool garbage = opens<MappedBST<int, int>>(path);
+
+	//  a count so large that count * sizeof(Key) wraps round to a small size
+	std::ofstream(path, std::ios::binary | std::ios::trunc) << patched(bytes, COUNT_OFFSET, 1ull << 62);
+	const bool hugeCount = opens<MappedBST<int, int>>(path);
+
+	//  keys overlapping the header, and keys off their alignment
+	std::ofstream(path, std::ios::binary | std::ios::trunc) << patched(bytes, KEYS_OFFSET, 0);
+	const bool inHeader = opens<MappedBST<int, int>>(path);
+	std::ofstream(path, std::ios::binary | std::ios::trunc) << patched(bytes, KEYS_OFFSET, 65);
+	const bool misaligned = opens<MappedBST<int, int>>(path);
+
+	//  the unpatched bytes still open
+	std::ofstream(path, std::ios::binary | std::ios::trunc) << bytes;
+	const bool restored = opens<MappedBST<int, int>>(path);
+
+	const bool missing = opens<MappedBST<int, int>>(utils::test::tempPath("mapped_bst_missing.bin"));
+	std::remove(path.c_str());
+
+	ASSERT_TRUE(sameTypes && !otherTypes && !truncated && !garbage && !missing);
+	ASSERT_TRUE(!hugeCount && !inHeader && !misaligned && restored);
+}
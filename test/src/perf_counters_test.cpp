@@ -0,0 +1,50 @@
+#include "gtest/gtest.h"
+#include <cstdint>
+#include "../../bench/include/perf_counters.h"
+
+namespace {
+	std::uint64_t work(const std::uint64_t n)
+	{
+		volatile std::uint64_t sum = 0;
+		for (std::uint64_t i = 0; i < n; ++i) {
+			sum = sum + i;
+		}
+
+		return sum;
+	}
+}
+
+TEST(perf_counters, region)
+{
+	using utils::bench::PerfCounters;
+
+	PerfCounters counters;
+
+	counters.start();
+	work(1000000);
+	counters.pause();
+	const double counted = counters.read(PerfCounters::INSTRUCTIONS_PC);
+
+	//  paused work is not counted
+	work(1000000);
+	ASSERT_TRUE(counters.read(PerfCounters::INSTRUCTIONS_PC) == counted);
+
+	for (int i = 0; i < PerfCounters::COUNTER_COUNT; ++i) {
+		const PerfCounters::E_COUNTER counter = static_cast<PerfCounters::E_COUNTER>(i);
+		ASSERT_TRUE(PerfCounters::name(counter) != nullptr);
+
+		//  a counter that could not be opened reads as zero rather than failing
+		if (!counters.available(counter)) {
+			ASSERT_TRUE(counters.read(counter) == 0.0);
+		}
+	}
+
+	if (counters.available(PerfCounters::INSTRUCTIONS_PC)) {
+		ASSERT_TRUE(counted >= 1000000.0);
+
+		//  start counts from zero again
+		counters.start();
+		counters.pause();
+		ASSERT_TRUE(counters.read(PerfCounters::INSTRUCTIONS_PC) < counted);
+	}
+}
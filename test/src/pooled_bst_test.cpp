@@ -0,0 +1,100 @@
+#include "gtest/gtest.h"
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "../../lib/include/pooled_bst.h"
+
+namespace {
+	//  holds a heap string, so a node the tree forgets shows up as a leak
+	//  copies fine until the budget runs out, a negative budget never runs out
+	struct Fragile
+	{
+		static int sBudget;
+
+		explicit Fragile(const int value) : mValue(std::to_string(value) + " long enough to live on the heap") {}
+		Fragile(const Fragile& rhs) : mValue(rhs.mValue)
+		{
+			if (sBudget == 0) throw std::runtime_error("copy failed");
+			if (sBudget > 0) --sBudget;
+		}
+
+		Fragile& operator=(const Fragile&) = default;
+		bool operator==(const Fragile& rhs) const { return mValue == rhs.mValue; }
+
+		std::string mValue;
+	};
+
+	int Fragile::sBudget = -1;
+}
+
+TEST(pooled_bst, insert_remove)
+{
+	using utils::storage::PooledBST;
+	typedef PooledBST<std::uint32_t, std::uint32_t> IntTree;
+
+	//  a scattered insert order keeps the tree shallow
+	IntTree tree;
+	const std::uint32_t count = 1 << 12;
+	for (std::uint32_t i = 0; i < count; ++i) {
+		tree.insert((i * 2654435761u) % count, i);
+	}
+
+	const IntTree::INSERT_RESULT same = tree.insert(7, *tree.find(7));
+	const IntTree::INSERT_RESULT different = tree.insert(7, 0);
+
+	std::uint32_t removed = 0;
+	for (std::uint32_t i = 0; i < count; i += 2) {
+		removed += tree.remove(i) ? 1 : 0;
+	}
+
+	//  freed slots are reused before the pool grows again
+	const std::size_t usage = tree.getMemoryUsage();
+	for (std::uint32_t i = 0; i < count; i += 2) {
+		tree.insert(i, i);
+	}
+
+	const bool reused = tree.getMemoryUsage() == usage;
+	for (std::uint32_t i = 0; i < count; i += 2) {
+		tree.remove(i);
+	}
+
+	IntTree copy(tree);
+	tree.clear();
+
+	std::vector<std::uint32_t> keys;
+	copy.forEach([&](const std::uint32_t& k, const std::uint32_t&) { keys.push_back(k); });
+
+	bool ordered = keys.size() == count / 2;
+	for (std::size_t i = 0; ordered && i < keys.size(); ++i) {
+		ordered = keys[i] == 2 * i + 1;
+	}
+
+	ASSERT_TRUE(same.second == IntTree::OVERWRITE_SAME_VALUE_IR && different.second == IntTree::OVERWRITE_DIFFERENT_VALUE_IR);
+	ASSERT_TRUE(removed == count / 2 && reused && !copy.remove(0) && ordered && *copy.find(7) == 0 && !copy.contains(8));
+	ASSERT_TRUE(tree.empty() && tree.find(7) == nullptr && copy.getSize() == count / 2);
+}
+
+TEST(pooled_bst, copy_throws)
+{
+	using utils::storage::PooledBST;
+
+	PooledBST<int, Fragile> source;
+	for (int i = 0; i < 100; ++i) {
+		source.insert((i * 37) % 100, Fragile(i));
+	}
+
+	Fragile::sBudget = 50;
+	bool threw = false;
+	try {
+		PooledBST<int, Fragile> copy(source);
+	}
+	catch (const std::runtime_error&) {
+		threw = true;
+	}
+
+	Fragile::sBudget = -1;
+	PooledBST<int, Fragile> copy(source);
+
+	ASSERT_TRUE(threw && copy.getSize() == 100 && copy.find(37)->mValue == Fragile(1).mValue);
+}
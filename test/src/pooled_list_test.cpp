@@ -0,0 +1,32 @@
+#include "gtest/gtest.h"
+#include <string>
+#include <utility>
+#include "../../lib/include/pooled_list.h"
+
+TEST(pooled_list, insert_remove)
+{
+	using utils::storage::PooledList;
+
+	PooledList<std::string> list;
+	list.insert("one");
+	list.emplace(3, 't');
+	list.insert(std::string("three"));
+
+	//  removing the tail has to move it back
+	list.remove("three");
+	list.insert("four");
+	list.remove("one");
+	list.remove("missing");
+
+	PooledList<std::string> copy(list);
+	PooledList<std::string> moved(std::move(list));
+	copy.insert("five");
+
+	std::string joined;
+	for (const std::string& s : copy) {
+		joined += s + " ";
+	}
+
+	ASSERT_TRUE(joined == "ttt four five " && copy.front() == "ttt" && copy.back() == "five" && copy.getSize() == 3);
+	ASSERT_TRUE(list.empty() && moved.getSize() == 2 && moved.back() == "four");
+}
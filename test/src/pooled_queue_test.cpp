@@ -0,0 +1,40 @@
+#include "gtest/gtest.h"
+#include <stdexcept>
+#include "../../lib/include/pooled_queue.h"
+
+TEST(pooled_queue, push_pop)
+{
+	using utils::storage::PooledQueue;
+
+	PooledQueue<int> queue;
+	for (int i = 0; i < 3000; ++i) {
+		queue.push_back(i);
+	}
+
+	queue.push_front(-1);
+
+	bool ordered = queue.front() == -1;
+	queue.pop_front();
+	for (int i = 0; ordered && i < 3000; ++i) {
+		ordered = queue.front() == i;
+		queue.pop_front();
+	}
+
+	//  the tail has to reset once the queue drains
+	queue.emplace_back(7);
+	queue.emplace_front(6);
+	PooledQueue<int> copy(queue);
+	queue.clear();
+
+	bool threw = false;
+	try {
+		queue.front();
+	} catch (const std::logic_error&) {
+		threw = true;
+	}
+
+	ASSERT_TRUE(ordered && threw && queue.empty());
+	ASSERT_TRUE(copy.getSize() == 2 && copy.front() == 6);
+	copy.pop_front();
+	ASSERT_TRUE(copy.front() == 7);
+}
@@ -0,0 +1,16 @@
+#include "gtest/gtest.h"
+#include <string>
+#include <vector>
+#include "../../lib/include/priority_queue.h"
+
+TEST(priority_queue, heapify)
+{
+	using utils::storage::PriorityQueue;
+	std::vector<std::string> words{ "pear", "apple", "fig", "zucchini", "kiwi", "banana" };
+	PriorityQueue<std::string> q(words.begin(), words.end());
+
+	PriorityQueue<std::string> copy = q;
+	copy.pop();
+
+	ASSERT_TRUE(q.getSize() == 6 && q.top() == "zucchini" && copy.top() == "pear");
+}
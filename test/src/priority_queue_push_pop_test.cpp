@@ -0,0 +1,23 @@
+#include "gtest/gtest.h"
+#include <functional>
+#include "../../lib/include/priority_queue.h"
+
+TEST(priority_queue, push_pop)
+{
+	using utils::storage::PriorityQueue;
+	PriorityQueue<int, std::greater<int>, 8> q;
+
+	//  enough elements to grow the buffer a few times
+	for (int i = 0; i < 200; ++i) {
+		q.push((i * 37) % 200);
+	}
+
+	bool ordered = true;
+	int expected = 0;
+	while (!q.empty()) {
+		ordered = ordered && (q.top() == expected++);
+		q.pop();
+	}
+
+	ASSERT_TRUE(ordered && expected == 200);
+}
@@ -0,0 +1,43 @@
+#include "gtest/gtest.h"
+#include <thread>
+#include <vector>
+#include "../../lib/include/lru_cache.h"
+
+TEST(sharded_lru_cache, concurrent)
+{
+	using utils::storage::ShardedLruCache;
+
+	const int threadCount = 4;
+	const int perThread = 2000;
+	ShardedLruCache<int, int> cache(threadCount * perThread, 8);
+
+	//  every thread writes its own keys, then reads them back
+	std::vector<std::thread> threads;
+	std::vector<int> found(threadCount, 0);
+	for (int t = 0; t < threadCount; ++t) {
+		threads.emplace_back([&, t]() {
+			for (int i = 0; i < perThread; ++i) {
+				cache.put(t * perThread + i, i);
+			}
+
+			for (int i = 0; i < perThread; ++i) {
+				int value = -1;
+				if (cache.get(t * perThread + i, value) && value == i) {
+					++found[t];
+				}
+			}
+		});
+	}
+
+	for (std::thread& thread : threads) {
+		thread.join();
+	}
+
+	//  shards may fill unevenly, so only the total and the absence of torn values are checked
+	int total = 0;
+	for (int count : found) {
+		total += count;
+	}
+
+	ASSERT_TRUE(cache.getShardCount() == 8 && cache.getSize() <= static_cast<std::size_t>(threadCount * perThread) && total == static_cast<int>(cache.getHits()) && total > 0);
+}
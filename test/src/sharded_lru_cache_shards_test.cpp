@@ -0,0 +1,50 @@
+#include "gtest/gtest.h"
+#include <cstddef>
+#include <stdexcept>
+#include "../../lib/include/lru_cache.h"
+
+namespace {
+	//  weighs like EntryWeigher, but the copy that finds the budget empty throws
+	//  a negative budget never runs out
+	struct FragileWeigher
+	{
+		static int sBudget;
+
+		FragileWeigher() = default;
+		FragileWeigher(const FragileWeigher&)
+		{
+			if (sBudget == 0) throw std::runtime_error("copy failed");
+			if (sBudget > 0) --sBudget;
+		}
+
+		std::size_t operator()(const int&, const int&) const { return 1; }
+	};
+
+	int FragileWeigher::sBudget = -1;
+}
+
+TEST(sharded_lru_cache, shards)
+{
+	using utils::storage::ShardedLruCache;
+	using utils::storage::LRU_EP;
+
+	//  more shards than room lowers the count, so every shard can hold something
+	ShardedLruCache<int, int> small(3, 16);
+	ShardedLruCache<int, int> empty(0, 4);
+	ShardedLruCache<int, int> rounded(100, 5);
+
+	//  a shard that throws while the cache is built takes the others down with it, the leak
+	//  checker would see any that stayed
+	FragileWeigher::sBudget = 5;
+	bool threw = false;
+	try {
+		ShardedLruCache<int, int, LRU_EP, FragileWeigher> cache(64, 8);
+	}
+	catch (const std::runtime_error&) {
+		threw = true;
+	}
+
+	FragileWeigher::sBudget = -1;
+
+	ASSERT_TRUE(small.getShardCount() == 2 && empty.getShardCount() == 1 && rounded.getShardCount() == 8 && threw);
+}
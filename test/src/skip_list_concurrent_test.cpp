@@ -0,0 +1,49 @@
+#include "gtest/gtest.h"
+#include <thread>
+#include <vector>
+#include "../../lib/include/skip_list.h"
+
+TEST(skip_list, concurrent)
+{
+	using utils::storage::ConcurrentSkipList;
+	ConcurrentSkipList<int, int> s;
+	const int threadCount = 4;
+	const int keyCount = 8000;
+
+	//  threads interleave their keys so neighbouring nodes are linked and unlinked by different threads,
+	//  each thread erases every other key it inserted while a reader walks the list
+	std::vector<std::thread> threads;
+	for (int t = 0; t < threadCount; ++t) {
+		threads.emplace_back([&s, t]() {
+			for (int i = t; i < keyCount; i += threadCount) {
+				s.insert(i, i);
+			}
+
+			for (int i = t; i < keyCount; i += threadCount * 2) {
+				s.erase(i);
+			}
+		});
+	}
+
+	threads.emplace_back([&s]() {
+		for (int pass = 0; pass < 20; ++pass) {
+			int previous = -1;
+			s.forEach([&previous](const int k, const int) { previous = k; });
+		}
+	});
+
+	for (std::thread& thread : threads) {
+		thread.join();
+	}
+
+	int previous = -1;
+	bool ordered = true;
+	std::size_t count = 0;
+	s.forEach([&](const int k, const int) {
+		ordered = ordered && (k > previous) && ((k / threadCount) % 2 == 1);
+		previous = k;
+		++count;
+	});
+
+	ASSERT_TRUE(ordered && count == keyCount / 2 && s.getSize() == keyCount / 2);
+}
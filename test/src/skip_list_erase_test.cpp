@@ -0,0 +1,26 @@
+#include "gtest/gtest.h"
+#include <vector>
+#include "../../lib/include/skip_list.h"
+
+TEST(skip_list, erase)
+{
+	using utils::storage::ConcurrentSkipList;
+	ConcurrentSkipList<int, int> s;
+
+	for (int i = 0; i < 100; ++i) {
+		s.insert(i, i * 2);
+	}
+
+	bool erased = true;
+	for (int i = 0; i < 100; i += 2) {
+		erased = erased && s.erase(i);
+	}
+
+	bool erasedTwice = s.erase(0);
+
+	std::vector<int> range;
+	s.forEachInRange(10, 20, [&range](const int k, const int) { range.push_back(k); });
+
+	ASSERT_TRUE(erased && !erasedTwice && s.getSize() == 50 &&
+		range == std::vector<int>({ 11, 13, 15, 17, 19 }));
+}
@@ -0,0 +1,28 @@
+#include "gtest/gtest.h"
+#include <vector>
+#include "../../lib/include/skip_list.h"
+
+TEST(skip_list, insert)
+{
+	using utils::storage::ConcurrentSkipList;
+	typedef ConcurrentSkipList<int, int> SkipList;
+	SkipList s;
+
+	SkipList::INSERT_RESULT first = s.insert(5, 50);
+	s.insert(1, 10);
+	s.insert(3, 30);
+	SkipList::INSERT_RESULT same = s.insert(3, 30);
+	SkipList::INSERT_RESULT different = s.insert(3, 31);
+
+	std::vector<int> keys;
+	s.forEach([&keys](const int k, const int) { keys.push_back(k); });
+
+	int value = 0;
+	bool found = s.find(3, value);
+
+	ASSERT_TRUE(first.second == SkipList::NEW_INSERT_IR &&
+		same.second == SkipList::OVERWRITE_SAME_VALUE_IR &&
+		different.second == SkipList::OVERWRITE_DIFFERENT_VALUE_IR &&
+		found && value == 31 && !s.contains(2) &&
+		s.getSize() == 3 && keys == std::vector<int>({ 1, 3, 5 }));
+}
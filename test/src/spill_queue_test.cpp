@@ -0,0 +1,200 @@
+#include "gtest/gtest.h"
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include "../../lib/include/mapped_file.h"
+#include "../../lib/include/spill_queue.h"
+#include "../include/temp_path.h"
+
+namespace {
+	using utils::storage::MappedFile;
+	using utils::storage::SpillQueue;
+
+	bool fileExists(const std::string& path)
+	{
+		std::FILE* file = std::fopen(path.c_str(), "rb");
+		if (file) std::fclose(file);
+		return file != nullptr;
+	}
+
+	struct StringCodec
+	{
+		static std::size_t getSize(const std::string& s) { return s.size(); }
+		static void encode(const std::string& s, void* out) { std::memcpy(out, s.data(), s.size()); }
+		static std::string decode(const void* in, const std::size_t size) { return std::string(static_cast<const char*>(in), size); }
+	};
+}
+
+TEST(spill_queue, mapped_create)
+{
+	const std::string path = utils::test::tempPath("spill_queue_create.bin");
+	{
+		MappedFile file;
+		file.create(path, 10000);
+		ASSERT_TRUE(file.getSize() == 10000 && file.getWritableData() != nullptr);
+
+		char* data = static_cast<char*>(file.getWritableData());
+		ASSERT_TRUE(data[0] == 0 && data[9999] == 0);
+		std::memcpy(data + 5000, "spill", 5);
+
+		//  evicted pages come back from the file
+		file.evict(0, 10000);
+		file.prefetch(0, 10000);
+		ASSERT_TRUE(std::memcmp(data + 5000, "spill", 5) == 0);
+	}
+
+	MappedFile reopened(path);
+	ASSERT_TRUE(reopened.getWritableData() == nullptr);
+	ASSERT_TRUE(std::memcmp(static_cast<const char*>(reopened.getData()) + 5000, "spill", 5) == 0);
+	reopened.close();
+	std::remove(path.c_str());
+
+	//  more than any disk holds, refused up front and nothing left behind
+	bool threw = false;
+	try {
+		MappedFile huge;
+		huge.create(path, static_cast<std::size_t>(1) << 60);
+	} catch (const std::runtime_error&) {
+		threw = true;
+	}
+
+	ASSERT_TRUE(threw);
+	ASSERT_TRUE(!fileExists(path));
+}
+
+TEST(spill_queue, disk_full)
+{
+	const std::string prefix = utils::test::tempPath("spill_queue_full");
+
+	bool threw = false;
+	try {
+		SpillQueue<int> tooSmall(prefix, 4, 2);
+	} catch (const std::invalid_argument&) {
+		threw = true;
+	}
+
+	ASSERT_TRUE(threw);
+
+	//  segments no disk has room for, the push that would spill throws and is left out
+	SpillQueue<int> queue(prefix, 4, static_cast<std::size_t>(1) << 60);
+	for (int i = 0; i < 4; ++i) {
+		queue.push_back(i);
+	}
+
+	threw = false;
+	try {
+		queue.push_back(4);
+	} catch (const std::runtime_error&) {
+		threw = true;
+	}
+
+	ASSERT_TRUE(threw);
+	ASSERT_TRUE(queue.getSize() == 4 && queue.getSpilledCount() == 0);
+	ASSERT_TRUE(!fileExists(prefix + ".0.seg"));
+
+	bool ordered = true;
+	for (int i = 0; i < 4; ++i) {
+		ordered = ordered && queue.front() == i;
+		queue.pop_front();
+	}
+
+	ASSERT_TRUE(ordered && queue.empty());
+}
+
+TEST(spill_queue, fifo)
+{
+	const std::string prefix = utils::test::tempPath("spill_queue_fifo");
+	const std::size_t LIMIT = 64;
+
+	SpillQueue<long long> queue(prefix, LIMIT, 4096);
+
+	//  pushes outrun pops in bursts, so the queue spills across many segments and drains back
+	long long pushed = 0;
+	long long popped = 0;
+	bool ordered = true;
+	bool bounded = true;
+	std::size_t largestSpill = 0;
+	std::size_t mostSegments = 0;
+
+	for (int round = 0; round < 50; ++round) {
+		for (int i = 0; i < 2000; ++i) {
+			queue.push_back(pushed++);
+			bounded = bounded && queue.getMemoryCount() <= LIMIT;
+		}
+
+		largestSpill = queue.getSpilledCount() > largestSpill ? queue.getSpilledCount() : largestSpill;
+		mostSegments = queue.getSegmentCount() > mostSegments ? queue.getSegmentCount() : mostSegments;
+
+		for (int i = 0; i < 1500; ++i) {
+			ordered = ordered && queue.front() == popped;
+			queue.pop_front();
+			++popped;
+		}
+	}
+
+	ASSERT_TRUE(queue.getSize() == static_cast<std::size_t>(pushed - popped));
+	while (!queue.empty()) {
+		ordered = ordered && queue.front() == popped;
+		queue.pop_front();
+		++popped;
+	}
+
+	ASSERT_TRUE(ordered && bounded);
+	ASSERT_TRUE(popped == pushed);
+	ASSERT_TRUE(largestSpill > 10000 && mostSegments > 10);
+
+	//  every segment is deleted once read
+	ASSERT_TRUE(queue.getSegmentCount() <= 1);
+	queue.clear();
+	ASSERT_TRUE(!fileExists(prefix + ".0.seg"));
+
+	bool threw = false;
+	try {
+		queue.front();
+	} catch (const std::logic_error&) {
+		threw = true;
+	}
+
+	ASSERT_TRUE(threw);
+}
+
+TEST(spill_queue, codec)
+{
+	const std::string prefix = utils::test::tempPath("spill_queue_codec");
+
+	{
+		SpillQueue<std::string, StringCodec> queue(prefix, 8, 256);
+		for (int i = 0; i < 500; ++i) {
+			//  some records are larger than a whole segment
+			queue.push_back(std::string(static_cast<std::size_t>(i % 7 == 0 ? 300 : i % 13), static_cast<char>('a' + i % 26)));
+		}
+
+		ASSERT_TRUE(queue.getSpilledCount() > 0);
+		ASSERT_TRUE(fileExists(prefix + ".0.seg"));
+
+		SpillQueue<std::string, StringCodec> moved(std::move(queue));
+		ASSERT_TRUE(queue.empty() && moved.getSize() == 500);
+
+		bool same = true;
+		for (int i = 0; i < 500; ++i) {
+			same = same && moved.front() == std::string(static_cast<std::size_t>(i % 7 == 0 ? 300 : i % 13), static_cast<char>('a' + i % 26));
+			moved.pop_front();
+		}
+
+		ASSERT_TRUE(same && moved.empty());
+
+		//  left with segments on disk, the destructor deletes them
+		for (int i = 0; i < 100; ++i) {
+			moved.push_back("left behind");
+		}
+	}
+
+	bool leftover = false;
+	for (int i = 0; i < 200; ++i) {
+		leftover = leftover || fileExists(prefix + "." + std::to_string(i) + ".seg");
+	}
+
+	ASSERT_TRUE(!leftover);
+}
@@ -0,0 +1,105 @@
+#include "gtest/gtest.h"
+#include <string>
+#include <utility>
+#include "../../lib/include/static_list.h"
+
+namespace {
+	using utils::storage::StaticList;
+
+	//  removed slots are handed out again
+	constexpr StaticList<int, 4> makeList()
+	{
+		StaticList<int, 4> list;
+		for (int i = 1; i <= 4; ++i) {
+			list.try_insert(i);
+		}
+
+		list.remove(2);
+		list.remove(4);
+		list.try_insert(5);
+		list.try_insert(6);
+		list.try_insert(7);
+		return list;
+	}
+
+	constexpr int weigh(const StaticList<int, 4>& list)
+	{
+		int weight = 0;
+		int position = 1;
+		for (const int value : list) {
+			weight += value * position;
+			++position;
+		}
+
+		return weight;
+	}
+
+	//  assigned over a list whose free slots are scattered, and topped up with a default element
+	constexpr StaticList<int, 4> assignOver()
+	{
+		StaticList<int, 4> list;
+		for (int i = 1; i <= 4; ++i) {
+			list.try_insert(i);
+		}
+
+		list.remove(3);
+		list.remove(1);
+		list = makeList();
+		list.remove(6);
+		list.try_emplace();
+		return list;
+	}
+
+	static_assert(makeList().getSize() == 4, "");
+	static_assert(makeList().back() == 6, "");
+	static_assert(weigh(makeList()) == 1 * 1 + 3 * 2 + 5 * 3 + 6 * 4, "");
+	static_assert(weigh(assignOver()) == 1 * 1 + 3 * 2 + 5 * 3 + 0 * 4, "");
+}
+
+TEST(static_list, insert_remove)
+{
+	StaticList<std::string, 3> list;
+	ASSERT_TRUE(list.begin() == list.end());
+	ASSERT_TRUE(list.try_insert("a"));
+	ASSERT_TRUE(list.try_insert("b"));
+	ASSERT_TRUE(list.try_emplace(2, 'c'));
+	ASSERT_TRUE(!list.try_insert("d"));
+
+	list.remove("b");
+	list.remove("x");
+	ASSERT_TRUE(list.getSize() == 2);
+	ASSERT_TRUE(list.try_insert("d"));
+	ASSERT_TRUE(list.front() == "a");
+	ASSERT_TRUE(list.back() == "d");
+
+	StaticList<std::string, 3> copy(list);
+	std::string joined;
+	for (const std::string& s : copy) {
+		joined += s;
+	}
+
+	ASSERT_TRUE(joined == "accd");
+
+	//  removing the tail and the head
+	copy.remove("d");
+	ASSERT_TRUE(copy.back() == "cc");
+	copy.remove("a");
+	ASSERT_TRUE(copy.front() == "cc");
+	ASSERT_TRUE(copy.try_insert("e"));
+	ASSERT_TRUE(copy.back() == "e");
+
+	for (std::string& s : list) {
+		s += "!";
+	}
+
+	StaticList<std::string, 3> moved(std::move(list));
+	ASSERT_TRUE(moved.front() == "a!");
+	copy = moved;
+	ASSERT_TRUE(copy.getSize() == 3);
+	copy.clear();
+	ASSERT_TRUE(copy.empty());
+	ASSERT_TRUE(copy.try_insert("f"));
+
+	constexpr StaticList<int, 4> built = makeList();
+	ASSERT_TRUE(weigh(built) == 46);
+}
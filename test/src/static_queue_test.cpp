@@ -0,0 +1,75 @@
+#include "gtest/gtest.h"
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include "../../lib/include/static_queue.h"
+
+namespace {
+	using utils::storage::StaticQueue;
+
+	//  wraps round the ring several times
+	constexpr int cycle()
+	{
+		StaticQueue<int, 3> queue;
+		int sum = 0;
+		for (int i = 0; i < 10; ++i) {
+			queue.try_push_back(i);
+			if (queue.full()) {
+				sum += queue.front();
+				queue.pop_front();
+			}
+		}
+
+		queue.try_push_front(100);
+		return sum * 1000 + queue.front() + queue.back();
+	}
+
+	static_assert(cycle() == (0 + 1 + 2 + 3 + 4 + 5 + 6 + 7) * 1000 + 100 + 9, "");
+}
+
+TEST(static_queue, ring)
+{
+	StaticQueue<std::string, 4> queue;
+
+	bool threw = false;
+	try {
+		queue.front();
+	} catch (const std::logic_error&) {
+		threw = true;
+	}
+
+	ASSERT_TRUE(threw);
+
+	//  front and back meet in the middle of the ring
+	ASSERT_TRUE(queue.try_push_back("b"));
+	ASSERT_TRUE(queue.try_push_front("a"));
+	ASSERT_TRUE(queue.try_push_back("c"));
+	ASSERT_TRUE(queue.try_emplace_front(2, 'z'));
+	ASSERT_TRUE(!queue.try_push_back("d"));
+	ASSERT_TRUE(!queue.try_push_front("d"));
+	ASSERT_TRUE(queue.front() == "zz");
+	ASSERT_TRUE(queue.back() == "c");
+
+	StaticQueue<std::string, 4> copy(queue);
+	const char* expected[] = { "zz", "a", "b", "c" };
+	for (const char* e : expected) {
+		ASSERT_TRUE(copy.front() == e);
+		copy.pop_front();
+	}
+
+	ASSERT_TRUE(copy.empty());
+	copy.pop_front();
+
+	queue.pop_front();
+	queue.try_push_back("d");
+	StaticQueue<std::string, 4> moved(std::move(queue));
+	ASSERT_TRUE(moved.front() == "a");
+	ASSERT_TRUE(moved.back() == "d");
+
+	copy = moved;
+	ASSERT_TRUE(copy.getSize() == 4);
+	copy.clear();
+	ASSERT_TRUE(copy.empty());
+	ASSERT_TRUE(copy.try_push_back("e"));
+	ASSERT_TRUE(copy.front() == "e");
+}
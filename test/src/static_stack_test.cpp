@@ -0,0 +1,72 @@
+#include "gtest/gtest.h"
+#include <string>
+#include <utility>
+#include "../../lib/include/static_stack.h"
+
+namespace {
+	using utils::storage::StaticStack;
+
+	//  built at compile time, the last push does not fit
+	constexpr StaticStack<int, 4> makeStack()
+	{
+		StaticStack<int, 4> stack;
+		for (int i = 1; i <= 5; ++i) {
+			stack.try_push(i * 10);
+		}
+
+		stack.pop();
+		stack.try_emplace(7);
+		return stack;
+	}
+
+	constexpr int drain(StaticStack<int, 4> stack)
+	{
+		int sum = 0;
+		while (!stack.empty()) {
+			sum += stack.top();
+			stack.pop();
+		}
+
+		return sum;
+	}
+
+	static_assert(makeStack().getSize() == 4, "");
+	static_assert(makeStack().top() == 7, "");
+	static_assert(drain(makeStack()) == 10 + 20 + 30 + 7, "");
+	static_assert(!StaticStack<int, 1>().full(), "");
+}
+
+TEST(static_stack, push_pop)
+{
+	StaticStack<std::string, 3> stack;
+	ASSERT_TRUE(stack.empty());
+	ASSERT_TRUE(stack.try_push("a"));
+	ASSERT_TRUE(stack.try_push(std::string(64, 'b')));
+	ASSERT_TRUE(stack.try_emplace(3, 'c'));
+	ASSERT_TRUE(stack.full());
+
+	//  a full stack is left as it was
+	ASSERT_TRUE(!stack.try_push("d"));
+	ASSERT_TRUE(stack.getSize() == 3);
+	ASSERT_TRUE(stack.top() == "ccc");
+
+	StaticStack<std::string, 3> copy(stack);
+	stack.pop();
+	ASSERT_TRUE(stack.top() == std::string(64, 'b'));
+	ASSERT_TRUE(copy.top() == "ccc");
+
+	StaticStack<std::string, 3> moved(std::move(copy));
+	ASSERT_TRUE(moved.getSize() == 3);
+
+	copy = stack;
+	ASSERT_TRUE(copy.getSize() == 2);
+	copy = std::move(moved);
+	ASSERT_TRUE(copy.top() == "ccc");
+
+	copy.clear();
+	copy.pop();
+	ASSERT_TRUE(copy.empty());
+
+	constexpr StaticStack<int, 4> built = makeStack();
+	ASSERT_TRUE(built.top() == 7);
+}
@@ -0,0 +1,54 @@
+#include "gtest/gtest.h"
+#include <atomic>
+#include <stdexcept>
+#include "../../lib/include/thread_pool.h"
+
+namespace {
+	//  recursive fork-join sum of [lo, hi), nests groups far deeper than there are workers
+	long long forkSum(utils::concurrency::ThreadPool& pool, const long long lo, const long long hi)
+	{
+		if (hi - lo <= 64) {
+			long long sum = 0;
+			for (long long i = lo; i < hi; ++i) sum += i;
+			return sum;
+		}
+
+		const long long mid = lo + (hi - lo) / 2;
+		long long left = 0;
+		utils::concurrency::TaskGroup group(pool);
+		group.run([&]() { left = forkSum(pool, lo, mid); });
+		const long long right = forkSum(pool, mid, hi);
+		group.wait();
+
+		return left + right;
+	}
+}
+
+TEST(thread_pool, task_group)
+{
+	using utils::concurrency::TaskGroup;
+	using utils::concurrency::ThreadPool;
+
+	ThreadPool pool(2);
+	const long long sum = forkSum(pool, 0, 100000);
+
+	//  the first failure reaches the waiting thread, the other tasks still run
+	std::atomic<int> ran{ 0 };
+	bool threw = false;
+	TaskGroup group(pool);
+	for (int i = 0; i < 8; ++i) {
+		group.run([&, i]() {
+			++ran;
+			if (i == 3) throw std::runtime_error("task failed");
+		});
+	}
+
+	try {
+		group.wait();
+	}
+	catch (const std::runtime_error&) {
+		threw = true;
+	}
+
+	ASSERT_TRUE(sum == 100000LL * 99999 / 2 && threw && ran == 8 && pool.getThreadCount() == 2);
+}
@@ -0,0 +1,54 @@
+#include "gtest/gtest.h"
+#include <cstdint>
+#include <limits>
+#include <vector>
+#include "../../lib/include/timing_wheel.h"
+
+namespace {
+	struct Timeout : utils::storage::Timer {
+		int mId = 0;
+	};
+}
+
+TEST(timing_wheel, advance)
+{
+	using utils::storage::TimingWheel;
+
+	//  deadlines spread over several levels, including one far beyond the first rotations
+	const std::uint64_t deadlines[] = { 5, 63, 64, 4095, 4096, 300000, 1ull << 40, 5 };
+	Timeout timeouts[8];
+	TimingWheel<Timeout> wheel(1);
+	for (int i = 0; i < 8; ++i) {
+		timeouts[i].mId = i;
+		wheel.schedule(timeouts[i], deadlines[i]);
+	}
+
+	std::vector<std::uint64_t> firedAt;
+	auto record = [&](Timeout& t) { firedAt.push_back(t.getDeadline()); ASSERT_TRUE(t.getDeadline() <= wheel.getNow() && !t.isScheduled()); };
+
+	const std::size_t early = wheel.advance(4095, record);
+	const std::size_t late = wheel.advance(1ull << 41, record);
+
+	const std::vector<std::uint64_t> expected = { 5, 5, 63, 64, 4095, 4096, 300000, 1ull << 40 };
+	ASSERT_TRUE(early == 5 && late == 3 && firedAt == expected && wheel.empty());
+}
+
+TEST(timing_wheel, advance_to_last_tick)
+{
+	using utils::storage::TimingWheel;
+
+	//  the very last tick is a deadline like any other
+	const std::uint64_t last = std::numeric_limits<std::uint64_t>::max();
+	const std::uint64_t deadlines[] = { 100, last - 64, last - 1, last };
+	Timeout timeouts[4];
+	TimingWheel<Timeout> wheel(0);
+	for (int i = 0; i < 4; ++i) {
+		wheel.schedule(timeouts[i], deadlines[i]);
+	}
+
+	std::vector<std::uint64_t> firedAt;
+	const std::size_t fired = wheel.advance(last, [&](Timeout& t) { firedAt.push_back(t.getDeadline()); });
+
+	const std::vector<std::uint64_t> expected(deadlines, deadlines + 4);
+	ASSERT_TRUE(fired == 4 && firedAt == expected && wheel.getNow() == last && wheel.empty());
+}
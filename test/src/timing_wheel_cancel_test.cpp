@@ -0,0 +1,38 @@
+#include "gtest/gtest.h"
+#include <vector>
+#include "../../lib/include/timing_wheel.h"
+
+namespace {
+	struct Timeout : utils::storage::Timer {
+		int mId = 0;
+	};
+}
+
+TEST(timing_wheel, cancel)
+{
+	using utils::storage::TimingWheel;
+
+	Timeout timeouts[4];
+	TimingWheel<Timeout> wheel;
+	for (int i = 0; i < 4; ++i) {
+		timeouts[i].mId = i;
+		wheel.schedule(timeouts[i], 100 * (i + 1));
+	}
+
+	//  cancel one, reschedule another past the rest, and let a callback reschedule itself once
+	wheel.cancel(timeouts[1]);
+	wheel.schedule(timeouts[0], 1000);
+
+	std::vector<int> fired;
+	bool repeated = false;
+	wheel.advance(1000, [&](Timeout& t) {
+		fired.push_back(t.mId);
+		if (t.mId == 2 && !repeated) {
+			repeated = true;
+			wheel.schedule(t, wheel.getNow() + 50);
+		}
+	});
+
+	const std::vector<int> expected = { 2, 2, 3, 0 };
+	ASSERT_TRUE(fired == expected && wheel.empty() && !timeouts[1].isScheduled());
+}
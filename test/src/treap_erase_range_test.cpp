@@ -0,0 +1,21 @@
+#include "gtest/gtest.h"
+#include "../../lib/include/treap.h"
+
+TEST(treap, erase_range)
+{
+	using utils::storage::Treap;
+
+	Treap<int, int> treap;
+	for (int i = 0; i < 1000; ++i) {
+		treap.insert(i, i);
+	}
+
+	const std::size_t erased = treap.erase_range(100, 200);
+	Treap<int, int> extracted = treap.extract_range(500, 600);
+
+	//  an empty or inverted range removes nothing
+	const std::size_t none = treap.erase_range(150, 50) + treap.erase_range(100, 200);
+
+	ASSERT_TRUE(erased == 100 && none == 0 && treap.getSize() == 800 && !treap.contains(150) && treap.contains(200));
+	ASSERT_TRUE(extracted.getSize() == 100 && extracted.contains(500) && !extracted.contains(600) && !treap.contains(599));
+}
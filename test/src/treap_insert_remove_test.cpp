@@ -0,0 +1,36 @@
+#include "gtest/gtest.h"
+#include <vector>
+#include "../../lib/include/treap.h"
+
+TEST(treap, insert_remove)
+{
+	using utils::storage::Treap;
+	typedef Treap<int, int> IntTreap;
+
+	//  sorted inserts would degenerate a plain BST into a list
+	IntTreap treap;
+	const int count = 1 << 12;
+	for (int i = 0; i < count; ++i) {
+		treap.insert(i, i * 2);
+	}
+
+	const IntTreap::INSERT_RESULT same = treap.insert(7, 14);
+	const IntTreap::INSERT_RESULT different = treap.insert(7, 0);
+
+	int removed = 0;
+	for (int i = 0; i < count; i += 2) {
+		removed += treap.remove(i) ? 1 : 0;
+	}
+
+	std::vector<int> keys;
+	treap.forEach([&](const int& k, const int&) { keys.push_back(k); });
+
+	bool ordered = keys.size() == static_cast<std::size_t>(count / 2);
+	for (std::size_t i = 0; ordered && i < keys.size(); ++i) {
+		ordered = keys[i] == static_cast<int>(2 * i + 1);
+	}
+
+	ASSERT_TRUE(same.second == IntTreap::OVERWRITE_SAME_VALUE_IR && different.second == IntTreap::OVERWRITE_DIFFERENT_VALUE_IR);
+	ASSERT_TRUE(removed == count / 2 && !treap.remove(0) && ordered && *treap.find(7) == 0 && !treap.contains(8));
+	ASSERT_TRUE(treap.getSize() == static_cast<std::size_t>(count / 2) && treap.getHeight() < 48);
+}
@@ -0,0 +1,74 @@
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <iterator>
+#include <random>
+#include <set>
+#include <vector>
+#include "../../lib/include/thread_pool.h"
+#include "../../lib/include/treap.h"
+
+namespace {
+	typedef utils::storage::Treap<int, int> IntTreap;
+
+	IntTreap makeTreap(const std::set<int>& keys, const int tag)
+	{
+		IntTreap treap;
+		for (int key : keys) {
+			treap.insert(key, tag);
+		}
+
+		return treap;
+	}
+
+	//  keys in order, and every value equal to tag
+	std::vector<int> keysOf(const IntTreap& treap, const int tag, bool& tagged)
+	{
+		std::vector<int> keys;
+		treap.forEach([&](const int& k, const int& d) { keys.push_back(k); tagged = tagged && d == tag; });
+		return keys;
+	}
+}
+
+TEST(treap, set_operations)
+{
+	using utils::concurrency::ThreadPool;
+
+	std::mt19937 rng(3);
+	std::set<int> a;
+	std::set<int> b;
+	while (a.size() < 20000) a.insert(static_cast<int>(rng() % 60000));
+	while (b.size() < 5000) b.insert(static_cast<int>(rng() % 60000));
+
+	std::vector<int> expectedUnion;
+	std::vector<int> expectedIntersection;
+	std::vector<int> expectedDifference;
+	std::set_union(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(expectedUnion));
+	std::set_intersection(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(expectedIntersection));
+	std::set_difference(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(expectedDifference));
+
+	ThreadPool pool(4);
+	ThreadPool* pools[] = { nullptr, &pool };
+
+	for (ThreadPool* p : pools) {
+		IntTreap unionLhs = makeTreap(a, 1);
+		IntTreap unionRhs = makeTreap(b, 2);
+		IntTreap intersectionLhs = makeTreap(a, 1);
+		IntTreap intersectionRhs = makeTreap(b, 2);
+		IntTreap differenceLhs = makeTreap(a, 1);
+		IntTreap differenceRhs = makeTreap(b, 2);
+
+		unionLhs.set_union(unionRhs, p);
+		intersectionLhs.set_intersection(intersectionRhs, p);
+		differenceLhs.set_difference(differenceRhs, p);
+
+		//  the left hand side's data survives wherever a key was in both
+		bool unionTagged = true;
+		std::vector<int> unionKeys;
+		unionLhs.forEach([&](const int& k, const int& d) { unionKeys.push_back(k); unionTagged = unionTagged && d == (a.count(k) ? 1 : 2); });
+
+		bool tagged = true;
+		ASSERT_TRUE(unionKeys == expectedUnion && unionTagged && unionLhs.getSize() == expectedUnion.size() && unionRhs.empty());
+		ASSERT_TRUE(keysOf(intersectionLhs, 1, tagged) == expectedIntersection && intersectionLhs.getSize() == expectedIntersection.size() && intersectionRhs.empty());
+		ASSERT_TRUE(keysOf(differenceLhs, 1, tagged) == expectedDifference && differenceLhs.getSize() == expectedDifference.size() && differenceRhs.empty() && tagged);
+	}
+}
@@ -0,0 +1,29 @@
+#include "gtest/gtest.h"
+#include <stdexcept>
+#include "../../lib/include/treap.h"
+
+TEST(treap, split_join)
+{
+	using utils::storage::Treap;
+
+	Treap<int, int> lower;
+	for (int i = 0; i < 1000; ++i) {
+		lower.insert(i, i);
+	}
+
+	Treap<int, int> upper = lower.split(600);
+	const bool splitOk = lower.getSize() == 600 && upper.getSize() == 400 && !lower.contains(600) && upper.contains(600);
+
+	//  overlapping ranges are refused and leave both sides untouched
+	bool threw = false;
+	try {
+		upper.join(lower);
+	}
+	catch (const std::invalid_argument&) {
+		threw = true;
+	}
+
+	lower.join(upper);
+
+	ASSERT_TRUE(splitOk && threw && lower.getSize() == 1000 && upper.empty() && lower.contains(0) && lower.contains(999));
+}
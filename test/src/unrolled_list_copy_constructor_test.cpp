@@ -0,0 +1,14 @@
+#include "gtest/gtest.h"
+#include <string>
+#include "../../lib/include/unrolled_list.h"
+
+TEST(unrolled_list, copy_constructor)
+{
+	using utils::storage::UnrolledList;
+	UnrolledList<std::string, 2> l2{ "a", "b", "c" };
+	UnrolledList<std::string, 2> l1 = l2;
+
+	l2.remove("b");
+
+	ASSERT_TRUE(l1.getSize() == 3 && l2.getSize() == 2);
+}
@@ -0,0 +1,18 @@
+#include "gtest/gtest.h"
+#include "../../lib/include/unrolled_list.h"
+
+TEST(unrolled_list, insert)
+{
+	using utils::storage::UnrolledList;
+	UnrolledList<int, 4> l;
+
+	for (int i = 0; i < 10; ++i) {
+		l.insert(i);
+	}
+
+	int value = 10;
+	l.insert(value);
+	l.emplace(11);
+
+	ASSERT_TRUE(l.getSize() == 12 && l.getNodeCount() == 3);
+}
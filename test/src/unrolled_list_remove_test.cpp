@@ -0,0 +1,23 @@
+#include "gtest/gtest.h"
+#include "../../lib/include/unrolled_list.h"
+
+TEST(unrolled_list, remove)
+{
+	using utils::storage::UnrolledList;
+	UnrolledList<int, 4> l{ 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+
+	l.remove(1);
+	l.remove(9);
+	l.remove(2);
+	l.remove(10);
+	ASSERT_TRUE(l.getSize() == 6 && l.getNodeCount() == 2);
+
+	l.remove(4);
+	l.remove(3);
+	l.remove(5);
+	l.remove(8);
+	l.remove(6);
+	l.remove(7);
+
+	ASSERT_TRUE(l.getSize() == 0 && l.getNodeCount() == 0);
+}